@@ -0,0 +1,165 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#ifndef AWKWARD_BROADCAST_H_
+#define AWKWARD_BROADCAST_H_
+
+#include <string>
+#include <vector>
+
+#include "awkward/common.h"
+#include "awkward/util.h"
+#include "awkward/Content.h"
+
+namespace awkward {
+  class NumpyArray;
+
+  /// @class Elementwise
+  ///
+  /// @brief Abstract class for functions that #broadcast_and_apply applies
+  /// to the aligned NumpyArray leaves of its inputs.
+  class EXPORT_SYMBOL Elementwise {
+  public:
+    /// @brief Virtual destructor acts as a first non-inline virtual function
+    /// that determines a specific translation unit in which vtable shall be
+    /// emitted.
+    virtual ~Elementwise();
+
+    /// @brief Name of the function, as in NumPy's ufuncs.
+    virtual const std::string
+      name() const = 0;
+
+    /// @brief Number of arguments this function takes.
+    virtual int64_t
+      numinputs() const = 0;
+
+    /// @brief Applies the function to NumpyArrays that all have the same
+    /// shape, except for scalars (zero-dimensional arrays), which apply to
+    /// every element.
+    virtual const ContentPtr
+      apply(const std::vector<std::shared_ptr<NumpyArray>>& inputs) const = 0;
+  };
+
+  /// @class ElementwiseUfunc
+  ///
+  /// @brief An Elementwise function backed by one of the typed
+  /// `awkward_elementwise_*` kernels, selected by its NumPy ufunc name.
+  ///
+  /// The registered names are `add`, `subtract`, `multiply`,
+  /// `true_divide` (or `divide`), `power`, `minimum`, `maximum`, `equal`,
+  /// `not_equal`, `less`, `less_equal`, `greater`, `greater_equal`,
+  /// `logical_and`, `logical_or`, `logical_xor`, `negative`, `absolute`,
+  /// `sqrt`, `exp`, `log`, `sin`, `cos`, and `logical_not`.
+  ///
+  /// Inputs may be booleans, `int32`, `int64`, `float32`, or `float64`;
+  /// mixed types are promoted as in NumPy, and any other type raises
+  /// `std::invalid_argument`.
+  class EXPORT_SYMBOL ElementwiseUfunc: public Elementwise {
+  public:
+    /// @brief Creates an ElementwiseUfunc from a registered name, or raises
+    /// `std::invalid_argument` if there is no such function.
+    ElementwiseUfunc(const std::string& name);
+
+    /// @brief Returns `true` if `name` is a registered function.
+    static bool
+      has(const std::string& name);
+
+    const std::string
+      name() const override;
+
+    int64_t
+      numinputs() const override;
+
+    const ContentPtr
+      apply(const std::vector<std::shared_ptr<NumpyArray>>& inputs) const
+      override;
+
+  private:
+    const std::string name_;
+    int64_t op_;
+    int64_t numinputs_;
+  };
+
+  /// @class ElementwiseExpression
+  ///
+  /// @brief An Elementwise function that evaluates a whole expression in
+  /// one pass over its inputs, without an intermediate array for each
+  /// operation.
+  ///
+  /// The expression is a postfix `program` of tokens: `"#i"` for input
+  /// `i`, numbers for constants, and the names of ElementwiseUfunc
+  /// functions or `"where"` (condition, value if true, value if false) for
+  /// operations. For example, `sqrt(x**2 + y**2)` is
+  /// `{"#0", "2", "power", "#1", "2", "power", "add", "sqrt"}`.
+  ///
+  /// The expression is evaluated in the type that NumPy would promote its
+  /// inputs to: `float32` if all floating-point inputs are `float32`,
+  /// `int64` for integer inputs with only integer constants and no
+  /// `divide`, `power`, or transcendental functions (which are otherwise
+  /// `float64`), and `float64` for everything else. The result is a
+  /// boolean array if the last operation is a comparison or logical
+  /// operation, and has the evaluation type otherwise.
+  class EXPORT_SYMBOL ElementwiseExpression: public Elementwise {
+  public:
+    /// @brief Compiles a postfix `program`, raising `std::invalid_argument`
+    /// for unknown tokens or a program that does not leave exactly one
+    /// value.
+    ElementwiseExpression(const std::vector<std::string>& program);
+
+    /// @brief The postfix program this expression was compiled from.
+    const std::vector<std::string>
+      program() const;
+
+    /// @brief Returns `true` if the expression evaluates to booleans.
+    bool
+      isboolean() const;
+
+    const std::string
+      name() const override;
+
+    int64_t
+      numinputs() const override;
+
+    const ContentPtr
+      apply(const std::vector<std::shared_ptr<NumpyArray>>& inputs) const
+      override;
+
+  private:
+    /// @brief Runs the program with output type `T`, evaluated in `C`.
+    template <typename T, typename C>
+    const ContentPtr
+      apply_program(const std::vector<const void*>& ptrs,
+                    const std::vector<int64_t>& offsets,
+                    const std::vector<int64_t>& strides,
+                    const std::vector<int64_t>& dtypes,
+                    const std::vector<ssize_t>& shape,
+                    int64_t length) const;
+
+    const std::vector<std::string> program_;
+    std::vector<int64_t> instructions_;
+    std::vector<double> constants_;
+    int64_t numinputs_;
+    bool isboolean_;
+    bool floatops_;
+    bool integerconstants_;
+  };
+
+  /// @brief Broadcasts `inputs` against one another and applies `function`
+  /// to their aligned NumpyArray leaves, returning an array with the
+  /// structure of the broadcasted inputs.
+  ///
+  /// This follows the same rules as `awkward1._util.broadcast_and_apply`:
+  /// variable-length lists are broadcast to the offsets of the first one,
+  /// regular dimensions of size 1 are repeated, option types are masked
+  /// and reapplied to the result, and records are applied field by field.
+  /// Scalars (zero-dimensional NumpyArrays) are broadcast to everything.
+  /// Lists that share the same offsets are not broadcast at all: their
+  /// contents are passed down directly and the output reuses the offsets.
+  ///
+  /// Inputs with behaviors (`"__array__"` or `"__record__"` parameters),
+  /// unions, or mismatched lengths raise `std::invalid_argument`.
+  EXPORT_SYMBOL const ContentPtr
+    broadcast_and_apply(const ContentPtrVec& inputs,
+                        const Elementwise& function);
+}
+
+#endif // AWKWARD_BROADCAST_H_
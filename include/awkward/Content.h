@@ -5,6 +5,7 @@
 
 #include <cstdio>
 #include <map>
+#include <type_traits>
 
 #include "awkward/common.h"
 #include "awkward/Identities.h"
@@ -21,6 +22,7 @@ namespace awkward {
   class Form;
   using FormPtr       = std::shared_ptr<Form>;
   using FormKey       = std::shared_ptr<std::string>;
+  class ArrayCache;
 
   /// @class Form
   ///
@@ -238,6 +240,37 @@ namespace awkward {
   /// Any Content can be nested within any other Content.
   class EXPORT_SYMBOL Content {
   public:
+    /// @brief Concrete node types, one per class (and integer
+    /// specialization), as returned by #kind.
+    enum class Kind {
+      BitMaskedArray,
+      ByteMaskedArray,
+      EmptyArray,
+      IndexedArray32,
+      IndexedArrayU32,
+      IndexedArray64,
+      IndexedOptionArray32,
+      IndexedOptionArray64,
+      ListArray32,
+      ListArrayU32,
+      ListArray64,
+      ListOffsetArray32,
+      ListOffsetArrayU32,
+      ListOffsetArray64,
+      None,
+      NumpyArray,
+      RawArray,
+      Record,
+      RecordArray,
+      RegularArray,
+      UnionArray8_32,
+      UnionArray8_U32,
+      UnionArray8_64,
+      UnmaskedArray,
+      VirtualArray,
+      Unrecognized
+    };
+
     /// @brief Called by all subclass constructors; assigns #identities and
     /// #parameters upon construction.
     Content(const IdentitiesPtr& identities,
@@ -246,6 +279,41 @@ namespace awkward {
     /// @brief Empty destructor; required for some C++ reason.
     virtual ~Content() { }
 
+    /// @brief If `true`, #carry with `allow_lazy` defers gathering
+    /// NumpyArray data by wrapping it in an
+    /// {@link IndexedArrayOf IndexedArray64}, as RecordArray always does.
+    ///
+    /// Consecutive carries of such an array compose their indexes, so a
+    /// chain of filters gathers each leaf once, when it is projected or
+    /// converted, rather than once per filter. The default is `false`.
+    static bool
+      lazy_carry();
+
+    /// @brief Turns the process-wide #lazy_carry mode on or off.
+    static void
+      set_lazy_carry(bool lazy_carry);
+
+    /// @brief The ArrayCache in which
+    /// {@link IndexedArrayOf#project IndexedArray::project} and
+    /// {@link UnionArrayOf#project UnionArray::project} keep their results,
+    /// to return them (as a #shallow_copy) on later calls instead of
+    /// gathering them again, or `nullptr` if projections are not memoized.
+    /// The default is `nullptr`.
+    ///
+    /// Arrays are immutable, so a memo is never stale. Each node's memos are
+    /// keyed by a number that is unique in the process, so the cache's own
+    /// limits (e.g. an LRUArrayCache) bound the memory they hold.
+    static const std::shared_ptr<ArrayCache>
+      memoize_projections();
+
+    /// @brief Turns the process-wide #memoize_projections mode on with a
+    /// `cache` or off with `nullptr`.
+    ///
+    /// Turning it off does not clear the old cache; it only stops it from
+    /// being used.
+    static void
+      set_memoize_projections(const std::shared_ptr<ArrayCache>& cache);
+
     /// @brief Returns `true` if the data represented by this node is scalar,
     /// not a true array.
     ///
@@ -274,6 +342,11 @@ namespace awkward {
     virtual const std::string
       classname() const = 0;
 
+    /// @brief The concrete node type of this array, for dispatching on
+    /// type with a `switch` or #kind_cast, rather than `dynamic_cast`.
+    virtual Kind
+      kind() const = 0;
+
     /// @brief Optional Identities for each element of the array
     /// (may be `nullptr`).
     virtual const IdentitiesPtr
@@ -449,6 +522,30 @@ namespace awkward {
     virtual const ContentPtr
       getitem(const Slice& where) const;
 
+    /// @brief Selects the entries where `mask` is nonzero (a one-dimensional
+    /// boolean array, as in a SliceMask), without a Slice.
+    ///
+    /// The selected entries are carried directly; NumpyArray compacts its
+    /// data from the mask without making an index of the selected
+    /// positions. Like NumPy, a `mask` whose length differs from this
+    /// array's raises `std::invalid_argument`.
+    virtual const ContentPtr
+      getitem_mask(const Index8& mask) const;
+
+    /// @brief Selects the entries of each list where a jagged array of
+    /// booleans is nonzero: `mask` is its flattened content and `offsets`
+    /// (starting at `0`) are its list boundaries, as in a
+    /// {@link SliceJaggedOf SliceJagged64} of a SliceMask.
+    ///
+    /// ListOffsetArray counts the selected entries of each list for the
+    /// new offsets and applies `mask` to its flattened content with
+    /// #getitem_mask, without making an index of the selected positions
+    /// (ListArray and RegularArray do the same through a ListOffsetArray).
+    /// Other arrays apply the equivalent
+    /// {@link SliceJaggedOf SliceJagged64} (see SliceMask#tojagged).
+    virtual const ContentPtr
+      getitem_jagged_mask(const Index64& offsets, const Index8& mask) const;
+
     /// @brief Internal function that propagates a generic #getitem request
     /// through one axis (including advanced indexing).
     ///
@@ -589,6 +686,32 @@ namespace awkward {
     virtual const ContentPtr
       shallow_simplify() const = 0;
 
+    /// @brief Returns an equivalent array that holds only the elements that
+    /// are reachable from this one, so that buffers left behind by slicing
+    /// and filtering can be released.
+    ///
+    /// The result is built in one traversal and is in a minimal form:
+    /// lists become a ListOffsetArray whose offsets start at zero,
+    /// RegularArray, ByteMaskedArray, and BitMaskedArray contents are
+    /// trimmed to their length, IndexedArray is projected (unless it has
+    /// parameters, such as a categorical), IndexedOptionArray has its
+    /// non-missing values projected (in order), UnionArray contents
+    /// are projected by tag, and NumpyArray data are copied into contiguous
+    /// buffers of exactly their size. Identities and parameters are kept.
+    virtual const ContentPtr
+      packed() const = 0;
+
+    /// @brief Internal function for #packed: returns the elements at
+    /// `nextcarry` positions, packed, gathering each leaf only once.
+    ///
+    /// The default is #packed of #carry, which is right for nodes whose
+    /// #carry only gathers an index (lists, IndexedArray, UnionArray).
+    /// Nodes whose #carry gathers their contents pass `nextcarry` down to
+    /// the contents' `packed_carry` instead, and a NumpyArray's carried
+    /// buffer is already packed.
+    virtual const ContentPtr
+      packed_carry(const Index64& nextcarry) const;
+
     /// @brief The length of this array (as a NumpyArray scalar) if `axis = 0`
     /// or the lengths of subarrays (as an array or nested array) if
     /// `axis != 0`.
@@ -636,6 +759,22 @@ namespace awkward {
     virtual const ContentPtr
       merge(const ContentPtr& other) const = 0;
 
+    /// @brief An array with this and all of the `others` concatenated, in
+    /// order.
+    ///
+    /// Unlike a chain of #merge calls, which copies the accumulated result
+    /// at each step, NumpyArray, ListOffsetArray and RecordArray size their
+    /// output once and copy each input once; ListArray and RegularArray are
+    /// converted to ListOffsetArray to do the same. Any array that is not
+    /// #mergeable is merged as a union (see #merge_as_union), and unions
+    /// are simplified along the way.
+    ///
+    /// @param others The arrays to append to this one.
+    /// @param mergebool If `true`, consider boolean types to be equivalent
+    /// to integers.
+    virtual const ContentPtr
+      merge_many(const ContentPtrVec& others, bool mergebool) const;
+
     /// @brief Converts this array into a SliceItem that can be used in
     /// getitem.
     virtual const SliceItemPtr
@@ -1241,12 +1380,128 @@ namespace awkward {
                           const std::string& pre,
                           const std::string& post) const;
 
+    /// @brief Returns a new number that is unique in the process, to key
+    /// one node's projections in the #memoize_projections cache.
+    static int64_t
+      newprojectionid();
+
+    /// @brief The #memoize_projections cache key of projection `index` of
+    /// the node numbered `projectionid`.
+    static const std::string
+      projection_key(int64_t projectionid, int64_t index);
+
   protected:
     /// @brief See #identities.
     IdentitiesPtr identities_;
     /// @brief See #parameters.
     util::Parameters parameters_;
   };
+
+  class BitMaskedArray;
+  class ByteMaskedArray;
+  class EmptyArray;
+  template <typename T, bool ISOPTION>
+  class IndexedArrayOf;
+  template <typename T>
+  class ListArrayOf;
+  template <typename T>
+  class ListOffsetArrayOf;
+  class None;
+  class NumpyArray;
+  class Record;
+  class RecordArray;
+  class RegularArray;
+  template <typename T, typename I>
+  class UnionArrayOf;
+  class UnmaskedArray;
+  class VirtualArray;
+
+  /// @brief The Content::Kind of node type `T` (specialized for each one).
+  template <typename T>
+  struct ContentKindOf { };
+
+#define AWKWARD_CONTENT_KIND_OF(TYPE, KIND)                             \
+  template <>                                                           \
+  struct ContentKindOf<TYPE> {                                          \
+    static constexpr Content::Kind value() { return Content::Kind::KIND; } \
+  };
+
+  AWKWARD_CONTENT_KIND_OF(BitMaskedArray, BitMaskedArray)
+  AWKWARD_CONTENT_KIND_OF(ByteMaskedArray, ByteMaskedArray)
+  AWKWARD_CONTENT_KIND_OF(EmptyArray, EmptyArray)
+  AWKWARD_CONTENT_KIND_OF(None, None)
+  AWKWARD_CONTENT_KIND_OF(NumpyArray, NumpyArray)
+  AWKWARD_CONTENT_KIND_OF(Record, Record)
+  AWKWARD_CONTENT_KIND_OF(RecordArray, RecordArray)
+  AWKWARD_CONTENT_KIND_OF(RegularArray, RegularArray)
+  AWKWARD_CONTENT_KIND_OF(UnmaskedArray, UnmaskedArray)
+  AWKWARD_CONTENT_KIND_OF(VirtualArray, VirtualArray)
+
+#undef AWKWARD_CONTENT_KIND_OF
+
+  template <typename T, bool ISOPTION>
+  struct ContentKindOf<IndexedArrayOf<T, ISOPTION>> {
+    static constexpr Content::Kind value() {
+      return ISOPTION ?
+        (std::is_same<T, int32_t>::value ? Content::Kind::IndexedOptionArray32 :
+         std::is_same<T, int64_t>::value ? Content::Kind::IndexedOptionArray64 :
+                                           Content::Kind::Unrecognized) :
+        (std::is_same<T, int32_t>::value ? Content::Kind::IndexedArray32 :
+         std::is_same<T, uint32_t>::value ? Content::Kind::IndexedArrayU32 :
+         std::is_same<T, int64_t>::value ? Content::Kind::IndexedArray64 :
+                                           Content::Kind::Unrecognized);
+    }
+  };
+
+  template <typename T>
+  struct ContentKindOf<ListArrayOf<T>> {
+    static constexpr Content::Kind value() {
+      return std::is_same<T, int32_t>::value ? Content::Kind::ListArray32 :
+             std::is_same<T, uint32_t>::value ? Content::Kind::ListArrayU32 :
+             std::is_same<T, int64_t>::value ? Content::Kind::ListArray64 :
+                                               Content::Kind::Unrecognized;
+    }
+  };
+
+  template <typename T>
+  struct ContentKindOf<ListOffsetArrayOf<T>> {
+    static constexpr Content::Kind value() {
+      return std::is_same<T, int32_t>::value ?
+               Content::Kind::ListOffsetArray32 :
+             std::is_same<T, uint32_t>::value ?
+               Content::Kind::ListOffsetArrayU32 :
+             std::is_same<T, int64_t>::value ?
+               Content::Kind::ListOffsetArray64 :
+               Content::Kind::Unrecognized;
+    }
+  };
+
+  template <typename T, typename I>
+  struct ContentKindOf<UnionArrayOf<T, I>> {
+    static constexpr Content::Kind value() {
+      return !std::is_same<T, int8_t>::value ? Content::Kind::Unrecognized :
+             std::is_same<I, int32_t>::value ? Content::Kind::UnionArray8_32 :
+             std::is_same<I, uint32_t>::value ? Content::Kind::UnionArray8_U32 :
+             std::is_same<I, int64_t>::value ? Content::Kind::UnionArray8_64 :
+                                               Content::Kind::Unrecognized;
+    }
+  };
+
+  /// @brief Returns `content` as a `T*` if it is exactly that node type,
+  /// `nullptr` otherwise.
+  ///
+  /// This is a replacement for `dynamic_cast<T*>(content)` that compares
+  /// Content::kind values instead of walking the RTTI, which matters in
+  /// long chains of type tests on small arrays.
+  template <typename T>
+  T*
+  kind_cast(Content* content) {
+    if (content != nullptr  &&
+        content->kind() == ContentKindOf<T>::value()) {
+      return static_cast<T*>(content);
+    }
+    return nullptr;
+  }
 }
 
 #endif // AWKWARD_CONTENT_H_
@@ -533,6 +533,72 @@ namespace awkward {
 
   using SliceJagged64 = SliceJaggedOf<int64_t>;
 
+  /// @class SliceMask
+  ///
+  /// @brief Represents a one-dimensional array of booleans in a slice
+  /// tuple, selecting the entries where the mask is nonzero.
+  ///
+  /// If it is the only item in a Slice, it is applied directly by
+  /// {@link Content#getitem_mask Content::getitem_mask}, which compacts
+  /// the data without making an index of the selected positions.
+  /// Otherwise, Slice#become_sealed replaces it with the equivalent
+  /// {@link SliceArrayOf SliceArray64}.
+  ///
+  /// A {@link SliceJaggedOf SliceJagged64} whose content is a SliceMask is
+  /// a jagged array of booleans (the mask is the flattened content, with
+  /// offsets starting at `0`). If it is the only item in a Slice, it is
+  /// applied directly by
+  /// {@link Content#getitem_jagged_mask Content::getitem_jagged_mask};
+  /// otherwise, it is replaced by #tojagged.
+  class EXPORT_SYMBOL SliceMask: public SliceItem {
+  public:
+    /// @brief Creates a SliceMask from a full set of parameters.
+    ///
+    /// @param mask One byte per entry: nonzero to select the entry.
+    SliceMask(const Index8& mask);
+
+    /// @brief One byte per entry: nonzero to select the entry.
+    const Index8
+      mask() const;
+
+    /// @brief The length of the #mask.
+    int64_t
+      length() const;
+
+    /// @brief The equivalent {@link SliceArrayOf SliceArray64}: the
+    /// positions where #mask is nonzero.
+    const SliceItemPtr
+      toarray() const;
+
+    /// @brief The equivalent {@link SliceJaggedOf SliceJagged64} of local
+    /// positions, if this mask is the content of a jagged slice with
+    /// `offsets`.
+    const SliceItemPtr
+      tojagged(const Index64& offsets) const;
+
+    /// @brief Replaces a SliceMask or a {@link SliceJaggedOf SliceJagged64}
+    /// of a SliceMask with its #toarray or #tojagged equivalent; returns
+    /// any other `item` unchanged.
+    static const SliceItemPtr
+      tostandard(const SliceItemPtr& item);
+
+    const SliceItemPtr
+      shallow_copy() const override;
+
+    const std::string
+      tostring() const override;
+
+    /// @copydoc SliceItem::preserves_type()
+    ///
+    /// Always `true` for SliceMask (it is only applied on its own).
+    bool
+      preserves_type(const Index64& advanced) const override;
+
+  private:
+    /// @brief See #mask.
+    const Index8 mask_;
+  };
+
   /// @class Slice
   ///
   /// @brief A sequence of SliceItem objects representing a tuple passed
@@ -572,8 +638,8 @@ namespace awkward {
     int64_t
       length() const;
 
-    /// @brief The number of SliceAt, SliceRange, and SliceArrayOf objects
-    /// in the #items.
+    /// @brief The number of SliceAt, SliceRange, SliceArrayOf, and
+    /// SliceMask objects in the #items.
     int64_t
       dimlength() const;
 
@@ -582,6 +648,9 @@ namespace awkward {
       head() const;
 
     /// @brief Returns a Slice representing all but the first SliceItem.
+    ///
+    /// The tail shares this Slice's items, so it is made without copying
+    /// them (it is taken at every level of `getitem_next`).
     const Slice
       tail() const;
 
@@ -637,12 +706,20 @@ namespace awkward {
     void
       append(const SliceJagged64& item);
 
+    /// @brief Inserts a SliceMask in-place at the end of the #items.
+    void
+      append(const SliceMask& item);
+
     /// @brief Seal this Slice so that it is no longer open to #append.
+    ///
+    /// A SliceMask that is not the only item is replaced by the equivalent
+    /// {@link SliceArrayOf SliceArray64}, so that it broadcasts with any
+    /// other arrays in the Slice.
     void
       become_sealed();
 
-    /// @brief Returns `true` if the Slice contains SliceArrayOf; `false`
-    /// otherwise.
+    /// @brief Returns `true` if the Slice contains SliceArrayOf or
+    /// SliceMask; `false` otherwise.
     ///
     /// This function can only be called when the Slice is sealed (see
     /// #Slice and #become_sealed).
@@ -650,8 +727,22 @@ namespace awkward {
       isadvanced() const;
 
   private:
-    /// @brief See #items.
-    std::vector<SliceItemPtr> items_;
+    /// @brief Creates a Slice of the items from `start` onward in `items`,
+    /// without copying them.
+    Slice(const std::shared_ptr<std::vector<SliceItemPtr>>& items,
+          size_t start,
+          bool sealed);
+
+    /// @brief Internal function that returns #items_ for modification,
+    /// first copying them if they are shared with another Slice.
+    std::vector<SliceItemPtr>&
+      own_items();
+
+    /// @brief The SliceItem objects, which may be shared with the Slices
+    /// made by #tail (so that #tail does not copy them).
+    std::shared_ptr<std::vector<SliceItemPtr>> items_;
+    /// @brief Position of this Slice's first item in #items_.
+    size_t start_;
     /// @brief See #sealed.
     bool sealed_;
   };
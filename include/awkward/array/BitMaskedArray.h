@@ -208,6 +208,9 @@ namespace awkward {
     const std::string
       classname() const override;
 
+    Kind
+      kind() const override;
+
     void
       setidentities() override;
 
@@ -308,6 +311,13 @@ namespace awkward {
     const ContentPtr
       shallow_simplify() const override;
 
+    /// @copydoc Content::packed()
+    const ContentPtr
+      packed() const override;
+
+    const ContentPtr
+      packed_carry(const Index64& nextcarry) const override;
+
     const ContentPtr
       num(int64_t axis, int64_t depth) const override;
 
@@ -416,6 +426,20 @@ namespace awkward {
     const ContentPtr
       copy_to(kernel::Lib ptr_lib) const override;
 
+  protected:
+    template <typename S>
+    const ContentPtr
+      getitem_next_jagged_generic(const Index64& slicestarts,
+                                  const Index64& slicestops,
+                                  const S& slicecontent,
+                                  const Slice& tail) const;
+
+    /// @brief Positions of the valid elements in #content and an
+    /// {@link IndexedArrayOf IndexedOptionArray} index into them, read
+    /// directly from the bits of #mask.
+    const std::pair<Index64, Index64>
+      nextcarry_outindex(int64_t& numnull) const;
+
   private:
     /// @brief See #mask.
     const IndexU8 mask_;
@@ -178,6 +178,9 @@ namespace awkward {
     const std::string
       classname() const override;
 
+    Kind
+      kind() const override;
+
     void
       setidentities() override;
 
@@ -278,6 +281,13 @@ namespace awkward {
     const ContentPtr
       shallow_simplify() const override;
 
+    /// @copydoc Content::packed()
+    const ContentPtr
+      packed() const override;
+
+    const ContentPtr
+      packed_carry(const Index64& nextcarry) const override;
+
     const ContentPtr
       num(int64_t axis, int64_t depth) const override;
 
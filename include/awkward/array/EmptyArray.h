@@ -99,6 +99,9 @@ namespace awkward {
     const std::string
       classname() const override;
 
+    Kind
+      kind() const override;
+
     void
       setidentities() override;
 
@@ -191,6 +194,12 @@ namespace awkward {
     const ContentPtr
       shallow_simplify() const override;
 
+    /// @copydoc Content::packed()
+    ///
+    /// For EmptyArray, this method returns #shallow_copy (pass-through).
+    const ContentPtr
+      packed() const override;
+
     const ContentPtr
       num(int64_t axis, int64_t depth) const override;
 
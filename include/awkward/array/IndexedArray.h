@@ -242,6 +242,9 @@ namespace awkward {
     const std::string
       classname() const override;
 
+    Kind
+      kind() const override;
+
     void
       setidentities() override;
 
@@ -344,6 +347,17 @@ namespace awkward {
     const ContentPtr
       shallow_simplify() const override;
 
+    /// @copydoc Content::packed()
+    ///
+    /// For {@link IndexedArrayOf IndexedArray}, the result is the packed
+    /// #project, unless it has #parameters (such as a categorical), in which
+    /// case the index is copied and the #content packed; for
+    /// {@link IndexedArrayOf IndexedOptionArray}, it is an
+    /// {@link IndexedArrayOf IndexedOptionArray64} whose index counts up
+    /// through the packed non-missing values.
+    const ContentPtr
+      packed() const override;
+
     const ContentPtr
       num(int64_t axis, int64_t depth) const override;
 
@@ -468,6 +482,9 @@ namespace awkward {
     const IndexOf<T> index_;
     /// @brief See #content.
     const ContentPtr content_;
+    /// @brief Keys the result of #project in the
+    /// Content#memoize_projections cache; renumbered by #setidentities.
+    int64_t projectionid_;
   };
 
 #if !defined AWKWARD_INDEXEDARRAY_NO_EXTERN_TEMPLATE && !defined _MSC_VER
@@ -206,6 +206,9 @@ namespace awkward {
     const std::string
       classname() const override;
 
+    Kind
+      kind() const override;
+
     void
       setidentities() override;
 
@@ -273,6 +276,10 @@ namespace awkward {
     const ContentPtr
       getitem_fields(const std::vector<std::string>& keys) const override;
 
+    const ContentPtr
+      getitem_jagged_mask(const Index64& offsets,
+                          const Index8& mask) const override;
+
     const ContentPtr
       carry(const Index64& carry, bool allow_lazy) const override;
 
@@ -302,6 +309,13 @@ namespace awkward {
     const ContentPtr
       shallow_simplify() const override;
 
+    /// @copydoc Content::packed()
+    ///
+    /// For {@link ListArrayOf ListArray}, the result is a
+    /// {@link ListOffsetArrayOf ListOffsetArray64}.
+    const ContentPtr
+      packed() const override;
+
     const ContentPtr
       num(int64_t axis, int64_t depth) const override;
 
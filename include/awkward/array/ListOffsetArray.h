@@ -187,6 +187,9 @@ namespace awkward {
     const std::string
       classname() const override;
 
+    Kind
+      kind() const override;
+
     void
       setidentities() override;
 
@@ -260,6 +263,10 @@ namespace awkward {
                           const SliceItemPtr& slicecontent,
                           const Slice& tail) const override;
 
+    const ContentPtr
+      getitem_jagged_mask(const Index64& offsets,
+                          const Index8& mask) const override;
+
     const ContentPtr
       carry(const Index64& carry, bool allow_lazy) const override;
 
@@ -289,6 +296,13 @@ namespace awkward {
     const ContentPtr
       shallow_simplify() const override;
 
+    /// @copydoc Content::packed()
+    ///
+    /// For {@link ListOffsetArrayOf ListOffsetArray}, the result is a
+    /// {@link ListOffsetArrayOf ListOffsetArray64}.
+    const ContentPtr
+      packed() const override;
+
     const ContentPtr
       num(int64_t axis, int64_t depth) const override;
 
@@ -301,6 +315,9 @@ namespace awkward {
     const ContentPtr
       merge(const ContentPtr& other) const override;
 
+    const ContentPtr
+      merge_many(const ContentPtrVec& others, bool mergebool) const override;
+
     const SliceItemPtr
       asslice() const override;
 
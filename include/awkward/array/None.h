@@ -33,6 +33,9 @@ namespace awkward {
     const std::string
       classname() const override;
 
+    Kind
+      kind() const override;
+
     /// @exception std::runtime_error is always thrown
     void
       setidentities() override;
@@ -144,6 +147,10 @@ namespace awkward {
     const ContentPtr
       shallow_simplify() const override;
 
+    /// @exception std::runtime_error is always thrown
+    const ContentPtr
+      packed() const override;
+
     /// @exception std::runtime_error is always thrown
     const ContentPtr
       num(int64_t axis, int64_t depth) const override;
@@ -377,6 +377,9 @@ namespace awkward {
     const std::string
       classname() const override;
 
+    Kind
+      kind() const override;
+
     void
       setidentities() override;
 
@@ -449,6 +452,12 @@ namespace awkward {
     const ContentPtr
       getitem(const Slice& where) const override;
 
+    /// @copydoc Content::getitem_mask()
+    ///
+    /// Runs of selected entries are copied at once, directly from the mask.
+    const ContentPtr
+      getitem_mask(const Index8& mask) const override;
+
     const ContentPtr
       getitem_next(const SliceItemPtr& head,
                    const Slice& tail,
@@ -482,6 +491,16 @@ namespace awkward {
     const ContentPtr
       shallow_simplify() const override;
 
+    /// @copydoc Content::packed()
+    ///
+    /// For NumpyArray, the data are always copied: the array cannot tell
+    /// whether its #ptr is shared with a larger buffer.
+    const ContentPtr
+      packed() const override;
+
+    const ContentPtr
+      packed_carry(const Index64& nextcarry) const override;
+
     const ContentPtr
       num(int64_t axis, int64_t depth) const override;
 
@@ -494,6 +513,9 @@ namespace awkward {
     const ContentPtr
       merge(const ContentPtr& other) const override;
 
+    const ContentPtr
+      merge_many(const ContentPtrVec& others, bool mergebool) const override;
+
     const SliceItemPtr
       asslice() const override;
 
@@ -318,6 +318,11 @@ namespace awkward {
         std::string(">");
     }
 
+    Kind
+      kind() const override {
+      return Kind::RawArray;
+    }
+
     void
       setidentities() override {
       if (length() <= kMaxInt32) {
@@ -746,6 +751,14 @@ namespace awkward {
       return shallow_copy();
     }
 
+    /// @copydoc Content::packed()
+    ///
+    /// For RawArray, this method returns a #deep_copy of the items only.
+    const ContentPtr
+      packed() const override {
+      return deep_copy(true, false, false);
+    }
+
     const ContentPtr
       num(int64_t axis, int64_t depth) const override {
       int64_t toaxis = axis_wrap_if_negative(axis);
@@ -59,6 +59,9 @@ namespace awkward {
     const std::string
       classname() const override;
 
+    Kind
+      kind() const override;
+
     const IdentitiesPtr
       identities() const override;
 
@@ -169,6 +172,10 @@ namespace awkward {
     const ContentPtr
       shallow_simplify() const override;
 
+    /// For Record, this method packs the one record it refers to.
+    const ContentPtr
+      packed() const override;
+
     const ContentPtr
       num(int64_t axis, int64_t depth) const override;
 
@@ -174,6 +174,9 @@ namespace awkward {
     const std::string
       classname() const override;
 
+    Kind
+      kind() const override;
+
     void
       setidentities() override;
 
@@ -274,6 +277,13 @@ namespace awkward {
     const ContentPtr
       shallow_simplify() const override;
 
+    /// @copydoc Content::packed()
+    const ContentPtr
+      packed() const override;
+
+    const ContentPtr
+      packed_carry(const Index64& nextcarry) const override;
+
     const ContentPtr
       num(int64_t axis, int64_t depth) const override;
 
@@ -286,6 +296,9 @@ namespace awkward {
     const ContentPtr
       merge(const ContentPtr& other) const override;
 
+    const ContentPtr
+      merge_many(const ContentPtrVec& others, bool mergebool) const override;
+
     const SliceItemPtr
       asslice() const override;
 
@@ -157,6 +157,9 @@ namespace awkward {
     const std::string
       classname() const override;
 
+    Kind
+      kind() const override;
+
     void
       setidentities() override;
 
@@ -224,6 +227,10 @@ namespace awkward {
     const ContentPtr
       getitem_fields(const std::vector<std::string>& keys) const override;
 
+    const ContentPtr
+      getitem_jagged_mask(const Index64& offsets,
+                          const Index8& mask) const override;
+
     const ContentPtr
       carry(const Index64& carry, bool allow_lazy) const override;
 
@@ -252,6 +259,13 @@ namespace awkward {
     const ContentPtr
       shallow_simplify() const override;
 
+    /// @copydoc Content::packed()
+    const ContentPtr
+      packed() const override;
+
+    const ContentPtr
+      packed_carry(const Index64& nextcarry) const override;
+
     const ContentPtr
       num(int64_t axis, int64_t depth) const override;
 
@@ -185,6 +185,9 @@ namespace awkward {
     const std::string
       classname() const override;
 
+    Kind
+      kind() const override;
+
     void
       setidentities() override;
 
@@ -286,6 +289,13 @@ namespace awkward {
     const ContentPtr
       shallow_simplify() const override;
 
+    /// @copydoc Content::packed()
+    ///
+    /// For {@link UnionArrayOf UnionArray}, the result is a
+    /// {@link UnionArrayOf UnionArray8_64} whose index is #regular_index.
+    const ContentPtr
+      packed() const override;
+
     const ContentPtr
       num(int64_t axis, int64_t depth) const override;
 
@@ -406,6 +416,9 @@ namespace awkward {
     const IndexOf<T> tags_;
     const IndexOf<I> index_;
     const ContentPtrVec contents_;
+    /// @brief Keys the results of #project in the
+    /// Content#memoize_projections cache; renumbered by #setidentities.
+    int64_t projectionid_;
   };
 
 #if !defined AWKWARD_UNIONARRAY_NO_EXTERN_TEMPLATE && !defined _MSC_VER
@@ -3,6 +3,7 @@
 #ifndef AWKWARD_VIRTUALARRAY_H_
 #define AWKWARD_VIRTUALARRAY_H_
 
+#include <future>
 #include <string>
 #include <memory>
 #include <vector>
@@ -133,8 +134,9 @@ namespace awkward {
     const kernel::Lib
       ptr_lib() const;
 
-    /// @brief Returns the array if it exists in the #cache; `nullptr`
-    /// otherwise.
+    /// @brief Returns the array if it exists in the #cache (or, if there is
+    /// no #cache, if this VirtualArray has already materialized it);
+    /// `nullptr` otherwise.
     ///
     /// This method *does not* cause the array to be materialized if it is not.
     const ContentPtr
@@ -143,9 +145,28 @@ namespace awkward {
     /// @brief Ensures that the array is generated and returns it.
     ///
     /// This method *does not* return `nullptr`.
+    ///
+    /// Generation is single-flight: if several threads miss the same
+    /// #cache_key in the same #cache at the same time, one of them runs the
+    /// #generator and the others wait for its result (or its exception).
+    /// If there is no #cache, the array is remembered by this VirtualArray
+    /// (not its copies) after the first call.
     const ContentPtr
       array() const;
 
+    /// @brief Function that blocks until another thread's generation of
+    /// the same array (see #array) is finished.
+    using Waiter = void (*)(const std::shared_future<ContentPtr>& generation);
+
+    /// @brief Sets the #Waiter used by all VirtualArrays in the process, or
+    /// restores the default (which just waits) if `nullptr`.
+    ///
+    /// The thread it is waiting for may be running any generator or cache
+    /// (or one nested inside another), so an embedding that has a global
+    /// lock, such as Python's GIL, must release it here.
+    static void
+      set_waiter(Waiter waiter);
+
     /// @brief The key this VirtualArray will use when filling a #cache.
     const std::string
       cache_key() const;
@@ -154,6 +175,9 @@ namespace awkward {
     const std::string
       classname() const override;
 
+    Kind
+      kind() const override;
+
     void
       setidentities() override;
 
@@ -250,6 +274,12 @@ namespace awkward {
     const ContentPtr
       shallow_simplify() const override;
 
+    const ContentPtr
+      packed() const override;
+
+    const ContentPtr
+      packed_carry(const Index64& nextcarry) const override;
+
     const ContentPtr
       num(int64_t axis, int64_t depth) const override;
 
@@ -378,6 +408,9 @@ namespace awkward {
     const std::string cache_key_;
     /// @brief See#ptr_lib
     const kernel::Lib ptr_lib_;
+    /// @brief The materialized array if there is no #cache; only accessed
+    /// through `std::atomic_load` and `std::atomic_store`.
+    mutable ContentPtr memo_;
   };
 
 }
@@ -0,0 +1,280 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#ifndef AWKWARDCPU_ELEMENTWISE_H_
+#define AWKWARDCPU_ELEMENTWISE_H_
+
+#include "awkward/common.h"
+
+extern "C" {
+  /// @brief Operation codes for the `op` argument of the elementwise kernels.
+  enum awkward_elementwise_op {
+    awkward_elementwise_add = 0,
+    awkward_elementwise_subtract = 1,
+    awkward_elementwise_multiply = 2,
+    awkward_elementwise_divide = 3,
+    awkward_elementwise_power = 4,
+    awkward_elementwise_minimum = 5,
+    awkward_elementwise_maximum = 6,
+    awkward_elementwise_equal = 10,
+    awkward_elementwise_not_equal = 11,
+    awkward_elementwise_less = 12,
+    awkward_elementwise_less_equal = 13,
+    awkward_elementwise_greater = 14,
+    awkward_elementwise_greater_equal = 15,
+    awkward_elementwise_logical_and = 20,
+    awkward_elementwise_logical_or = 21,
+    awkward_elementwise_logical_xor = 22,
+    awkward_elementwise_negative = 30,
+    awkward_elementwise_absolute = 31,
+    awkward_elementwise_sqrt = 32,
+    awkward_elementwise_exp = 33,
+    awkward_elementwise_log = 34,
+    awkward_elementwise_sin = 35,
+    awkward_elementwise_cos = 36,
+    awkward_elementwise_logical_not = 37,
+    awkward_elementwise_where = 40,
+    awkward_elementwise_input = 100,
+    awkward_elementwise_constant = 101
+  };
+
+  /// @brief Type codes for the inputs of the `awkward_elementwise_program`
+  /// kernels.
+  enum awkward_elementwise_dtype {
+    awkward_elementwise_dtype_bool = 0,
+    awkward_elementwise_dtype_int32 = 1,
+    awkward_elementwise_dtype_int64 = 2,
+    awkward_elementwise_dtype_float32 = 3,
+    awkward_elementwise_dtype_float64 = 4
+  };
+
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_binary_float64(
+      double* toptr,
+      const double* leftptr,
+      int64_t leftoffset,
+      int64_t leftstride,
+      const double* rightptr,
+      int64_t rightoffset,
+      int64_t rightstride,
+      int64_t length,
+      int64_t op);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_binary_float32(
+      float* toptr,
+      const float* leftptr,
+      int64_t leftoffset,
+      int64_t leftstride,
+      const float* rightptr,
+      int64_t rightoffset,
+      int64_t rightstride,
+      int64_t length,
+      int64_t op);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_binary_int64(
+      int64_t* toptr,
+      const int64_t* leftptr,
+      int64_t leftoffset,
+      int64_t leftstride,
+      const int64_t* rightptr,
+      int64_t rightoffset,
+      int64_t rightstride,
+      int64_t length,
+      int64_t op);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_binary_int32(
+      int32_t* toptr,
+      const int32_t* leftptr,
+      int64_t leftoffset,
+      int64_t leftstride,
+      const int32_t* rightptr,
+      int64_t rightoffset,
+      int64_t rightstride,
+      int64_t length,
+      int64_t op);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_binary_bool(
+      bool* toptr,
+      const bool* leftptr,
+      int64_t leftoffset,
+      int64_t leftstride,
+      const bool* rightptr,
+      int64_t rightoffset,
+      int64_t rightstride,
+      int64_t length,
+      int64_t op);
+
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_compare_float64(
+      bool* toptr,
+      const double* leftptr,
+      int64_t leftoffset,
+      int64_t leftstride,
+      const double* rightptr,
+      int64_t rightoffset,
+      int64_t rightstride,
+      int64_t length,
+      int64_t op);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_compare_float32(
+      bool* toptr,
+      const float* leftptr,
+      int64_t leftoffset,
+      int64_t leftstride,
+      const float* rightptr,
+      int64_t rightoffset,
+      int64_t rightstride,
+      int64_t length,
+      int64_t op);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_compare_int64(
+      bool* toptr,
+      const int64_t* leftptr,
+      int64_t leftoffset,
+      int64_t leftstride,
+      const int64_t* rightptr,
+      int64_t rightoffset,
+      int64_t rightstride,
+      int64_t length,
+      int64_t op);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_compare_int32(
+      bool* toptr,
+      const int32_t* leftptr,
+      int64_t leftoffset,
+      int64_t leftstride,
+      const int32_t* rightptr,
+      int64_t rightoffset,
+      int64_t rightstride,
+      int64_t length,
+      int64_t op);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_compare_bool(
+      bool* toptr,
+      const bool* leftptr,
+      int64_t leftoffset,
+      int64_t leftstride,
+      const bool* rightptr,
+      int64_t rightoffset,
+      int64_t rightstride,
+      int64_t length,
+      int64_t op);
+
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_unary_float64(
+      double* toptr,
+      const double* fromptr,
+      int64_t fromoffset,
+      int64_t length,
+      int64_t op);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_unary_float32(
+      float* toptr,
+      const float* fromptr,
+      int64_t fromoffset,
+      int64_t length,
+      int64_t op);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_unary_int64(
+      int64_t* toptr,
+      const int64_t* fromptr,
+      int64_t fromoffset,
+      int64_t length,
+      int64_t op);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_unary_int32(
+      int32_t* toptr,
+      const int32_t* fromptr,
+      int64_t fromoffset,
+      int64_t length,
+      int64_t op);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_unary_bool(
+      bool* toptr,
+      const bool* fromptr,
+      int64_t fromoffset,
+      int64_t length,
+      int64_t op);
+
+  /// @brief Evaluates a postfix `program` of `programlength` instructions,
+  /// each a pair of `(op, argument)`, for every element, in blocks that
+  /// stay in cache instead of whole-array temporaries.
+  ///
+  /// `awkward_elementwise_input` pushes input `argument` (converted to the
+  /// computation type from its `inputdtypes` code),
+  /// `awkward_elementwise_constant` pushes `constants[argument]`, and every
+  /// other op pops its arguments and pushes its result. Comparisons and
+  /// logical operations give `1` or `0`; `awkward_elementwise_where` pops
+  /// a condition and two values.
+  ///
+  /// The computation type is the output type, or the suffix after `bool_`
+  /// for boolean outputs. Integer programs may not contain divide, power,
+  /// or the transcendental functions.
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_program_int64(
+      int64_t* toptr,
+      const void* const* inputptrs,
+      const int64_t* inputoffsets,
+      const int64_t* inputstrides,
+      const int64_t* inputdtypes,
+      const int64_t* program,
+      int64_t programlength,
+      const double* constants,
+      int64_t length);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_program_float32(
+      float* toptr,
+      const void* const* inputptrs,
+      const int64_t* inputoffsets,
+      const int64_t* inputstrides,
+      const int64_t* inputdtypes,
+      const int64_t* program,
+      int64_t programlength,
+      const double* constants,
+      int64_t length);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_program_float64(
+      double* toptr,
+      const void* const* inputptrs,
+      const int64_t* inputoffsets,
+      const int64_t* inputstrides,
+      const int64_t* inputdtypes,
+      const int64_t* program,
+      int64_t programlength,
+      const double* constants,
+      int64_t length);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_program_bool_int64(
+      bool* toptr,
+      const void* const* inputptrs,
+      const int64_t* inputoffsets,
+      const int64_t* inputstrides,
+      const int64_t* inputdtypes,
+      const int64_t* program,
+      int64_t programlength,
+      const double* constants,
+      int64_t length);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_program_bool_float32(
+      bool* toptr,
+      const void* const* inputptrs,
+      const int64_t* inputoffsets,
+      const int64_t* inputstrides,
+      const int64_t* inputdtypes,
+      const int64_t* program,
+      int64_t programlength,
+      const double* constants,
+      int64_t length);
+  EXPORT_SYMBOL struct Error
+    awkward_elementwise_program_bool_float64(
+      bool* toptr,
+      const void* const* inputptrs,
+      const int64_t* inputoffsets,
+      const int64_t* inputstrides,
+      const int64_t* inputdtypes,
+      const int64_t* program,
+      int64_t programlength,
+      const double* constants,
+      int64_t length);
+}
+
+#endif // AWKWARDCPU_ELEMENTWISE_H_
@@ -196,6 +196,45 @@ extern "C" {
       int64_t stride,
       int64_t offset,
       const int64_t* pos);
+  EXPORT_SYMBOL struct Error
+    awkward_NumpyArray_getitem_boolean_compact(
+      uint8_t* toptr,
+      const uint8_t* fromptr,
+      int64_t byteoffset,
+      int64_t stride,
+      const int8_t* mask,
+      int64_t maskoffset,
+      int64_t length);
+  EXPORT_SYMBOL struct Error
+    awkward_ListOffsetArray32_getitem_jagged_mask_64(
+      int64_t* tooffsets,
+      const int32_t* fromoffsets,
+      int64_t fromoffsetsoffset,
+      const int64_t* maskoffsets,
+      int64_t maskoffsetsoffset,
+      const int8_t* mask,
+      int64_t maskoffset,
+      int64_t length);
+  EXPORT_SYMBOL struct Error
+    awkward_ListOffsetArrayU32_getitem_jagged_mask_64(
+      int64_t* tooffsets,
+      const uint32_t* fromoffsets,
+      int64_t fromoffsetsoffset,
+      const int64_t* maskoffsets,
+      int64_t maskoffsetsoffset,
+      const int8_t* mask,
+      int64_t maskoffset,
+      int64_t length);
+  EXPORT_SYMBOL struct Error
+    awkward_ListOffsetArray64_getitem_jagged_mask_64(
+      int64_t* tooffsets,
+      const int64_t* fromoffsets,
+      int64_t fromoffsetsoffset,
+      const int64_t* maskoffsets,
+      int64_t maskoffsetsoffset,
+      const int8_t* mask,
+      int64_t maskoffset,
+      int64_t length);
   EXPORT_SYMBOL struct Error
     awkward_NumpyArray_getitem_next_at_64(
       int64_t* nextcarryptr,
@@ -1089,6 +1128,41 @@ extern "C" {
       int64_t length,
       bool validwhen);
 
+  EXPORT_SYMBOL struct Error
+    awkward_BitMaskedArray_numnull(
+      int64_t* numnull,
+      const uint8_t* mask,
+      int64_t maskoffset,
+      int64_t length,
+      bool validwhen,
+      bool lsb_order);
+  EXPORT_SYMBOL struct Error
+    awkward_BitMaskedArray_getitem_nextcarry_64(
+      int64_t* tocarry,
+      const uint8_t* mask,
+      int64_t maskoffset,
+      int64_t length,
+      bool validwhen,
+      bool lsb_order);
+  EXPORT_SYMBOL struct Error
+    awkward_BitMaskedArray_getitem_nextcarry_outindex_64(
+      int64_t* tocarry,
+      int64_t* outindex,
+      const uint8_t* mask,
+      int64_t maskoffset,
+      int64_t length,
+      bool validwhen,
+      bool lsb_order);
+  EXPORT_SYMBOL struct Error
+    awkward_BitMaskedArray_getitem_carry_64(
+      uint8_t* tomask,
+      const uint8_t* frommask,
+      int64_t frommaskoffset,
+      int64_t lenmask,
+      const int64_t* fromcarry,
+      int64_t lencarry,
+      bool lsb_order);
+
   EXPORT_SYMBOL struct Error
   awkward_Content_getitem_next_missing_jagged_getmaskstartstop(
       int64_t* index_in, int64_t index_in_offset, int64_t* offsets_in,
@@ -1212,6 +1212,18 @@ extern "C" {
       int64_t parentsoffset,
       int64_t length,
       bool validwhen);
+  EXPORT_SYMBOL struct Error
+    awkward_BitMaskedArray_reduce_next_64(
+      int64_t* nextcarry,
+      int64_t* nextparents,
+      int64_t* outindex,
+      const uint8_t* mask,
+      int64_t maskoffset,
+      const int64_t* parents,
+      int64_t parentsoffset,
+      int64_t length,
+      bool validwhen,
+      bool lsb_order);
 
 }
 
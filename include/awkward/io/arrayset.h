@@ -0,0 +1,228 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#ifndef AWKWARD_IO_ARRAYSET_H_
+#define AWKWARD_IO_ARRAYSET_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "awkward/common.h"
+#include "awkward/util.h"
+#include "awkward/Index.h"
+#include "awkward/Content.h"
+#include "awkward/virtual/ArrayCache.h"
+#include "awkward/virtual/ArrayGenerator.h"
+
+namespace awkward {
+  /// @class ArraysetFile
+  ///
+  /// @brief A single file containing a Form and the raw buffers of every
+  /// {@link IndexOf Index} and NumpyArray in an array, opened without
+  /// reading the buffers.
+  ///
+  /// The file is a fixed header (magic string, version, top-level length,
+  /// sizes of the sections that follow), the Form as JSON, a table of
+  /// buffers, a table of node lengths, and then the buffers themselves,
+  /// each aligned to a 64-byte boundary. Buffers are keyed the same way as
+  /// in `ak.to_arrayset`: `form_key` for NumpyArray data and
+  /// `form_key + "-" + attribute` (`"offsets"`, `"starts"`, `"index"`, ...)
+  /// for {@link IndexOf Indexes}.
+  ///
+  /// On POSIX systems, the file is memory-mapped (copy-on-write) when it is
+  /// opened, and every buffer handed out shares ownership of that mapping
+  /// (through `std::shared_ptr`'s aliasing constructor), so the file is
+  /// unmapped when the ArraysetFile and the last array referring to it are
+  /// gone. Opening costs only as much as reading the metadata; pages of the
+  /// buffers are faulted in when they are first touched. On other systems,
+  /// the whole file is read into memory.
+  ///
+  /// Buffers are little-endian; the file can only be read and written on
+  /// little-endian machines.
+  class EXPORT_SYMBOL ArraysetFile {
+  public:
+    /// @brief Opens and maps the file at `path` and reads its metadata.
+    ArraysetFile(const std::string& path);
+
+    /// @brief The path this file was opened from.
+    const std::string
+      path() const;
+
+    /// @brief Form of the whole array, with a unique `form_key` on each
+    /// node.
+    const FormPtr
+      form() const;
+
+    /// @brief Length of the whole array.
+    int64_t
+      length() const;
+
+    /// @brief Total number of bytes in the file.
+    int64_t
+      filesize() const;
+
+    /// @brief Keys of all buffers in the file.
+    const std::vector<std::string>
+      keys() const;
+
+    /// @brief Returns `true` if the file has a buffer with this `key`;
+    /// `false` otherwise.
+    bool
+      has_buffer(const std::string& key) const;
+
+    /// @brief The buffer associated with `key`; raises an error if there is
+    /// no such buffer.
+    ///
+    /// The returned pointer shares ownership of the whole mapping.
+    const std::shared_ptr<void>
+      buffer(const std::string& key) const;
+
+    /// @brief Number of bytes in the buffer associated with `key`.
+    int64_t
+      buffer_nbytes(const std::string& key) const;
+
+    /// @brief Length of the node whose `form_key` is `key`.
+    int64_t
+      node_length(const std::string& key) const;
+
+    /// @brief The whole array, built without copying any buffers.
+    const ContentPtr
+      content() const;
+
+    /// @brief The subtree of the array described by `form`, which must be
+    /// this file's #form or one of its descendants.
+    ///
+    /// Only the buffers referenced by `form` and its descendants are
+    /// touched.
+    const ContentPtr
+      content(const FormPtr& form) const;
+
+  private:
+    /// @brief Internal function to check that the buffer associated with
+    /// `key` holds at least `length` items of `itemsize` bytes each,
+    /// raising an error naming the buffer if it does not.
+    void
+      check_buffer(const std::string& key,
+                   int64_t length,
+                   int64_t itemsize) const;
+
+    /// @brief Internal function to wrap the first `length` items of one
+    /// buffer as an {@link IndexOf Index}, after #check_buffer.
+    template <typename T>
+    const IndexOf<T>
+      index(const std::string& key, int64_t length) const;
+
+    /// @brief See #path.
+    const std::string path_;
+    /// @brief The whole file (mapped or read into memory).
+    std::shared_ptr<void> data_;
+    /// @brief See #filesize.
+    int64_t filesize_;
+    /// @brief See #form.
+    FormPtr form_;
+    /// @brief See #length.
+    int64_t length_;
+    /// @brief Byte offset and number of bytes of each buffer by key.
+    std::map<std::string, std::pair<int64_t, int64_t>> buffers_;
+    /// @brief Length of each node by `form_key`.
+    std::map<std::string, int64_t> lengths_;
+  };
+
+  using ArraysetFilePtr = std::shared_ptr<ArraysetFile>;
+
+  /// @class ArraysetGenerator
+  ///
+  /// @brief Generator for one subtree of an ArraysetFile: produces the
+  /// array described by #form (which must carry the file's `form_keys`)
+  /// from the file's buffers, without Python.
+  ///
+  /// Only the buffers of that subtree are touched, so a VirtualArray with
+  /// this generator reads nothing from the other columns of the file.
+  class EXPORT_SYMBOL ArraysetGenerator: public ArrayGenerator {
+  public:
+    /// @brief Creates an ArraysetGenerator from a full set of parameters.
+    ///
+    /// @param form The subtree of `file`'s Form to generate; may not be
+    /// `nullptr`.
+    /// @param length The length of the generated array or a negative number
+    /// if unknown.
+    /// @param file The open file to read from.
+    /// @param start The first entry of the subtree to generate; entries
+    /// `start` to `start + length` are generated (if `length` is known).
+    ArraysetGenerator(const FormPtr& form,
+                      int64_t length,
+                      const ArraysetFilePtr& file,
+                      int64_t start = 0);
+
+    /// @brief The open file to read from.
+    const ArraysetFilePtr
+      file() const;
+
+    /// @brief The first entry of the subtree to generate.
+    int64_t
+      start() const;
+
+    const ContentPtr
+      generate() const override;
+
+    const std::string
+      tostring_part(const std::string& indent,
+                    const std::string& pre,
+                    const std::string& post) const override;
+
+    const std::shared_ptr<ArrayGenerator>
+      shallow_copy() const override;
+
+    const std::shared_ptr<ArrayGenerator>
+      with_form(const FormPtr& form) const override;
+
+    const std::shared_ptr<ArrayGenerator>
+      with_length(int64_t length) const override;
+
+    /// @brief If #form is a RecordForm, returns an ArraysetGenerator that
+    /// reads only the buffers of field `key`.
+    const std::shared_ptr<ArrayGenerator>
+      project_field(const std::string& key) const override;
+
+    /// @brief If #length is known, returns an ArraysetGenerator for entries
+    /// `start` to `stop` of this one, which reads only those entries.
+    const std::shared_ptr<ArrayGenerator>
+      project_range(int64_t start, int64_t stop) const override;
+
+  private:
+    /// @brief See #file.
+    const ArraysetFilePtr file_;
+    /// @brief See #start.
+    const int64_t start_;
+  };
+
+  /// @brief Writes an array to a single ArraysetFile.
+  ///
+  /// @param array The array to write; VirtualArrays are materialized and
+  /// arrays on other devices are copied to main memory first. Arrays with
+  /// Identities are not supported.
+  /// @param path The file to create or overwrite.
+  ///
+  /// Buffers are written as they are: this does not remove data that the
+  /// array does not reach (e.g. after slicing a ListArray).
+  EXPORT_SYMBOL void
+    ToArraysetFile(const ContentPtr& array, const std::string& path);
+
+  /// @brief Reads a whole ArraysetFile as a Content array, without copying
+  /// the buffers.
+  ///
+  /// @param path The file to read.
+  EXPORT_SYMBOL const ContentPtr
+    FromArraysetFile(const std::string& path);
+
+  /// @brief Opens an ArraysetFile lazily: each field of a top-level record
+  /// (or the whole array, if it is not a record) becomes a VirtualArray with
+  /// an ArraysetGenerator, so that only the fields that are used are read.
+  ///
+  /// @param path The file to read.
+  /// @param cache Cache for the VirtualArrays (may be `nullptr`).
+  EXPORT_SYMBOL const ContentPtr
+    FromArraysetFileLazy(const std::string& path, const ArrayCachePtr& cache);
+}
+
+#endif // AWKWARD_IO_ARRAYSET_H_
@@ -0,0 +1,102 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#ifndef AWKWARD_IO_ARROW_H_
+#define AWKWARD_IO_ARROW_H_
+
+#include <string>
+
+#include "awkward/common.h"
+#include "awkward/Content.h"
+
+// The Apache Arrow C Data Interface, exactly as specified in
+// https://arrow.apache.org/docs/format/CDataInterface.html (the guard lets
+// it coexist with Arrow's own copy of these definitions).
+
+extern "C" {
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+  struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+  };
+
+  struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+  };
+
+#endif  // ARROW_C_DATA_INTERFACE
+}
+
+namespace awkward {
+  /// @brief Exports an array through the Arrow C Data Interface, without
+  /// copying buffers wherever Arrow and Awkward layouts agree.
+  ///
+  /// @param array The array to export; VirtualArrays are materialized and
+  /// arrays on other devices are copied to main memory first.
+  /// @param schema Uninitialized struct to fill with the array's type.
+  /// @param out Uninitialized struct to fill with the array's data.
+  ///
+  /// Both structs must eventually be released by the consumer (through
+  /// their `release` callbacks); until then, they share ownership of the
+  /// Awkward buffers they point to.
+  ///
+  /// The mapping is the same as `ak.to_arrow`: NumpyArray becomes a
+  /// primitive array (booleans are bit-packed, multidimensional arrays are
+  /// fixed-size lists), RegularArray becomes a fixed-size list, lists become
+  /// (large) lists or, with `"__array__"` parameters, (large) strings and
+  /// binaries, RecordArray becomes a struct, UnionArray becomes a dense
+  /// union, IndexedArray and IndexedOptionArray become dictionary-encoded
+  /// arrays, and option types become validity bitmaps. Identities and other
+  /// parameters are not exported.
+  EXPORT_SYMBOL void
+    ToArrow(const ContentPtr& array,
+            struct ArrowSchema* schema,
+            struct ArrowArray* out);
+
+  /// @brief Imports an array from the Arrow C Data Interface without
+  /// copying buffers wherever Arrow and Awkward layouts agree.
+  ///
+  /// @param schema The array's type; it is released before this function
+  /// returns (even if it fails).
+  /// @param array The array's data; its contents are moved into an object
+  /// that is shared by all of the output's buffers, so that it is released
+  /// when the last of them is deleted. On return, `array` is marked as
+  /// released.
+  ///
+  /// This is the inverse of ToArrow: Arrow validity bitmaps become
+  /// BitMaskedArrays, dictionary-encoded arrays become IndexedArrays, and
+  /// structs whose field names are `"0"`, `"1"`, ... become tuples.
+  EXPORT_SYMBOL const ContentPtr
+    FromArrow(struct ArrowSchema* schema, struct ArrowArray* array);
+}
+
+#endif // AWKWARD_IO_ARROW_H_
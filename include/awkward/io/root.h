@@ -25,15 +25,23 @@ namespace awkward {
   /// non-negative integer is allowed.
   /// @param itemsize The number of bytes in each numerical value in the
   /// deepest `std::vector`.
-  /// @param format The pybind11 format string for the data type.
+  /// @param format The pybind11 format string for the data type. If it
+  /// specifies a non-native byte order (e.g. `">f"` on a little-endian
+  /// machine), the data are byteswapped and the output has the native format.
   /// @param options Configuration options for building an ArrayBuilder array.
+  /// @param numthreads Number of threads to decode with; if `1`, entries are
+  /// decoded sequentially; if `0` or negative, one thread per hardware core.
+  /// In parallel mode, the entries are split into ranges of about the same
+  /// number of bytes, each range's output size is counted, and then all
+  /// ranges fill disjoint parts of the same output buffers.
   EXPORT_SYMBOL const ContentPtr
     FromROOT_nestedvector(const Index64& byteoffsets,
                           const NumpyArray& rawdata,
                           int64_t depth,
                           int64_t itemsize,
                           std::string format,
-                          const ArrayBuilderOptions& options);
+                          const ArrayBuilderOptions& options,
+                          int64_t numthreads = 1);
 }
 
 #endif // AWKWARD_IO_ROOT_H_
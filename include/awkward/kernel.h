@@ -317,6 +317,15 @@ namespace kernel {
     int64_t length,
     int64_t stride);
 
+  ERROR NumpyArray_getitem_boolean_compact(
+    uint8_t* toptr,
+    const uint8_t* fromptr,
+    int64_t byteoffset,
+    int64_t stride,
+    const int8_t* mask,
+    int64_t maskoffset,
+    int64_t length);
+
   ERROR NumpyArray_getitem_boolean_nonzero_64(
     int64_t* toptr,
     const int8_t* fromptr,
@@ -528,6 +537,17 @@ namespace kernel {
     int64_t maskoffset,
     int64_t masklength);
 
+  template <typename T>
+  ERROR ListOffsetArray_getitem_jagged_mask_64(
+    int64_t* tooffsets,
+    const T* fromoffsets,
+    int64_t fromoffsetsoffset,
+    const int64_t* maskoffsets,
+    int64_t maskoffsetsoffset,
+    const int8_t* mask,
+    int64_t maskoffset,
+    int64_t length);
+
   ERROR IndexedArray_getitem_adjust_outindex_64(
     int8_t* tomask,
     int64_t* toindex,
@@ -734,6 +754,40 @@ namespace kernel {
     int64_t length,
     bool validwhen);
 
+  ERROR BitMaskedArray_numnull(
+    int64_t* numnull,
+    const uint8_t* mask,
+    int64_t maskoffset,
+    int64_t length,
+    bool validwhen,
+    bool lsb_order);
+
+  ERROR BitMaskedArray_getitem_nextcarry_64(
+    int64_t* tocarry,
+    const uint8_t* mask,
+    int64_t maskoffset,
+    int64_t length,
+    bool validwhen,
+    bool lsb_order);
+
+  ERROR BitMaskedArray_getitem_nextcarry_outindex_64(
+    int64_t* tocarry,
+    int64_t* outindex,
+    const uint8_t* mask,
+    int64_t maskoffset,
+    int64_t length,
+    bool validwhen,
+    bool lsb_order);
+
+  ERROR BitMaskedArray_getitem_carry_64(
+    uint8_t* tomask,
+    const uint8_t* frommask,
+    int64_t frommaskoffset,
+    int64_t lenmask,
+    const int64_t* fromcarry,
+    int64_t lencarry,
+    bool lsb_order);
+
   ERROR Content_getitem_next_missing_jagged_getmaskstartstop(
       int64_t* index_in, int64_t index_in_offset, int64_t* offsets_in,
       int64_t offsets_in_offset, int64_t* mask_out, int64_t* starts_out,
@@ -1597,6 +1651,18 @@ namespace kernel {
     int64_t length,
     bool validwhen);
 
+  ERROR BitMaskedArray_reduce_next_64(
+    int64_t* nextcarry,
+    int64_t* nextparents,
+    int64_t* outindex,
+    const uint8_t* mask,
+    int64_t maskoffset,
+    const int64_t* parents,
+    int64_t parentsoffset,
+    int64_t length,
+    bool validwhen,
+    bool lsb_order);
+
   /////////////////////////////////// awkward/cpu-kernels/sorting.h
 
   ERROR sorting_ranges(
@@ -1660,6 +1726,52 @@ namespace kernel {
     int64_t parentslength,
     const int64_t* nextparents,
     int64_t nextparentsoffset);
+
+  /////////////////////////////////// awkward/cpu-kernels/elementwise.h
+
+  template <typename T>
+  ERROR elementwise_binary(
+    T* toptr,
+    const T* leftptr,
+    int64_t leftoffset,
+    int64_t leftstride,
+    const T* rightptr,
+    int64_t rightoffset,
+    int64_t rightstride,
+    int64_t length,
+    int64_t op);
+
+  template <typename T>
+  ERROR elementwise_compare(
+    bool* toptr,
+    const T* leftptr,
+    int64_t leftoffset,
+    int64_t leftstride,
+    const T* rightptr,
+    int64_t rightoffset,
+    int64_t rightstride,
+    int64_t length,
+    int64_t op);
+
+  template <typename T>
+  ERROR elementwise_unary(
+    T* toptr,
+    const T* fromptr,
+    int64_t fromoffset,
+    int64_t length,
+    int64_t op);
+
+  template <typename T, typename C>
+  ERROR elementwise_program(
+    T* toptr,
+    const void* const* inputptrs,
+    const int64_t* inputoffsets,
+    const int64_t* inputstrides,
+    const int64_t* inputdtypes,
+    const int64_t* program,
+    int64_t programlength,
+    const double* constants,
+    int64_t length);
 }
 
 #endif //AWKWARD_KERNEL_H_
@@ -0,0 +1,110 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#ifndef AWKWARD_PARTITIONPREFETCHER_H_
+#define AWKWARD_PARTITIONPREFETCHER_H_
+
+#include <future>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "awkward/partition/PartitionedArray.h"
+
+namespace awkward {
+  /// @class PartitionPrefetcher
+  ///
+  /// @brief Reads ahead through a PartitionedArray: while partition `k` is
+  /// being processed, partitions `k + 1` through `k + depth` are
+  /// materialized on background threads.
+  ///
+  /// Materializing a partition means calling
+  /// {@link VirtualArray#array VirtualArray::array} on every VirtualArray
+  /// it consists of (directly or as fields of a RecordArray), which puts
+  /// the generated arrays in the VirtualArrays' caches (or their memos, if
+  /// they have no cache). Partitions that are not virtual cost nothing.
+  ///
+  /// The number of generated bytes that have been prefetched but not yet
+  /// requested through #partition is bounded by #max_inflight_bytes: a
+  /// prefetch is not started if it would (given the average size of the
+  /// partitions generated so far) exceed this bound, and only one is started
+  /// at a time until the size of a partition is known.
+  class EXPORT_SYMBOL PartitionPrefetcher {
+  public:
+    /// @brief Creates a PartitionPrefetcher; no work starts until the first
+    /// call to #partition.
+    ///
+    /// @param array The partitions to read through.
+    /// @param depth Number of partitions to read ahead; must be at least
+    /// `1`.
+    /// @param max_inflight_bytes Bound on the bytes of prefetched partitions
+    /// that have not been requested yet, or a negative number for no bound.
+    PartitionPrefetcher(const PartitionedArrayPtr& array,
+                        int64_t depth,
+                        int64_t max_inflight_bytes);
+
+    /// @brief Waits for all background work to finish.
+    ~PartitionPrefetcher();
+
+    /// @brief The partitions to read through.
+    const PartitionedArrayPtr
+      array() const;
+
+    /// @brief Number of partitions to read ahead.
+    int64_t
+      depth() const;
+
+    /// @brief Bound on the bytes of prefetched partitions that have not been
+    /// requested yet (negative if unbounded).
+    int64_t
+      max_inflight_bytes() const;
+
+    /// @brief Bytes of partitions that have been prefetched but not yet
+    /// requested.
+    int64_t
+      inflight_bytes() const;
+
+    /// @brief Returns partition `partitionid`, materialized, and starts
+    /// prefetching the `depth` partitions after it.
+    ///
+    /// If this partition was being prefetched, this waits for it (and
+    /// rethrows its exception, if it failed); otherwise, it is materialized
+    /// on the calling thread.
+    const ContentPtr
+      partition(int64_t partitionid);
+
+    /// @brief Waits for all prefetches that have been started to finish,
+    /// ignoring their errors.
+    void
+      wait();
+
+  private:
+    /// @brief Internal function to start prefetches after `partitionid`,
+    /// with #mutex_ held.
+    void
+      schedule(int64_t partitionid);
+
+    /// @brief See #array.
+    const PartitionedArrayPtr array_;
+    /// @brief See #depth.
+    const int64_t depth_;
+    /// @brief See #max_inflight_bytes.
+    const int64_t max_inflight_bytes_;
+    /// @brief Guards all of the members below.
+    mutable std::mutex mutex_;
+    /// @brief See #inflight_bytes.
+    int64_t inflight_bytes_;
+    /// @brief Bytes of each finished prefetch that has not been requested.
+    std::map<int64_t, int64_t> finished_;
+    /// @brief Total bytes and number of all materialized partitions, for
+    /// the size estimate.
+    int64_t total_bytes_;
+    int64_t total_count_;
+    /// @brief Prefetches that have been started and not yet requested.
+    std::map<int64_t, std::shared_future<int64_t>> started_;
+    /// @brief Every prefetch that may still be running (including those
+    /// that were skipped), so that #wait can wait for them.
+    std::vector<std::shared_future<int64_t>> tasks_;
+  };
+}
+
+#endif // AWKWARD_PARTITIONPREFETCHER_H_
@@ -3,6 +3,8 @@
 #ifndef AWKWARD_PARTITIONEDARRAY_H_
 #define AWKWARD_PARTITIONEDARRAY_H_
 
+#include <functional>
+
 #include "awkward/Content.h"
 
 namespace awkward {
@@ -50,10 +52,41 @@ namespace awkward {
                            int64_t& partitionid,
                            int64_t& index) const = 0;
 
+    /// @brief Gets the partitionid and index for each of many logical
+    /// positions, like #partitionid_index_at (including its treatment of
+    /// out-of-bounds positions).
+    ///
+    /// If `at` is sorted, this is a single merge-like pass over `at` and the
+    /// partitions; otherwise, each position that is less than its
+    /// predecessor is looked up with #partitionid_index_at.
+    ///
+    /// @param at The logical positions.
+    /// @param partitionids Filled with the partitionid of each position.
+    /// @param indexes Filled with the index of each position within its
+    /// partition.
+    void
+      partitionids_indexes_at(const std::vector<int64_t>& at,
+                              std::vector<int64_t>& partitionids,
+                              std::vector<int64_t>& indexes) const;
+
     /// @brief Returns this array with a specified (irregular) partitioning.
     virtual PartitionedArrayPtr
       repartition(const std::vector<int64_t>& stops) const = 0;
 
+    /// @brief Returns this array with partitions of about `target_bytes`
+    /// each (using #repartition), for roughly equal units of work.
+    ///
+    /// Sizes come from {@link Content#nbytes Content::nbytes}, or are
+    /// estimated from the Form for VirtualArrays that have not been
+    /// materialized (so this does not materialize them). Small partitions
+    /// are coalesced and large ones are split, assuming that bytes are
+    /// evenly spread over each partition's entries. A stop within a quarter
+    /// of `target_bytes` of a partition boundary is moved to the boundary,
+    /// so partitions that are about the right size are kept as they are,
+    /// without copying.
+    const PartitionedArrayPtr
+      repartition_by_bytes(int64_t target_bytes) const;
+
     /// @brief User-friendly name of this class.
     virtual const std::string
       classname() const = 0;
@@ -153,6 +186,72 @@ namespace awkward {
     const PartitionedArrayPtr
       getitem_range_nowrap(int64_t start, int64_t stop, int64_t step) const;
 
+    /// @brief Concatenates all partitions into a single Content.
+    const ContentPtr
+      tocontent() const;
+
+    /// @brief Returns `true` if `axis` is the dimension that the partitions
+    /// divide (the outermost), as opposed to a dimension within each
+    /// partition.
+    ///
+    /// Negative `axis` counts backward from the deepest levels, as in
+    /// {@link Content#reduce Content::reduce}.
+    bool
+      is_partition_axis(int64_t axis) const;
+
+    /// @brief Applies `fn` to each partition, with up to `nthreads`
+    /// partitions at a time on separate threads, and returns the results
+    /// as a new PartitionedArray.
+    ///
+    /// @param fn The function to apply; it may be called concurrently.
+    /// @param nthreads Maximum number of threads (including the calling
+    /// thread), or a non-positive number for one per hardware thread.
+    ///
+    /// If any call fails, the exception from the lowest partitionid is
+    /// rethrown after all calls have finished.
+    const PartitionedArrayPtr
+      map(const std::function<const ContentPtr(const ContentPtr&)>& fn,
+          int64_t nthreads) const;
+
+    /// @brief The same as {@link Content#reduce Content::reduce} of the
+    /// concatenated partitions, computed partition by partition with up to
+    /// `nthreads` threads.
+    ///
+    /// If `axis` is the partition axis (see #is_partition_axis), each
+    /// partition is reduced to a partial result and the partial results are
+    /// reduced again (e.g. the sums of partial sums or the minimums of
+    /// partial minimums; counts are summed). ReducerArgmin and ReducerArgmax
+    /// do not combine this way, so they reduce the concatenated partitions.
+    ///
+    /// Otherwise, each partition is reduced independently and the results
+    /// are concatenated; use #map to keep them partitioned.
+    const ContentPtr
+      reduce(const Reducer& reducer,
+             int64_t axis,
+             bool mask,
+             bool keepdims,
+             int64_t nthreads) const;
+
+    /// @brief This array with one axis sorted, computed partition by
+    /// partition with up to `nthreads` threads.
+    ///
+    /// Sorting the partition axis (see #is_partition_axis) mixes the
+    /// partitions, so in that case the concatenated partitions are sorted
+    /// and returned as a single partition.
+    const PartitionedArrayPtr
+      sort(int64_t axis, bool ascending, bool stable, int64_t nthreads) const;
+
+    /// @brief Applies a Slice to this array, with up to `nthreads`
+    /// partitions sliced at a time.
+    ///
+    /// A SliceRange at the head of `where` selects partitions (as in
+    /// #getitem_range) and the rest of `where` applies within each of them;
+    /// field, fields, and ellipsis heads apply within each partition. Other
+    /// heads (integers, arrays, and new axes) do not preserve partitions
+    /// and raise an error: use #getitem_at or #tocontent for those.
+    const PartitionedArrayPtr
+      getitem(const Slice& where, int64_t nthreads) const;
+
   protected:
     const ContentPtrVec partitions_;
   };
@@ -23,6 +23,7 @@
 #include "awkward/array/RegularArray.h"
 #include "awkward/array/UnionArray.h"
 #include "awkward/array/VirtualArray.h"
+#include "awkward/Broadcast.h"
 
 namespace py = pybind11;
 namespace ak = awkward;
@@ -180,4 +181,16 @@ py::class_<ak::UnionArrayOf<T, I>,
 py::class_<ak::VirtualArray, std::shared_ptr<ak::VirtualArray>, ak::Content>
   make_VirtualArray(const py::handle& m, const std::string& name);
 
+/// @brief Makes a `broadcast_and_apply` function in Python that applies an
+/// ElementwiseUfunc by name, returning `None` if the inputs need the Python
+/// implementation.
+void
+  make_broadcast_and_apply(py::module& m, const std::string& name);
+
+/// @brief Makes an ElementwiseExpression class in Python that mirrors the
+/// one in C++.
+py::class_<ak::ElementwiseExpression,
+           std::shared_ptr<ak::ElementwiseExpression>>
+  make_ElementwiseExpression(const py::handle& m, const std::string& name);
+
 #endif // AWKWARDPY_CONTENT_H_
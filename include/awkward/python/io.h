@@ -13,4 +13,10 @@ make_fromjson(py::module& m, const std::string& name);
 void
 make_fromroot_nestedvector(py::module& m, const std::string& name);
 
+void
+make_toarrayset_file(py::module& m, const std::string& name);
+
+void
+make_fromarrayset_file(py::module& m, const std::string& name);
+
 #endif // AWKWARDPY_IO_H_
@@ -3,10 +3,13 @@
 #ifndef AWKWARDPY_VIRTUAL_H_
 #define AWKWARDPY_VIRTUAL_H_
 
+#include <future>
+
 #include <pybind11/pybind11.h>
 
 #include "awkward/virtual/ArrayGenerator.h"
 #include "awkward/virtual/ArrayCache.h"
+#include "awkward/io/arrayset.h"
 
 namespace py = pybind11;
 namespace ak = awkward;
@@ -70,6 +73,11 @@ make_PyArrayGenerator(const py::handle& m, const std::string& name);
 py::class_<ak::SliceGenerator, std::shared_ptr<ak::SliceGenerator>>
 make_SliceGenerator(const py::handle& m, const std::string& name);
 
+////////// ArraysetGenerator
+
+py::class_<ak::ArraysetGenerator, std::shared_ptr<ak::ArraysetGenerator>>
+make_ArraysetGenerator(const py::handle& m, const std::string& name);
+
 ////////// PyArrayCache
 
 class PyArrayCache: public ak::ArrayCache {
@@ -97,4 +105,32 @@ private:
 py::class_<PyArrayCache, std::shared_ptr<PyArrayCache>>
 make_PyArrayCache(const py::handle& m, const std::string& name);
 
+////////// LRUArrayCache
+
+py::class_<ak::LRUArrayCache, std::shared_ptr<ak::LRUArrayCache>>
+make_LRUArrayCache(const py::handle& m, const std::string& name);
+
+////////// TieredArrayCache
+
+py::class_<ak::TieredArrayCache,
+           std::shared_ptr<ak::TieredArrayCache>,
+           ak::LRUArrayCache>
+make_TieredArrayCache(const py::handle& m, const std::string& name);
+
+/// @brief Converts a Python object into an ArrayCache, which may be either
+/// an ak.layout.ArrayCache or an ak.layout.LRUArrayCache (or None).
+///
+/// `where` is used in the error message.
+ak::ArrayCachePtr
+unbox_arraycache(const py::object& cache, const std::string& where);
+
+/// @brief Converts an ArrayCache into a Python object (or None).
+py::object
+box_arraycache(const ak::ArrayCachePtr& cache);
+
+/// @brief The VirtualArray::Waiter for Python: releases the GIL (if this
+/// thread holds it) so that the generating thread can use Python.
+void
+wait_without_gil(const std::shared_future<ak::ContentPtr>& generation);
+
 #endif // AWKWARDPY_VIRTUAL_H_
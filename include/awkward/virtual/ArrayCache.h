@@ -3,9 +3,29 @@
 #ifndef AWKWARD_ARRAYCACHE_H_
 #define AWKWARD_ARRAYCACHE_H_
 
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
 #include "awkward/Content.h"
 
 namespace awkward {
+  /// @brief Counters of an ArrayCache's activity (see
+  /// {@link ArrayCache#stats ArrayCache::stats}).
+  struct EXPORT_SYMBOL ArrayCacheStats {
+    /// @brief Number of calls to `get` that found an array.
+    int64_t hits;
+    /// @brief Number of calls to `get` that did not find an array.
+    int64_t misses;
+    /// @brief Number of calls to `set`.
+    int64_t sets;
+    /// @brief Number of arrays removed to make room for others.
+    int64_t evictions;
+    /// @brief Bytes currently held, or a negative number if unknown.
+    int64_t resident_bytes;
+  };
+
   /// @class ArrayCache
   ///
   /// @brief Abstract superclass of cache for VirtualArray, definining
@@ -16,6 +36,14 @@ namespace awkward {
   /// C++ caches could be written.
   class EXPORT_SYMBOL ArrayCache {
   public:
+    /// @brief Called by subclasses to start the #stats at zero.
+    ArrayCache();
+
+    /// @brief Virtual destructor acts as a first non-inline virtual function
+    /// that determines a specific translation unit in which vtable shall be
+    /// emitted.
+    virtual ~ArrayCache();
+
     /// @brief Returns a new key that is globally unique in the current
     /// process.
     ///
@@ -37,6 +65,31 @@ namespace awkward {
       tostring_part(const std::string& indent,
                     const std::string& pre,
                     const std::string& post) const = 0;
+
+    /// @brief Bytes currently held, or a negative number if the cache
+    /// cannot tell (the default).
+    virtual int64_t
+      resident_bytes() const;
+
+    /// @brief Counters of #get and #set calls and evictions since this
+    /// cache was created or #reset_stats was last called, and the
+    /// #resident_bytes.
+    ///
+    /// The counters are atomic, but not updated together: a snapshot taken
+    /// while other threads use the cache may be slightly inconsistent.
+    const ArrayCacheStats
+      stats() const;
+
+    /// @brief Sets all counters in #stats to zero.
+    virtual void
+      reset_stats();
+
+  protected:
+    /// @brief See #stats; subclasses must update these in #get and #set.
+    mutable std::atomic<int64_t> stats_hits_;
+    mutable std::atomic<int64_t> stats_misses_;
+    std::atomic<int64_t> stats_sets_;
+    std::atomic<int64_t> stats_evictions_;
   };
 
   using ArrayCachePtr = std::shared_ptr<ArrayCache>;
@@ -45,6 +98,269 @@ namespace awkward {
   // large), define it in this file and implement it in
   // src/libawkward/virtual/ArrayCache.cpp.
 
+  /// @class LRUArrayCache
+  ///
+  /// @brief Pure C++ cache that holds arrays up to a total of #limit_bytes
+  /// (as measured by {@link Content#nbytes Content::nbytes}), evicting the
+  /// least recently used ones first.
+  ///
+  /// All methods are thread-safe. An array larger than the whole limit is
+  /// not stored at all.
+  class EXPORT_SYMBOL LRUArrayCache: public ArrayCache {
+  public:
+    /// @brief Creates an empty LRUArrayCache.
+    ///
+    /// @param limit_bytes Maximum total number of bytes to hold.
+    LRUArrayCache(int64_t limit_bytes);
+
+    /// @brief Maximum total number of bytes to hold.
+    int64_t
+      limit_bytes() const;
+
+    /// @brief Total number of bytes currently held.
+    int64_t
+      current_bytes() const;
+
+    /// @brief Number of arrays currently held.
+    int64_t
+      size() const;
+
+    /// @brief Keys of the arrays currently held, from most to least recently
+    /// used.
+    const std::vector<std::string>
+      keys() const;
+
+    /// @brief Returns `true` if an array is held at `key` (without changing
+    /// its position in the eviction order); `false` otherwise.
+    virtual bool
+      has(const std::string& key) const;
+
+    /// @brief Gets an array and marks it as most recently used; `nullptr` if
+    /// not available.
+    ContentPtr
+      get(const std::string& key) const override;
+
+    /// @brief Writes or overwrites an array at `key`, marks it as most
+    /// recently used, and evicts others until the total fits #limit_bytes.
+    void
+      set(const std::string& key, const ContentPtr& value) override;
+
+    /// @brief Removes the array at `key`, if any; returns `true` if there
+    /// was one.
+    virtual bool
+      remove(const std::string& key);
+
+    /// @brief Removes all arrays.
+    virtual void
+      clear();
+
+    const std::string
+      tostring_part(const std::string& indent,
+                    const std::string& pre,
+                    const std::string& post) const override;
+
+    /// @brief Same as #current_bytes.
+    int64_t
+      resident_bytes() const override;
+
+  protected:
+    /// @brief #get without counting it in the #stats.
+    ContentPtr
+      lookup(const std::string& key) const;
+
+    /// @brief #set without counting it in the #stats.
+    void
+      insert(const std::string& key, const ContentPtr& value);
+
+    /// @brief Called (without any lock held) for each array that is dropped
+    /// to make room for others, or that is too large to hold at all; does
+    /// nothing by default.
+    virtual void
+      evicted(const std::string& key, const ContentPtr& value);
+
+  private:
+    /// @brief One cached array and its size.
+    struct Entry {
+      std::string key;
+      ContentPtr value;
+      int64_t nbytes;
+    };
+    using EntryList = std::list<Entry>;
+
+    /// @brief Removes an entry; the mutex must already be held.
+    void
+      remove_entry(EntryList::iterator entry);
+
+    /// @brief See #limit_bytes.
+    const int64_t limit_bytes_;
+    /// @brief See #current_bytes.
+    int64_t current_bytes_;
+    /// @brief Entries from most to least recently used; mutable because
+    /// #get reorders it.
+    mutable EntryList order_;
+    /// @brief Position of each key in #order_.
+    std::unordered_map<std::string, EntryList::iterator> lookup_;
+    /// @brief Guards all of the above.
+    mutable std::mutex mutex_;
+  };
+
+  using LRUArrayCachePtr = std::shared_ptr<LRUArrayCache>;
+
+  class ArraysetFile;
+
+  /// @class TieredArrayCache
+  ///
+  /// @brief LRUArrayCache with a second tier on local disk: arrays evicted
+  /// from memory (or too large for it) are written to files in #directory
+  /// instead of being dropped, and getting them again memory-maps the files
+  /// back, without copying or regenerating them.
+  ///
+  /// The files have the raw-buffer format of ArraysetFile, so arrays with
+  /// Identities (which that format does not support) are dropped when they
+  /// are evicted. An array that is read back from disk is put in memory
+  /// again, but its file is kept, so evicting it a second time costs
+  /// nothing. Files are deleted when their arrays are removed, replaced, or
+  /// evicted from the disk tier (if #disk_limit_bytes is reached), and when
+  /// the cache is deleted.
+  ///
+  /// #keys, #size, and #current_bytes (and
+  /// {@link ArrayCacheStats#resident_bytes resident_bytes}) refer to the
+  /// memory tier only.
+  class EXPORT_SYMBOL TieredArrayCache: public LRUArrayCache {
+  public:
+    /// @brief Creates an empty TieredArrayCache.
+    ///
+    /// @param limit_bytes Maximum total number of bytes to hold in memory.
+    /// @param directory Existing, writable directory for the files.
+    /// @param disk_limit_bytes Maximum total number of bytes to hold on
+    /// disk, or a negative number for no limit.
+    TieredArrayCache(int64_t limit_bytes,
+                     const std::string& directory,
+                     int64_t disk_limit_bytes);
+
+    /// @brief Deletes all of the files.
+    ~TieredArrayCache();
+
+    /// @brief Directory in which the files are written.
+    const std::string
+      directory() const;
+
+    /// @brief Maximum total number of bytes to hold on disk (negative if
+    /// unlimited).
+    int64_t
+      disk_limit_bytes() const;
+
+    /// @brief Total number of bytes currently held on disk.
+    int64_t
+      disk_bytes() const;
+
+    /// @brief Keys of the arrays currently held on disk, from most to least
+    /// recently used.
+    const std::vector<std::string>
+      disk_keys() const;
+
+    /// @brief Number of arrays that have been written to disk since this
+    /// cache was created or #reset_stats was last called.
+    int64_t
+      spills() const;
+
+    /// @brief Number of #get calls that were satisfied from disk since this
+    /// cache was created or #reset_stats was last called (these are also
+    /// counted as hits).
+    int64_t
+      disk_hits() const;
+
+    /// @brief Number of arrays that could not be written to disk (and were
+    /// dropped) since this cache was created or #reset_stats was last
+    /// called.
+    int64_t
+      spill_failures() const;
+
+    /// @brief Returns `true` if an array is held at `key` in memory or on
+    /// disk; `false` otherwise.
+    bool
+      has(const std::string& key) const override;
+
+    /// @brief Gets an array from memory or, failing that, from disk (and
+    /// puts it in memory); `nullptr` if not available.
+    ContentPtr
+      get(const std::string& key) const override;
+
+    /// @brief Writes or overwrites an array at `key` in memory, deleting
+    /// any older array at `key` on disk.
+    void
+      set(const std::string& key, const ContentPtr& value) override;
+
+    bool
+      remove(const std::string& key) override;
+
+    void
+      clear() override;
+
+    void
+      reset_stats() override;
+
+    const std::string
+      tostring_part(const std::string& indent,
+                    const std::string& pre,
+                    const std::string& post) const override;
+
+  protected:
+    /// @brief Writes the array to disk, unless it is already there.
+    ///
+    /// The file is written without holding the lock; #set, #remove and
+    /// #clear cancel a write in progress for their key, so that an older
+    /// array never lands on disk after a newer one was set.
+    void
+      evicted(const std::string& key, const ContentPtr& value) override;
+
+  private:
+    /// @brief One array on disk; its file is opened when it is first read.
+    struct DiskEntry {
+      std::string key;
+      std::string path;
+      int64_t nbytes;
+      std::shared_ptr<ArraysetFile> file;
+      /// @brief The array read back from #file, if it is still in memory:
+      /// evicting that array again does not need a new file.
+      std::weak_ptr<Content> value;
+    };
+    using DiskEntryList = std::list<DiskEntry>;
+
+    /// @brief Removes an entry and deletes its file; #disk_mutex_ must
+    /// already be held.
+    void
+      remove_disk_entry(DiskEntryList::iterator entry);
+
+    /// @brief See #directory.
+    const std::string directory_;
+    /// @brief See #disk_limit_bytes.
+    const int64_t disk_limit_bytes_;
+    /// @brief See #disk_bytes.
+    int64_t disk_bytes_;
+    /// @brief Entries from most to least recently used; mutable because
+    /// #get reorders it and opens files.
+    mutable DiskEntryList disk_order_;
+    /// @brief Position of each key in #disk_order_.
+    std::unordered_map<std::string, DiskEntryList::iterator> disk_lookup_;
+    /// @brief Keys being written by #evicted, each with the number of its
+    /// write; a key that is gone or renumbered when the write finishes was
+    /// set again in the meantime.
+    std::unordered_map<std::string, int64_t> pending_;
+    /// @brief Number of the last write registered in #pending_.
+    int64_t numpending_;
+    /// @brief Guards all of the above.
+    mutable std::mutex disk_mutex_;
+    /// @brief See #spills.
+    std::atomic<int64_t> spills_;
+    /// @brief See #disk_hits.
+    mutable std::atomic<int64_t> disk_hits_;
+    /// @brief See #spill_failures.
+    std::atomic<int64_t> spill_failures_;
+  };
+
+  using TieredArrayCachePtr = std::shared_ptr<TieredArrayCache>;
+
 }
 
 #endif // AWKWARD_ARRAYCACHE_H_
@@ -3,12 +3,27 @@
 #ifndef AWKWARD_ARRAYGENERATOR_H_
 #define AWKWARD_ARRAYGENERATOR_H_
 
+#include <atomic>
+
 #include "awkward/Slice.h"
 #include "awkward/Content.h"
 
 namespace awkward {
   ////////// ArrayGenerator
 
+  /// @brief Counters of an ArrayGenerator's activity (see
+  /// {@link ArrayGenerator#stats ArrayGenerator::stats}).
+  struct EXPORT_SYMBOL ArrayGeneratorStats {
+    /// @brief Number of calls to
+    /// {@link ArrayGenerator#generate_and_check generate_and_check}.
+    int64_t calls;
+    /// @brief Total wall time spent in those calls, in nanoseconds.
+    int64_t wall_time_ns;
+    /// @brief Total bytes of the arrays they produced (as measured by
+    /// {@link Content#nbytes Content::nbytes}).
+    int64_t bytes;
+  };
+
   /// @class ArrayGenerator
   ///
   /// @brief Abstract superclass to generat arrays for VirtualArray, definining
@@ -50,9 +65,23 @@ namespace awkward {
       generate() const = 0;
 
     /// @brief Creates an array and checks it against the #form.
+    ///
+    /// Successful calls are counted in #stats.
     const ContentPtr
       generate_and_check() const;
 
+    /// @brief Counters of #generate_and_check calls since this
+    /// ArrayGenerator was created or #reset_stats was last called.
+    ///
+    /// Copies made by #shallow_copy, #with_form, and #with_length start with
+    /// their own counters at zero.
+    const ArrayGeneratorStats
+      stats() const;
+
+    /// @brief Sets all counters in #stats to zero.
+    void
+      reset_stats();
+
     /// @brief Returns a string representation of this ArrayGenerator.
     virtual const std::string
       tostring_part(const std::string& indent,
@@ -73,9 +102,34 @@ namespace awkward {
     virtual const std::shared_ptr<ArrayGenerator>
       with_length(int64_t length) const = 0;
 
+    /// @brief Returns a generator for field `key` of the array that this
+    /// one generates, if it can make that field without making the whole
+    /// array; `nullptr` otherwise (the default).
+    ///
+    /// Used by {@link VirtualArray#getitem_field VirtualArray::getitem_field}.
+    virtual const std::shared_ptr<ArrayGenerator>
+      project_field(const std::string& key) const;
+
+    /// @brief Returns a generator for entries `start` to `stop` of the
+    /// array that this one generates (with
+    /// `0 <= start <= stop <= length()`), if it can make them without making
+    /// the whole array; `nullptr` otherwise (the default).
+    ///
+    /// Used by {@link VirtualArray#getitem_range_nowrap
+    /// VirtualArray::getitem_range_nowrap}, so that slicing a lazy array
+    /// reads only the entries it needs.
+    virtual const std::shared_ptr<ArrayGenerator>
+      project_range(int64_t start, int64_t stop) const;
+
   protected:
     const FormPtr form_;
     int64_t length_;
+
+  private:
+    /// @brief See #stats.
+    mutable std::atomic<int64_t> stats_calls_;
+    mutable std::atomic<int64_t> stats_wall_time_ns_;
+    mutable std::atomic<int64_t> stats_bytes_;
   };
 
   using ArrayGeneratorPtr = std::shared_ptr<ArrayGenerator>;
@@ -117,6 +171,12 @@ namespace awkward {
     const std::shared_ptr<ArrayGenerator>
       with_length(int64_t length) const override;
 
+    /// @brief If this is a range slice (with unit step), returns a single
+    /// SliceGenerator of the combined range on the same #content, so that
+    /// slices of slices do not nest.
+    const std::shared_ptr<ArrayGenerator>
+      project_range(int64_t start, int64_t stop) const override;
+
   protected:
     const ContentPtr content_;
     const Slice slice_;
@@ -38,6 +38,7 @@ import awkward1._connect._numexpr
 numexpr = type(awkward1._connect._numexpr)("numexpr")
 numexpr.evaluate = awkward1._connect._numexpr.evaluate
 numexpr.re_evaluate = awkward1._connect._numexpr.re_evaluate
+numexpr.fused = awkward1._connect._numexpr.fused
 
 import awkward1._connect._autograd
 
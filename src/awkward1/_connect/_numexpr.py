@@ -2,6 +2,7 @@
 
 from __future__ import absolute_import
 
+import ast
 import warnings
 import sys
 import distutils.version
@@ -82,6 +83,7 @@ def evaluate(
         )
     names, ex_uses_vml = numexpr.necompiler._names_cache[expr_key]
     arguments = getArguments(names, local_dict, global_dict)
+    behavior = awkward1._util.behaviorof(*arguments)
 
     arrays = [
         awkward1.operations.convert.to_layout(x, allow_record=True, allow_other=True)
@@ -109,7 +111,6 @@ def evaluate(
         else:
             return None
 
-    behavior = awkward1._util.behaviorof(*arrays)
     out = awkward1._util.broadcast_and_apply(arrays, getfunction, behavior)
     assert isinstance(out, tuple) and len(out) == 1
     return awkward1._util.wrap(out[0], behavior)
@@ -147,10 +148,147 @@ def re_evaluate(local_dict=None):
         else:
             return None
 
-    behavior = awkward1._util.behaviorof(*arrays)
     out = awkward1._util.broadcast_and_apply(arrays, getfunction, behavior)
     assert isinstance(out, tuple) and len(out) == 1
     return awkward1._util.wrap(out[0], behavior)
 
 
 evaluate.re_evaluate = re_evaluate
+
+
+fused_binary = {
+    ast.Add: "add",
+    ast.Sub: "subtract",
+    ast.Mult: "multiply",
+    ast.Div: "divide",
+    ast.Pow: "power",
+    ast.BitAnd: "logical_and",
+    ast.BitOr: "logical_or",
+    ast.BitXor: "logical_xor",
+}
+
+fused_compare = {
+    ast.Eq: "equal",
+    ast.NotEq: "not_equal",
+    ast.Lt: "less",
+    ast.LtE: "less_equal",
+    ast.Gt: "greater",
+    ast.GtE: "greater_equal",
+}
+
+fused_unary = {
+    ast.USub: "negative",
+    ast.Invert: "logical_not",
+    ast.Not: "logical_not",
+}
+
+fused_functions = {
+    "sqrt": ("sqrt", 1),
+    "exp": ("exp", 1),
+    "log": ("log", 1),
+    "sin": ("sin", 1),
+    "cos": ("cos", 1),
+    "abs": ("absolute", 1),
+    "absolute": ("absolute", 1),
+    "minimum": ("minimum", 2),
+    "maximum": ("maximum", 2),
+    "where": ("where", 3),
+}
+
+
+def fused_program(expression):
+    names = []
+    program = []
+
+    def recurse(node):
+        if isinstance(node, ast.BinOp) and type(node.op) in fused_binary:
+            recurse(node.left)
+            recurse(node.right)
+            program.append(fused_binary[type(node.op)])
+
+        elif isinstance(node, ast.Compare) and (
+            len(node.ops) == 1 and type(node.ops[0]) in fused_compare
+        ):
+            recurse(node.left)
+            recurse(node.comparators[0])
+            program.append(fused_compare[type(node.ops[0])])
+
+        elif isinstance(node, ast.BoolOp):
+            op = "logical_and" if isinstance(node.op, ast.And) else "logical_or"
+            recurse(node.values[0])
+            for value in node.values[1:]:
+                recurse(value)
+                program.append(op)
+
+        elif isinstance(node, ast.UnaryOp) and isinstance(node.op, ast.UAdd):
+            recurse(node.operand)
+
+        elif isinstance(node, ast.UnaryOp) and type(node.op) in fused_unary:
+            recurse(node.operand)
+            program.append(fused_unary[type(node.op)])
+
+        elif (
+            isinstance(node, ast.Call)
+            and isinstance(node.func, ast.Name)
+            and node.func.id in fused_functions
+            and len(node.args) == fused_functions[node.func.id][1]
+            and len(node.keywords) == 0
+        ):
+            for arg in node.args:
+                recurse(arg)
+            program.append(fused_functions[node.func.id][0])
+
+        elif isinstance(node, ast.Name) and node.id in ("True", "False"):
+            program.append("1" if node.id == "True" else "0")
+
+        elif isinstance(node, ast.Name):
+            if node.id not in names:
+                names.append(node.id)
+            program.append("#{0}".format(names.index(node.id)))
+
+        elif isinstance(node, getattr(ast, "Constant", ())) and isinstance(
+            node.value, bool
+        ):
+            program.append("1" if node.value else "0")
+
+        elif isinstance(node, getattr(ast, "Constant", ())) and isinstance(
+            node.value, int
+        ):
+            program.append(repr(int(node.value)))
+
+        elif isinstance(node, getattr(ast, "Constant", ())) and isinstance(
+            node.value, float
+        ):
+            program.append(repr(float(node.value)))
+
+        elif isinstance(node, getattr(ast, "NameConstant", ())) and isinstance(
+            node.value, bool
+        ):
+            program.append("1" if node.value else "0")
+
+        elif isinstance(node, getattr(ast, "Num", ())) and isinstance(
+            node.n, (int, float)
+        ):
+            program.append(repr(node.n if isinstance(node.n, int) else float(node.n)))
+
+        else:
+            raise ValueError(
+                "cannot evaluate {0} in a fused expression".format(ast.dump(node))
+            )
+
+    recurse(ast.parse(expression, mode="eval").body)
+    return names, program
+
+
+def fused(expression, local_dict=None, global_dict=None):
+    names, program = fused_program(expression)
+    arguments = getArguments(names, local_dict, global_dict)
+    behavior = awkward1._util.behaviorof(*arguments)
+
+    arrays = [
+        awkward1.operations.convert.to_layout(x, allow_record=False, allow_other=True)
+        for x in arguments
+    ]
+
+    out = awkward1.layout.ElementwiseExpression(program).apply(arrays)
+    return awkward1._util.wrap(out, behavior)
@@ -50,6 +50,15 @@ def array_ufunc(ufunc, method, inputs, kwargs):
         for x in inputs
     ]
 
+    if len(kwargs) == 0 and all(
+        isinstance(x, awkward1.layout.Content)
+        or (isinstance(x, (bool, int, float)) and not isinstance(x, numpy.generic))
+        for x in inputs
+    ):
+        out = awkward1.layout._broadcast_and_apply(ufunc.__name__, inputs)
+        if out is not None:
+            return awkward1._util.wrap(out, behavior)
+
     def adjust(custom, inputs, kwargs):
         args = [
             awkward1._util.wrap(x, behavior)
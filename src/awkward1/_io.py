@@ -4,3 +4,5 @@ from __future__ import absolute_import
 
 from awkward1._ext import fromjson
 from awkward1._ext import fromroot_nestedvector
+from awkward1._ext import toarrayset_file
+from awkward1._ext import fromarrayset_file
@@ -191,6 +191,10 @@ class Array(
     See #ak.numexpr.re_evaluate to recalculate an expression without
     rebuilding its virtual machine.
 
+    See #ak.numexpr.fused to calculate a simple arithmetic expression in one
+    pass over the leaves, without NumExpr and without an intermediate array
+    for each operation.
+
     Autograd
     ********
 
@@ -51,7 +51,12 @@ from awkward1._ext import UnionArray8_64
 from awkward1._ext import VirtualArray
 from awkward1._ext import ArrayGenerator
 from awkward1._ext import SliceGenerator
+from awkward1._ext import ArraysetGenerator
 from awkward1._ext import ArrayCache
+from awkward1._ext import LRUArrayCache
+from awkward1._ext import TieredArrayCache
 
 from awkward1._ext import _slice_tostring
+from awkward1._ext import _broadcast_and_apply
+from awkward1._ext import ElementwiseExpression
 from awkward1._ext import kernelLib
@@ -560,6 +560,46 @@ def without_parameters(array, highlevel=True):
         return out
 
 
+def packed(array, highlevel=True):
+    """
+    Args:
+        array: Data convertible into an Awkward Array.
+        highlevel (bool): If True, return an #ak.Array; otherwise, return
+            a low-level #ak.layout.Content subclass.
+
+    Returns an array with the same values as `array` whose buffers contain
+    only the elements that are reachable from it.
+
+    Slicing and filtering are views: an array selected from a larger one
+    keeps the larger one's buffers alive, even if it only uses 1% of them.
+    This function copies what is used into new buffers (in one pass), so
+    that the original can be released. For example,
+
+        >>> big = ak.Array([[1.1, 2.2, 3.3], [], [4.4, 5.5]] * 1000000)
+        >>> small = big[::1000]
+        >>> ak.packed(small).layout.nbytes < small.layout.nbytes
+        True
+
+    Lists become #ak.layout.ListOffsetArray64 with offsets that start at
+    zero, #ak.layout.IndexedOptionArray64 is projected onto its non-missing
+    values, and #ak.layout.BitMaskedArray, #ak.layout.ByteMaskedArray, and
+    #ak.layout.RegularArray are trimmed to their length.
+    """
+    layout = awkward1.operations.convert.to_layout(
+        array, allow_record=True, allow_other=False
+    )
+
+    if isinstance(layout, awkward1.partition.PartitionedArray):
+        out = awkward1.partition.apply(lambda x: x.packed(), layout)
+    else:
+        out = layout.packed()
+
+    if highlevel:
+        return awkward1._util.wrap(out, behavior=awkward1._util.behaviorof(array))
+    else:
+        return out
+
+
 @awkward1._connect._numpy.implements(numpy.broadcast_arrays)
 def broadcast_arrays(*arrays, **kwargs):
     """
@@ -723,14 +763,7 @@ def concatenate(arrays, axis=0, mergebool=True, highlevel=True):
 
     if len(contents) == 0:
         raise ValueError("need at least one array to concatenate")
-    out = contents[0]
-    for x in contents[1:]:
-        if not out.mergeable(x, mergebool=mergebool):
-            out = out.merge_as_union(x)
-        else:
-            out = out.merge(x)
-        if isinstance(out, awkward1._util.uniontypes):
-            out = out.simplify(mergebool=mergebool)
+    out = contents[0].merge_many(contents[1:], mergebool=mergebool)
 
     if highlevel:
         return awkward1._util.wrap(out, behavior=awkward1._util.behaviorof(*arrays))
@@ -2338,7 +2371,12 @@ def virtual(
             mapping with `__setitem__`, retrieved with `__getitem__`, and only
             re-generated if `__getitem__` raises a `KeyError`. This mapping may
             evict elements according to any caching algorithm (LRU, LFR, RR,
-            TTL, etc.).
+            TTL, etc.). An #ak.layout.LRUArrayCache is a thread-safe cache
+            implemented in C++ that evicts least recently used arrays to stay
+            within a byte limit; it avoids Python calls when arrays are
+            materialized. An #ak.layout.TieredArrayCache is an LRUArrayCache
+            that writes evicted arrays to files in a local directory and
+            memory-maps them back, rather than regenerating them.
         cache_key (None or str): If None, a unique string is generated for this
             virtual array for use with the `cache` (unique per Python process);
             otherwise, the explicitly provided key is used (which ought to
@@ -2389,7 +2427,9 @@ def virtual(
     gen = awkward1.layout.ArrayGenerator(
         generate, args, kwargs, form=form, length=length
     )
-    if cache is not None:
+    if cache is not None and not isinstance(
+        cache, (awkward1.layout.ArrayCache, awkward1.layout.LRUArrayCache)
+    ):
         cache = awkward1.layout.ArrayCache(cache)
 
     out = awkward1.layout.VirtualArray(
@@ -2470,7 +2510,9 @@ def with_cache(array, cache, chain=None, highlevel=True):
     elif chain is not None and chain not in ("first", "last"):
         raise ValueError("chain must be None, 'first', 'last', or bool")
 
-    if not isinstance(cache, awkward1.layout.ArrayCache):
+    if cache is not None and not isinstance(
+        cache, (awkward1.layout.ArrayCache, awkward1.layout.LRUArrayCache)
+    ):
         cache = awkward1.layout.ArrayCache(cache)
 
     def getfunction(layout, depth):
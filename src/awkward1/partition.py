@@ -70,29 +70,66 @@ def partition_as(sample, arrays):
         return out
 
 
-def iterate(numpartitions, arrays):
-    if isinstance(arrays, dict):
-        for partitionid in range(numpartitions):
-            out = {}
-            for n, x in arrays.items():
-                if isinstance(x, PartitionedArray):
-                    out[n] = x.partition(partitionid)
-                else:
-                    out[n] = x
-            yield out
+def iterate(numpartitions, arrays, prefetch=0, max_inflight_bytes=None):
+    """
+    Yields the partitions of all PartitionedArrays in `arrays` (a dict or a
+    list, in which anything else is passed through as-is), one partition
+    at a time.
+
+    If `prefetch` is greater than zero, the next `prefetch` partitions of
+    each PartitionedArray are materialized on background threads while the
+    current one is being processed, with at most `max_inflight_bytes` of
+    generated data (if not None) waiting to be used.
+    """
+    if prefetch > 0:
+        prefetchers = {}
+        items = arrays.items() if isinstance(arrays, dict) else enumerate(arrays)
+        for n, x in items:
+            if isinstance(x, PartitionedArray):
+                prefetchers[n] = awkward1._ext.PartitionPrefetcher(
+                    x._ext, prefetch, max_inflight_bytes
+                )
+
+        def partition(n, x, partitionid):
+            return prefetchers[n].partition(partitionid)
+
     else:
-        for partitionid in range(numpartitions):
-            out = []
-            for x in arrays:
-                if isinstance(x, PartitionedArray):
-                    out.append(x.partition(partitionid))
-                else:
-                    out.append(x)
-            yield out
+        prefetchers = {}
+
+        def partition(n, x, partitionid):
+            return x.partition(partitionid)
+
+    try:
+        if isinstance(arrays, dict):
+            for partitionid in range(numpartitions):
+                out = {}
+                for n, x in arrays.items():
+                    if isinstance(x, PartitionedArray):
+                        out[n] = partition(n, x, partitionid)
+                    else:
+                        out[n] = x
+                yield out
+        else:
+            for partitionid in range(numpartitions):
+                out = []
+                for n, x in enumerate(arrays):
+                    if isinstance(x, PartitionedArray):
+                        out.append(partition(n, x, partitionid))
+                    else:
+                        out.append(x)
+                yield out
+
+    finally:
+        for prefetcher in prefetchers.values():
+            prefetcher.wait()
 
 
-def apply(function, array):
-    return IrregularlyPartitionedArray([function(x) for x in array.partitions])
+def apply(function, array, nthreads=None):
+    if nthreads is None:
+        return IrregularlyPartitionedArray([function(x) for x in array.partitions])
+    else:
+        # the GIL is released between calls; nthreads=0 is one per core
+        return PartitionedArray.from_ext(array._ext.map(function, nthreads))
 
 
 class PartitionedArray(object):
@@ -142,6 +179,9 @@ class PartitionedArray(object):
     def partitionid_index_at(self, at):
         return self._ext.partitionid_index_at(at)
 
+    def partitionids_indexes_at(self, at):
+        return self._ext.partitionids_indexes_at(at)
+
     def type(self, typestrs):
         out = None
         for x in self.partitions:
@@ -238,7 +278,11 @@ class PartitionedArray(object):
                 [x.rpad_and_clip(length, axis) for x in self.partitions]
             )
 
-    def reduce(self, name, axis, mask, keepdims):
+    def reduce(self, name, axis, mask, keepdims, nthreads=None):
+        if nthreads is not None:
+            out = self._ext.reduce(name, axis, mask, keepdims, nthreads)
+            return PartitionedArray.from_ext(out)
+
         branch, depth = first(self).branch_depth
         negaxis = -axis
         if not branch and negaxis <= 0:
@@ -333,20 +377,14 @@ class PartitionedArray(object):
             return y
 
     def toContent(self):
-        contents = self._ext.partitions
-        out = contents[0]
-        for x in contents[1:]:
-            if not out.mergeable(x, mergebool=False):
-                out = out.merge_as_union(x)
-            else:
-                out = out.merge(x)
-            if isinstance(out, awkward1._util.uniontypes):
-                out = out.simplify(mergebool=False)
-        return out
+        return self._ext.tocontent()
 
     def repartition(self, *args, **kwargs):
         return PartitionedArray.from_ext(self._ext.repartition(*args, **kwargs))
 
+    def repartition_by_bytes(self, target_bytes):
+        return PartitionedArray.from_ext(self._ext.repartition_by_bytes(target_bytes))
+
     def __getitem__(self, where):
         import awkward1.operations.convert
         import awkward1.operations.describe
@@ -0,0 +1,980 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#include <cmath>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+#include "awkward/cpu-kernels/elementwise.h"
+
+template <typename OUT, typename IN, typename F>
+void awkward_elementwise_loop(
+  OUT* toptr,
+  const IN* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const IN* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  F f) {
+  // strides are 1 for arrays and 0 for scalars; keep the common case simple
+  if (leftstride == 1  &&  rightstride == 1) {
+    for (int64_t i = 0;  i < length;  i++) {
+      toptr[i] = f(leftptr[leftoffset + i], rightptr[rightoffset + i]);
+    }
+  }
+  else {
+    for (int64_t i = 0;  i < length;  i++) {
+      toptr[i] = f(leftptr[leftoffset + i*leftstride],
+                   rightptr[rightoffset + i*rightstride]);
+    }
+  }
+}
+
+template <typename T>
+T awkward_elementwise_ipow(T base, T exponent) {
+  T out = 1;
+  while (exponent > 0) {
+    if (exponent & 1) {
+      out *= base;
+    }
+    base *= base;
+    exponent >>= 1;
+  }
+  return out;
+}
+
+template <typename T>
+ERROR awkward_elementwise_binary_float(
+  T* toptr,
+  const T* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const T* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  int64_t op) {
+  switch (op) {
+    case awkward_elementwise_add:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> T { return x + y; });
+      break;
+    case awkward_elementwise_subtract:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> T { return x - y; });
+      break;
+    case awkward_elementwise_multiply:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> T { return x * y; });
+      break;
+    case awkward_elementwise_divide:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> T { return x / y; });
+      break;
+    case awkward_elementwise_power:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> T { return std::pow(x, y); });
+      break;
+    case awkward_elementwise_minimum:
+      // like NumPy, NaN in either argument is propagated
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> T {
+                                 return (x < y  ||  x != x) ? x : y; });
+      break;
+    case awkward_elementwise_maximum:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> T {
+                                 return (x > y  ||  x != x) ? x : y; });
+      break;
+    default:
+      return failure("unsupported elementwise operation for floating-point "
+                     "numbers", kSliceNone, op);
+  }
+  return success();
+}
+
+template <typename T>
+ERROR awkward_elementwise_binary_integer(
+  T* toptr,
+  const T* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const T* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  int64_t op) {
+  switch (op) {
+    case awkward_elementwise_add:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> T { return x + y; });
+      break;
+    case awkward_elementwise_subtract:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> T { return x - y; });
+      break;
+    case awkward_elementwise_multiply:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> T { return x * y; });
+      break;
+    case awkward_elementwise_power:
+      for (int64_t i = 0;  i < length;  i++) {
+        if (rightptr[rightoffset + i*rightstride] < 0) {
+          return failure("integers to negative integer powers are not "
+                         "allowed", i, kSliceNone);
+        }
+      }
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> T {
+                                 return awkward_elementwise_ipow(x, y); });
+      break;
+    case awkward_elementwise_minimum:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> T { return x < y ? x : y; });
+      break;
+    case awkward_elementwise_maximum:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> T { return x > y ? x : y; });
+      break;
+    default:
+      return failure("unsupported elementwise operation for integers",
+                     kSliceNone, op);
+  }
+  return success();
+}
+
+template <typename T>
+ERROR awkward_elementwise_compare(
+  bool* toptr,
+  const T* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const T* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  int64_t op) {
+  switch (op) {
+    case awkward_elementwise_equal:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> bool { return x == y; });
+      break;
+    case awkward_elementwise_not_equal:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> bool { return x != y; });
+      break;
+    case awkward_elementwise_less:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> bool { return x < y; });
+      break;
+    case awkward_elementwise_less_equal:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> bool { return x <= y; });
+      break;
+    case awkward_elementwise_greater:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> bool { return x > y; });
+      break;
+    case awkward_elementwise_greater_equal:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](T x, T y) -> bool { return x >= y; });
+      break;
+    default:
+      return failure("unsupported elementwise comparison", kSliceNone, op);
+  }
+  return success();
+}
+
+template <typename T>
+ERROR awkward_elementwise_unary_float(
+  T* toptr,
+  const T* fromptr,
+  int64_t fromoffset,
+  int64_t length,
+  int64_t op) {
+  const T* from = fromptr + fromoffset;
+  switch (op) {
+    case awkward_elementwise_negative:
+      for (int64_t i = 0;  i < length;  i++) {
+        toptr[i] = -from[i];
+      }
+      break;
+    case awkward_elementwise_absolute:
+      for (int64_t i = 0;  i < length;  i++) {
+        toptr[i] = std::fabs(from[i]);
+      }
+      break;
+    case awkward_elementwise_sqrt:
+      for (int64_t i = 0;  i < length;  i++) {
+        toptr[i] = std::sqrt(from[i]);
+      }
+      break;
+    case awkward_elementwise_exp:
+      for (int64_t i = 0;  i < length;  i++) {
+        toptr[i] = std::exp(from[i]);
+      }
+      break;
+    case awkward_elementwise_log:
+      for (int64_t i = 0;  i < length;  i++) {
+        toptr[i] = std::log(from[i]);
+      }
+      break;
+    case awkward_elementwise_sin:
+      for (int64_t i = 0;  i < length;  i++) {
+        toptr[i] = std::sin(from[i]);
+      }
+      break;
+    case awkward_elementwise_cos:
+      for (int64_t i = 0;  i < length;  i++) {
+        toptr[i] = std::cos(from[i]);
+      }
+      break;
+    default:
+      return failure("unsupported elementwise operation for floating-point "
+                     "numbers", kSliceNone, op);
+  }
+  return success();
+}
+
+template <typename T>
+ERROR awkward_elementwise_unary_integer(
+  T* toptr,
+  const T* fromptr,
+  int64_t fromoffset,
+  int64_t length,
+  int64_t op) {
+  const T* from = fromptr + fromoffset;
+  switch (op) {
+    case awkward_elementwise_negative:
+      for (int64_t i = 0;  i < length;  i++) {
+        toptr[i] = -from[i];
+      }
+      break;
+    case awkward_elementwise_absolute:
+      for (int64_t i = 0;  i < length;  i++) {
+        toptr[i] = from[i] < 0 ? -from[i] : from[i];
+      }
+      break;
+    default:
+      return failure("unsupported elementwise operation for integers",
+                     kSliceNone, op);
+  }
+  return success();
+}
+
+ERROR awkward_elementwise_binary_float64(
+  double* toptr,
+  const double* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const double* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  int64_t op) {
+  return awkward_elementwise_binary_float<double>(
+    toptr,
+    leftptr,
+    leftoffset,
+    leftstride,
+    rightptr,
+    rightoffset,
+    rightstride,
+    length,
+    op);
+}
+ERROR awkward_elementwise_binary_float32(
+  float* toptr,
+  const float* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const float* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  int64_t op) {
+  return awkward_elementwise_binary_float<float>(
+    toptr,
+    leftptr,
+    leftoffset,
+    leftstride,
+    rightptr,
+    rightoffset,
+    rightstride,
+    length,
+    op);
+}
+ERROR awkward_elementwise_binary_int64(
+  int64_t* toptr,
+  const int64_t* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const int64_t* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  int64_t op) {
+  return awkward_elementwise_binary_integer<int64_t>(
+    toptr,
+    leftptr,
+    leftoffset,
+    leftstride,
+    rightptr,
+    rightoffset,
+    rightstride,
+    length,
+    op);
+}
+ERROR awkward_elementwise_binary_int32(
+  int32_t* toptr,
+  const int32_t* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const int32_t* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  int64_t op) {
+  return awkward_elementwise_binary_integer<int32_t>(
+    toptr,
+    leftptr,
+    leftoffset,
+    leftstride,
+    rightptr,
+    rightoffset,
+    rightstride,
+    length,
+    op);
+}
+ERROR awkward_elementwise_binary_bool(
+  bool* toptr,
+  const bool* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const bool* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  int64_t op) {
+  switch (op) {
+    case awkward_elementwise_logical_and:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](bool x, bool y) -> bool { return x && y; });
+      break;
+    case awkward_elementwise_logical_or:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](bool x, bool y) -> bool { return x || y; });
+      break;
+    case awkward_elementwise_logical_xor:
+      awkward_elementwise_loop(toptr, leftptr, leftoffset, leftstride,
+                               rightptr, rightoffset, rightstride, length,
+                               [](bool x, bool y) -> bool { return x != y; });
+      break;
+    default:
+      return failure("unsupported elementwise operation for booleans",
+                     kSliceNone, op);
+  }
+  return success();
+}
+
+ERROR awkward_elementwise_compare_float64(
+  bool* toptr,
+  const double* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const double* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  int64_t op) {
+  return awkward_elementwise_compare<double>(
+    toptr,
+    leftptr,
+    leftoffset,
+    leftstride,
+    rightptr,
+    rightoffset,
+    rightstride,
+    length,
+    op);
+}
+ERROR awkward_elementwise_compare_float32(
+  bool* toptr,
+  const float* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const float* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  int64_t op) {
+  return awkward_elementwise_compare<float>(
+    toptr,
+    leftptr,
+    leftoffset,
+    leftstride,
+    rightptr,
+    rightoffset,
+    rightstride,
+    length,
+    op);
+}
+ERROR awkward_elementwise_compare_int64(
+  bool* toptr,
+  const int64_t* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const int64_t* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  int64_t op) {
+  return awkward_elementwise_compare<int64_t>(
+    toptr,
+    leftptr,
+    leftoffset,
+    leftstride,
+    rightptr,
+    rightoffset,
+    rightstride,
+    length,
+    op);
+}
+ERROR awkward_elementwise_compare_int32(
+  bool* toptr,
+  const int32_t* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const int32_t* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  int64_t op) {
+  return awkward_elementwise_compare<int32_t>(
+    toptr,
+    leftptr,
+    leftoffset,
+    leftstride,
+    rightptr,
+    rightoffset,
+    rightstride,
+    length,
+    op);
+}
+ERROR awkward_elementwise_compare_bool(
+  bool* toptr,
+  const bool* leftptr,
+  int64_t leftoffset,
+  int64_t leftstride,
+  const bool* rightptr,
+  int64_t rightoffset,
+  int64_t rightstride,
+  int64_t length,
+  int64_t op) {
+  return awkward_elementwise_compare<bool>(
+    toptr,
+    leftptr,
+    leftoffset,
+    leftstride,
+    rightptr,
+    rightoffset,
+    rightstride,
+    length,
+    op);
+}
+
+ERROR awkward_elementwise_unary_float64(
+  double* toptr,
+  const double* fromptr,
+  int64_t fromoffset,
+  int64_t length,
+  int64_t op) {
+  return awkward_elementwise_unary_float<double>(
+    toptr,
+    fromptr,
+    fromoffset,
+    length,
+    op);
+}
+ERROR awkward_elementwise_unary_float32(
+  float* toptr,
+  const float* fromptr,
+  int64_t fromoffset,
+  int64_t length,
+  int64_t op) {
+  return awkward_elementwise_unary_float<float>(
+    toptr,
+    fromptr,
+    fromoffset,
+    length,
+    op);
+}
+ERROR awkward_elementwise_unary_int64(
+  int64_t* toptr,
+  const int64_t* fromptr,
+  int64_t fromoffset,
+  int64_t length,
+  int64_t op) {
+  return awkward_elementwise_unary_integer<int64_t>(
+    toptr,
+    fromptr,
+    fromoffset,
+    length,
+    op);
+}
+ERROR awkward_elementwise_unary_int32(
+  int32_t* toptr,
+  const int32_t* fromptr,
+  int64_t fromoffset,
+  int64_t length,
+  int64_t op) {
+  return awkward_elementwise_unary_integer<int32_t>(
+    toptr,
+    fromptr,
+    fromoffset,
+    length,
+    op);
+}
+ERROR awkward_elementwise_unary_bool(
+  bool* toptr,
+  const bool* fromptr,
+  int64_t fromoffset,
+  int64_t length,
+  int64_t op) {
+  if (op != awkward_elementwise_logical_not) {
+    return failure("unsupported elementwise operation for booleans",
+                   kSliceNone, op);
+  }
+  const bool* from = fromptr + fromoffset;
+  for (int64_t i = 0;  i < length;  i++) {
+    toptr[i] = !from[i];
+  }
+  return success();
+}
+
+template <typename IN, typename C>
+void awkward_elementwise_program_load(
+  C* toptr,
+  const void* fromptr,
+  int64_t fromoffset,
+  int64_t fromstride,
+  int64_t start,
+  int64_t length) {
+  const IN* from = reinterpret_cast<const IN*>(fromptr) + fromoffset;
+  if (fromstride == 0) {
+    C value = (C)from[0];
+    for (int64_t i = 0;  i < length;  i++) {
+      toptr[i] = value;
+    }
+  }
+  else {
+    from += start;
+    for (int64_t i = 0;  i < length;  i++) {
+      toptr[i] = (C)from[i];
+    }
+  }
+}
+
+template <typename C, typename F>
+void awkward_elementwise_program_binary(
+  C* left,
+  const C* right,
+  int64_t length,
+  F f) {
+  for (int64_t i = 0;  i < length;  i++) {
+    left[i] = f(left[i], right[i]);
+  }
+}
+
+template <typename C, typename F>
+void awkward_elementwise_program_unary(
+  C* x,
+  int64_t length,
+  F f) {
+  for (int64_t i = 0;  i < length;  i++) {
+    x[i] = f(x[i]);
+  }
+}
+
+template <typename T, typename C>
+ERROR awkward_elementwise_program(
+  T* toptr,
+  const void* const* inputptrs,
+  const int64_t* inputoffsets,
+  const int64_t* inputstrides,
+  const int64_t* inputdtypes,
+  const int64_t* program,
+  int64_t programlength,
+  const double* constants,
+  int64_t length) {
+  // check the program and find how deep its stack gets
+  int64_t depth = 0;
+  int64_t maxdepth = 0;
+  for (int64_t j = 0;  j < programlength;  j++) {
+    int64_t op = program[2*j];
+    int64_t numargs;
+    if (op == awkward_elementwise_input  ||
+        op == awkward_elementwise_constant) {
+      numargs = 0;
+    }
+    else if (op == awkward_elementwise_where) {
+      numargs = 3;
+    }
+    else if (op >= awkward_elementwise_negative  &&
+             op <= awkward_elementwise_logical_not) {
+      numargs = 1;
+    }
+    else {
+      numargs = 2;
+    }
+    if (std::is_integral<C>::value  &&
+        (op == awkward_elementwise_divide  ||
+         op == awkward_elementwise_power  ||
+         (op >= awkward_elementwise_sqrt  &&  op <= awkward_elementwise_cos))) {
+      return failure("floating-point operation in an integer elementwise "
+                     "program", j, op);
+    }
+    if (depth < numargs) {
+      return failure("elementwise program pops an empty stack", j, kSliceNone);
+    }
+    depth += 1 - numargs;
+    maxdepth = (depth > maxdepth ? depth : maxdepth);
+  }
+  if (depth != 1) {
+    return failure("elementwise program must leave exactly one value",
+                   kSliceNone, depth);
+  }
+
+  const int64_t blocksize = 1024;
+  std::vector<C> stack((size_t)(maxdepth*blocksize));
+  for (int64_t start = 0;  start < length;  start += blocksize) {
+    int64_t blocklength = (length - start < blocksize ?
+                           length - start : blocksize);
+    C* top = stack.data() - blocksize;
+    for (int64_t j = 0;  j < programlength;  j++) {
+      int64_t op = program[2*j];
+      int64_t arg = program[2*j + 1];
+      switch (op) {
+        case awkward_elementwise_input:
+          top += blocksize;
+          switch (inputdtypes[arg]) {
+            case awkward_elementwise_dtype_bool:
+              awkward_elementwise_program_load<bool, C>(
+                top, inputptrs[arg], inputoffsets[arg], inputstrides[arg],
+                start, blocklength);
+              break;
+            case awkward_elementwise_dtype_int32:
+              awkward_elementwise_program_load<int32_t, C>(
+                top, inputptrs[arg], inputoffsets[arg], inputstrides[arg],
+                start, blocklength);
+              break;
+            case awkward_elementwise_dtype_int64:
+              awkward_elementwise_program_load<int64_t, C>(
+                top, inputptrs[arg], inputoffsets[arg], inputstrides[arg],
+                start, blocklength);
+              break;
+            case awkward_elementwise_dtype_float32:
+              awkward_elementwise_program_load<float, C>(
+                top, inputptrs[arg], inputoffsets[arg], inputstrides[arg],
+                start, blocklength);
+              break;
+            case awkward_elementwise_dtype_float64:
+              awkward_elementwise_program_load<double, C>(
+                top, inputptrs[arg], inputoffsets[arg], inputstrides[arg],
+                start, blocklength);
+              break;
+            default:
+              return failure("unrecognized elementwise input type",
+                             arg, inputdtypes[arg]);
+          }
+          break;
+        case awkward_elementwise_constant:
+          top += blocksize;
+          for (int64_t i = 0;  i < blocklength;  i++) {
+            top[i] = (C)constants[arg];
+          }
+          break;
+        case awkward_elementwise_where:
+          top -= 2*blocksize;
+          for (int64_t i = 0;  i < blocklength;  i++) {
+            top[i] = (top[i] != 0 ? top[blocksize + i] : top[2*blocksize + i]);
+          }
+          break;
+
+        case awkward_elementwise_negative:
+          awkward_elementwise_program_unary(top, blocklength,
+            [](C x) -> C { return -x; });
+          break;
+        case awkward_elementwise_absolute:
+          awkward_elementwise_program_unary(top, blocklength,
+            [](C x) -> C { return std::abs(x); });
+          break;
+        case awkward_elementwise_sqrt:
+          awkward_elementwise_program_unary(top, blocklength,
+            [](C x) -> C { return std::sqrt(x); });
+          break;
+        case awkward_elementwise_exp:
+          awkward_elementwise_program_unary(top, blocklength,
+            [](C x) -> C { return std::exp(x); });
+          break;
+        case awkward_elementwise_log:
+          awkward_elementwise_program_unary(top, blocklength,
+            [](C x) -> C { return std::log(x); });
+          break;
+        case awkward_elementwise_sin:
+          awkward_elementwise_program_unary(top, blocklength,
+            [](C x) -> C { return std::sin(x); });
+          break;
+        case awkward_elementwise_cos:
+          awkward_elementwise_program_unary(top, blocklength,
+            [](C x) -> C { return std::cos(x); });
+          break;
+        case awkward_elementwise_logical_not:
+          awkward_elementwise_program_unary(top, blocklength,
+            [](C x) -> C { return x == 0 ? 1 : 0; });
+          break;
+
+        default:
+          top -= blocksize;
+          switch (op) {
+            case awkward_elementwise_add:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return x + y; });
+              break;
+            case awkward_elementwise_subtract:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return x - y; });
+              break;
+            case awkward_elementwise_multiply:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return x * y; });
+              break;
+            case awkward_elementwise_divide:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return x / y; });
+              break;
+            case awkward_elementwise_power:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return y == 2 ? x * x : (C)std::pow(x, y); });
+              break;
+            case awkward_elementwise_minimum:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return (x < y  ||  x != x) ? x : y; });
+              break;
+            case awkward_elementwise_maximum:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return (x > y  ||  x != x) ? x : y; });
+              break;
+            case awkward_elementwise_equal:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return x == y ? 1 : 0; });
+              break;
+            case awkward_elementwise_not_equal:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return x != y ? 1 : 0; });
+              break;
+            case awkward_elementwise_less:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return x < y ? 1 : 0; });
+              break;
+            case awkward_elementwise_less_equal:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return x <= y ? 1 : 0; });
+              break;
+            case awkward_elementwise_greater:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return x > y ? 1 : 0; });
+              break;
+            case awkward_elementwise_greater_equal:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return x >= y ? 1 : 0; });
+              break;
+            case awkward_elementwise_logical_and:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return (x != 0  &&  y != 0) ? 1 : 0; });
+              break;
+            case awkward_elementwise_logical_or:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return (x != 0  ||  y != 0) ? 1 : 0; });
+              break;
+            case awkward_elementwise_logical_xor:
+              awkward_elementwise_program_binary(top, top + blocksize,
+                blocklength, [](C x, C y) -> C {
+                  return ((x != 0) != (y != 0)) ? 1 : 0; });
+              break;
+            default:
+              return failure("unsupported elementwise operation in program",
+                             j, op);
+          }
+      }
+    }
+    for (int64_t i = 0;  i < blocklength;  i++) {
+      toptr[start + i] = (T)stack[(size_t)i];
+    }
+  }
+  return success();
+}
+ERROR awkward_elementwise_program_int64(
+  int64_t* toptr,
+  const void* const* inputptrs,
+  const int64_t* inputoffsets,
+  const int64_t* inputstrides,
+  const int64_t* inputdtypes,
+  const int64_t* program,
+  int64_t programlength,
+  const double* constants,
+  int64_t length) {
+  return awkward_elementwise_program<int64_t, int64_t>(
+    toptr,
+    inputptrs,
+    inputoffsets,
+    inputstrides,
+    inputdtypes,
+    program,
+    programlength,
+    constants,
+    length);
+}
+ERROR awkward_elementwise_program_float32(
+  float* toptr,
+  const void* const* inputptrs,
+  const int64_t* inputoffsets,
+  const int64_t* inputstrides,
+  const int64_t* inputdtypes,
+  const int64_t* program,
+  int64_t programlength,
+  const double* constants,
+  int64_t length) {
+  return awkward_elementwise_program<float, float>(
+    toptr,
+    inputptrs,
+    inputoffsets,
+    inputstrides,
+    inputdtypes,
+    program,
+    programlength,
+    constants,
+    length);
+}
+ERROR awkward_elementwise_program_float64(
+  double* toptr,
+  const void* const* inputptrs,
+  const int64_t* inputoffsets,
+  const int64_t* inputstrides,
+  const int64_t* inputdtypes,
+  const int64_t* program,
+  int64_t programlength,
+  const double* constants,
+  int64_t length) {
+  return awkward_elementwise_program<double, double>(
+    toptr,
+    inputptrs,
+    inputoffsets,
+    inputstrides,
+    inputdtypes,
+    program,
+    programlength,
+    constants,
+    length);
+}
+ERROR awkward_elementwise_program_bool_int64(
+  bool* toptr,
+  const void* const* inputptrs,
+  const int64_t* inputoffsets,
+  const int64_t* inputstrides,
+  const int64_t* inputdtypes,
+  const int64_t* program,
+  int64_t programlength,
+  const double* constants,
+  int64_t length) {
+  return awkward_elementwise_program<bool, int64_t>(
+    toptr,
+    inputptrs,
+    inputoffsets,
+    inputstrides,
+    inputdtypes,
+    program,
+    programlength,
+    constants,
+    length);
+}
+ERROR awkward_elementwise_program_bool_float32(
+  bool* toptr,
+  const void* const* inputptrs,
+  const int64_t* inputoffsets,
+  const int64_t* inputstrides,
+  const int64_t* inputdtypes,
+  const int64_t* program,
+  int64_t programlength,
+  const double* constants,
+  int64_t length) {
+  return awkward_elementwise_program<bool, float>(
+    toptr,
+    inputptrs,
+    inputoffsets,
+    inputstrides,
+    inputdtypes,
+    program,
+    programlength,
+    constants,
+    length);
+}
+ERROR awkward_elementwise_program_bool_float64(
+  bool* toptr,
+  const void* const* inputptrs,
+  const int64_t* inputoffsets,
+  const int64_t* inputstrides,
+  const int64_t* inputdtypes,
+  const int64_t* program,
+  int64_t programlength,
+  const double* constants,
+  int64_t length) {
+  return awkward_elementwise_program<bool, double>(
+    toptr,
+    inputptrs,
+    inputoffsets,
+    inputstrides,
+    inputdtypes,
+    program,
+    programlength,
+    constants,
+    length);
+}
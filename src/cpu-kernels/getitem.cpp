@@ -1,7 +1,65 @@
 // BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
 
+#include <cstring>
+
 #include "awkward/cpu-kernels/getitem.h"
 
+static inline int64_t
+awkward_popcount64(uint64_t word) {
+#if defined(__GNUC__)  ||  defined(__clang__)
+  return (int64_t)__builtin_popcountll(word);
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (int64_t)((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+static inline int64_t
+awkward_countzeros64(uint64_t word) {   // word != 0
+#if defined(__GNUC__)  ||  defined(__clang__)
+  return (int64_t)__builtin_ctzll(word);
+#else
+  int64_t out = 0;
+  while ((word & 1) == 0) {
+    word >>= 1;
+    out++;
+  }
+  return out;
+#endif
+}
+
+// Reads 8 bytes of a boolean mask into a word in which the lowest bit of
+// byte k is set if mask[k] is nonzero (and all other bits are zero). The
+// word is assembled by shifts, not memcpy, so that byte k is bits 8*k to
+// 8*k + 7 on any byte order; compilers turn this into one load where they
+// can.
+static inline uint64_t
+awkward_bytemask_nonzero8(const int8_t* mask) {
+  uint64_t word = 0;
+  for (int64_t k = 0;  k < 8;  k++) {
+    word |= (uint64_t)(uint8_t)mask[k] << (8*k);
+  }
+  word |= word >> 4;
+  word |= word >> 2;
+  word |= word >> 1;
+  return word & 0x0101010101010101ULL;
+}
+
+static inline int64_t
+awkward_bytemask_numtrue(const int8_t* mask, int64_t length) {
+  int64_t out = 0;
+  int64_t i = 0;
+  for (;  i + 8 <= length;  i += 8) {
+    out += awkward_popcount64(awkward_bytemask_nonzero8(&mask[i]));
+  }
+  for (;  i < length;  i++) {
+    out += (mask[i] != 0);
+  }
+  return out;
+}
+
 void awkward_regularize_rangeslice(
   int64_t* start,
   int64_t* stop,
@@ -697,6 +755,10 @@ ERROR awkward_NumpyArray_getitem_boolean_numtrue(
   int64_t byteoffset,
   int64_t length,
   int64_t stride) {
+  if (stride == 1) {
+    *numtrue = awkward_bytemask_numtrue(&fromptr[byteoffset], length);
+    return success();
+  }
   *numtrue = 0;
   for (int64_t i = 0;  i < length;  i += stride) {
     *numtrue = *numtrue + (fromptr[byteoffset + i] != 0);
@@ -704,6 +766,156 @@ ERROR awkward_NumpyArray_getitem_boolean_numtrue(
   return success();
 }
 
+// ITEMSIZE is the stride if known at compile time, or 0 if not.
+template <int64_t ITEMSIZE>
+void awkward_NumpyArray_getitem_boolean_compact_items(
+  uint8_t* toptr,
+  const uint8_t* fromptr,
+  int64_t stride,
+  const int8_t* mask,
+  int64_t length) {
+  size_t itemsize = (size_t)(ITEMSIZE != 0 ? ITEMSIZE : stride);
+  int64_t k = 0;
+  int64_t i = 0;
+  for (;  i + 8 <= length;  i += 8) {
+    uint64_t word = awkward_bytemask_nonzero8(&mask[i]);
+    if (word == 0x0101010101010101ULL) {
+      std::memcpy(&toptr[k*stride], &fromptr[i*stride], 8*itemsize);
+      k += 8;
+    }
+    else {
+      // compress-store: one copy per selected entry, found by bit scan
+      while (word != 0) {
+        int64_t j = i + awkward_countzeros64(word) / 8;
+        std::memcpy(&toptr[k*stride], &fromptr[j*stride], itemsize);
+        k++;
+        word &= word - 1;
+      }
+    }
+  }
+  for (;  i < length;  i++) {
+    if (mask[i] != 0) {
+      std::memcpy(&toptr[k*stride], &fromptr[i*stride], itemsize);
+      k++;
+    }
+  }
+}
+ERROR awkward_NumpyArray_getitem_boolean_compact(
+  uint8_t* toptr,
+  const uint8_t* fromptr,
+  int64_t byteoffset,
+  int64_t stride,
+  const int8_t* mask,
+  int64_t maskoffset,
+  int64_t length) {
+  switch (stride) {
+  case 1:
+    awkward_NumpyArray_getitem_boolean_compact_items<1>(
+      toptr, &fromptr[byteoffset], stride, &mask[maskoffset], length);
+    break;
+  case 2:
+    awkward_NumpyArray_getitem_boolean_compact_items<2>(
+      toptr, &fromptr[byteoffset], stride, &mask[maskoffset], length);
+    break;
+  case 4:
+    awkward_NumpyArray_getitem_boolean_compact_items<4>(
+      toptr, &fromptr[byteoffset], stride, &mask[maskoffset], length);
+    break;
+  case 8:
+    awkward_NumpyArray_getitem_boolean_compact_items<8>(
+      toptr, &fromptr[byteoffset], stride, &mask[maskoffset], length);
+    break;
+  default:
+    awkward_NumpyArray_getitem_boolean_compact_items<0>(
+      toptr, &fromptr[byteoffset], stride, &mask[maskoffset], length);
+  }
+  return success();
+}
+
+template <typename T>
+ERROR awkward_ListOffsetArray_getitem_jagged_mask(
+  int64_t* tooffsets,
+  const T* fromoffsets,
+  int64_t fromoffsetsoffset,
+  const int64_t* maskoffsets,
+  int64_t maskoffsetsoffset,
+  const int8_t* mask,
+  int64_t maskoffset,
+  int64_t length) {
+  tooffsets[0] = 0;
+  for (int64_t i = 0;  i < length;  i++) {
+    int64_t masklen = maskoffsets[maskoffsetsoffset + i + 1] -
+                      maskoffsets[maskoffsetsoffset + i];
+    if ((int64_t)fromoffsets[fromoffsetsoffset + i + 1] -
+        (int64_t)fromoffsets[fromoffsetsoffset + i] != masklen) {
+      return failure(
+        "jagged slice inner length differs from array inner length",
+        i,
+        kSliceNone);
+    }
+    tooffsets[i + 1] = tooffsets[i] + awkward_bytemask_numtrue(
+      &mask[maskoffset + maskoffsets[maskoffsetsoffset + i]], masklen);
+  }
+  return success();
+}
+ERROR awkward_ListOffsetArray32_getitem_jagged_mask_64(
+  int64_t* tooffsets,
+  const int32_t* fromoffsets,
+  int64_t fromoffsetsoffset,
+  const int64_t* maskoffsets,
+  int64_t maskoffsetsoffset,
+  const int8_t* mask,
+  int64_t maskoffset,
+  int64_t length) {
+  return awkward_ListOffsetArray_getitem_jagged_mask<int32_t>(
+    tooffsets,
+    fromoffsets,
+    fromoffsetsoffset,
+    maskoffsets,
+    maskoffsetsoffset,
+    mask,
+    maskoffset,
+    length);
+}
+ERROR awkward_ListOffsetArrayU32_getitem_jagged_mask_64(
+  int64_t* tooffsets,
+  const uint32_t* fromoffsets,
+  int64_t fromoffsetsoffset,
+  const int64_t* maskoffsets,
+  int64_t maskoffsetsoffset,
+  const int8_t* mask,
+  int64_t maskoffset,
+  int64_t length) {
+  return awkward_ListOffsetArray_getitem_jagged_mask<uint32_t>(
+    tooffsets,
+    fromoffsets,
+    fromoffsetsoffset,
+    maskoffsets,
+    maskoffsetsoffset,
+    mask,
+    maskoffset,
+    length);
+}
+ERROR awkward_ListOffsetArray64_getitem_jagged_mask_64(
+  int64_t* tooffsets,
+  const int64_t* fromoffsets,
+  int64_t fromoffsetsoffset,
+  const int64_t* maskoffsets,
+  int64_t maskoffsetsoffset,
+  const int8_t* mask,
+  int64_t maskoffset,
+  int64_t length) {
+  return awkward_ListOffsetArray_getitem_jagged_mask<int64_t>(
+    tooffsets,
+    fromoffsets,
+    fromoffsetsoffset,
+    maskoffsets,
+    maskoffsetsoffset,
+    mask,
+    maskoffset,
+    length);
+}
+
 template <typename T>
 ERROR awkward_NumpyArray_getitem_boolean_nonzero(
   T* toptr,
@@ -3112,6 +3324,154 @@ ERROR awkward_ByteMaskedArray_toIndexedOptionArray64(
     validwhen);
 }
 
+// The BitMaskedArray kernels read the bitmap 64 bits at a time into a word
+// in which bit k is set if element (bitstart + k) is valid, whatever the
+// lsb_order and validwhen of the array.
+
+static inline uint8_t
+awkward_BitMaskedArray_reverse_bits(uint8_t byte) {
+  byte = (uint8_t)(((byte & 0xF0) >> 4) | ((byte & 0x0F) << 4));
+  byte = (uint8_t)(((byte & 0xCC) >> 2) | ((byte & 0x33) << 2));
+  byte = (uint8_t)(((byte & 0xAA) >> 1) | ((byte & 0x55) << 1));
+  return byte;
+}
+
+static inline uint64_t
+awkward_BitMaskedArray_validword(
+  const uint8_t* mask,
+  int64_t bitstart,
+  int64_t length,
+  bool validwhen,
+  bool lsb_order) {
+  int64_t numbits = length - bitstart;
+  if (numbits > 64) {
+    numbits = 64;
+  }
+  uint64_t word = 0;
+  for (int64_t b = 0;  b*8 < numbits;  b++) {
+    uint8_t byte = mask[bitstart / 8 + b];
+    if (!lsb_order) {
+      byte = awkward_BitMaskedArray_reverse_bits(byte);
+    }
+    word |= ((uint64_t)byte) << (8*b);
+  }
+  if (!validwhen) {
+    word = ~word;
+  }
+  if (numbits < 64) {
+    word &= (((uint64_t)1) << numbits) - 1;
+  }
+  return word;
+}
+
+ERROR awkward_BitMaskedArray_numnull(
+  int64_t* numnull,
+  const uint8_t* mask,
+  int64_t maskoffset,
+  int64_t length,
+  bool validwhen,
+  bool lsb_order) {
+  int64_t numvalid = 0;
+  for (int64_t bitstart = 0;  bitstart < length;  bitstart += 64) {
+    numvalid += awkward_popcount64(
+      awkward_BitMaskedArray_validword(&mask[maskoffset],
+                                       bitstart,
+                                       length,
+                                       validwhen,
+                                       lsb_order));
+  }
+  *numnull = length - numvalid;
+  return success();
+}
+
+ERROR awkward_BitMaskedArray_getitem_nextcarry_64(
+  int64_t* tocarry,
+  const uint8_t* mask,
+  int64_t maskoffset,
+  int64_t length,
+  bool validwhen,
+  bool lsb_order) {
+  int64_t k = 0;
+  for (int64_t bitstart = 0;  bitstart < length;  bitstart += 64) {
+    uint64_t word = awkward_BitMaskedArray_validword(&mask[maskoffset],
+                                                     bitstart,
+                                                     length,
+                                                     validwhen,
+                                                     lsb_order);
+    while (word != 0) {
+      tocarry[k] = bitstart + awkward_countzeros64(word);
+      k++;
+      word &= word - 1;
+    }
+  }
+  return success();
+}
+
+ERROR awkward_BitMaskedArray_getitem_nextcarry_outindex_64(
+  int64_t* tocarry,
+  int64_t* outindex,
+  const uint8_t* mask,
+  int64_t maskoffset,
+  int64_t length,
+  bool validwhen,
+  bool lsb_order) {
+  int64_t k = 0;
+  for (int64_t bitstart = 0;  bitstart < length;  bitstart += 64) {
+    uint64_t word = awkward_BitMaskedArray_validword(&mask[maskoffset],
+                                                     bitstart,
+                                                     length,
+                                                     validwhen,
+                                                     lsb_order);
+    int64_t numbits = length - bitstart;
+    if (numbits > 64) {
+      numbits = 64;
+    }
+    if (word == 0) {
+      for (int64_t j = 0;  j < numbits;  j++) {
+        outindex[bitstart + j] = -1;
+      }
+    }
+    else {
+      for (int64_t j = 0;  j < numbits;  j++) {
+        if ((word >> j) & 1) {
+          tocarry[k] = bitstart + j;
+          outindex[bitstart + j] = k;
+          k++;
+        }
+        else {
+          outindex[bitstart + j] = -1;
+        }
+      }
+    }
+  }
+  return success();
+}
+
+ERROR awkward_BitMaskedArray_getitem_carry_64(
+  uint8_t* tomask,
+  const uint8_t* frommask,
+  int64_t frommaskoffset,
+  int64_t lenmask,
+  const int64_t* fromcarry,
+  int64_t lencarry,
+  bool lsb_order) {
+  for (int64_t i = 0;  i < lencarry;  i += 8) {
+    uint8_t byte = 0;
+    for (int64_t j = 0;  j < 8  &&  i + j < lencarry;  j++) {
+      int64_t at = fromcarry[i + j];
+      if (at < 0  ||  at >= lenmask) {
+        return failure("index out of range", i + j, at);
+      }
+      uint8_t from = frommask[frommaskoffset + at / 8];
+      uint8_t bit = lsb_order ? (uint8_t)((from >> (at % 8)) & 1)
+                              : (uint8_t)((from >> (7 - at % 8)) & 1);
+      byte |= lsb_order ? (uint8_t)(bit << j) : (uint8_t)(bit << (7 - j));
+    }
+    tomask[i / 8] = byte;
+  }
+  return success();
+}
+
 ERROR awkward_Content_getitem_next_missing_jagged_getmaskstartstop(
     int64_t* index_in, int64_t index_in_offset, int64_t* offsets_in,
     int64_t offsets_in_offset, int64_t* mask_out, int64_t* starts_out,
@@ -2543,3 +2543,51 @@ ERROR awkward_ByteMaskedArray_reduce_next_64(
   }
   return success();
 }
+
+ERROR awkward_BitMaskedArray_reduce_next_64(
+  int64_t* nextcarry,
+  int64_t* nextparents,
+  int64_t* outindex,
+  const uint8_t* mask,
+  int64_t maskoffset,
+  const int64_t* parents,
+  int64_t parentsoffset,
+  int64_t length,
+  bool validwhen,
+  bool lsb_order) {
+  int64_t k = 0;
+  for (int64_t i = 0;  i < length;  i += 8) {
+    uint8_t byte = mask[maskoffset + i / 8];
+    if (!validwhen) {
+      byte = (uint8_t)~byte;
+    }
+    int64_t numbits = length - i < 8 ? length - i : 8;
+    if (byte == 0) {
+      for (int64_t j = 0;  j < numbits;  j++) {
+        outindex[i + j] = -1;
+      }
+    }
+    else if (byte == 255) {
+      for (int64_t j = 0;  j < numbits;  j++) {
+        nextcarry[k] = i + j;
+        nextparents[k] = parents[parentsoffset + i + j];
+        outindex[i + j] = k;
+        k++;
+      }
+    }
+    else {
+      for (int64_t j = 0;  j < numbits;  j++) {
+        if ((byte >> (lsb_order ? j : 7 - j)) & 1) {
+          nextcarry[k] = i + j;
+          nextparents[k] = parents[parentsoffset + i + j];
+          outindex[i + j] = k;
+          k++;
+        }
+        else {
+          outindex[i + j] = -1;
+        }
+      }
+    }
+  }
+  return success();
+}
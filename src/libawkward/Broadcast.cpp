@@ -0,0 +1,1442 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "awkward/kernel.h"
+#include "awkward/cpu-kernels/elementwise.h"
+#include "awkward/array/BitMaskedArray.h"
+#include "awkward/array/ByteMaskedArray.h"
+#include "awkward/array/EmptyArray.h"
+#include "awkward/array/IndexedArray.h"
+#include "awkward/array/ListArray.h"
+#include "awkward/array/ListOffsetArray.h"
+#include "awkward/array/NumpyArray.h"
+#include "awkward/array/RecordArray.h"
+#include "awkward/array/RegularArray.h"
+#include "awkward/array/UnmaskedArray.h"
+#include "awkward/array/VirtualArray.h"
+
+#include "awkward/Broadcast.h"
+
+namespace awkward {
+  Elementwise::~Elementwise() = default;
+
+  ////////// ElementwiseUfunc
+
+  namespace {
+    struct UfuncInfo {
+      const char* name;
+      int64_t op;
+      int64_t numinputs;
+    };
+
+    const UfuncInfo ufuncs[] = {
+      { "add",            awkward_elementwise_add,            2 },
+      { "subtract",       awkward_elementwise_subtract,       2 },
+      { "multiply",       awkward_elementwise_multiply,       2 },
+      { "true_divide",    awkward_elementwise_divide,         2 },
+      { "divide",         awkward_elementwise_divide,         2 },
+      { "power",          awkward_elementwise_power,          2 },
+      { "minimum",        awkward_elementwise_minimum,        2 },
+      { "maximum",        awkward_elementwise_maximum,        2 },
+      { "equal",          awkward_elementwise_equal,          2 },
+      { "not_equal",      awkward_elementwise_not_equal,      2 },
+      { "less",           awkward_elementwise_less,           2 },
+      { "less_equal",     awkward_elementwise_less_equal,     2 },
+      { "greater",        awkward_elementwise_greater,        2 },
+      { "greater_equal",  awkward_elementwise_greater_equal,  2 },
+      { "logical_and",    awkward_elementwise_logical_and,    2 },
+      { "logical_or",     awkward_elementwise_logical_or,     2 },
+      { "logical_xor",    awkward_elementwise_logical_xor,    2 },
+      { "negative",       awkward_elementwise_negative,       1 },
+      { "absolute",       awkward_elementwise_absolute,       1 },
+      { "sqrt",           awkward_elementwise_sqrt,           1 },
+      { "exp",            awkward_elementwise_exp,            1 },
+      { "log",            awkward_elementwise_log,            1 },
+      { "sin",            awkward_elementwise_sin,            1 },
+      { "cos",            awkward_elementwise_cos,            1 },
+      { "logical_not",    awkward_elementwise_logical_not,    1 }
+    };
+
+    const UfuncInfo*
+    find_ufunc(const std::string& name) {
+      for (auto& info : ufuncs) {
+        if (name == info.name) {
+          return &info;
+        }
+      }
+      return nullptr;
+    }
+
+    bool
+    is_comparison(int64_t op) {
+      return op >= awkward_elementwise_equal  &&
+             op <= awkward_elementwise_greater_equal;
+    }
+
+    bool
+    is_logical(int64_t op) {
+      return (op >= awkward_elementwise_logical_and  &&
+              op <= awkward_elementwise_logical_xor)  ||
+             op == awkward_elementwise_logical_not;
+    }
+
+    bool
+    is_transcendental(int64_t op) {
+      return op == awkward_elementwise_divide  ||
+             (op >= awkward_elementwise_sqrt  &&
+              op <= awkward_elementwise_cos);
+    }
+
+    /// @brief 0 for booleans, 1 for integers, 2 for floating point, or -1
+    /// for types without an elementwise kernel.
+    int
+    dtype_kind(util::dtype dt) {
+      switch (dt) {
+        case util::dtype::boolean:
+          return 0;
+        case util::dtype::int32:
+        case util::dtype::int64:
+          return 1;
+        case util::dtype::float32:
+        case util::dtype::float64:
+          return 2;
+        default:
+          return -1;
+      }
+    }
+
+    /// @brief NumPy's type promotion between two arrays, restricted to the
+    /// types with elementwise kernels.
+    util::dtype
+    promote_arrays(util::dtype a, util::dtype b) {
+      if (a == b) {
+        return a;
+      }
+      if (a == util::dtype::boolean) {
+        return b;
+      }
+      if (b == util::dtype::boolean) {
+        return a;
+      }
+      if (dtype_kind(a) == 1  &&  dtype_kind(b) == 1) {
+        return util::dtype::int64;
+      }
+      // float32 with int32 or int64, or anything with float64
+      return util::dtype::float64;
+    }
+
+    /// @brief NumPy's value-based promotion of an array type with a scalar:
+    /// the scalar only matters if it is a higher kind than the array or
+    /// does not fit in the array's type. Returns `NOT_PRIMITIVE` for
+    /// booleans with floating-point scalars, which NumPy promotes to
+    /// `float16`.
+    util::dtype
+    promote_scalar(util::dtype array, const NumpyArray& scalar);
+
+    template <typename T>
+    struct DtypeOf { };
+    template <>
+    struct DtypeOf<bool> {
+      static util::dtype value() { return util::dtype::boolean; }
+    };
+    template <>
+    struct DtypeOf<int32_t> {
+      static util::dtype value() { return util::dtype::int32; }
+    };
+    template <>
+    struct DtypeOf<int64_t> {
+      static util::dtype value() { return util::dtype::int64; }
+    };
+    template <>
+    struct DtypeOf<float> {
+      static util::dtype value() { return util::dtype::float32; }
+    };
+    template <>
+    struct DtypeOf<double> {
+      static util::dtype value() { return util::dtype::float64; }
+    };
+
+    template <typename T>
+    T
+    scalar_value(const NumpyArray& x) {
+      const uint8_t* ptr =
+        reinterpret_cast<const uint8_t*>(x.ptr().get()) + x.byteoffset();
+      switch (x.dtype()) {
+        case util::dtype::boolean:
+          return (T)(*reinterpret_cast<const bool*>(ptr));
+        case util::dtype::int32:
+          return (T)(*reinterpret_cast<const int32_t*>(ptr));
+        case util::dtype::int64:
+          return (T)(*reinterpret_cast<const int64_t*>(ptr));
+        case util::dtype::float32:
+          return (T)(*reinterpret_cast<const float*>(ptr));
+        case util::dtype::float64:
+          return (T)(*reinterpret_cast<const double*>(ptr));
+        default:
+          throw std::runtime_error("unexpected dtype in elementwise scalar");
+      }
+    }
+
+    util::dtype
+    promote_scalar(util::dtype array, const NumpyArray& scalar) {
+      int arraykind = dtype_kind(array);
+      int scalarkind = dtype_kind(scalar.dtype());
+      if (scalarkind < arraykind) {
+        return array;
+      }
+      else if (scalarkind == arraykind) {
+        if (array == util::dtype::int32) {
+          int64_t value = scalar_value<int64_t>(scalar);
+          if (value < std::numeric_limits<int32_t>::min()  ||
+              value > std::numeric_limits<int32_t>::max()) {
+            return util::dtype::int64;
+          }
+        }
+        else if (array == util::dtype::float32) {
+          double value = scalar_value<double>(scalar);
+          if (std::isfinite(value)  &&
+              std::fabs(value) > std::numeric_limits<float>::max()) {
+            return util::dtype::float64;
+          }
+        }
+        return array;
+      }
+      else if (scalarkind == 1) {
+        return util::dtype::int64;
+      }
+      else if (arraykind == 0) {
+        return util::dtype::NOT_PRIMITIVE;
+      }
+      else {
+        return util::dtype::float64;
+      }
+    }
+
+    /// @brief Copies a contiguous array of a narrower type into `toptr`.
+    /// Promotion never narrows, so each `T` only has to accept the types
+    /// below it.
+    template <typename T>
+    void
+    fill_promoted(T* toptr, const NumpyArray& x, int64_t length);
+
+    template <>
+    void
+    fill_promoted<bool>(bool* toptr, const NumpyArray& x, int64_t length) {
+      throw std::runtime_error("unexpected promotion to bool");
+    }
+
+    template <>
+    void
+    fill_promoted<int32_t>(int32_t* toptr,
+                           const NumpyArray& x,
+                           int64_t length) {
+      int64_t offset = x.byteoffset() / x.itemsize();
+      struct Error err;
+      switch (x.dtype()) {
+        case util::dtype::boolean:
+          err = kernel::NumpyArray_fill_frombool<int32_t>(
+            toptr, 0, reinterpret_cast<bool*>(x.ptr().get()), offset, length);
+          break;
+        default:
+          throw std::runtime_error("unexpected promotion to int32");
+      }
+      util::handle_error(err, x.classname(), nullptr);
+    }
+
+    template <>
+    void
+    fill_promoted<int64_t>(int64_t* toptr,
+                           const NumpyArray& x,
+                           int64_t length) {
+      int64_t offset = x.byteoffset() / x.itemsize();
+      struct Error err;
+      switch (x.dtype()) {
+        case util::dtype::boolean:
+          err = kernel::NumpyArray_fill_frombool<int64_t>(
+            toptr, 0, reinterpret_cast<bool*>(x.ptr().get()), offset, length);
+          break;
+        case util::dtype::int32:
+          err = kernel::NumpyArray_fill<int32_t, int64_t>(
+            toptr, 0, reinterpret_cast<int32_t*>(x.ptr().get()), offset,
+            length);
+          break;
+        default:
+          throw std::runtime_error("unexpected promotion to int64");
+      }
+      util::handle_error(err, x.classname(), nullptr);
+    }
+
+    template <>
+    void
+    fill_promoted<float>(float* toptr, const NumpyArray& x, int64_t length) {
+      int64_t offset = x.byteoffset() / x.itemsize();
+      struct Error err;
+      switch (x.dtype()) {
+        case util::dtype::boolean:
+          err = kernel::NumpyArray_fill_frombool<float>(
+            toptr, 0, reinterpret_cast<bool*>(x.ptr().get()), offset, length);
+          break;
+        default:
+          throw std::runtime_error("unexpected promotion to float32");
+      }
+      util::handle_error(err, x.classname(), nullptr);
+    }
+
+    template <>
+    void
+    fill_promoted<double>(double* toptr, const NumpyArray& x, int64_t length) {
+      int64_t offset = x.byteoffset() / x.itemsize();
+      struct Error err;
+      switch (x.dtype()) {
+        case util::dtype::boolean:
+          err = kernel::NumpyArray_fill_frombool<double>(
+            toptr, 0, reinterpret_cast<bool*>(x.ptr().get()), offset, length);
+          break;
+        case util::dtype::int32:
+          err = kernel::NumpyArray_fill<int32_t, double>(
+            toptr, 0, reinterpret_cast<int32_t*>(x.ptr().get()), offset,
+            length);
+          break;
+        case util::dtype::int64:
+          err = kernel::NumpyArray_fill<int64_t, double>(
+            toptr, 0, reinterpret_cast<int64_t*>(x.ptr().get()), offset,
+            length);
+          break;
+        case util::dtype::float32:
+          err = kernel::NumpyArray_fill<float, double>(
+            toptr, 0, reinterpret_cast<float*>(x.ptr().get()), offset,
+            length);
+          break;
+        default:
+          throw std::runtime_error("unexpected promotion to float64");
+      }
+      util::handle_error(err, x.classname(), nullptr);
+    }
+
+    /// @brief An input to an elementwise kernel: a buffer of `T`, the
+    /// position of its first element, and a stride of 1 (array) or 0
+    /// (scalar).
+    template <typename T>
+    struct KernelInput {
+      std::shared_ptr<T> ptr;
+      int64_t offset;
+      int64_t stride;
+    };
+
+    template <typename T>
+    KernelInput<T>
+    kernel_input(const std::shared_ptr<NumpyArray>& x, int64_t length) {
+      if (x.get()->isscalar()) {
+        std::shared_ptr<T> ptr =
+          kernel::ptr_alloc<T>(kernel::Lib::cpu_kernels, 1);
+        ptr.get()[0] = scalar_value<T>(*x.get());
+        return KernelInput<T>({ ptr, 0, 0 });
+      }
+      NumpyArray contiguous = x.get()->contiguous();
+      if (contiguous.dtype() == DtypeOf<T>::value()) {
+        return KernelInput<T>({
+          std::static_pointer_cast<T>(contiguous.ptr()),
+          (int64_t)(contiguous.byteoffset() / contiguous.itemsize()),
+          1 });
+      }
+      std::shared_ptr<T> ptr =
+        kernel::ptr_alloc<T>(kernel::Lib::cpu_kernels, length);
+      fill_promoted<T>(ptr.get(), contiguous, length);
+      return KernelInput<T>({ ptr, 0, 1 });
+    }
+
+    template <typename OUT>
+    const ContentPtr
+    kernel_output(const std::shared_ptr<OUT>& ptr,
+                  const std::vector<ssize_t>& shape) {
+      ssize_t itemsize = (ssize_t)sizeof(OUT);
+      std::vector<ssize_t> strides(shape.size(), itemsize);
+      for (int64_t i = (int64_t)shape.size() - 2;  i >= 0;  i--) {
+        strides[(size_t)i] = strides[(size_t)i + 1] * shape[(size_t)i + 1];
+      }
+      return std::make_shared<NumpyArray>(
+        Identities::none(),
+        util::Parameters(),
+        ptr,
+        shape,
+        strides,
+        0,
+        itemsize,
+        util::dtype_to_format(DtypeOf<OUT>::value()),
+        DtypeOf<OUT>::value(),
+        kernel::Lib::cpu_kernels);
+    }
+
+    template <typename T>
+    const ContentPtr
+    apply_typed(const std::vector<std::shared_ptr<NumpyArray>>& inputs,
+                const std::vector<ssize_t>& shape,
+                int64_t length,
+                int64_t op,
+                const std::string& name) {
+      struct Error err;
+      if (inputs.size() == 1) {
+        KernelInput<T> in = kernel_input<T>(inputs[0], length);
+        std::shared_ptr<T> out =
+          kernel::ptr_alloc<T>(kernel::Lib::cpu_kernels, length);
+        err = kernel::elementwise_unary<T>(
+          out.get(), in.ptr.get(), in.offset, length, op);
+        util::handle_error(err, name, nullptr);
+        return kernel_output<T>(out, shape);
+      }
+      KernelInput<T> left = kernel_input<T>(inputs[0], length);
+      KernelInput<T> right = kernel_input<T>(inputs[1], length);
+      if (is_comparison(op)) {
+        std::shared_ptr<bool> out =
+          kernel::ptr_alloc<bool>(kernel::Lib::cpu_kernels, length);
+        err = kernel::elementwise_compare<T>(
+          out.get(),
+          left.ptr.get(), left.offset, left.stride,
+          right.ptr.get(), right.offset, right.stride,
+          length,
+          op);
+        util::handle_error(err, name, nullptr);
+        return kernel_output<bool>(out, shape);
+      }
+      else {
+        std::shared_ptr<T> out =
+          kernel::ptr_alloc<T>(kernel::Lib::cpu_kernels, length);
+        err = kernel::elementwise_binary<T>(
+          out.get(),
+          left.ptr.get(), left.offset, left.stride,
+          right.ptr.get(), right.offset, right.stride,
+          length,
+          op);
+        util::handle_error(err, name, nullptr);
+        return kernel_output<T>(out, shape);
+      }
+    }
+  }
+
+  ElementwiseUfunc::ElementwiseUfunc(const std::string& name)
+      : name_(name) {
+    const UfuncInfo* info = find_ufunc(name);
+    if (info == nullptr) {
+      throw std::invalid_argument(
+        std::string("no elementwise kernel for ufunc ") + name);
+    }
+    op_ = info->op;
+    numinputs_ = info->numinputs;
+  }
+
+  bool
+  ElementwiseUfunc::has(const std::string& name) {
+    return find_ufunc(name) != nullptr;
+  }
+
+  const std::string
+  ElementwiseUfunc::name() const {
+    return name_;
+  }
+
+  int64_t
+  ElementwiseUfunc::numinputs() const {
+    return numinputs_;
+  }
+
+  const ContentPtr
+  ElementwiseUfunc::apply(
+    const std::vector<std::shared_ptr<NumpyArray>>& inputs) const {
+    if ((int64_t)inputs.size() != numinputs_) {
+      throw std::invalid_argument(
+        std::string("ufunc ") + name_ + std::string(" takes ")
+        + std::to_string(numinputs_) + std::string(" inputs, not ")
+        + std::to_string(inputs.size()));
+    }
+
+    bool has_array = false;
+    util::dtype arraytype = util::dtype::NOT_PRIMITIVE;
+    std::vector<ssize_t> shape;
+    for (auto x : inputs) {
+      if (dtype_kind(x.get()->dtype()) < 0) {
+        throw std::invalid_argument(
+          std::string("no elementwise kernel for ufunc ") + name_
+          + std::string(" on dtype ")
+          + util::dtype_to_name(x.get()->dtype()));
+      }
+      if (!x.get()->isscalar()) {
+        if (!has_array) {
+          arraytype = x.get()->dtype();
+          shape = x.get()->shape();
+          has_array = true;
+        }
+        else {
+          arraytype = promote_arrays(arraytype, x.get()->dtype());
+          if (x.get()->shape() != shape) {
+            throw std::invalid_argument(
+              std::string("ufunc ") + name_
+              + std::string(" inputs must have the same shape"));
+          }
+        }
+      }
+    }
+    if (!has_array) {
+      throw std::invalid_argument(
+        std::string("ufunc ") + name_
+        + std::string(" needs at least one array input"));
+    }
+    util::dtype computetype = arraytype;
+    for (auto x : inputs) {
+      if (x.get()->isscalar()) {
+        computetype = promote_scalar(computetype, *x.get());
+      }
+    }
+    if (computetype == util::dtype::NOT_PRIMITIVE) {
+      throw std::invalid_argument(
+        std::string("no elementwise kernel for ufunc ") + name_
+        + std::string(" on booleans with floating-point scalars"));
+    }
+
+    if (is_logical(op_)) {
+      if (computetype != util::dtype::boolean) {
+        throw std::invalid_argument(
+          std::string("no elementwise kernel for ufunc ") + name_
+          + std::string(" on non-boolean inputs"));
+      }
+    }
+    else if (is_transcendental(op_)) {
+      // NumPy computes these in float16 for booleans
+      if (computetype == util::dtype::boolean) {
+        throw std::invalid_argument(
+          std::string("no elementwise kernel for ufunc ") + name_
+          + std::string(" on boolean inputs"));
+      }
+      else if (dtype_kind(computetype) != 2) {
+        computetype = util::dtype::float64;
+      }
+    }
+    else if (!is_comparison(op_)  &&  computetype == util::dtype::boolean) {
+      throw std::invalid_argument(
+        std::string("no elementwise kernel for ufunc ") + name_
+        + std::string(" on boolean inputs"));
+    }
+
+    int64_t length = 1;
+    for (auto x : shape) {
+      length *= (int64_t)x;
+    }
+
+    switch (computetype) {
+      case util::dtype::boolean:
+        return apply_typed<bool>(inputs, shape, length, op_, name_);
+      case util::dtype::int32:
+        return apply_typed<int32_t>(inputs, shape, length, op_, name_);
+      case util::dtype::int64:
+        return apply_typed<int64_t>(inputs, shape, length, op_, name_);
+      case util::dtype::float32:
+        return apply_typed<float>(inputs, shape, length, op_, name_);
+      case util::dtype::float64:
+        return apply_typed<double>(inputs, shape, length, op_, name_);
+      default:
+        throw std::runtime_error("unexpected computation type in "
+                                 "ElementwiseUfunc::apply");
+    }
+  }
+
+  ////////// ElementwiseExpression
+
+  namespace {
+    int64_t
+    program_dtype(util::dtype dt) {
+      switch (dt) {
+        case util::dtype::boolean:
+          return awkward_elementwise_dtype_bool;
+        case util::dtype::int32:
+          return awkward_elementwise_dtype_int32;
+        case util::dtype::int64:
+          return awkward_elementwise_dtype_int64;
+        case util::dtype::float32:
+          return awkward_elementwise_dtype_float32;
+        case util::dtype::float64:
+          return awkward_elementwise_dtype_float64;
+        default:
+          return -1;
+      }
+    }
+  }
+
+  ElementwiseExpression::ElementwiseExpression(
+    const std::vector<std::string>& program)
+      : program_(program)
+      , numinputs_(0)
+      , isboolean_(false)
+      , floatops_(false)
+      , integerconstants_(true) {
+    int64_t depth = 0;
+    for (auto token : program_) {
+      int64_t op;
+      int64_t arg = 0;
+      int64_t numargs;
+      char* end = nullptr;
+      if (token.size() > 1  &&  token[0] == '#') {
+        arg = (int64_t)std::strtoll(token.c_str() + 1, &end, 10);
+        if (*end != 0  ||  arg < 0) {
+          throw std::invalid_argument(
+            std::string("not an elementwise input: ") + token);
+        }
+        op = awkward_elementwise_input;
+        numargs = 0;
+        numinputs_ = std::max(numinputs_, arg + 1);
+      }
+      else if (token == "where") {
+        op = awkward_elementwise_where;
+        numargs = 3;
+      }
+      else if (const UfuncInfo* info = find_ufunc(token)) {
+        op = info->op;
+        numargs = info->numinputs;
+      }
+      else {
+        double value = std::strtod(token.c_str(), &end);
+        if (token.empty()  ||  *end != 0) {
+          throw std::invalid_argument(
+            std::string("unrecognized token in elementwise expression: ")
+            + token);
+        }
+        op = awkward_elementwise_constant;
+        arg = (int64_t)constants_.size();
+        numargs = 0;
+        constants_.push_back(value);
+        // only integer literals ("2", not "2.0") keep integer arithmetic
+        char* intend;
+        std::strtoll(token.c_str(), &intend, 10);
+        if (*intend != 0  ||  !(std::fabs(value) < 9.2e18)) {
+          integerconstants_ = false;
+        }
+      }
+      if (is_transcendental(op)  ||  op == awkward_elementwise_power) {
+        floatops_ = true;
+      }
+      if (depth < numargs) {
+        throw std::invalid_argument(
+          std::string("not enough arguments for ") + token
+          + std::string(" in elementwise expression"));
+      }
+      depth += 1 - numargs;
+      instructions_.push_back(op);
+      instructions_.push_back(arg);
+      isboolean_ = is_comparison(op)  ||  is_logical(op);
+    }
+    if (depth != 1) {
+      throw std::invalid_argument(
+        std::string("elementwise expression must leave exactly one value, "
+                    "not ") + std::to_string(depth));
+    }
+  }
+
+  const std::vector<std::string>
+  ElementwiseExpression::program() const {
+    return program_;
+  }
+
+  bool
+  ElementwiseExpression::isboolean() const {
+    return isboolean_;
+  }
+
+  const std::string
+  ElementwiseExpression::name() const {
+    std::stringstream out;
+    for (size_t i = 0;  i < program_.size();  i++) {
+      out << (i == 0 ? "" : " ") << program_[i];
+    }
+    return out.str();
+  }
+
+  int64_t
+  ElementwiseExpression::numinputs() const {
+    return numinputs_;
+  }
+
+  const ContentPtr
+  ElementwiseExpression::apply(
+    const std::vector<std::shared_ptr<NumpyArray>>& inputs) const {
+    if ((int64_t)inputs.size() != numinputs_) {
+      throw std::invalid_argument(
+        std::string("elementwise expression takes ")
+        + std::to_string(numinputs_) + std::string(" inputs, not ")
+        + std::to_string(inputs.size()));
+    }
+
+    std::vector<ssize_t> shape;
+    bool has_array = false;
+    std::vector<NumpyArray> contiguous;
+    std::vector<const void*> ptrs;
+    std::vector<int64_t> offsets;
+    std::vector<int64_t> strides;
+    std::vector<int64_t> dtypes;
+    for (auto x : inputs) {
+      int64_t dtype = program_dtype(x.get()->dtype());
+      if (dtype < 0) {
+        throw std::invalid_argument(
+          std::string("no elementwise kernel for dtype ")
+          + util::dtype_to_name(x.get()->dtype()));
+      }
+      if (!x.get()->isscalar()) {
+        if (!has_array) {
+          shape = x.get()->shape();
+          has_array = true;
+        }
+        else if (x.get()->shape() != shape) {
+          throw std::invalid_argument(
+            "elementwise expression inputs must have the same shape");
+        }
+      }
+      contiguous.push_back(x.get()->isscalar() ? *x.get()
+                                               : x.get()->contiguous());
+      const NumpyArray& array = contiguous.back();
+      ptrs.push_back(array.ptr().get());
+      offsets.push_back((int64_t)(array.byteoffset() / array.itemsize()));
+      strides.push_back(array.isscalar() ? 0 : 1);
+      dtypes.push_back(dtype);
+    }
+    if (!has_array) {
+      throw std::invalid_argument(
+        "elementwise expression needs at least one array input");
+    }
+
+    // the same promotion as ElementwiseUfunc, except that integers are
+    // always widened to int64 and anything without an integer kernel is
+    // evaluated in float64
+    util::dtype computetype = util::dtype::boolean;
+    for (auto x : inputs) {
+      if (!x.get()->isscalar()) {
+        computetype = promote_arrays(computetype, x.get()->dtype());
+      }
+    }
+    for (auto x : inputs) {
+      if (x.get()->isscalar()) {
+        computetype = promote_scalar(computetype, *x.get());
+      }
+    }
+    if (dtype_kind(computetype) != 2) {
+      if (computetype == util::dtype::NOT_PRIMITIVE  ||
+          floatops_  ||
+          !integerconstants_) {
+        computetype = util::dtype::float64;
+      }
+      else {
+        computetype = util::dtype::int64;
+      }
+    }
+
+    int64_t length = 1;
+    for (auto x : shape) {
+      length *= (int64_t)x;
+    }
+    switch (computetype) {
+      case util::dtype::int64:
+        return isboolean_ ? apply_program<bool, int64_t>(ptrs, offsets,
+                                                          strides, dtypes,
+                                                          shape, length)
+                          : apply_program<int64_t, int64_t>(ptrs, offsets,
+                                                             strides, dtypes,
+                                                             shape, length);
+      case util::dtype::float32:
+        return isboolean_ ? apply_program<bool, float>(ptrs, offsets,
+                                                        strides, dtypes,
+                                                        shape, length)
+                          : apply_program<float, float>(ptrs, offsets,
+                                                         strides, dtypes,
+                                                         shape, length);
+      default:
+        return isboolean_ ? apply_program<bool, double>(ptrs, offsets,
+                                                         strides, dtypes,
+                                                         shape, length)
+                          : apply_program<double, double>(ptrs, offsets,
+                                                           strides, dtypes,
+                                                           shape, length);
+    }
+  }
+
+  template <typename T, typename C>
+  const ContentPtr
+  ElementwiseExpression::apply_program(
+    const std::vector<const void*>& ptrs,
+    const std::vector<int64_t>& offsets,
+    const std::vector<int64_t>& strides,
+    const std::vector<int64_t>& dtypes,
+    const std::vector<ssize_t>& shape,
+    int64_t length) const {
+    std::shared_ptr<T> out =
+      kernel::ptr_alloc<T>(kernel::Lib::cpu_kernels, length);
+    struct Error err = kernel::elementwise_program<T, C>(
+      out.get(),
+      ptrs.data(),
+      offsets.data(),
+      strides.data(),
+      dtypes.data(),
+      instructions_.data(),
+      (int64_t)instructions_.size() / 2,
+      constants_.data(),
+      length);
+    util::handle_error(err, "ElementwiseExpression", nullptr);
+    return kernel_output<T>(out, shape);
+  }
+
+  ////////// broadcast_and_apply
+
+  namespace {
+    bool
+    is_scalar(const ContentPtr& x) {
+      NumpyArray* raw = kind_cast<NumpyArray>(x.get());
+      return raw != nullptr  &&  raw->isscalar();
+    }
+
+    bool
+    is_list(const ContentPtr& x) {
+      switch (x.get()->kind()) {
+        case Content::Kind::ListArray32:
+        case Content::Kind::ListArrayU32:
+        case Content::Kind::ListArray64:
+        case Content::Kind::ListOffsetArray32:
+        case Content::Kind::ListOffsetArrayU32:
+        case Content::Kind::ListOffsetArray64:
+        case Content::Kind::RegularArray:
+          return true;
+        default:
+          return false;
+      }
+    }
+
+    bool
+    is_option(const ContentPtr& x) {
+      switch (x.get()->kind()) {
+        case Content::Kind::IndexedOptionArray32:
+        case Content::Kind::IndexedOptionArray64:
+        case Content::Kind::ByteMaskedArray:
+        case Content::Kind::BitMaskedArray:
+        case Content::Kind::UnmaskedArray:
+          return true;
+        default:
+          return false;
+      }
+    }
+
+    bool
+    is_indexed(const ContentPtr& x) {
+      switch (x.get()->kind()) {
+        case Content::Kind::IndexedArray32:
+        case Content::Kind::IndexedArrayU32:
+        case Content::Kind::IndexedArray64:
+          return true;
+        default:
+          return false;
+      }
+    }
+
+    bool
+    is_union(const ContentPtr& x) {
+      switch (x.get()->kind()) {
+        case Content::Kind::UnionArray8_32:
+        case Content::Kind::UnionArray8_U32:
+        case Content::Kind::UnionArray8_64:
+          return true;
+        default:
+          return false;
+      }
+    }
+
+    const Index8
+    option_bytemask(const ContentPtr& x) {
+      Content* raw = x.get();
+      if (IndexedOptionArray32* y = kind_cast<IndexedOptionArray32>(raw)) {
+        return y->bytemask();
+      }
+      else if (IndexedOptionArray64* y =
+               kind_cast<IndexedOptionArray64>(raw)) {
+        return y->bytemask();
+      }
+      else if (ByteMaskedArray* y = kind_cast<ByteMaskedArray>(raw)) {
+        return y->bytemask();
+      }
+      else if (BitMaskedArray* y = kind_cast<BitMaskedArray>(raw)) {
+        return y->bytemask();
+      }
+      else if (UnmaskedArray* y = kind_cast<UnmaskedArray>(raw)) {
+        return y->bytemask();
+      }
+      throw std::runtime_error("unexpected option type in broadcast_and_apply");
+    }
+
+    const ContentPtr
+    option_project(const ContentPtr& x, const Index8& mask) {
+      Content* raw = x.get();
+      if (IndexedOptionArray32* y = kind_cast<IndexedOptionArray32>(raw)) {
+        return y->project(mask);
+      }
+      else if (IndexedOptionArray64* y =
+               kind_cast<IndexedOptionArray64>(raw)) {
+        return y->project(mask);
+      }
+      else if (ByteMaskedArray* y = kind_cast<ByteMaskedArray>(raw)) {
+        return y->project(mask);
+      }
+      else if (BitMaskedArray* y = kind_cast<BitMaskedArray>(raw)) {
+        return y->project(mask);
+      }
+      else if (UnmaskedArray* y = kind_cast<UnmaskedArray>(raw)) {
+        return y->project(mask);
+      }
+      throw std::runtime_error("unexpected option type in broadcast_and_apply");
+    }
+
+    const ContentPtr
+    indexed_project(const ContentPtr& x) {
+      Content* raw = x.get();
+      if (IndexedArray32* y = kind_cast<IndexedArray32>(raw)) {
+        return y->project();
+      }
+      else if (IndexedArrayU32* y = kind_cast<IndexedArrayU32>(raw)) {
+        return y->project();
+      }
+      else if (IndexedArray64* y = kind_cast<IndexedArray64>(raw)) {
+        return y->project();
+      }
+      throw std::runtime_error("unexpected indexed type in "
+                               "broadcast_and_apply");
+    }
+
+    const Index64
+    list_compact_offsets64(const ContentPtr& x) {
+      Content* raw = x.get();
+      if (ListArray32* y = kind_cast<ListArray32>(raw)) {
+        return y->compact_offsets64(true);
+      }
+      else if (ListArrayU32* y = kind_cast<ListArrayU32>(raw)) {
+        return y->compact_offsets64(true);
+      }
+      else if (ListArray64* y = kind_cast<ListArray64>(raw)) {
+        return y->compact_offsets64(true);
+      }
+      else if (ListOffsetArray32* y = kind_cast<ListOffsetArray32>(raw)) {
+        return y->compact_offsets64(true);
+      }
+      else if (ListOffsetArrayU32* y = kind_cast<ListOffsetArrayU32>(raw)) {
+        return y->compact_offsets64(true);
+      }
+      else if (ListOffsetArray64* y = kind_cast<ListOffsetArray64>(raw)) {
+        return y->compact_offsets64(true);
+      }
+      else if (RegularArray* y = kind_cast<RegularArray>(raw)) {
+        return y->compact_offsets64(true);
+      }
+      throw std::runtime_error("unexpected list type in broadcast_and_apply");
+    }
+
+    const ContentPtr
+    list_broadcast_tooffsets64(const ContentPtr& x, const Index64& offsets) {
+      Content* raw = x.get();
+      ContentPtr out(nullptr);
+      if (ListArray32* y = kind_cast<ListArray32>(raw)) {
+        out = y->broadcast_tooffsets64(offsets);
+      }
+      else if (ListArrayU32* y = kind_cast<ListArrayU32>(raw)) {
+        out = y->broadcast_tooffsets64(offsets);
+      }
+      else if (ListArray64* y = kind_cast<ListArray64>(raw)) {
+        out = y->broadcast_tooffsets64(offsets);
+      }
+      else if (ListOffsetArray32* y = kind_cast<ListOffsetArray32>(raw)) {
+        out = y->broadcast_tooffsets64(offsets);
+      }
+      else if (ListOffsetArrayU32* y = kind_cast<ListOffsetArrayU32>(raw)) {
+        out = y->broadcast_tooffsets64(offsets);
+      }
+      else if (ListOffsetArray64* y = kind_cast<ListOffsetArray64>(raw)) {
+        out = y->broadcast_tooffsets64(offsets);
+      }
+      else if (RegularArray* y = kind_cast<RegularArray>(raw)) {
+        out = y->broadcast_tooffsets64(offsets);
+      }
+      else {
+        throw std::runtime_error("unexpected list type in "
+                                 "broadcast_and_apply");
+      }
+      return kind_cast<ListOffsetArray64>(out.get())->content();
+    }
+
+    const ContentPtr
+    wrap_regular(const ContentPtr& x, int64_t size) {
+      return std::make_shared<RegularArray>(Identities::none(),
+                                            util::Parameters(),
+                                            x,
+                                            size);
+    }
+
+    void
+    check_parameters(const ContentPtr& x) {
+      util::Parameters parameters = x.get()->parameters();
+      for (auto key : { "__array__", "__record__" }) {
+        auto item = parameters.find(key);
+        if (item != parameters.end()  &&  item->second != "null") {
+          throw std::invalid_argument(
+            std::string("broadcast_and_apply does not apply behaviors; ")
+            + x.get()->classname() + std::string(" has parameter ") + key);
+        }
+      }
+    }
+
+    void
+    check_length(const ContentPtrVec& contents) {
+      int64_t length = contents[0].get()->length();
+      for (auto x : contents) {
+        if (x.get()->length() != length) {
+          throw std::invalid_argument(
+            std::string("cannot broadcast ")
+            + contents[0].get()->classname() + std::string(" of length ")
+            + std::to_string(length) + std::string(" with ")
+            + x.get()->classname() + std::string(" of length ")
+            + std::to_string(x.get()->length()));
+        }
+      }
+    }
+
+    const ContentPtr
+    apply(const ContentPtrVec& inputs, const Elementwise& function);
+
+    /// @brief If every non-scalar input is a ListOffsetArrayOf<T> with the
+    /// same offsets (such as the fields of a list of records), applies the
+    /// function to their contents without broadcasting and reuses the
+    /// offsets. Returns `nullptr` otherwise.
+    template <typename T>
+    const ContentPtr
+    apply_shared_offsets(const ContentPtrVec& inputs,
+                         const ContentPtrVec& contents,
+                         const Elementwise& function) {
+      ListOffsetArrayOf<T>* first =
+        kind_cast<ListOffsetArrayOf<T>>(contents[0].get());
+      if (first == nullptr) {
+        return ContentPtr(nullptr);
+      }
+      IndexOf<T> offsets = first->offsets();
+      for (auto x : contents) {
+        ListOffsetArrayOf<T>* raw = kind_cast<ListOffsetArrayOf<T>>(x.get());
+        if (raw == nullptr  ||
+            raw->offsets().ptr().get() != offsets.ptr().get()  ||
+            raw->offsets().offset() != offsets.offset()  ||
+            raw->offsets().length() != offsets.length()) {
+          return ContentPtr(nullptr);
+        }
+      }
+
+      int64_t start = (int64_t)offsets.getitem_at_nowrap(0);
+      int64_t stop =
+        (int64_t)offsets.getitem_at_nowrap(offsets.length() - 1);
+      ContentPtrVec nextinputs;
+      for (auto x : inputs) {
+        if (ListOffsetArrayOf<T>* raw =
+            kind_cast<ListOffsetArrayOf<T>>(x.get())) {
+          nextinputs.push_back(
+            raw->content().get()->getitem_range_nowrap(start, stop));
+        }
+        else {
+          nextinputs.push_back(x);
+        }
+      }
+      ContentPtr out = apply(nextinputs, function);
+      if (start == 0) {
+        return std::make_shared<ListOffsetArrayOf<T>>(Identities::none(),
+                                                      util::Parameters(),
+                                                      offsets,
+                                                      out);
+      }
+      else {
+        return std::make_shared<ListOffsetArray64>(
+          Identities::none(),
+          util::Parameters(),
+          first->compact_offsets64(true),
+          out);
+      }
+    }
+
+    const ContentPtr
+    apply(const ContentPtrVec& inputs, const Elementwise& function) {
+      ContentPtrVec contents;
+      for (auto x : inputs) {
+        if (!is_scalar(x)) {
+          contents.push_back(x);
+        }
+      }
+
+      // handle implicit right-broadcasting (i.e. NumPy-like)
+      bool any_list = false;
+      bool any_virtual = false;
+      bool all_regular = true;
+      int64_t maxdepth = 0;
+      for (auto x : contents) {
+        any_list = any_list  ||  is_list(x);
+        any_virtual = any_virtual  ||
+                      x.get()->kind() == Content::Kind::VirtualArray;
+      }
+      if (any_list  &&  !any_virtual) {
+        for (auto x : contents) {
+          if (!x.get()->purelist_isregular()) {
+            all_regular = false;
+            break;
+          }
+          maxdepth = std::max(maxdepth, x.get()->purelist_depth());
+        }
+        if (all_regular  &&  maxdepth > 0) {
+          bool changed = false;
+          ContentPtrVec nextinputs;
+          for (auto x : inputs) {
+            if (!is_scalar(x)) {
+              for (int64_t depth = x.get()->purelist_depth();
+                   depth < maxdepth;
+                   depth++) {
+                x = wrap_regular(x, 1);
+                changed = true;
+              }
+            }
+            nextinputs.push_back(x);
+          }
+          if (changed) {
+            return apply(nextinputs, function);
+          }
+        }
+      }
+
+      for (auto x : contents) {
+        check_parameters(x);
+      }
+
+      // now all lengths must agree
+      check_length(contents);
+
+      bool all_numpy = true;
+      bool same_shape = true;
+      for (auto x : contents) {
+        NumpyArray* raw = kind_cast<NumpyArray>(x.get());
+        if (raw == nullptr) {
+          all_numpy = false;
+          break;
+        }
+        if (raw->shape() !=
+            kind_cast<NumpyArray>(contents[0].get())->shape()) {
+          same_shape = false;
+        }
+      }
+
+      // the rest of this is one switch statement
+      if (all_numpy  &&  same_shape) {
+        std::vector<std::shared_ptr<NumpyArray>> arrays;
+        for (auto x : inputs) {
+          arrays.push_back(std::static_pointer_cast<NumpyArray>(x));
+        }
+        return function.apply(arrays);
+      }
+
+      ContentPtrVec nextinputs;
+
+      if (any_virtual) {
+        for (auto x : inputs) {
+          if (VirtualArray* raw = kind_cast<VirtualArray>(x.get())) {
+            nextinputs.push_back(raw->array());
+          }
+          else {
+            nextinputs.push_back(x);
+          }
+        }
+        return apply(nextinputs, function);
+      }
+
+      if (std::any_of(contents.begin(), contents.end(),
+                      [](const ContentPtr& x) -> bool {
+            return x.get()->kind() == Content::Kind::EmptyArray;
+          })) {
+        for (auto x : inputs) {
+          if (EmptyArray* raw = kind_cast<EmptyArray>(x.get())) {
+            nextinputs.push_back(raw->toNumpyArray(
+              util::dtype_to_format(util::dtype::boolean),
+              1,
+              util::dtype::boolean));
+          }
+          else {
+            nextinputs.push_back(x);
+          }
+        }
+        return apply(nextinputs, function);
+      }
+
+      if (std::any_of(contents.begin(), contents.end(),
+                      [](const ContentPtr& x) -> bool {
+            NumpyArray* raw = kind_cast<NumpyArray>(x.get());
+            return raw != nullptr  &&  raw->ndim() > 1;
+          })) {
+        for (auto x : inputs) {
+          NumpyArray* raw = kind_cast<NumpyArray>(x.get());
+          if (raw != nullptr  &&  raw->ndim() > 1) {
+            nextinputs.push_back(raw->toRegularArray());
+          }
+          else {
+            nextinputs.push_back(x);
+          }
+        }
+        return apply(nextinputs, function);
+      }
+
+      if (std::any_of(contents.begin(), contents.end(), is_indexed)) {
+        for (auto x : inputs) {
+          nextinputs.push_back(is_indexed(x) ? indexed_project(x) : x);
+        }
+        return apply(nextinputs, function);
+      }
+
+      if (std::any_of(contents.begin(), contents.end(), is_union)) {
+        throw std::invalid_argument(
+          "broadcast_and_apply does not broadcast unions");
+      }
+
+      if (std::any_of(contents.begin(), contents.end(), is_option)) {
+        int64_t length = contents[0].get()->length();
+        Index8 mask(length);
+        struct Error err = kernel::zero_mask8(mask.ptr().get(), length);
+        util::handle_error(err, "broadcast_and_apply", nullptr);
+        for (auto x : contents) {
+          if (is_option(x)) {
+            Index8 m = option_bytemask(x);
+            err = kernel::ByteMaskedArray_overlay_mask8(
+              mask.ptr().get(),
+              mask.ptr().get(),
+              mask.offset(),
+              m.ptr().get(),
+              m.offset(),
+              length,
+              false);
+            util::handle_error(err, x.get()->classname(), nullptr);
+          }
+        }
+
+        Index64 index(length);
+        Index64 carry(length);
+        err = kernel::ByteMaskedArray_getitem_nextcarry_outindex_64(
+          carry.ptr().get(),
+          index.ptr().get(),
+          mask.ptr().get(),
+          mask.offset(),
+          length,
+          false);
+        util::handle_error(err, "broadcast_and_apply", nullptr);
+
+        bool all_option =
+          std::all_of(contents.begin(), contents.end(), is_option);
+        Index64 nextindex(all_option ? 0 : length);
+        if (!all_option) {
+          err = kernel::ByteMaskedArray_toIndexedOptionArray64(
+            nextindex.ptr().get(),
+            mask.ptr().get(),
+            mask.offset(),
+            length,
+            false);
+          util::handle_error(err, "broadcast_and_apply", nullptr);
+        }
+
+        for (auto x : inputs) {
+          if (is_scalar(x)) {
+            nextinputs.push_back(x);
+          }
+          else if (is_option(x)) {
+            nextinputs.push_back(option_project(x, mask));
+          }
+          else {
+            IndexedOptionArray64 masked(Identities::none(),
+                                        util::Parameters(),
+                                        nextindex,
+                                        x);
+            nextinputs.push_back(masked.project(mask));
+          }
+        }
+
+        ContentPtr out = apply(nextinputs, function);
+        return IndexedOptionArray64(Identities::none(),
+                                    util::Parameters(),
+                                    index,
+                                    out).simplify_optiontype();
+      }
+
+      if (std::any_of(contents.begin(), contents.end(), is_list)) {
+        if (std::all_of(contents.begin(), contents.end(),
+                        [](const ContentPtr& x) -> bool {
+              return !is_list(x)  ||
+                     x.get()->kind() == Content::Kind::RegularArray;
+            })) {
+          int64_t maxsize = 0;
+          for (auto x : contents) {
+            if (RegularArray* raw = kind_cast<RegularArray>(x.get())) {
+              maxsize = std::max(maxsize, raw->size());
+            }
+          }
+          for (auto x : inputs) {
+            RegularArray* raw = kind_cast<RegularArray>(x.get());
+            if (raw == nullptr) {
+              nextinputs.push_back(x);
+            }
+            else if (maxsize > 1  &&  raw->size() == 1) {
+              Index64 offsets(raw->length() + 1);
+              struct Error err = kernel::RegularArray_compact_offsets_64(
+                offsets.ptr().get(),
+                raw->length(),
+                maxsize);
+              util::handle_error(err, raw->classname(), nullptr);
+              nextinputs.push_back(list_broadcast_tooffsets64(x, offsets));
+            }
+            else if (raw->size() == maxsize) {
+              nextinputs.push_back(raw->content().get()->getitem_range_nowrap(
+                0, raw->length() * raw->size()));
+            }
+            else {
+              throw std::invalid_argument(
+                std::string("cannot broadcast RegularArray of size ")
+                + std::to_string(raw->size())
+                + std::string(" with RegularArray of size ")
+                + std::to_string(maxsize));
+            }
+          }
+          return wrap_regular(apply(nextinputs, function), maxsize);
+        }
+
+        else {
+          ContentPtr out(nullptr);
+          switch (contents[0].get()->kind()) {
+            case Content::Kind::ListOffsetArray32:
+              out = apply_shared_offsets<int32_t>(inputs, contents, function);
+              break;
+            case Content::Kind::ListOffsetArrayU32:
+              out = apply_shared_offsets<uint32_t>(inputs, contents, function);
+              break;
+            case Content::Kind::ListOffsetArray64:
+              out = apply_shared_offsets<int64_t>(inputs, contents, function);
+              break;
+            default:
+              break;
+          }
+          if (out.get() != nullptr) {
+            return out;
+          }
+
+          ContentPtr first(nullptr);
+          for (auto x : contents) {
+            if (is_list(x)  &&
+                x.get()->kind() != Content::Kind::RegularArray) {
+              first = x;
+              break;
+            }
+          }
+          Index64 offsets = list_compact_offsets64(first);
+
+          for (auto x : inputs) {
+            if (is_scalar(x)) {
+              nextinputs.push_back(x);
+            }
+            else if (is_list(x)) {
+              nextinputs.push_back(list_broadcast_tooffsets64(x, offsets));
+            }
+            // handle implicit left-broadcasting (unlike NumPy)
+            else {
+              nextinputs.push_back(
+                list_broadcast_tooffsets64(wrap_regular(x, 1), offsets));
+            }
+          }
+          return std::make_shared<ListOffsetArray64>(
+            Identities::none(),
+            util::Parameters(),
+            offsets,
+            apply(nextinputs, function));
+        }
+      }
+
+      if (std::any_of(contents.begin(), contents.end(),
+                      [](const ContentPtr& x) -> bool {
+            return x.get()->kind() == Content::Kind::RecordArray;
+          })) {
+        std::vector<std::string> keys;
+        std::vector<std::string> sortedkeys;
+        int64_t length = -1;
+        bool istuple = true;
+        for (auto x : contents) {
+          if (RecordArray* raw = kind_cast<RecordArray>(x.get())) {
+            std::vector<std::string> xkeys = raw->keys();
+            std::sort(xkeys.begin(), xkeys.end());
+            if (length < 0) {
+              keys = raw->keys();
+              sortedkeys = xkeys;
+              length = raw->length();
+            }
+            else if (xkeys != sortedkeys) {
+              throw std::invalid_argument(
+                "cannot broadcast records because keys don't match");
+            }
+            else if (raw->length() != length) {
+              throw std::invalid_argument(
+                std::string("cannot broadcast RecordArray of length ")
+                + std::to_string(length)
+                + std::string(" with RecordArray of length ")
+                + std::to_string(raw->length()));
+            }
+            if (!raw->istuple()) {
+              istuple = false;
+            }
+          }
+        }
+
+        ContentPtrVec outcontents;
+        for (auto key : keys) {
+          ContentPtrVec fieldinputs;
+          for (auto x : inputs) {
+            if (x.get()->kind() == Content::Kind::RecordArray) {
+              fieldinputs.push_back(x.get()->getitem_field(key));
+            }
+            else {
+              fieldinputs.push_back(x);
+            }
+          }
+          outcontents.push_back(apply(fieldinputs, function));
+        }
+        util::RecordLookupPtr recordlookup(nullptr);
+        if (!istuple) {
+          recordlookup = std::make_shared<util::RecordLookup>(keys);
+        }
+        return std::make_shared<RecordArray>(Identities::none(),
+                                             util::Parameters(),
+                                             outcontents,
+                                             recordlookup,
+                                             length);
+      }
+
+      std::stringstream out;
+      out << "cannot broadcast: ";
+      for (size_t i = 0;  i < contents.size();  i++) {
+        out << (i == 0 ? "" : ", ") << contents[i].get()->classname();
+      }
+      throw std::invalid_argument(out.str());
+    }
+  }
+
+  const ContentPtr
+  broadcast_and_apply(const ContentPtrVec& inputs,
+                      const Elementwise& function) {
+    if ((int64_t)inputs.size() != function.numinputs()) {
+      throw std::invalid_argument(
+        function.name() + std::string(" takes ")
+        + std::to_string(function.numinputs()) + std::string(" inputs, not ")
+        + std::to_string(inputs.size()));
+    }
+    if (std::all_of(inputs.begin(), inputs.end(), is_scalar)) {
+      throw std::invalid_argument(
+        "broadcast_and_apply needs at least one array input");
+    }
+    return apply(inputs, function);
+  }
+}
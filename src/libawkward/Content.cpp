@@ -1,5 +1,6 @@
 // BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
 
+#include <atomic>
 #include <sstream>
 
 #include "rapidjson/document.h"
@@ -766,6 +767,42 @@ namespace awkward {
 
   ////////// Content
 
+  std::atomic<bool> content_lazy_carry{false};
+
+  bool
+  Content::lazy_carry() {
+    return content_lazy_carry.load();
+  }
+
+  void
+  Content::set_lazy_carry(bool lazy_carry) {
+    content_lazy_carry.store(lazy_carry);
+  }
+
+  std::shared_ptr<ArrayCache> content_memoize_projections(nullptr);
+  std::atomic<int64_t> content_projection_ids{0};
+
+  const std::shared_ptr<ArrayCache>
+  Content::memoize_projections() {
+    return std::atomic_load(&content_memoize_projections);
+  }
+
+  void
+  Content::set_memoize_projections(const std::shared_ptr<ArrayCache>& cache) {
+    std::atomic_store(&content_memoize_projections, cache);
+  }
+
+  int64_t
+  Content::newprojectionid() {
+    return content_projection_ids++;
+  }
+
+  const std::string
+  Content::projection_key(int64_t projectionid, int64_t index) {
+    return std::string("ak-projection-") + std::to_string(projectionid)
+           + std::string("-") + std::to_string(index);
+  }
+
   Content::Content(const IdentitiesPtr& identities,
                    const util::Parameters& parameters)
       : identities_(identities)
@@ -1077,6 +1114,49 @@ namespace awkward {
     return util::parameter_asstring(parameters_, key);
   }
 
+  const ContentPtr
+  Content::merge_many(const ContentPtrVec& others, bool mergebool) const {
+    // lists without offsets take the one-pass ListOffsetArray merge
+    ContentPtr out = shallow_copy();
+    ContentPtr list(nullptr);
+    if (ListArray32* raw = kind_cast<ListArray32>(out.get())) {
+      list = raw->toListOffsetArray64(true);
+    }
+    else if (ListArrayU32* raw = kind_cast<ListArrayU32>(out.get())) {
+      list = raw->toListOffsetArray64(true);
+    }
+    else if (ListArray64* raw = kind_cast<ListArray64>(out.get())) {
+      list = raw->toListOffsetArray64(true);
+    }
+    else if (RegularArray* raw = kind_cast<RegularArray>(out.get())) {
+      list = raw->toListOffsetArray64(true);
+    }
+    if (list.get() != nullptr) {
+      return list.get()->merge_many(others, mergebool);
+    }
+
+    for (auto other : others) {
+      if (out.get()->mergeable(other, mergebool)) {
+        out = out.get()->merge(other);
+      }
+      else {
+        out = out.get()->merge_as_union(other);
+      }
+      if (UnionArray8_32* raw = kind_cast<UnionArray8_32>(out.get())) {
+        out = raw->simplify_uniontype(mergebool);
+      }
+      else if (UnionArray8_U32* raw =
+               kind_cast<UnionArray8_U32>(out.get())) {
+        out = raw->simplify_uniontype(mergebool);
+      }
+      else if (UnionArray8_64* raw =
+               kind_cast<UnionArray8_64>(out.get())) {
+        out = raw->simplify_uniontype(mergebool);
+      }
+    }
+    return out;
+  }
+
   const ContentPtr
   Content::merge_as_union(const ContentPtr& other) const {
     int64_t mylength = length();
@@ -1210,6 +1290,19 @@ namespace awkward {
 
   const ContentPtr
   Content::getitem(const Slice& where) const {
+    if (where.length() == 1) {
+      SliceItemPtr head = where.head();
+      if (SliceMask* mask = dynamic_cast<SliceMask*>(head.get())) {
+        return getitem_mask(mask->mask());
+      }
+      if (SliceJagged64* jagged = dynamic_cast<SliceJagged64*>(head.get())) {
+        if (SliceMask* mask =
+            dynamic_cast<SliceMask*>(jagged->content().get())) {
+          return getitem_jagged_mask(jagged->offsets(), mask->mask());
+        }
+      }
+    }
+
     ContentPtr next = std::make_shared<RegularArray>(Identities::none(),
                                                      util::Parameters(),
                                                      shallow_copy(),
@@ -1229,6 +1322,46 @@ namespace awkward {
     }
   }
 
+  const ContentPtr
+  Content::getitem_mask(const Index8& mask) const {
+    if (mask.length() != length()) {
+      throw std::invalid_argument(
+        std::string("boolean mask of length ")
+        + std::to_string(mask.length())
+        + std::string(" does not match ") + classname()
+        + std::string(" of length ") + std::to_string(length()));
+    }
+
+    int64_t numnull;
+    struct Error err1 = kernel::ByteMaskedArray_numnull(
+      &numnull,
+      mask.ptr().get(),
+      mask.offset(),
+      mask.length(),
+      true);
+    util::handle_error(err1, classname(), identities_.get());
+
+    Index64 nextcarry(mask.length() - numnull);
+    struct Error err2 = kernel::ByteMaskedArray_getitem_nextcarry_64(
+      nextcarry.ptr().get(),
+      mask.ptr().get(),
+      mask.offset(),
+      mask.length(),
+      true);
+    util::handle_error(err2, classname(), identities_.get());
+
+    return carry(nextcarry, true);
+  }
+
+  const ContentPtr
+  Content::getitem_jagged_mask(const Index64& offsets,
+                               const Index8& mask) const {
+    Slice where;
+    where.append(SliceMask(mask).tojagged(offsets));
+    where.become_sealed();
+    return getitem(where);
+  }
+
   const ContentPtr
   Content::getitem_next(const SliceItemPtr& head,
                         const Slice& tail,
@@ -1270,8 +1403,15 @@ namespace awkward {
     }
     else if (SliceJagged64* jagged =
              dynamic_cast<SliceJagged64*>(head.get())) {
+      if (dynamic_cast<SliceMask*>(jagged->content().get())) {
+        return getitem_next(SliceMask::tostandard(head), tail, advanced);
+      }
       return getitem_next(*jagged, tail, advanced);
     }
+    else if (SliceMask* mask =
+             dynamic_cast<SliceMask*>(head.get())) {
+      return getitem_next(mask->toarray(), tail, advanced);
+    }
     else {
       throw std::runtime_error("unrecognized slice type");
     }
@@ -1451,7 +1591,7 @@ namespace awkward {
 
     ContentPtr next = getitem_next(missing.content(), tail, advanced);
 
-    if (RegularArray* raw = dynamic_cast<RegularArray*>(next.get())) {
+    if (RegularArray* raw = kind_cast<RegularArray>(next.get())) {
       return getitem_next_regular_missing(missing,
                                           tail,
                                           advanced,
@@ -1460,13 +1600,13 @@ namespace awkward {
                                           classname());
     }
 
-    else if (RecordArray* rec = dynamic_cast<RecordArray*>(next.get())) {
+    else if (RecordArray* rec = kind_cast<RecordArray>(next.get())) {
       if (rec->numfields() == 0) {
         return next;
       }
       ContentPtrVec contents;
       for (auto content : rec->contents()) {
-        if (RegularArray* raw = dynamic_cast<RegularArray*>(content.get())) {
+        if (RegularArray* raw = kind_cast<RegularArray>(content.get())) {
           contents.push_back(getitem_next_regular_missing(missing,
                                                           tail,
                                                           advanced,
@@ -1535,6 +1675,11 @@ namespace awkward {
     return out;
   }
 
+  const ContentPtr
+  Content::packed_carry(const Index64& nextcarry) const {
+    return carry(nextcarry, false).get()->packed();
+  }
+
   const std::string
   Content::parameters_tostring(const std::string& indent,
                                const std::string& pre,
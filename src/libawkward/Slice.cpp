@@ -5,6 +5,7 @@
 #include <type_traits>
 
 #include "awkward/cpu-kernels/getitem.h"
+#include "awkward/kernel.h"
 #include "awkward/util.h"
 
 #define AWKWARD_SLICE_NO_EXTERN_TEMPLATE
@@ -542,6 +543,112 @@ namespace awkward {
 
   template class EXPORT_SYMBOL SliceJaggedOf<int64_t>;
 
+  ////////// SliceMask
+
+  SliceMask::SliceMask(const Index8& mask)
+      : mask_(mask) { }
+
+  const Index8
+  SliceMask::mask() const {
+    return mask_;
+  }
+
+  int64_t
+  SliceMask::length() const {
+    return mask_.length();
+  }
+
+  const SliceItemPtr
+  SliceMask::toarray() const {
+    int64_t numtrue;
+    struct Error err1 = kernel::NumpyArray_getitem_boolean_numtrue(
+      &numtrue,
+      mask_.ptr().get(),
+      mask_.offset(),
+      mask_.length(),
+      1);
+    util::handle_error(err1, "SliceMask", nullptr);
+
+    Index64 index(numtrue);
+    struct Error err2 = kernel::NumpyArray_getitem_boolean_nonzero_64(
+      index.ptr().get(),
+      mask_.ptr().get(),
+      mask_.offset(),
+      mask_.length(),
+      1);
+    util::handle_error(err2, "SliceMask", nullptr);
+
+    std::vector<int64_t> shape({ numtrue });
+    std::vector<int64_t> strides({ 1 });
+    return std::make_shared<SliceArray64>(index, shape, strides, true);
+  }
+
+  const SliceItemPtr
+  SliceMask::tojagged(const Index64& offsets) const {
+    SliceItemPtr nonzeroitem = toarray();
+    SliceArray64* array = dynamic_cast<SliceArray64*>(nonzeroitem.get());
+    Index64 nonzero = array->index();
+    Index64 adjustedoffsets(offsets.length());
+    Index64 adjustednonzero(nonzero.length());
+    struct Error err = kernel::ListOffsetArray_getitem_adjust_offsets_64(
+      adjustedoffsets.ptr().get(),
+      adjustednonzero.ptr().get(),
+      offsets.ptr().get(),
+      offsets.offset(),
+      offsets.length() - 1,
+      nonzero.ptr().get(),
+      nonzero.offset(),
+      nonzero.length());
+    util::handle_error(err, "SliceMask", nullptr);
+
+    SliceItemPtr newarray = std::make_shared<SliceArray64>(
+      adjustednonzero, array->shape(), array->strides(), true);
+    return std::make_shared<SliceJagged64>(adjustedoffsets, newarray);
+  }
+
+  const SliceItemPtr
+  SliceMask::tostandard(const SliceItemPtr& item) {
+    if (SliceMask* mask = dynamic_cast<SliceMask*>(item.get())) {
+      return mask->toarray();
+    }
+    else if (SliceJagged64* jagged =
+             dynamic_cast<SliceJagged64*>(item.get())) {
+      if (SliceMask* mask = dynamic_cast<SliceMask*>(jagged->content().get())) {
+        return mask->tojagged(jagged->offsets());
+      }
+    }
+    return item;
+  }
+
+  const SliceItemPtr
+  SliceMask::shallow_copy() const {
+    return std::make_shared<SliceMask>(mask_);
+  }
+
+  const std::string
+  SliceMask::tostring() const {
+    std::stringstream out;
+    out << "mask([";
+    int64_t len = mask_.length();
+    for (int64_t i = 0;  i < len;  i++) {
+      if (len >= 6  &&  i == 3) {
+        out << ", ...";
+        i = len - 3;
+      }
+      if (i != 0) {
+        out << ", ";
+      }
+      out << (mask_.getitem_at_nowrap(i) != 0 ? "True" : "False");
+    }
+    out << "])";
+    return out.str();
+  }
+
+  bool
+  SliceMask::preserves_type(const Index64& advanced) const {
+    return true;
+  }
+
   ////////// Slice
 
   int64_t Slice::none() {
@@ -549,20 +656,31 @@ namespace awkward {
   }
 
   Slice::Slice()
-      : items_(std::vector<SliceItemPtr>())
+      : items_(std::make_shared<std::vector<SliceItemPtr>>())
+      , start_(0)
       , sealed_(false) { }
 
   Slice::Slice(const std::vector<SliceItemPtr>& items)
-      : items_(items)
+      : items_(std::make_shared<std::vector<SliceItemPtr>>(items))
+      , start_(0)
       , sealed_(false) { }
 
   Slice::Slice(const std::vector<SliceItemPtr>& items, bool sealed)
+      : items_(std::make_shared<std::vector<SliceItemPtr>>(items))
+      , start_(0)
+      , sealed_(sealed) { }
+
+  Slice::Slice(const std::shared_ptr<std::vector<SliceItemPtr>>& items,
+               size_t start,
+               bool sealed)
       : items_(items)
+      , start_(start)
       , sealed_(sealed) { }
 
   const std::vector<SliceItemPtr>
   Slice::items() const {
-    return items_;
+    return std::vector<SliceItemPtr>(items_.get()->begin() + (int64_t)start_,
+                                     items_.get()->end());
   }
 
   bool
@@ -572,20 +690,24 @@ namespace awkward {
 
   int64_t
   Slice::length() const {
-    return (int64_t)items_.size();
+    return (int64_t)(items_.get()->size() - start_);
   }
 
   int64_t
   Slice::dimlength() const {
     int64_t out = 0;
-    for (auto x : items_) {
-      if (dynamic_cast<SliceAt*>(x.get()) != nullptr) {
+    for (size_t i = start_;  i < items_.get()->size();  i++) {
+      SliceItem* x = (*items_.get())[i].get();
+      if (dynamic_cast<SliceAt*>(x) != nullptr) {
+        out += 1;
+      }
+      else if (dynamic_cast<SliceRange*>(x) != nullptr) {
         out += 1;
       }
-      else if (dynamic_cast<SliceRange*>(x.get()) != nullptr) {
+      else if (dynamic_cast<SliceArray64*>(x) != nullptr) {
         out += 1;
       }
-      else if (dynamic_cast<SliceArray64*>(x.get()) != nullptr) {
+      else if (dynamic_cast<SliceMask*>(x) != nullptr) {
         out += 1;
       }
     }
@@ -594,8 +716,8 @@ namespace awkward {
 
   const SliceItemPtr
   Slice::head() const {
-    if (!items_.empty()) {
-      return items_[0];
+    if (start_ < items_.get()->size()) {
+      return (*items_.get())[start_];
     }
     else {
       return SliceItemPtr(nullptr);
@@ -604,22 +726,25 @@ namespace awkward {
 
   const Slice
   Slice::tail() const {
-    std::vector<SliceItemPtr> items;
-    if (!items_.empty()) {
-      items.insert(items.end(), items_.begin() + 1, items_.end());
+    // shares the items, rather than copying them, because getitem_next
+    // takes the tail at every level of recursion
+    if (start_ < items_.get()->size()) {
+      return Slice(items_, start_ + 1, true);
+    }
+    else {
+      return Slice(items_, start_, true);
     }
-    return Slice(items, true);
   }
 
   const std::string
   Slice::tostring() const {
     std::stringstream out;
     out << "[";
-    for (size_t i = 0;  i < items_.size();  i++) {
-      if (i != 0) {
+    for (size_t i = start_;  i < items_.get()->size();  i++) {
+      if (i != start_) {
         out << ", ";
       }
-      out << items_[i].get()->tostring();
+      out << (*items_.get())[i].get()->tostring();
     }
     out << "]";
     return out.str();
@@ -627,8 +752,12 @@ namespace awkward {
 
   const Slice
   Slice::prepended(const SliceItemPtr& item) const {
-    std::vector<SliceItemPtr> items(items_);
+    std::vector<SliceItemPtr> items = this->items();
     items.insert(items.begin(), item);
+    // a SliceMask is only applied on its own
+    for (size_t i = 0;  i < items.size();  i++) {
+      items[i] = SliceMask::tostandard(items[i]);
+    }
     return Slice(items, true);
   }
 
@@ -637,52 +766,57 @@ namespace awkward {
     if (sealed_) {
       throw std::runtime_error("Slice::append when sealed_ == true");
     }
-    items_.push_back(item);
+    own_items().push_back(item);
   }
 
   void
   Slice::append(const SliceAt& item) {
-    items_.push_back(item.shallow_copy());
+    own_items().push_back(item.shallow_copy());
   }
 
   void
   Slice::append(const SliceRange& item) {
-    items_.push_back(item.shallow_copy());
+    own_items().push_back(item.shallow_copy());
   }
 
   void
   Slice::append(const SliceEllipsis& item) {
-    items_.push_back(item.shallow_copy());
+    own_items().push_back(item.shallow_copy());
   }
 
   void
   Slice::append(const SliceNewAxis& item) {
-    items_.push_back(item.shallow_copy());
+    own_items().push_back(item.shallow_copy());
   }
 
   void
   Slice::append(const SliceArray64& item) {
-    items_.push_back(item.shallow_copy());
+    own_items().push_back(item.shallow_copy());
   }
 
   void
   Slice::append(const SliceField& item) {
-    items_.push_back(item.shallow_copy());
+    own_items().push_back(item.shallow_copy());
   }
 
   void
   Slice::append(const SliceFields& item) {
-    items_.push_back(item.shallow_copy());
+    own_items().push_back(item.shallow_copy());
   }
 
   void
   Slice::append(const SliceMissing64& item) {
-    items_.push_back(item.shallow_copy());
+    own_items().push_back(item.shallow_copy());
   }
 
   void
   Slice::append(const SliceJagged64& item) {
-    items_.push_back(item.shallow_copy());
+    own_items().push_back(item.shallow_copy());
+  }
+
+  void
+  Slice::append(const SliceMask& item) {
+    own_items().push_back(item.shallow_copy());
   }
 
   void
@@ -690,10 +824,18 @@ namespace awkward {
     if (sealed_) {
       throw std::runtime_error("Slice::become_sealed when sealed_ == true");
     }
+    std::vector<SliceItemPtr>& items = own_items();
+
+    // a SliceMask is only applied on its own
+    if (items.size() != 1) {
+      for (size_t i = 0;  i < items.size();  i++) {
+        items[i] = SliceMask::tostandard(items[i]);
+      }
+    }
 
     std::vector<int64_t> shape;
-    for (size_t i = 0;  i < items_.size();  i++) {
-      if (SliceArray64* array = dynamic_cast<SliceArray64*>(items_[i].get())) {
+    for (size_t i = 0;  i < items.size();  i++) {
+      if (SliceArray64* array = dynamic_cast<SliceArray64*>(items[i].get())) {
         if (shape.empty()) {
           shape = array->shape();
         }
@@ -715,21 +857,21 @@ namespace awkward {
     }
 
     if (!shape.empty()) {
-      for (size_t i = 0;  i < items_.size();  i++) {
-        if (SliceAt* at = dynamic_cast<SliceAt*>(items_[i].get())) {
+      for (size_t i = 0;  i < items.size();  i++) {
+        if (SliceAt* at = dynamic_cast<SliceAt*>(items[i].get())) {
           Index64 index(1);
           index.setitem_at_nowrap(0, at->at());
           std::vector<int64_t> strides;
           for (size_t j = 0;  j < shape.size();  j++) {
             strides.push_back(0);
           }
-          items_[i] = std::make_shared<SliceArray64>(index,
+          items[i] = std::make_shared<SliceArray64>(index,
                                                      shape,
                                                      strides,
                                                      false);
         }
         else if (SliceArray64* array =
-                 dynamic_cast<SliceArray64*>(items_[i].get())) {
+                 dynamic_cast<SliceArray64*>(items[i].get())) {
           std::vector<int64_t> arrayshape = array->shape();
           std::vector<int64_t> arraystrides = array->strides();
           std::vector<int64_t> strides;
@@ -744,7 +886,7 @@ namespace awkward {
               throw std::invalid_argument("cannot broadcast arrays in slice");
             }
           }
-          items_[i] = std::make_shared<SliceArray64>(array->index(),
+          items[i] = std::make_shared<SliceArray64>(array->index(),
                                                      shape,
                                                      strides,
                                                      array->frombool());
@@ -752,32 +894,32 @@ namespace awkward {
       }
 
       std::string types;
-      for (size_t i = 0;  i < items_.size();  i++) {
-        if (dynamic_cast<SliceAt*>(items_[i].get()) != nullptr) {
+      for (size_t i = 0;  i < items.size();  i++) {
+        if (dynamic_cast<SliceAt*>(items[i].get()) != nullptr) {
           types.push_back('@');
         }
-        else if (dynamic_cast<SliceRange*>(items_[i].get()) != nullptr) {
+        else if (dynamic_cast<SliceRange*>(items[i].get()) != nullptr) {
           types.push_back(':');
         }
-        else if (dynamic_cast<SliceEllipsis*>(items_[i].get()) != nullptr) {
+        else if (dynamic_cast<SliceEllipsis*>(items[i].get()) != nullptr) {
           types.push_back('.');
         }
-        else if (dynamic_cast<SliceNewAxis*>(items_[i].get()) != nullptr) {
+        else if (dynamic_cast<SliceNewAxis*>(items[i].get()) != nullptr) {
           types.push_back('1');
         }
-        else if (dynamic_cast<SliceArray64*>(items_[i].get()) != nullptr) {
+        else if (dynamic_cast<SliceArray64*>(items[i].get()) != nullptr) {
           types.push_back('A');
         }
-        else if (dynamic_cast<SliceField*>(items_[i].get()) != nullptr) {
+        else if (dynamic_cast<SliceField*>(items[i].get()) != nullptr) {
           types.push_back('"');
         }
-        else if (dynamic_cast<SliceFields*>(items_[i].get()) != nullptr) {
+        else if (dynamic_cast<SliceFields*>(items[i].get()) != nullptr) {
           types.push_back('[');
         }
-        else if (dynamic_cast<SliceMissing64*>(items_[i].get()) != nullptr) {
+        else if (dynamic_cast<SliceMissing64*>(items[i].get()) != nullptr) {
           types.push_back('?');
         }
-        else if (dynamic_cast<SliceJagged64*>(items_[i].get()) != nullptr) {
+        else if (dynamic_cast<SliceJagged64*>(items[i].get()) != nullptr) {
           types.push_back('J');
         }
       }
@@ -807,11 +949,22 @@ namespace awkward {
     if (!sealed_) {
       throw std::runtime_error("Slice::isadvanced when sealed_ == false");
     }
-    for (size_t i = 0;  i < items_.size();  i++) {
-      if (dynamic_cast<SliceArray64*>(items_[i].get()) != nullptr) {
+    for (size_t i = start_;  i < items_.get()->size();  i++) {
+      if (dynamic_cast<SliceArray64*>((*items_.get())[i].get()) != nullptr  ||
+          dynamic_cast<SliceMask*>((*items_.get())[i].get()) != nullptr) {
         return true;
       }
     }
     return false;
   }
+
+  std::vector<SliceItemPtr>&
+  Slice::own_items() {
+    // copy-on-write: the items may be shared with other Slices
+    if (start_ != 0  ||  items_.use_count() > 1) {
+      items_ = std::make_shared<std::vector<SliceItemPtr>>(items());
+      start_ = 0;
+    }
+    return *items_.get();
+  }
 }
@@ -14,6 +14,8 @@
 #include "awkward/array/EmptyArray.h"
 #include "awkward/array/UnionArray.h"
 #include "awkward/array/NumpyArray.h"
+#include "awkward/array/RegularArray.h"
+#include "awkward/array/ListOffsetArray.h"
 #include "awkward/array/IndexedArray.h"
 #include "awkward/array/ByteMaskedArray.h"
 #include "awkward/array/UnmaskedArray.h"
@@ -232,7 +234,27 @@ namespace awkward {
 
   const ContentPtr
   BitMaskedArray::project() const {
-    return toByteMaskedArray().get()->project();
+    int64_t numnull;
+    struct Error err1 = kernel::BitMaskedArray_numnull(
+      &numnull,
+      mask_.ptr().get(),
+      mask_.offset(),
+      length_,
+      valid_when_,
+      lsb_order_);
+    util::handle_error(err1, classname(), identities_.get());
+
+    Index64 nextcarry(length_ - numnull);
+    struct Error err2 = kernel::BitMaskedArray_getitem_nextcarry_64(
+      nextcarry.ptr().get(),
+      mask_.ptr().get(),
+      mask_.offset(),
+      length_,
+      valid_when_,
+      lsb_order_);
+    util::handle_error(err2, classname(), identities_.get());
+
+    return content_.get()->carry(nextcarry, false);
   }
 
   const ContentPtr
@@ -256,17 +278,17 @@ namespace awkward {
 
   const ContentPtr
   BitMaskedArray::simplify_optiontype() const {
-    if (dynamic_cast<IndexedArray32*>(content_.get())        ||
-        dynamic_cast<IndexedArrayU32*>(content_.get())       ||
-        dynamic_cast<IndexedArray64*>(content_.get())        ||
-        dynamic_cast<IndexedOptionArray32*>(content_.get())  ||
-        dynamic_cast<IndexedOptionArray64*>(content_.get())  ||
-        dynamic_cast<ByteMaskedArray*>(content_.get())       ||
-        dynamic_cast<BitMaskedArray*>(content_.get())        ||
-        dynamic_cast<UnmaskedArray*>(content_.get())) {
+    if (kind_cast<IndexedArray32>(content_.get())        ||
+        kind_cast<IndexedArrayU32>(content_.get())       ||
+        kind_cast<IndexedArray64>(content_.get())        ||
+        kind_cast<IndexedOptionArray32>(content_.get())  ||
+        kind_cast<IndexedOptionArray64>(content_.get())  ||
+        kind_cast<ByteMaskedArray>(content_.get())       ||
+        kind_cast<BitMaskedArray>(content_.get())        ||
+        kind_cast<UnmaskedArray>(content_.get())) {
       ContentPtr step1 = toIndexedOptionArray64();
       IndexedOptionArray64* step2 =
-        dynamic_cast<IndexedOptionArray64*>(step1.get());
+        kind_cast<IndexedOptionArray64>(step1.get());
       return step2->simplify_optiontype();
     }
     else {
@@ -316,6 +338,11 @@ namespace awkward {
     return "BitMaskedArray";
   }
 
+  Content::Kind
+  BitMaskedArray::kind() const {
+    return Kind::BitMaskedArray;
+  }
+
   void
   BitMaskedArray::setidentities(const IdentitiesPtr& identities) {
     if (identities.get() == nullptr) {
@@ -632,12 +659,77 @@ namespace awkward {
   BitMaskedArray::getitem_next(const SliceItemPtr& head,
                                const Slice& tail,
                                const Index64& advanced) const {
-    return toByteMaskedArray().get()->getitem_next(head, tail, advanced);
+    if (head.get() == nullptr) {
+      return shallow_copy();
+    }
+    else if (dynamic_cast<SliceAt*>(head.get())  ||
+             dynamic_cast<SliceRange*>(head.get())  ||
+             dynamic_cast<SliceArray64*>(head.get())  ||
+             dynamic_cast<SliceJagged64*>(head.get())) {
+      int64_t numnull;
+      std::pair<Index64, Index64> pair = nextcarry_outindex(numnull);
+      Index64 nextcarry = pair.first;
+      Index64 outindex = pair.second;
+
+      ContentPtr next = content_.get()->carry(nextcarry, true);
+
+      ContentPtr out = next.get()->getitem_next(head, tail, advanced);
+      IndexedOptionArray64 out2(identities_, parameters_, outindex, out);
+      return out2.simplify_optiontype();
+    }
+    else if (SliceEllipsis* ellipsis =
+             dynamic_cast<SliceEllipsis*>(head.get())) {
+      return Content::getitem_next(*ellipsis, tail, advanced);
+    }
+    else if (SliceNewAxis* newaxis =
+             dynamic_cast<SliceNewAxis*>(head.get())) {
+      return Content::getitem_next(*newaxis, tail, advanced);
+    }
+    else if (SliceField* field =
+             dynamic_cast<SliceField*>(head.get())) {
+      return Content::getitem_next(*field, tail, advanced);
+    }
+    else if (SliceFields* fields =
+             dynamic_cast<SliceFields*>(head.get())) {
+      return Content::getitem_next(*fields, tail, advanced);
+    }
+    else if (SliceMissing64* missing =
+             dynamic_cast<SliceMissing64*>(head.get())) {
+      return Content::getitem_next(*missing, tail, advanced);
+    }
+    else {
+      throw std::runtime_error("unrecognized slice type");
+    }
   }
 
   const ContentPtr
   BitMaskedArray::carry(const Index64& carry, bool allow_lazy) const {
-    return toByteMaskedArray().get()->carry(carry, allow_lazy);
+    int64_t bytelength = carry.length() / 8;
+    if (carry.length() % 8 != 0) {
+      bytelength++;
+    }
+    IndexU8 nextmask(bytelength);
+    struct Error err = kernel::BitMaskedArray_getitem_carry_64(
+      nextmask.ptr().get(),
+      mask_.ptr().get(),
+      mask_.offset(),
+      length_,
+      carry.ptr().get(),
+      carry.length(),
+      lsb_order_);
+    util::handle_error(err, classname(), identities_.get());
+    IdentitiesPtr identities(nullptr);
+    if (identities_.get() != nullptr) {
+      identities = identities_.get()->getitem_carry_64(carry);
+    }
+    return std::make_shared<BitMaskedArray>(
+      identities,
+      parameters_,
+      nextmask,
+      content_.get()->carry(carry, allow_lazy),
+      valid_when_,
+      carry.length(),
+      lsb_order_);
   }
 
   int64_t
@@ -675,6 +767,54 @@ namespace awkward {
     return simplify_optiontype();
   }
 
+  const ContentPtr
+  BitMaskedArray::packed() const {
+    int64_t bytelength = length_ / 8;
+    if (length_ % 8 != 0) {
+      bytelength++;
+    }
+    IndexU8 mask = mask_.getitem_range_nowrap(0, bytelength).deep_copy();
+    ContentPtr content =
+      content_.get()->getitem_range_nowrap(0, length_).get()->packed();
+    return std::make_shared<BitMaskedArray>(identities_,
+                                            parameters_,
+                                            mask,
+                                            content,
+                                            valid_when_,
+                                            length_,
+                                            lsb_order_);
+  }
+
+  const ContentPtr
+  BitMaskedArray::packed_carry(const Index64& nextcarry) const {
+    int64_t bytelength = nextcarry.length() / 8;
+    if (nextcarry.length() % 8 != 0) {
+      bytelength++;
+    }
+    IndexU8 nextmask(bytelength);
+    struct Error err = kernel::BitMaskedArray_getitem_carry_64(
+      nextmask.ptr().get(),
+      mask_.ptr().get(),
+      mask_.offset(),
+      length_,
+      nextcarry.ptr().get(),
+      nextcarry.length(),
+      lsb_order_);
+    util::handle_error(err, classname(), identities_.get());
+    IdentitiesPtr identities(nullptr);
+    if (identities_.get() != nullptr) {
+      identities = identities_.get()->getitem_carry_64(nextcarry);
+    }
+    return std::make_shared<BitMaskedArray>(
+      identities,
+      parameters_,
+      nextmask,
+      content_.get()->packed_carry(nextcarry),
+      valid_when_,
+      nextcarry.length(),
+      lsb_order_);
+  }
+
   const ContentPtr
   BitMaskedArray::num(int64_t axis, int64_t depth) const {
     return toByteMaskedArray().get()->num(axis, depth);
@@ -687,7 +827,7 @@ namespace awkward {
 
   bool
   BitMaskedArray::mergeable(const ContentPtr& other, bool mergebool) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return mergeable(raw->array(), mergebool);
     }
 
@@ -695,43 +835,43 @@ namespace awkward {
       return false;
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())  ||
-        dynamic_cast<UnionArray8_32*>(other.get())  ||
-        dynamic_cast<UnionArray8_U32*>(other.get())  ||
-        dynamic_cast<UnionArray8_64*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())  ||
+        kind_cast<UnionArray8_32>(other.get())  ||
+        kind_cast<UnionArray8_U32>(other.get())  ||
+        kind_cast<UnionArray8_64>(other.get())) {
       return true;
     }
 
     if (IndexedArray32* rawother =
-        dynamic_cast<IndexedArray32*>(other.get())) {
+        kind_cast<IndexedArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else {
@@ -743,7 +883,7 @@ namespace awkward {
   BitMaskedArray::reverse_merge(const ContentPtr& other) const {
     ContentPtr indexedoptionarray = toIndexedOptionArray64();
     IndexedOptionArray64* raw =
-      dynamic_cast<IndexedOptionArray64*>(indexedoptionarray.get());
+      kind_cast<IndexedOptionArray64>(indexedoptionarray.get());
     return raw->reverse_merge(other);
   }
 
@@ -782,13 +922,83 @@ namespace awkward {
                               int64_t outlength,
                               bool mask,
                               bool keepdims) const {
-    return toByteMaskedArray().get()->reduce_next(reducer,
-                                                  negaxis,
-                                                  starts,
-                                                  parents,
-                                                  outlength,
-                                                  mask,
-                                                  keepdims);
+    int64_t numnull;
+    struct Error err1 = kernel::BitMaskedArray_numnull(
+      &numnull,
+      mask_.ptr().get(),
+      mask_.offset(),
+      length_,
+      valid_when_,
+      lsb_order_);
+    util::handle_error(err1, classname(), identities_.get());
+
+    Index64 nextparents(length_ - numnull);
+    Index64 nextcarry(length_ - numnull);
+    Index64 outindex(length_);
+    struct Error err2 = kernel::BitMaskedArray_reduce_next_64(
+      nextcarry.ptr().get(),
+      nextparents.ptr().get(),
+      outindex.ptr().get(),
+      mask_.ptr().get(),
+      mask_.offset(),
+      parents.ptr().get(),
+      parents.offset(),
+      length_,
+      valid_when_,
+      lsb_order_);
+    util::handle_error(err2, classname(), identities_.get());
+
+    ContentPtr next = content_.get()->carry(nextcarry, false);
+    ContentPtr out = next.get()->reduce_next(reducer,
+                                             negaxis,
+                                             starts,
+                                             nextparents,
+                                             outlength,
+                                             mask,
+                                             keepdims);
+
+    std::pair<bool, int64_t> branchdepth = branch_depth();
+    if (!branchdepth.first  &&  negaxis == branchdepth.second) {
+      return out;
+    }
+    else {
+      if (RegularArray* raw =
+          kind_cast<RegularArray>(out.get())) {
+        out = raw->toListOffsetArray64(true);
+      }
+      if (ListOffsetArray64* raw =
+          kind_cast<ListOffsetArray64>(out.get())) {
+        Index64 outoffsets(starts.length() + 1);
+        if (starts.length() > 0  &&  starts.getitem_at_nowrap(0) != 0) {
+          throw std::runtime_error(
+            "reduce_next with unbranching depth > negaxis expects "
+            "a ListOffsetArray64 whose offsets start at zero");
+        }
+        struct Error err3 = kernel::IndexedArray_reduce_next_fix_offsets_64(
+          outoffsets.ptr().get(),
+          starts.ptr().get(),
+          starts.offset(),
+          starts.length(),
+          outindex.length());
+        util::handle_error(err3, classname(), identities_.get());
+
+        return std::make_shared<ListOffsetArray64>(
+          raw->identities(),
+          raw->parameters(),
+          outoffsets,
+          std::make_shared<IndexedOptionArray64>(Identities::none(),
+                                                 util::Parameters(),
+                                                 outindex,
+                                                 raw->content()));
+      }
+      else {
+        throw std::runtime_error(
+          std::string("reduce_next with unbranching depth > negaxis is only "
+                      "expected to return RegularArray or ListOffsetArray64; "
+                      "instead, it returned ")
+          + out.get()->classname());
+      }
+    }
   }
 
   const ContentPtr
@@ -882,10 +1092,10 @@ namespace awkward {
                                       const Index64& slicestops,
                                       const SliceArray64& slicecontent,
                                       const Slice& tail) const {
-    return toByteMaskedArray().get()->getitem_next_jagged(slicestarts,
-                                                          slicestops,
-                                                          slicecontent,
-                                                          tail);
+    return getitem_next_jagged_generic<SliceArray64>(slicestarts,
+                                                     slicestops,
+                                                     slicecontent,
+                                                     tail);
   }
 
   const ContentPtr
@@ -893,10 +1103,10 @@ namespace awkward {
                                       const Index64& slicestops,
                                       const SliceMissing64& slicecontent,
                                       const Slice& tail) const {
-    return toByteMaskedArray().get()->getitem_next_jagged(slicestarts,
-                                                          slicestops,
-                                                          slicecontent,
-                                                          tail);
+    return getitem_next_jagged_generic<SliceMissing64>(slicestarts,
+                                                       slicestops,
+                                                       slicecontent,
+                                                       tail);
   }
 
   const ContentPtr
@@ -904,10 +1114,10 @@ namespace awkward {
                                       const Index64& slicestops,
                                       const SliceJagged64& slicecontent,
                                       const Slice& tail) const {
-    return toByteMaskedArray().get()->getitem_next_jagged(slicestarts,
-                                                          slicestops,
-                                                          slicecontent,
-                                                          tail);
+    return getitem_next_jagged_generic<SliceJagged64>(slicestarts,
+                                                      slicestops,
+                                                      slicecontent,
+                                                      tail);
   }
 
   const ContentPtr
@@ -922,4 +1132,55 @@ namespace awkward {
                                             length(),
                                             lsb_order());
   }
+
+  template <typename S>
+  const ContentPtr BitMaskedArray::getitem_next_jagged_generic(
+      const Index64& slicestarts, const Index64& slicestops,
+      const S& slicecontent, const Slice& tail) const {
+    int64_t numnull;
+    std::pair<Index64, Index64> pair = nextcarry_outindex(numnull);
+    Index64 nextcarry = pair.first;
+    Index64 outindex = pair.second;
+
+    Index64 reducedstarts(length_ - numnull);
+    Index64 reducedstops(length_ - numnull);
+    struct Error err = kernel::MaskedArray_getitem_next_jagged_project<int64_t>(
+        outindex.ptr().get(), outindex.offset(), slicestarts.ptr().get(),
+        slicestarts.offset(), slicestops.ptr().get(), slicestops.offset(),
+        reducedstarts.ptr().get(), reducedstops.ptr().get(), length_);
+    util::handle_error(err, classname(), identities_.get());
+
+    ContentPtr next = content_.get()->carry(nextcarry, true);
+    ContentPtr out = next.get()->getitem_next_jagged(
+        reducedstarts, reducedstops, slicecontent, tail);
+    IndexedOptionArray64 out2(identities_, parameters_, outindex, out);
+    return out2.simplify_optiontype();
+  }
+
+  const std::pair<Index64, Index64>
+  BitMaskedArray::nextcarry_outindex(int64_t& numnull) const {
+    struct Error err1 = kernel::BitMaskedArray_numnull(
+      &numnull,
+      mask_.ptr().get(),
+      mask_.offset(),
+      length_,
+      valid_when_,
+      lsb_order_);
+    util::handle_error(err1, classname(), identities_.get());
+
+    Index64 nextcarry(length_ - numnull);
+    Index64 outindex(length_);
+    struct Error err2 = kernel::BitMaskedArray_getitem_nextcarry_outindex_64(
+      nextcarry.ptr().get(),
+      outindex.ptr().get(),
+      mask_.ptr().get(),
+      mask_.offset(),
+      length_,
+      valid_when_,
+      lsb_order_);
+    util::handle_error(err2, classname(), identities_.get());
+
+    return std::pair<Index64, Index64>(nextcarry, outindex);
+  }
+
 }
@@ -278,17 +278,17 @@ namespace awkward {
 
   const ContentPtr
   ByteMaskedArray::simplify_optiontype() const {
-    if (dynamic_cast<IndexedArray32*>(content_.get())        ||
-        dynamic_cast<IndexedArrayU32*>(content_.get())       ||
-        dynamic_cast<IndexedArray64*>(content_.get())        ||
-        dynamic_cast<IndexedOptionArray32*>(content_.get())  ||
-        dynamic_cast<IndexedOptionArray64*>(content_.get())  ||
-        dynamic_cast<ByteMaskedArray*>(content_.get())       ||
-        dynamic_cast<BitMaskedArray*>(content_.get())        ||
-        dynamic_cast<UnmaskedArray*>(content_.get())) {
+    if (kind_cast<IndexedArray32>(content_.get())        ||
+        kind_cast<IndexedArrayU32>(content_.get())       ||
+        kind_cast<IndexedArray64>(content_.get())        ||
+        kind_cast<IndexedOptionArray32>(content_.get())  ||
+        kind_cast<IndexedOptionArray64>(content_.get())  ||
+        kind_cast<ByteMaskedArray>(content_.get())       ||
+        kind_cast<BitMaskedArray>(content_.get())        ||
+        kind_cast<UnmaskedArray>(content_.get())) {
       ContentPtr step1 = toIndexedOptionArray64();
       IndexedOptionArray64* step2 =
-        dynamic_cast<IndexedOptionArray64*>(step1.get());
+        kind_cast<IndexedOptionArray64>(step1.get());
       return step2->simplify_optiontype();
     }
     else {
@@ -317,6 +317,11 @@ namespace awkward {
     return "ByteMaskedArray";
   }
 
+  Content::Kind
+  ByteMaskedArray::kind() const {
+    return Kind::ByteMaskedArray;
+  }
+
   void
   ByteMaskedArray::setidentities(const IdentitiesPtr& identities) {
     if (identities.get() == nullptr) {
@@ -705,6 +710,41 @@ namespace awkward {
     return simplify_optiontype();
   }
 
+  const ContentPtr
+  ByteMaskedArray::packed() const {
+    int64_t len = length();
+    ContentPtr content =
+      content_.get()->getitem_range_nowrap(0, len).get()->packed();
+    return std::make_shared<ByteMaskedArray>(identities_,
+                                             parameters_,
+                                             mask_.deep_copy(),
+                                             content,
+                                             valid_when_);
+  }
+
+  const ContentPtr
+  ByteMaskedArray::packed_carry(const Index64& nextcarry) const {
+    Index8 nextmask(nextcarry.length());
+    struct Error err = kernel::ByteMaskedArray_getitem_carry_64(
+      nextmask.ptr().get(),
+      mask_.ptr().get(),
+      mask_.offset(),
+      mask_.length(),
+      nextcarry.ptr().get(),
+      nextcarry.length());
+    util::handle_error(err, classname(), identities_.get());
+    IdentitiesPtr identities(nullptr);
+    if (identities_.get() != nullptr) {
+      identities = identities_.get()->getitem_carry_64(nextcarry);
+    }
+    return std::make_shared<ByteMaskedArray>(
+      identities,
+      parameters_,
+      nextmask,
+      content_.get()->packed_carry(nextcarry),
+      valid_when_);
+  }
+
   const ContentPtr
   ByteMaskedArray::num(int64_t axis, int64_t depth) const {
     int64_t posaxis = axis_wrap_if_negative(axis);
@@ -776,7 +816,7 @@ namespace awkward {
 
   bool
   ByteMaskedArray::mergeable(const ContentPtr& other, bool mergebool) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return mergeable(raw->array(), mergebool);
     }
 
@@ -784,43 +824,43 @@ namespace awkward {
       return false;
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())  ||
-        dynamic_cast<UnionArray8_32*>(other.get())  ||
-        dynamic_cast<UnionArray8_U32*>(other.get())  ||
-        dynamic_cast<UnionArray8_64*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())  ||
+        kind_cast<UnionArray8_32>(other.get())  ||
+        kind_cast<UnionArray8_U32>(other.get())  ||
+        kind_cast<UnionArray8_64>(other.get())) {
       return true;
     }
 
     if (IndexedArray32* rawother =
-        dynamic_cast<IndexedArray32*>(other.get())) {
+        kind_cast<IndexedArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else {
@@ -832,7 +872,7 @@ namespace awkward {
   ByteMaskedArray::reverse_merge(const ContentPtr& other) const {
     ContentPtr indexedoptionarray = toIndexedOptionArray64();
     IndexedOptionArray64* raw =
-      dynamic_cast<IndexedOptionArray64*>(indexedoptionarray.get());
+      kind_cast<IndexedOptionArray64>(indexedoptionarray.get());
     return raw->reverse_merge(other);
   }
 
@@ -966,11 +1006,11 @@ namespace awkward {
     }
     else {
       if (RegularArray* raw =
-          dynamic_cast<RegularArray*>(out.get())) {
+          kind_cast<RegularArray>(out.get())) {
         out = raw->toListOffsetArray64(true);
       }
       if (ListOffsetArray64* raw =
-          dynamic_cast<ListOffsetArray64*>(out.get())) {
+          kind_cast<ListOffsetArray64>(out.get())) {
         Index64 outoffsets(starts.length() + 1);
         if (starts.length() > 0  &&  starts.getitem_at_nowrap(0) != 0) {
           throw std::runtime_error(
@@ -1108,11 +1148,11 @@ namespace awkward {
     }
     else {
       if (RegularArray* raw =
-          dynamic_cast<RegularArray*>(out.get())) {
+          kind_cast<RegularArray>(out.get())) {
         out = raw->toListOffsetArray64(true);
       }
       if (ListOffsetArray64* raw =
-          dynamic_cast<ListOffsetArray64*>(out.get())) {
+          kind_cast<ListOffsetArray64>(out.get())) {
         Index64 outoffsets(starts.length() + 1);
         if (starts.length() > 0  &&  starts.getitem_at_nowrap(0) != 0) {
           throw std::runtime_error(
@@ -1193,11 +1233,11 @@ namespace awkward {
     }
     else {
       if (RegularArray* raw =
-          dynamic_cast<RegularArray*>(out.get())) {
+          kind_cast<RegularArray>(out.get())) {
         out = raw->toListOffsetArray64(true);
       }
       if (ListOffsetArray64* raw =
-          dynamic_cast<ListOffsetArray64*>(out.get())) {
+          kind_cast<ListOffsetArray64>(out.get())) {
         Index64 outoffsets(starts.length() + 1);
         if (starts.length() > 0  &&  starts.getitem_at_nowrap(0) != 0) {
           throw std::runtime_error(
@@ -155,6 +155,11 @@ namespace awkward {
     return "EmptyArray";
   }
 
+  Content::Kind
+  EmptyArray::kind() const {
+    return Kind::EmptyArray;
+  }
+
   void
   EmptyArray::setidentities(const IdentitiesPtr& identities) {
     if (identities.get() != nullptr  &&
@@ -350,6 +355,11 @@ namespace awkward {
     return shallow_copy();
   }
 
+  const ContentPtr
+  EmptyArray::packed() const {
+    return shallow_copy();
+  }
+
   const ContentPtr
   EmptyArray::num(int64_t axis, int64_t depth) const {
     int64_t posaxis = axis_wrap_if_negative(axis);
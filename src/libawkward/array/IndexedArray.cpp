@@ -337,7 +337,8 @@ namespace awkward {
     const ContentPtr& content)
       : Content(identities, parameters)
       , index_(index)
-      , content_(content) { }
+      , content_(content)
+      , projectionid_(newprojectionid()) { }
 
   template <typename T, bool ISOPTION>
   const IndexOf<T>
@@ -360,6 +361,17 @@ namespace awkward {
   template <typename T, bool ISOPTION>
   const ContentPtr
   IndexedArrayOf<T, ISOPTION>::project() const {
+    ArrayCachePtr cache = Content::memoize_projections();
+    std::string key;
+    if (cache.get() != nullptr) {
+      key = projection_key(projectionid_, 0);
+      ContentPtr memo = cache.get()->get(key);
+      if (memo.get() != nullptr) {
+        return memo.get()->shallow_copy();
+      }
+    }
+
+    ContentPtr out(nullptr);
     if (ISOPTION) {
       int64_t numnull;
       struct Error err1 = kernel::IndexedArray_numnull<T>(
@@ -378,7 +390,7 @@ namespace awkward {
         content_.get()->length());
       util::handle_error(err2, classname(), identities_.get());
 
-      return content_.get()->carry(nextcarry, false);
+      out = content_.get()->carry(nextcarry, false);
     }
     else {
       Index64 nextcarry(length());
@@ -390,8 +402,14 @@ namespace awkward {
         content_.get()->length());
       util::handle_error(err, classname(), identities_.get());
 
-      return content_.get()->carry(nextcarry, false);
+      out = content_.get()->carry(nextcarry, false);
     }
+
+    if (cache.get() != nullptr) {
+      cache.get()->set(key, out);
+      return out.get()->shallow_copy();
+    }
+    return out;
   }
 
   template <typename T, bool ISOPTION>
@@ -447,7 +465,7 @@ namespace awkward {
   IndexedArrayOf<T, ISOPTION>::simplify_optiontype() const {
     if (ISOPTION) {
       if (IndexedArray32* rawcontent =
-          dynamic_cast<IndexedArray32*>(content_.get())) {
+          kind_cast<IndexedArray32>(content_.get())) {
         Index32 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify32_to64(
@@ -465,7 +483,7 @@ namespace awkward {
                                                       rawcontent->content());
       }
       else if (IndexedArrayU32* rawcontent =
-               dynamic_cast<IndexedArrayU32*>(content_.get())) {
+               kind_cast<IndexedArrayU32>(content_.get())) {
         IndexU32 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplifyU32_to64(
@@ -483,7 +501,7 @@ namespace awkward {
                                                       rawcontent->content());
       }
       else if (IndexedArray64* rawcontent =
-               dynamic_cast<IndexedArray64*>(content_.get())) {
+               kind_cast<IndexedArray64>(content_.get())) {
         Index64 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify64_to64(
@@ -501,7 +519,7 @@ namespace awkward {
                                                       rawcontent->content());
       }
       else if (IndexedOptionArray32* rawcontent =
-               dynamic_cast<IndexedOptionArray32*>(content_.get())) {
+               kind_cast<IndexedOptionArray32>(content_.get())) {
         Index32 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify32_to64(
@@ -519,7 +537,7 @@ namespace awkward {
                                                       rawcontent->content());
       }
       else if (IndexedOptionArray64* rawcontent =
-               dynamic_cast<IndexedOptionArray64*>(content_.get())) {
+               kind_cast<IndexedOptionArray64>(content_.get())) {
         Index64 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify64_to64(
@@ -537,10 +555,10 @@ namespace awkward {
                                                       rawcontent->content());
       }
       else if (ByteMaskedArray* step1 =
-               dynamic_cast<ByteMaskedArray*>(content_.get())) {
+               kind_cast<ByteMaskedArray>(content_.get())) {
         ContentPtr step2 = step1->toIndexedOptionArray64();
         IndexedOptionArray64* rawcontent =
-          dynamic_cast<IndexedOptionArray64*>(step2.get());
+          kind_cast<IndexedOptionArray64>(step2.get());
         Index64 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify64_to64(
@@ -558,10 +576,10 @@ namespace awkward {
                                                       rawcontent->content());
       }
       else if (BitMaskedArray* step1 =
-               dynamic_cast<BitMaskedArray*>(content_.get())) {
+               kind_cast<BitMaskedArray>(content_.get())) {
         ContentPtr step2 = step1->toIndexedOptionArray64();
         IndexedOptionArray64* rawcontent =
-          dynamic_cast<IndexedOptionArray64*>(step2.get());
+          kind_cast<IndexedOptionArray64>(step2.get());
         Index64 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify64_to64(
@@ -579,10 +597,10 @@ namespace awkward {
                                                       rawcontent->content());
       }
       else if (UnmaskedArray* step1 =
-               dynamic_cast<UnmaskedArray*>(content_.get())) {
+               kind_cast<UnmaskedArray>(content_.get())) {
         ContentPtr step2 = step1->toIndexedOptionArray64();
         IndexedOptionArray64* rawcontent =
-          dynamic_cast<IndexedOptionArray64*>(step2.get());
+          kind_cast<IndexedOptionArray64>(step2.get());
         Index64 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify64_to64(
@@ -605,7 +623,7 @@ namespace awkward {
     }
     else {
       if (IndexedArray32* rawcontent =
-          dynamic_cast<IndexedArray32*>(content_.get())) {
+          kind_cast<IndexedArray32>(content_.get())) {
         Index32 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify32_to64(
@@ -623,7 +641,7 @@ namespace awkward {
                                                 rawcontent->content());
       }
       else if (IndexedArrayU32* rawcontent =
-               dynamic_cast<IndexedArrayU32*>(content_.get())) {
+               kind_cast<IndexedArrayU32>(content_.get())) {
         IndexU32 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplifyU32_to64(
@@ -641,7 +659,7 @@ namespace awkward {
                                                 rawcontent->content());
       }
       else if (IndexedArray64* rawcontent =
-               dynamic_cast<IndexedArray64*>(content_.get())) {
+               kind_cast<IndexedArray64>(content_.get())) {
         Index64 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify64_to64(
@@ -659,7 +677,7 @@ namespace awkward {
                                                 rawcontent->content());
       }
       else if (IndexedOptionArray32* rawcontent =
-               dynamic_cast<IndexedOptionArray32*>(content_.get())) {
+               kind_cast<IndexedOptionArray32>(content_.get())) {
         Index32 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify32_to64(
@@ -677,7 +695,7 @@ namespace awkward {
                                                       rawcontent->content());
       }
       else if (IndexedOptionArray64* rawcontent =
-               dynamic_cast<IndexedOptionArray64*>(content_.get())) {
+               kind_cast<IndexedOptionArray64>(content_.get())) {
         Index64 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify64_to64(
@@ -695,10 +713,10 @@ namespace awkward {
                                                       rawcontent->content());
       }
       else if (ByteMaskedArray* step1 =
-               dynamic_cast<ByteMaskedArray*>(content_.get())) {
+               kind_cast<ByteMaskedArray>(content_.get())) {
         ContentPtr step2 = step1->toIndexedOptionArray64();
         IndexedOptionArray64* rawcontent =
-          dynamic_cast<IndexedOptionArray64*>(step2.get());
+          kind_cast<IndexedOptionArray64>(step2.get());
         Index64 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify64_to64(
@@ -716,10 +734,10 @@ namespace awkward {
                                                       rawcontent->content());
       }
       else if (BitMaskedArray* step1 =
-               dynamic_cast<BitMaskedArray*>(content_.get())) {
+               kind_cast<BitMaskedArray>(content_.get())) {
         ContentPtr step2 = step1->toIndexedOptionArray64();
         IndexedOptionArray64* rawcontent =
-          dynamic_cast<IndexedOptionArray64*>(step2.get());
+          kind_cast<IndexedOptionArray64>(step2.get());
         Index64 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify64_to64(
@@ -737,10 +755,10 @@ namespace awkward {
                                                       rawcontent->content());
       }
       else if (UnmaskedArray* step1 =
-               dynamic_cast<UnmaskedArray*>(content_.get())) {
+               kind_cast<UnmaskedArray>(content_.get())) {
         ContentPtr step2 = step1->toIndexedOptionArray64();
         IndexedOptionArray64* rawcontent =
-          dynamic_cast<IndexedOptionArray64*>(step2.get());
+          kind_cast<IndexedOptionArray64>(step2.get());
         Index64 inner = rawcontent->index();
         Index64 result(index_.length());
         struct Error err = kernel::IndexedArray_simplify64_to64(
@@ -794,9 +812,16 @@ namespace awkward {
     return "UnrecognizedIndexedArray";
   }
 
+  template <typename T, bool ISOPTION>
+  Content::Kind
+  IndexedArrayOf<T, ISOPTION>::kind() const {
+    return ContentKindOf<IndexedArrayOf<T, ISOPTION>>::value();
+  }
+
   template <typename T, bool ISOPTION>
   void
   IndexedArrayOf<T, ISOPTION>::setidentities(const IdentitiesPtr& identities) {
+    projectionid_ = newprojectionid();
     if (identities.get() == nullptr) {
       content_.get()->setidentities(identities);
     }
@@ -1286,6 +1311,61 @@ namespace awkward {
     return simplify_optiontype();
   }
 
+  template <typename T, bool ISOPTION>
+  const ContentPtr
+  IndexedArrayOf<T, ISOPTION>::packed() const {
+    if (ISOPTION) {
+      int64_t numnull;
+      struct Error err1 = kernel::IndexedArray_numnull<T>(
+        &numnull,
+        index_.ptr().get(),
+        index_.offset(),
+        index_.length());
+      util::handle_error(err1, classname(), identities_.get());
+
+      Index64 nextcarry(length() - numnull);
+      Index64 outindex(length());
+      struct Error err2 =
+        kernel::IndexedArray_getitem_nextcarry_outindex_mask_64<T>(
+        nextcarry.ptr().get(),
+        outindex.ptr().get(),
+        index_.ptr().get(),
+        index_.offset(),
+        index_.length(),
+        content_.get()->length());
+      util::handle_error(err2, classname(), identities_.get());
+
+      return std::make_shared<IndexedOptionArray64>(
+        identities_,
+        parameters_,
+        outindex,
+        content_.get()->packed_carry(nextcarry));
+    }
+    else if (!parameters_.empty()) {
+      // parameters such as "__array__": "categorical" describe the
+      // indirection itself, so it is kept instead of projected
+      Index64 index = std::is_same<T, int64_t>::value
+                      ? index_.to64().deep_copy()
+                      : index_.to64();
+      return std::make_shared<IndexedArray64>(identities_,
+                                              parameters_,
+                                              index,
+                                              content_.get()->packed());
+    }
+    else {
+      Index64 nextcarry(length());
+      struct Error err = kernel::IndexedArray_getitem_nextcarry_64<T>(
+        nextcarry.ptr().get(),
+        index_.ptr().get(),
+        index_.offset(),
+        index_.length(),
+        content_.get()->length());
+      util::handle_error(err, classname(), identities_.get());
+
+      return content_.get()->packed_carry(nextcarry);
+    }
+  }
+
   template <typename T, bool ISOPTION>
   const ContentPtr
   IndexedArrayOf<T, ISOPTION>::num(int64_t axis, int64_t depth) const {
@@ -1366,7 +1446,7 @@ namespace awkward {
   bool
   IndexedArrayOf<T, ISOPTION>::mergeable(const ContentPtr& other,
                                          bool mergebool) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return mergeable(raw->array(), mergebool);
     }
 
@@ -1374,43 +1454,43 @@ namespace awkward {
       return false;
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())  ||
-        dynamic_cast<UnionArray8_32*>(other.get())  ||
-        dynamic_cast<UnionArray8_U32*>(other.get())  ||
-        dynamic_cast<UnionArray8_64*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())  ||
+        kind_cast<UnionArray8_32>(other.get())  ||
+        kind_cast<UnionArray8_U32>(other.get())  ||
+        kind_cast<UnionArray8_64>(other.get())) {
       return true;
     }
 
     if (IndexedArray32* rawother =
-        dynamic_cast<IndexedArray32*>(other.get())) {
+        kind_cast<IndexedArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else {
@@ -1421,7 +1501,7 @@ namespace awkward {
   template <typename T, bool ISOPTION>
   const ContentPtr
   IndexedArrayOf<T, ISOPTION>::reverse_merge(const ContentPtr& other) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return reverse_merge(raw->array());
     }
 
@@ -1482,7 +1562,7 @@ namespace awkward {
   template <typename T, bool ISOPTION>
   const ContentPtr
   IndexedArrayOf<T, ISOPTION>::merge(const ContentPtr& other) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return merge(raw->array());
     }
 
@@ -1490,19 +1570,19 @@ namespace awkward {
       return merge_as_union(other);
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())) {
       return shallow_copy();
     }
     else if (UnionArray8_32* rawother =
-             dynamic_cast<UnionArray8_32*>(other.get())) {
+             kind_cast<UnionArray8_32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_U32* rawother =
-             dynamic_cast<UnionArray8_U32*>(other.get())) {
+             kind_cast<UnionArray8_U32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_64* rawother =
-             dynamic_cast<UnionArray8_64*>(other.get())) {
+             kind_cast<UnionArray8_64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
 
@@ -1546,15 +1626,15 @@ namespace awkward {
 
     ContentPtr replaced_other = other;
     if (ByteMaskedArray* rawother =
-        dynamic_cast<ByteMaskedArray*>(other.get())) {
+        kind_cast<ByteMaskedArray>(other.get())) {
       replaced_other = rawother->toIndexedOptionArray64();
     }
     else if (BitMaskedArray* rawother =
-        dynamic_cast<BitMaskedArray*>(other.get())) {
+        kind_cast<BitMaskedArray>(other.get())) {
       replaced_other = rawother->toIndexedOptionArray64();
     }
     else if (UnmaskedArray* rawother =
-        dynamic_cast<UnmaskedArray*>(other.get())) {
+        kind_cast<UnmaskedArray>(other.get())) {
       replaced_other = rawother->toIndexedOptionArray64();
     }
 
@@ -1562,7 +1642,7 @@ namespace awkward {
     ContentPtr content;
     bool other_isoption = false;
     if (IndexedArray32* rawother =
-        dynamic_cast<IndexedArray32*>(replaced_other.get())) {
+        kind_cast<IndexedArray32>(replaced_other.get())) {
       content = content_.get()->merge(rawother->content());
       Index32 other_index = rawother->index();
       struct Error err = kernel::IndexedArray_fill<int32_t, int64_t>(
@@ -1577,7 +1657,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(replaced_other.get())) {
+             kind_cast<IndexedArrayU32>(replaced_other.get())) {
       content = content_.get()->merge(rawother->content());
       IndexU32 other_index = rawother->index();
       struct Error err = kernel::IndexedArray_fill<uint32_t, int64_t>(
@@ -1592,7 +1672,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(replaced_other.get())) {
+             kind_cast<IndexedArray64>(replaced_other.get())) {
       content = content_.get()->merge(rawother->content());
       Index64 other_index = rawother->index();
       struct Error err = kernel::IndexedArray_fill<int64_t, int64_t>(
@@ -1607,7 +1687,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(replaced_other.get())) {
+             kind_cast<IndexedOptionArray32>(replaced_other.get())) {
       content = content_.get()->merge(rawother->content());
       Index32 other_index = rawother->index();
       struct Error err = kernel::IndexedArray_fill<int32_t, int64_t>(
@@ -1623,7 +1703,7 @@ namespace awkward {
       other_isoption = true;
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(replaced_other.get())) {
+             kind_cast<IndexedOptionArray64>(replaced_other.get())) {
       content = content_.get()->merge(rawother->content());
       Index64 other_index = rawother->index();
       struct Error err = kernel::IndexedArray_fill<int64_t, int64_t>(
@@ -1894,11 +1974,11 @@ namespace awkward {
     }
     else {
       if (RegularArray* raw =
-          dynamic_cast<RegularArray*>(out.get())) {
+          kind_cast<RegularArray>(out.get())) {
         out = raw->toListOffsetArray64(true);
       }
       if (ListOffsetArray64* raw =
-          dynamic_cast<ListOffsetArray64*>(out.get())) {
+          kind_cast<ListOffsetArray64>(out.get())) {
         Index64 outoffsets(starts.length() + 1);
         if (starts.length() > 0  &&  starts.getitem_at_nowrap(0) != 0) {
           throw std::runtime_error(
@@ -2070,11 +2150,11 @@ namespace awkward {
     }
     else {
       if (RegularArray* raw =
-        dynamic_cast<RegularArray*>(out.get())) {
+        kind_cast<RegularArray>(out.get())) {
         out = raw->toListOffsetArray64(true);
       }
       if (ListOffsetArray64* raw =
-        dynamic_cast<ListOffsetArray64*>(out.get())) {
+        kind_cast<ListOffsetArray64>(out.get())) {
         Index64 outoffsets(starts.length() + 1);
         if (starts.length() > 0  &&  starts.getitem_at_nowrap(0) != 0) {
           throw std::runtime_error(
@@ -2173,11 +2253,11 @@ namespace awkward {
     }
     else {
       if (RegularArray* raw =
-        dynamic_cast<RegularArray*>(out.get())) {
+        kind_cast<RegularArray>(out.get())) {
           out = raw->toListOffsetArray64(true);
       }
       if (ListOffsetArray64* raw =
-        dynamic_cast<ListOffsetArray64*>(out.get())) {
+        kind_cast<ListOffsetArray64>(out.get())) {
         Index64 outoffsets(starts.length() + 1);
         if (starts.length() > 0  &&  starts.getitem_at_nowrap(0) != 0) {
           throw std::runtime_error(
@@ -292,7 +292,7 @@ namespace awkward {
     Index64 offsets = compact_offsets64(true);
     ContentPtr listoffsetarray64 = broadcast_tooffsets64(offsets);
     ListOffsetArray64* raw =
-      dynamic_cast<ListOffsetArray64*>(listoffsetarray64.get());
+      kind_cast<ListOffsetArray64>(listoffsetarray64.get());
     return raw->toRegularArray();
   }
 
@@ -320,6 +320,12 @@ namespace awkward {
     }
   }
 
+  template <typename T>
+  Content::Kind
+  ListArrayOf<T>::kind() const {
+    return ContentKindOf<ListArrayOf<T>>::value();
+  }
+
   template <typename T>
   void
   ListArrayOf<T>::setidentities(const IdentitiesPtr& identities) {
@@ -692,6 +698,16 @@ namespace awkward {
       content_.get()->getitem_fields(keys));
   }
 
+  template <typename T>
+  const ContentPtr
+  ListArrayOf<T>::getitem_jagged_mask(const Index64& offsets,
+                                      const Index8& mask) const {
+    if (offsets.length() != length() + 1  ||  identities_.get() != nullptr) {
+      return Content::getitem_jagged_mask(offsets, mask);
+    }
+    return toListOffsetArray64(true).get()->getitem_jagged_mask(offsets, mask);
+  }
+
   template <typename T>
   const ContentPtr
   ListArrayOf<T>::carry(const Index64& carry, bool allow_lazy) const {
@@ -782,6 +798,30 @@ namespace awkward {
     return shallow_copy();
   }
 
+  template <typename T>
+  const ContentPtr
+  ListArrayOf<T>::packed() const {
+    Index64 offsets = compact_offsets64(true);
+    int64_t carrylen = offsets.getitem_at_nowrap(offsets.length() - 1);
+    Index64 nextcarry(carrylen);
+    struct Error err = kernel::ListArray_broadcast_tooffsets_64<T>(
+      nextcarry.ptr().get(),
+      offsets.ptr().get(),
+      offsets.offset(),
+      offsets.length(),
+      starts_.ptr().get(),
+      starts_.offset(),
+      stops_.ptr().get(),
+      stops_.offset(),
+      content_.get()->length());
+    util::handle_error(err, classname(), identities_.get());
+    return std::make_shared<ListOffsetArray64>(
+      identities_,
+      parameters_,
+      offsets,
+      content_.get()->packed_carry(nextcarry));
+  }
+
   template <typename T>
   const ContentPtr
   ListArrayOf<T>::num(int64_t axis, int64_t depth) const {
@@ -818,7 +858,7 @@ namespace awkward {
   template <typename T>
   bool
   ListArrayOf<T>::mergeable(const ContentPtr& other, bool mergebool) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return mergeable(raw->array(), mergebool);
     }
 
@@ -826,71 +866,71 @@ namespace awkward {
       return false;
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())  ||
-        dynamic_cast<UnionArray8_32*>(other.get())  ||
-        dynamic_cast<UnionArray8_U32*>(other.get())  ||
-        dynamic_cast<UnionArray8_64*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())  ||
+        kind_cast<UnionArray8_32>(other.get())  ||
+        kind_cast<UnionArray8_U32>(other.get())  ||
+        kind_cast<UnionArray8_64>(other.get())) {
       return true;
     }
     else if (IndexedArray32* rawother =
-             dynamic_cast<IndexedArray32*>(other.get())) {
+             kind_cast<IndexedArray32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
 
     if (RegularArray* rawother =
-        dynamic_cast<RegularArray*>(other.get())) {
+        kind_cast<RegularArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListArray32* rawother =
-             dynamic_cast<ListArray32*>(other.get())) {
+             kind_cast<ListArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListArrayU32* rawother =
-             dynamic_cast<ListArrayU32*>(other.get())) {
+             kind_cast<ListArrayU32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListArray64* rawother =
-             dynamic_cast<ListArray64*>(other.get())) {
+             kind_cast<ListArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListOffsetArray32* rawother =
-             dynamic_cast<ListOffsetArray32*>(other.get())) {
+             kind_cast<ListOffsetArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListOffsetArrayU32* rawother =
-             dynamic_cast<ListOffsetArrayU32*>(other.get())) {
+             kind_cast<ListOffsetArrayU32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListOffsetArray64* rawother =
-             dynamic_cast<ListOffsetArray64*>(other.get())) {
+             kind_cast<ListOffsetArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else {
@@ -901,7 +941,7 @@ namespace awkward {
   template <typename T>
   const ContentPtr
   ListArrayOf<T>::merge(const ContentPtr& other) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return merge(raw->array());
     }
 
@@ -909,51 +949,51 @@ namespace awkward {
       return merge_as_union(other);
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())) {
       return shallow_copy();
     }
     else if (IndexedArray32* rawother =
-             dynamic_cast<IndexedArray32*>(other.get())) {
+             kind_cast<IndexedArray32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_32* rawother =
-             dynamic_cast<UnionArray8_32*>(other.get())) {
+             kind_cast<UnionArray8_32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_U32* rawother =
-             dynamic_cast<UnionArray8_U32*>(other.get())) {
+             kind_cast<UnionArray8_U32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_64* rawother =
-             dynamic_cast<UnionArray8_64*>(other.get())) {
+             kind_cast<UnionArray8_64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
 
@@ -1011,7 +1051,7 @@ namespace awkward {
     int64_t mycontentlength = content_.get()->length();
     ContentPtr content;
     if (ListArray32* rawother =
-        dynamic_cast<ListArray32*>(other.get())) {
+        kind_cast<ListArray32>(other.get())) {
       content = content_.get()->merge(rawother->content());
       Index32 other_starts = rawother->starts();
       Index32 other_stops = rawother->stops();
@@ -1031,7 +1071,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (ListArrayU32* rawother =
-             dynamic_cast<ListArrayU32*>(other.get())) {
+             kind_cast<ListArrayU32>(other.get())) {
       content = content_.get()->merge(rawother->content());
       IndexU32 other_starts = rawother->starts();
       IndexU32 other_stops = rawother->stops();
@@ -1051,7 +1091,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (ListArray64* rawother =
-             dynamic_cast<ListArray64*>(other.get())) {
+             kind_cast<ListArray64>(other.get())) {
       content = content_.get()->merge(rawother->content());
       Index64 other_starts = rawother->starts();
       Index64 other_stops = rawother->stops();
@@ -1071,7 +1111,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (ListOffsetArray32* rawother =
-             dynamic_cast<ListOffsetArray32*>(other.get())) {
+             kind_cast<ListOffsetArray32>(other.get())) {
       content = content_.get()->merge(rawother->content());
       Index32 other_starts = rawother->starts();
       Index32 other_stops = rawother->stops();
@@ -1090,7 +1130,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (ListOffsetArrayU32* rawother =
-             dynamic_cast<ListOffsetArrayU32*>(other.get())) {
+             kind_cast<ListOffsetArrayU32>(other.get())) {
       content = content_.get()->merge(rawother->content());
       IndexU32 other_starts = rawother->starts();
       IndexU32 other_stops = rawother->stops();
@@ -1110,7 +1150,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (ListOffsetArray64* rawother =
-             dynamic_cast<ListOffsetArray64*>(other.get())) {
+             kind_cast<ListOffsetArray64>(other.get())) {
       content = content_.get()->merge(rawother->content());
       Index64 other_starts = rawother->starts();
       Index64 other_stops = rawother->stops();
@@ -1130,10 +1170,10 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (RegularArray* rawregulararray =
-             dynamic_cast<RegularArray*>(other.get())) {
+             kind_cast<RegularArray>(other.get())) {
       ContentPtr listoffsetarray = rawregulararray->toListOffsetArray64(true);
       ListOffsetArray64* rawother =
-        dynamic_cast<ListOffsetArray64*>(listoffsetarray.get());
+        kind_cast<ListOffsetArray64>(listoffsetarray.get());
       content = content_.get()->merge(rawother->content());
       Index64 other_starts = rawother->starts();
       Index64 other_stops = rawother->stops();
@@ -1386,7 +1426,7 @@ namespace awkward {
     else {
       ContentPtr compact = toListOffsetArray64(true);
       ListOffsetArray64* rawcompact =
-        dynamic_cast<ListOffsetArray64*>(compact.get());
+        kind_cast<ListOffsetArray64>(compact.get());
       ContentPtr next = rawcompact->content().get()->combinations(n,
                                                                   replacement,
                                                                   recordlookup,
@@ -1785,7 +1825,7 @@ namespace awkward {
                                          tail);
     }
 
-    if (ListOffsetArray64* raw = dynamic_cast<ListOffsetArray64*>(out.get())) {
+    if (ListOffsetArray64* raw = kind_cast<ListOffsetArray64>(out.get())) {
       ContentPtr content = raw->content();
       Index64 missing_trim =
           missing.getitem_range_nowrap(0, largeoffsets.getitem_at(-1));
@@ -356,6 +356,12 @@ namespace awkward {
     }
   }
 
+  template <typename T>
+  Content::Kind
+  ListOffsetArrayOf<T>::kind() const {
+    return ContentKindOf<ListOffsetArrayOf<T>>::value();
+  }
+
   template <typename T>
   void
   ListOffsetArrayOf<T>::setidentities(const IdentitiesPtr& identities) {
@@ -703,6 +709,50 @@ namespace awkward {
                                                 tail);
   }
 
+  template <typename T>
+  const ContentPtr
+  ListOffsetArrayOf<T>::getitem_jagged_mask(const Index64& offsets,
+                                            const Index8& mask) const {
+    int64_t len = length();
+    if (offsets.length() != len + 1  ||
+        identities_.get() != nullptr  ||
+        offsets_.ptr_lib() != kernel::Lib::cpu_kernels  ||
+        mask.ptr_lib() != kernel::Lib::cpu_kernels) {
+      return Content::getitem_jagged_mask(offsets, mask);
+    }
+    int64_t maskstart = offsets.getitem_at_nowrap(0);
+    int64_t maskstop = offsets.getitem_at_nowrap(len);
+    if (maskstart < 0  ||  maskstop > mask.length()) {
+      return Content::getitem_jagged_mask(offsets, mask);
+    }
+
+    Index64 nextoffsets(len + 1);
+    struct Error err = kernel::ListOffsetArray_getitem_jagged_mask_64<T>(
+      nextoffsets.ptr().get(),
+      offsets_.ptr().get(),
+      offsets_.offset(),
+      offsets.ptr().get(),
+      offsets.offset(),
+      mask.ptr().get(),
+      mask.offset(),
+      len);
+    util::handle_error(err, classname(), identities_.get());
+
+    // every list has the same length as its part of the mask, so the mask
+    // applies to the flattened content entry by entry
+    int64_t start = (int64_t)offsets_.getitem_at_nowrap(0);
+    int64_t stop = (int64_t)offsets_.getitem_at_nowrap(len);
+    ContentPtr nextcontent = content_.get()->getitem_range_nowrap(start, stop);
+    Index8 flatmask(mask.ptr(),
+                    mask.offset() + maskstart,
+                    maskstop - maskstart);
+    return std::make_shared<ListOffsetArray64>(
+      Identities::none(),
+      parameters_,
+      nextoffsets,
+      nextcontent.get()->getitem_mask(flatmask));
+  }
+
   template <typename T>
   const ContentPtr
   ListOffsetArrayOf<T>::carry(const Index64& carry, bool allow_lazy) const {
@@ -790,6 +840,24 @@ namespace awkward {
     return shallow_copy();
   }
 
+  template <typename T>
+  const ContentPtr
+  ListOffsetArrayOf<T>::packed() const {
+    int64_t start = (int64_t)offsets_.getitem_at_nowrap(0);
+    int64_t stop = (int64_t)offsets_.getitem_at_nowrap(offsets_.length() - 1);
+    // 64-bit offsets that already start at zero are passed through by
+    // compact_offsets64, but they may be a view of a longer buffer
+    Index64 offsets = (std::is_same<T, int64_t>::value  &&  start == 0)
+                      ? compact_offsets64(true).deep_copy()
+                      : compact_offsets64(true);
+    ContentPtr content =
+      content_.get()->getitem_range_nowrap(start, stop).get()->packed();
+    return std::make_shared<ListOffsetArray64>(identities_,
+                                               parameters_,
+                                               offsets,
+                                               content);
+  }
+
   template <typename T>
   const ContentPtr
   ListOffsetArrayOf<T>::num(int64_t axis, int64_t depth) const {
@@ -835,7 +903,7 @@ namespace awkward {
     else if (posaxis == depth + 1) {
       ContentPtr listoffsetarray = toListOffsetArray64(true);
       ListOffsetArray64* raw =
-        dynamic_cast<ListOffsetArray64*>(listoffsetarray.get());
+        kind_cast<ListOffsetArray64>(listoffsetarray.get());
       return std::pair<Index64, ContentPtr>(raw->offsets(), raw->content());
     }
     else {
@@ -875,7 +943,7 @@ namespace awkward {
   bool
   ListOffsetArrayOf<T>::mergeable(const ContentPtr& other,
                                   bool mergebool) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return mergeable(raw->array(), mergebool);
     }
 
@@ -883,71 +951,71 @@ namespace awkward {
       return false;
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())  ||
-        dynamic_cast<UnionArray8_32*>(other.get())  ||
-        dynamic_cast<UnionArray8_U32*>(other.get())  ||
-        dynamic_cast<UnionArray8_64*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())  ||
+        kind_cast<UnionArray8_32>(other.get())  ||
+        kind_cast<UnionArray8_U32>(other.get())  ||
+        kind_cast<UnionArray8_64>(other.get())) {
       return true;
     }
     else if (IndexedArray32* rawother =
-             dynamic_cast<IndexedArray32*>(other.get())) {
+             kind_cast<IndexedArray32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
 
     if (RegularArray* rawother =
-        dynamic_cast<RegularArray*>(other.get())) {
+        kind_cast<RegularArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListArray32* rawother =
-             dynamic_cast<ListArray32*>(other.get())) {
+             kind_cast<ListArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListArrayU32* rawother =
-             dynamic_cast<ListArrayU32*>(other.get())) {
+             kind_cast<ListArrayU32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListArray64* rawother =
-             dynamic_cast<ListArray64*>(other.get())) {
+             kind_cast<ListArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListOffsetArray32* rawother =
-             dynamic_cast<ListOffsetArray32*>(other.get())) {
+             kind_cast<ListOffsetArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListOffsetArrayU32* rawother =
-             dynamic_cast<ListOffsetArrayU32*>(other.get())) {
+             kind_cast<ListOffsetArrayU32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListOffsetArray64* rawother =
-             dynamic_cast<ListOffsetArray64*>(other.get())) {
+             kind_cast<ListOffsetArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else {
@@ -955,10 +1023,100 @@ namespace awkward {
     }
   }
 
+  template <typename T>
+  const ContentPtr
+  ListOffsetArrayOf<T>::merge_many(const ContentPtrVec& others,
+                                   bool mergebool) const {
+    // lists are concatenated at once, with one merge_many of their
+    // contents; lists without offsets are compacted to offsets first
+    ContentPtrVec lists = { toListOffsetArray64(false) };
+    for (auto other : others) {
+      ContentPtr array = other;
+      if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
+        array = raw->array();
+      }
+      if (kind_cast<EmptyArray>(array.get())  &&
+          array.get()->parameters_equal(parameters_)) {
+        continue;
+      }
+      ContentPtr list(nullptr);
+      if (ListOffsetArray32* raw =
+          kind_cast<ListOffsetArray32>(array.get())) {
+        list = raw->toListOffsetArray64(false);
+      }
+      else if (ListOffsetArrayU32* raw =
+               kind_cast<ListOffsetArrayU32>(array.get())) {
+        list = raw->toListOffsetArray64(false);
+      }
+      else if (ListOffsetArray64* raw =
+               kind_cast<ListOffsetArray64>(array.get())) {
+        list = raw->shallow_copy();
+      }
+      else if (ListArray32* raw = kind_cast<ListArray32>(array.get())) {
+        list = raw->toListOffsetArray64(true);
+      }
+      else if (ListArrayU32* raw = kind_cast<ListArrayU32>(array.get())) {
+        list = raw->toListOffsetArray64(true);
+      }
+      else if (ListArray64* raw = kind_cast<ListArray64>(array.get())) {
+        list = raw->toListOffsetArray64(true);
+      }
+      else if (RegularArray* raw = kind_cast<RegularArray>(array.get())) {
+        list = raw->toListOffsetArray64(true);
+      }
+      if (list.get() == nullptr  ||  !mergeable(array, mergebool)) {
+        return Content::merge_many(others, mergebool);
+      }
+      lists.push_back(list);
+    }
+
+    int64_t total = 0;
+    for (auto list : lists) {
+      total += list.get()->length();
+    }
+    Index64 offsets(total + 1);
+    offsets.setitem_at_nowrap(0, 0);
+    ContentPtrVec contents;
+    int64_t pos = 0;
+    int64_t contentpos = 0;
+    for (auto list : lists) {
+      ListOffsetArray64* raw = kind_cast<ListOffsetArray64>(list.get());
+      Index64 rawoffsets = raw->offsets();
+      int64_t len = raw->length();
+      int64_t start = rawoffsets.getitem_at_nowrap(0);
+      int64_t stop = rawoffsets.getitem_at_nowrap(len);
+      // the starts and stops of one list are both its offsets, shifted
+      // to follow the contents before it
+      struct Error err = kernel::ListArray_fill<int64_t, int64_t>(
+        offsets.ptr().get(),
+        pos,
+        offsets.ptr().get(),
+        pos + 1,
+        rawoffsets.ptr().get(),
+        rawoffsets.offset(),
+        rawoffsets.ptr().get(),
+        rawoffsets.offset() + 1,
+        len,
+        contentpos - start);
+      util::handle_error(err, classname(), identities_.get());
+      contents.push_back(
+        raw->content().get()->getitem_range_nowrap(start, stop));
+      pos += len;
+      contentpos += stop - start;
+    }
+
+    ContentPtrVec tail(std::next(contents.begin()), contents.end());
+    ContentPtr content = contents[0].get()->merge_many(tail, mergebool);
+    return std::make_shared<ListOffsetArray64>(Identities::none(),
+                                               parameters_,
+                                               offsets,
+                                               content);
+  }
+
   template <typename T>
   const ContentPtr
   ListOffsetArrayOf<T>::merge(const ContentPtr& other) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return merge(raw->array());
     }
 
@@ -966,51 +1124,51 @@ namespace awkward {
       return merge_as_union(other);
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())) {
       return shallow_copy();
     }
     else if (IndexedArray32* rawother =
-             dynamic_cast<IndexedArray32*>(other.get())) {
+             kind_cast<IndexedArray32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_32* rawother =
-             dynamic_cast<UnionArray8_32*>(other.get())) {
+             kind_cast<UnionArray8_32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_U32* rawother =
-             dynamic_cast<UnionArray8_U32*>(other.get())) {
+             kind_cast<UnionArray8_U32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_64* rawother =
-             dynamic_cast<UnionArray8_64*>(other.get())) {
+             kind_cast<UnionArray8_64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
 
@@ -1071,7 +1229,7 @@ namespace awkward {
     int64_t mycontentlength = content_.get()->length();
     ContentPtr content;
     if (ListArray32* rawother =
-        dynamic_cast<ListArray32*>(other.get())) {
+        kind_cast<ListArray32>(other.get())) {
       content = content_.get()->merge(rawother->content());
       Index32 other_starts = rawother->starts();
       Index32 other_stops = rawother->stops();
@@ -1091,7 +1249,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (ListArrayU32* rawother =
-             dynamic_cast<ListArrayU32*>(other.get())) {
+             kind_cast<ListArrayU32>(other.get())) {
       content = content_.get()->merge(rawother->content());
       IndexU32 other_starts = rawother->starts();
       IndexU32 other_stops = rawother->stops();
@@ -1111,7 +1269,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (ListArray64* rawother =
-             dynamic_cast<ListArray64*>(other.get())) {
+             kind_cast<ListArray64>(other.get())) {
       content = content_.get()->merge(rawother->content());
       Index64 other_starts = rawother->starts();
       Index64 other_stops = rawother->stops();
@@ -1131,7 +1289,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (ListOffsetArray32* rawother =
-             dynamic_cast<ListOffsetArray32*>(other.get())) {
+             kind_cast<ListOffsetArray32>(other.get())) {
       content = content_.get()->merge(rawother->content());
       Index32 other_starts = rawother->starts();
       Index32 other_stops = rawother->stops();
@@ -1151,7 +1309,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (ListOffsetArrayU32* rawother =
-             dynamic_cast<ListOffsetArrayU32*>(other.get())) {
+             kind_cast<ListOffsetArrayU32>(other.get())) {
       content = content_.get()->merge(rawother->content());
       IndexU32 other_starts = rawother->starts();
       IndexU32 other_stops = rawother->stops();
@@ -1171,7 +1329,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (ListOffsetArray64* rawother =
-             dynamic_cast<ListOffsetArray64*>(other.get())) {
+             kind_cast<ListOffsetArray64>(other.get())) {
       content = content_.get()->merge(rawother->content());
       Index64 other_starts = rawother->starts();
       Index64 other_stops = rawother->stops();
@@ -1191,10 +1349,10 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (RegularArray* rawregulararray =
-             dynamic_cast<RegularArray*>(other.get())) {
+             kind_cast<RegularArray>(other.get())) {
       ContentPtr listoffsetarray = rawregulararray->toListOffsetArray64(true);
       ListOffsetArray64* rawother =
-        dynamic_cast<ListOffsetArray64*>(listoffsetarray.get());
+        kind_cast<ListOffsetArray64>(listoffsetarray.get());
       content = content_.get()->merge(rawother->content());
       Index64 other_starts = rawother->starts();
       Index64 other_stops = rawother->stops();
@@ -1686,7 +1844,7 @@ namespace awkward {
     else {
       ContentPtr compact = toListOffsetArray64(true);
       ListOffsetArray64* rawcompact =
-        dynamic_cast<ListOffsetArray64*>(compact.get());
+        kind_cast<ListOffsetArray64>(compact.get());
       ContentPtr next = rawcompact->content().get()->combinations(n,
                                                                   replacement,
                                                                   recordlookup,
@@ -1731,7 +1889,7 @@ namespace awkward {
     // if this is array of strings, axis parameter is ignored
     // and this array is sorted
     if (util::parameter_isstring(parameters_, "__array__")) {
-      if (NumpyArray* content = dynamic_cast<NumpyArray*>(content_.get())) {
+      if (NumpyArray* content = kind_cast<NumpyArray>(content_.get())) {
         ContentPtr out = content->sort_asstrings(offsets_,
                                                  ascending,
                                                  stable);
@@ -23,6 +23,11 @@ namespace awkward {
     return "None";
   }
 
+  Content::Kind
+  None::kind() const {
+    return Kind::None;
+  }
+
   void
   None::setidentities(const IdentitiesPtr& identities) {
     throw std::runtime_error(
@@ -170,6 +175,11 @@ namespace awkward {
     throw std::runtime_error("undefined operation: None::shallow_simplify");
   }
 
+  const ContentPtr
+  None::packed() const {
+    throw std::runtime_error("undefined operation: None::packed");
+  }
+
   const ContentPtr
   None::num(int64_t axis, int64_t depth) const {
     throw std::runtime_error("undefined operation: None::num");
@@ -514,6 +514,11 @@ namespace awkward {
     return "NumpyArray";
   }
 
+  Content::Kind
+  NumpyArray::kind() const {
+    return Kind::NumpyArray;
+  }
+
   void
   NumpyArray::setidentities(const IdentitiesPtr& identities) {
     if (identities.get() != nullptr  &&
@@ -1125,6 +1130,25 @@ namespace awkward {
       throw std::runtime_error("cannot get-item on a scalar");
     }
 
+    if (where.length() == 1) {
+      SliceItemPtr head = where.head();
+      if (SliceMask* mask = dynamic_cast<SliceMask*>(head.get())) {
+        return getitem_mask(mask->mask());
+      }
+      if (SliceJagged64* jagged = dynamic_cast<SliceJagged64*>(head.get())) {
+        if (SliceMask* mask =
+            dynamic_cast<SliceMask*>(jagged->content().get())) {
+          return getitem_jagged_mask(jagged->offsets(), mask->mask());
+        }
+      }
+      // in lazy-carry mode, a flat index goes through (lazy) carry
+      SliceArray64* array = dynamic_cast<SliceArray64*>(head.get());
+      if (array != nullptr  &&  array->ndim() == 1  &&  ndim() == 1  &&
+          Content::lazy_carry()) {
+        return Content::getitem(where);
+      }
+    }
+
     if (getitem_too_general(where.head(), where.tail())) {
       if (ndim() == 1) {
         return Content::getitem(where);
@@ -1232,8 +1256,73 @@ namespace awkward {
                         false).shallow_copy();
   }
 
+  const ContentPtr
+  NumpyArray::getitem_mask(const Index8& mask) const {
+    if (isscalar()  ||
+        Content::lazy_carry()  ||
+        identities_.get() != nullptr  ||
+        ptr_lib_ != kernel::Lib::cpu_kernels) {
+      return Content::getitem_mask(mask);
+    }
+    if (mask.length() != length()) {
+      throw std::invalid_argument(
+        std::string("boolean mask of length ")
+        + std::to_string(mask.length())
+        + std::string(" does not match ") + classname()
+        + std::string(" of length ") + std::to_string(length()));
+    }
+    if (!iscontiguous()) {
+      return contiguous().getitem_mask(mask);
+    }
+
+    int64_t numtrue;
+    struct Error err1 = kernel::NumpyArray_getitem_boolean_numtrue(
+      &numtrue,
+      mask.ptr().get(),
+      mask.offset(),
+      mask.length(),
+      1);
+    util::handle_error(err1, classname(), identities_.get());
+
+    std::shared_ptr<void> ptr(
+      kernel::ptr_alloc<uint8_t>(ptr_lib_, numtrue*((int64_t)strides_[0])));
+    struct Error err2 = kernel::NumpyArray_getitem_boolean_compact(
+      reinterpret_cast<uint8_t*>(ptr.get()),
+      reinterpret_cast<uint8_t*>(ptr_.get()),
+      byteoffset_,
+      strides_[0],
+      mask.ptr().get(),
+      mask.offset(),
+      mask.length());
+    util::handle_error(err2, classname(), identities_.get());
+
+    std::vector<ssize_t> shape = { (ssize_t)numtrue };
+    shape.insert(shape.end(), std::next(shape_.begin()), shape_.end());
+    return std::make_shared<NumpyArray>(Identities::none(),
+                                        parameters_,
+                                        ptr,
+                                        shape,
+                                        strides_,
+                                        0,
+                                        itemsize_,
+                                        format_,
+                                        dtype_,
+                                        ptr_lib_);
+  }
+
   const ContentPtr
   NumpyArray::carry(const Index64& carry, bool allow_lazy) const {
+    if (allow_lazy  &&  Content::lazy_carry()) {
+      IdentitiesPtr identities(nullptr);
+      if (identities_.get() != nullptr) {
+        identities = identities_.get()->getitem_carry_64(carry);
+      }
+      return std::make_shared<IndexedArray64>(identities,
+                                              parameters_,
+                                              carry,
+                                              shallow_copy());
+    }
+
     std::shared_ptr<void> ptr(
       kernel::ptr_alloc<uint8_t>(ptr_lib_, carry.length()*((int64_t)strides_[0])));
     struct Error err = kernel::NumpyArray_getitem_next_null_64(
@@ -1319,6 +1408,33 @@ namespace awkward {
     return shallow_copy();
   }
 
+  const ContentPtr
+  NumpyArray::packed() const {
+    if (isscalar()) {
+      return deep_copy(true, false, false);
+    }
+    // unlike #contiguous, copy even if the array is already contiguous:
+    // its #ptr may be a view of a larger buffer
+    Index64 bytepos(shape_[0]);
+    struct Error err =
+      kernel::NumpyArray_contiguous_init_64(bytepos.ptr().get(),
+                                            shape_[0],
+                                            strides_[0]);
+    util::handle_error(err, classname(), identities_.get());
+    return std::make_shared<NumpyArray>(contiguous_next(bytepos));
+  }
+
+  const ContentPtr
+  NumpyArray::packed_carry(const Index64& nextcarry) const {
+    // a carry is a new buffer of exactly the carried elements
+    ContentPtr out = carry(nextcarry, false);
+    NumpyArray* raw = kind_cast<NumpyArray>(out.get());
+    if (raw != nullptr  &&  raw->iscontiguous()) {
+      return out;
+    }
+    return out.get()->packed();
+  }
+
   const ContentPtr
   NumpyArray::num(int64_t axis, int64_t depth) const {
     int64_t posaxis = axis_wrap_if_negative(axis);
@@ -1409,7 +1525,7 @@ namespace awkward {
 
   bool
   NumpyArray::mergeable(const ContentPtr& other, bool mergebool) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return mergeable(raw->array(), mergebool);
     }
 
@@ -1417,42 +1533,42 @@ namespace awkward {
       return false;
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())  ||
-        dynamic_cast<UnionArray8_32*>(other.get())  ||
-        dynamic_cast<UnionArray8_U32*>(other.get())  ||
-        dynamic_cast<UnionArray8_64*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())  ||
+        kind_cast<UnionArray8_32>(other.get())  ||
+        kind_cast<UnionArray8_U32>(other.get())  ||
+        kind_cast<UnionArray8_64>(other.get())) {
       return true;
     }
     else if (IndexedArray32* rawother =
-             dynamic_cast<IndexedArray32*>(other.get())) {
+             kind_cast<IndexedArray32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
 
@@ -1460,7 +1576,7 @@ namespace awkward {
       return false;
     }
 
-    if (NumpyArray* rawother = dynamic_cast<NumpyArray*>(other.get())) {
+    if (NumpyArray* rawother = kind_cast<NumpyArray>(other.get())) {
       if (ndim() != rawother->ndim()) {
         return false;
       }
@@ -1530,9 +1646,518 @@ namespace awkward {
     }
   }
 
+  namespace {
+    // The dtype that merging `one` with `two` produces, or NOT_PRIMITIVE
+    // if there is none; shared by merge and merge_many.
+    util::dtype
+    merged_dtype(util::dtype one, util::dtype two) {
+      if (one == util::dtype::complex256  ||
+          two == util::dtype::complex256) {
+        return util::dtype::complex256;
+      }
+      else if ((one == util::dtype::float128  &&
+                util::is_complex(two))  ||
+               (two == util::dtype::float128  &&
+                util::is_complex(one))) {
+        return util::dtype::complex256;
+      }
+      else if (one == util::dtype::complex128  ||
+               two == util::dtype::complex128) {
+        return util::dtype::complex128;
+      }
+      else if (((one == util::dtype::float64  ||
+                 one == util::dtype::uint64  ||
+                 one == util::dtype::int64  ||
+                 one == util::dtype::uint32  ||
+                 one == util::dtype::int32)  &&
+                util::is_complex(two))  ||
+               ((two == util::dtype::float64  ||
+                 two == util::dtype::uint64  ||
+                 two == util::dtype::int64  ||
+                 two == util::dtype::uint32  ||
+                 two == util::dtype::int32)  &&
+                util::is_complex(one))) {
+        return util::dtype::complex128;
+      }
+      else if (one == util::dtype::complex64  ||
+               two == util::dtype::complex64) {
+        return util::dtype::complex64;
+      }
+      else if (one == util::dtype::float128  ||
+               two == util::dtype::float128) {
+        return util::dtype::float128;
+      }
+      else if (one == util::dtype::float64  ||
+               two == util::dtype::float64) {
+        return util::dtype::float64;
+      }
+      else if ((one == util::dtype::float32  &&
+                (two == util::dtype::uint64  ||
+                 two == util::dtype::int64  ||
+                 two == util::dtype::uint32  ||
+                 two == util::dtype::int32))  ||
+               (two == util::dtype::float32  &&
+                (one == util::dtype::uint64  ||
+                 one == util::dtype::int64  ||
+                 one == util::dtype::uint32  ||
+                 one == util::dtype::int32))) {
+        return util::dtype::float64;
+      }
+      else if (one == util::dtype::float32  ||
+               two == util::dtype::float32) {
+        return util::dtype::float32;
+      }
+      else if ((one == util::dtype::float16  &&
+                (two == util::dtype::uint64  ||
+                 two == util::dtype::int64  ||
+                 two == util::dtype::uint32  ||
+                 two == util::dtype::int32))  ||
+               (two == util::dtype::float16  &&
+                (one == util::dtype::uint64  ||
+                 one == util::dtype::int64  ||
+                 one == util::dtype::uint32  ||
+                 one == util::dtype::int32))) {
+        return util::dtype::float64;
+      }
+      else if ((one == util::dtype::float16  &&
+                (two == util::dtype::uint16  ||
+                 two == util::dtype::int16))  ||
+               (two == util::dtype::float16  &&
+                (one == util::dtype::uint16  ||
+                 one == util::dtype::int16))) {
+        return util::dtype::float32;
+      }
+      else if (one == util::dtype::float16  ||
+               two == util::dtype::float16) {
+        return util::dtype::float16;
+      }
+      else if ((one == util::dtype::uint64  &&
+                util::is_signed(two))  ||
+               (two == util::dtype::uint64  &&
+                util::is_signed(one))) {
+        return util::dtype::float64;
+      }
+      else if (one == util::dtype::uint64  ||
+               two == util::dtype::uint64) {
+        return util::dtype::uint64;
+      }
+      else if (one == util::dtype::int64  ||
+               two == util::dtype::int64) {
+        return util::dtype::int64;
+      }
+      else if ((one == util::dtype::uint32  &&
+                util::is_signed(two))  ||
+               (two == util::dtype::uint32  &&
+                util::is_signed(one))) {
+        return util::dtype::int64;
+      }
+      else if (one == util::dtype::uint32  ||
+               two == util::dtype::uint32) {
+        return util::dtype::uint32;
+      }
+      else if (one == util::dtype::int32  ||
+               two == util::dtype::int32) {
+        return util::dtype::int32;
+      }
+      else if ((one == util::dtype::uint16  &&
+                util::is_signed(two))  ||
+               (two == util::dtype::uint16  &&
+                util::is_signed(one))) {
+        return util::dtype::int32;
+      }
+      else if (one == util::dtype::uint16  ||
+               two == util::dtype::uint16) {
+        return util::dtype::uint16;
+      }
+      else if (one == util::dtype::int16  ||
+               two == util::dtype::int16) {
+        return util::dtype::int16;
+      }
+      else if ((one == util::dtype::uint8  &&
+                util::is_signed(two))  ||
+               (two == util::dtype::uint8  &&
+                util::is_signed(one))) {
+        return util::dtype::int16;
+      }
+      else if (one == util::dtype::uint8  ||
+               two == util::dtype::uint8) {
+        return util::dtype::uint8;
+      }
+      else if (one == util::dtype::int8  ||
+               two == util::dtype::int8) {
+        return util::dtype::int8;
+      }
+      else if (one == util::dtype::boolean  &&
+               two == util::dtype::boolean) {
+        return util::dtype::boolean;
+      }
+      // else if (one == util::dtype::datetime64  &&
+      //          two == util::dtype::datetime64) {
+      //   return util::dtype::datetime64;
+      // }
+      // else if (one == util::dtype::timedelta64  &&
+      //          two == util::dtype::timedelta64) {
+      //   return util::dtype::timedelta64;
+      // }
+      return util::dtype::NOT_PRIMITIVE;
+    }
+
+    template <typename FROM, typename TO>
+    struct Error
+    fill_from(void* toptr,
+              int64_t tooffset,
+              const NumpyArray& from,
+              int64_t length) {
+      return kernel::NumpyArray_fill<FROM, TO>(
+        reinterpret_cast<TO*>(toptr),
+        tooffset,
+        reinterpret_cast<FROM*>(from.ptr().get()),
+        from.byteoffset() / from.itemsize(),
+        length);
+    }
+
+    template <typename TO>
+    struct Error
+    fill_frombool(void* toptr,
+                  int64_t tooffset,
+                  const NumpyArray& from,
+                  int64_t length) {
+      return kernel::NumpyArray_fill_frombool<TO>(
+        reinterpret_cast<TO*>(toptr),
+        tooffset,
+        reinterpret_cast<bool*>(from.ptr().get()),
+        from.byteoffset() / from.itemsize(),
+        length);
+    }
+
+    // Writes `length` items of the contiguous array `from` into `toptr` at
+    // `tooffset`, converting each to `to` on the way; returns false if there
+    // is no kernel for this pair of dtypes.
+    bool
+    fill_converted(util::dtype to,
+                   void* toptr,
+                   int64_t tooffset,
+                   const NumpyArray& from,
+                   int64_t length,
+                   struct Error& err) {
+      switch (to) {
+        case util::dtype::boolean:
+          switch (from.dtype()) {
+            case util::dtype::boolean:
+              err = fill_frombool<bool>(toptr, tooffset, from, length);
+              return true;
+            default:
+              return false;
+          }
+        case util::dtype::int8:
+          switch (from.dtype()) {
+            case util::dtype::boolean:
+              err = fill_frombool<int8_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int8:
+              err = fill_from<int8_t, int8_t>(toptr, tooffset, from, length);
+              return true;
+            default:
+              return false;
+          }
+        case util::dtype::int16:
+          switch (from.dtype()) {
+            case util::dtype::boolean:
+              err = fill_frombool<int16_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int8:
+              err = fill_from<int8_t, int16_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int16:
+              err = fill_from<int16_t, int16_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint8:
+              err = fill_from<uint8_t, int16_t>(toptr, tooffset, from, length);
+              return true;
+            default:
+              return false;
+          }
+        case util::dtype::int32:
+          switch (from.dtype()) {
+            case util::dtype::boolean:
+              err = fill_frombool<int32_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int8:
+              err = fill_from<int8_t, int32_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int16:
+              err = fill_from<int16_t, int32_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int32:
+              err = fill_from<int32_t, int32_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint8:
+              err = fill_from<uint8_t, int32_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint16:
+              err = fill_from<uint16_t, int32_t>(toptr, tooffset, from, length);
+              return true;
+            default:
+              return false;
+          }
+        case util::dtype::int64:
+          switch (from.dtype()) {
+            case util::dtype::boolean:
+              err = fill_frombool<int64_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int8:
+              err = fill_from<int8_t, int64_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int16:
+              err = fill_from<int16_t, int64_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int32:
+              err = fill_from<int32_t, int64_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int64:
+              err = fill_from<int64_t, int64_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint8:
+              err = fill_from<uint8_t, int64_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint16:
+              err = fill_from<uint16_t, int64_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint32:
+              err = fill_from<uint32_t, int64_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint64:
+              err = fill_from<uint64_t, int64_t>(toptr, tooffset, from, length);
+              return true;
+            default:
+              return false;
+          }
+        case util::dtype::uint8:
+          switch (from.dtype()) {
+            case util::dtype::boolean:
+              err = fill_frombool<uint8_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint8:
+              err = fill_from<uint8_t, uint8_t>(toptr, tooffset, from, length);
+              return true;
+            default:
+              return false;
+          }
+        case util::dtype::uint16:
+          switch (from.dtype()) {
+            case util::dtype::boolean:
+              err = fill_frombool<uint16_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint8:
+              err = fill_from<uint8_t, uint16_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint16:
+              err = fill_from<uint16_t, uint16_t>(toptr, tooffset, from, length);
+              return true;
+            default:
+              return false;
+          }
+        case util::dtype::uint32:
+          switch (from.dtype()) {
+            case util::dtype::boolean:
+              err = fill_frombool<uint32_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint8:
+              err = fill_from<uint8_t, uint32_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint16:
+              err = fill_from<uint16_t, uint32_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint32:
+              err = fill_from<uint32_t, uint32_t>(toptr, tooffset, from, length);
+              return true;
+            default:
+              return false;
+          }
+        case util::dtype::uint64:
+          switch (from.dtype()) {
+            case util::dtype::boolean:
+              err = fill_frombool<uint64_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint8:
+              err = fill_from<uint8_t, uint64_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint16:
+              err = fill_from<uint16_t, uint64_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint32:
+              err = fill_from<uint32_t, uint64_t>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint64:
+              err = fill_from<uint64_t, uint64_t>(toptr, tooffset, from, length);
+              return true;
+            default:
+              return false;
+          }
+        case util::dtype::float32:
+          switch (from.dtype()) {
+            case util::dtype::boolean:
+              err = fill_frombool<float>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int8:
+              err = fill_from<int8_t, float>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int16:
+              err = fill_from<int16_t, float>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int32:
+              err = fill_from<int32_t, float>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int64:
+              err = fill_from<int64_t, float>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint8:
+              err = fill_from<uint8_t, float>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint16:
+              err = fill_from<uint16_t, float>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint32:
+              err = fill_from<uint32_t, float>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint64:
+              err = fill_from<uint64_t, float>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::float32:
+              err = fill_from<float, float>(toptr, tooffset, from, length);
+              return true;
+            default:
+              return false;
+          }
+        case util::dtype::float64:
+          switch (from.dtype()) {
+            case util::dtype::boolean:
+              err = fill_frombool<double>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int8:
+              err = fill_from<int8_t, double>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int16:
+              err = fill_from<int16_t, double>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int32:
+              err = fill_from<int32_t, double>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::int64:
+              err = fill_from<int64_t, double>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint8:
+              err = fill_from<uint8_t, double>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint16:
+              err = fill_from<uint16_t, double>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint32:
+              err = fill_from<uint32_t, double>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::uint64:
+              err = fill_from<uint64_t, double>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::float32:
+              err = fill_from<float, double>(toptr, tooffset, from, length);
+              return true;
+            case util::dtype::float64:
+              err = fill_from<double, double>(toptr, tooffset, from, length);
+              return true;
+            default:
+              return false;
+          }
+        default:
+          return false;
+      }
+    }
+  }
+
+  const ContentPtr
+  NumpyArray::merge_many(const ContentPtrVec& others, bool mergebool) const {
+    // every input is written once, converted to the common dtype as it goes
+    if (ndim() == 0) {
+      return Content::merge_many(others, mergebool);
+    }
+    std::vector<NumpyArray> contiguous_arrays;
+    contiguous_arrays.push_back(contiguous());
+    util::dtype dtype = dtype_;
+    int64_t total = length();
+    for (auto other : others) {
+      ContentPtr array = other;
+      if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
+        array = raw->array();
+      }
+      if (kind_cast<EmptyArray>(array.get())  &&
+          array.get()->parameters_equal(parameters_)) {
+        continue;
+      }
+      NumpyArray* rawother = kind_cast<NumpyArray>(array.get());
+      if (rawother == nullptr  ||  rawother->ndim() != ndim()) {
+        return Content::merge_many(others, mergebool);
+      }
+      std::vector<ssize_t> other_shape = rawother->shape();
+      if (!std::equal(std::next(shape_.begin()),
+                      shape_.end(),
+                      std::next(other_shape.begin()))  ||
+          !parameters_equal(rawother->parameters())  ||
+          (!mergebool  &&
+           (dtype_ == util::dtype::boolean) !=
+           (rawother->dtype() == util::dtype::boolean))) {
+        return Content::merge_many(others, mergebool);
+      }
+      if (rawother->dtype() != dtype_  &&
+          (parameter_equals("__array__", "\"byte\"")  ||
+           parameter_equals("__array__", "\"char\""))) {
+        return Content::merge_many(others, mergebool);
+      }
+      dtype = merged_dtype(dtype, rawother->dtype());
+      if (dtype == util::dtype::NOT_PRIMITIVE) {
+        return Content::merge_many(others, mergebool);
+      }
+      contiguous_arrays.push_back(rawother->contiguous());
+      total += rawother->length();
+    }
+
+    int64_t inner = 1;
+    for (auto x = std::next(shape_.begin());  x != shape_.end();  ++x) {
+      inner *= (int64_t)(*x);
+    }
+    int64_t itemsize = util::dtype_to_itemsize(dtype);
+    std::shared_ptr<void> ptr(
+      kernel::ptr_alloc<uint8_t>(ptr_lib_, total*inner*itemsize));
+    int64_t pos = 0;
+    for (auto array : contiguous_arrays) {
+      int64_t flatlength = array.length()*inner;
+      struct Error err;
+      if (!fill_converted(dtype, ptr.get(), pos, array, flatlength, err)) {
+        return Content::merge_many(others, mergebool);
+      }
+      util::handle_error(err, classname(), nullptr);
+      pos += flatlength;
+    }
+
+    std::vector<ssize_t> shape = { (ssize_t)total };
+    std::vector<ssize_t> strides = { (ssize_t)itemsize };
+    for (int64_t i = ((int64_t)shape_.size()) - 1;  i > 0;  i--) {
+      shape.insert(std::next(shape.begin()), shape_[(size_t)i]);
+      strides.insert(strides.begin(), strides[0]*shape_[(size_t)i]);
+    }
+    return std::make_shared<NumpyArray>(Identities::none(),
+                                        parameters_,
+                                        ptr,
+                                        shape,
+                                        strides,
+                                        0,
+                                        (ssize_t)itemsize,
+                                        util::dtype_to_format(dtype),
+                                        dtype,
+                                        ptr_lib_);
+  }
+
   const ContentPtr
   NumpyArray::merge(const ContentPtr& other) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return merge(raw->array());
     }
 
@@ -1540,51 +2165,51 @@ namespace awkward {
       return merge_as_union(other);
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())) {
       return shallow_copy();
     }
     else if (IndexedArray32* rawother =
-             dynamic_cast<IndexedArray32*>(other.get())) {
+             kind_cast<IndexedArray32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_32* rawother =
-             dynamic_cast<UnionArray8_32*>(other.get())) {
+             kind_cast<UnionArray8_32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_U32* rawother =
-             dynamic_cast<UnionArray8_U32*>(other.get())) {
+             kind_cast<UnionArray8_U32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_64* rawother =
-             dynamic_cast<UnionArray8_64*>(other.get())) {
+             kind_cast<UnionArray8_64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
 
@@ -1606,163 +2231,14 @@ namespace awkward {
     }
 
     NumpyArray contiguous_self = contiguous();
-    if (NumpyArray* rawother = dynamic_cast<NumpyArray*>(other.get())) {
-      util::dtype dtype = util::dtype::NOT_PRIMITIVE;
-
+    if (NumpyArray* rawother = kind_cast<NumpyArray>(other.get())) {
       if (ndim() != rawother->ndim()) {
         throw std::invalid_argument(
           "cannot merge arrays with different shapes");
       }
 
-      if (dtype_ == util::dtype::complex256  ||
-          rawother->dtype() == util::dtype::complex256) {
-        dtype = util::dtype::complex256;
-      }
-      else if ((dtype_ == util::dtype::float128  &&
-                util::is_complex(rawother->dtype()))  ||
-               (rawother->dtype() == util::dtype::float128  &&
-                util::is_complex(dtype_))) {
-        dtype = util::dtype::complex256;
-      }
-      else if (dtype_ == util::dtype::complex128  ||
-               rawother->dtype() == util::dtype::complex128) {
-        dtype = util::dtype::complex128;
-      }
-      else if (((dtype_ == util::dtype::float64  ||
-                 dtype_ == util::dtype::uint64  ||
-                 dtype_ == util::dtype::int64  ||
-                 dtype_ == util::dtype::uint32  ||
-                 dtype_ == util::dtype::int32)  &&
-                util::is_complex(rawother->dtype()))  ||
-               ((rawother->dtype() == util::dtype::float64  ||
-                 rawother->dtype() == util::dtype::uint64  ||
-                 rawother->dtype() == util::dtype::int64  ||
-                 rawother->dtype() == util::dtype::uint32  ||
-                 rawother->dtype() == util::dtype::int32)  &&
-                util::is_complex(dtype_))) {
-        dtype = util::dtype::complex128;
-      }
-      else if (dtype_ == util::dtype::complex64  ||
-               rawother->dtype() == util::dtype::complex64) {
-        dtype = util::dtype::complex64;
-      }
-      else if (dtype_ == util::dtype::float128  ||
-               rawother->dtype() == util::dtype::float128) {
-        dtype = util::dtype::float128;
-      }
-      else if (dtype_ == util::dtype::float64  ||
-               rawother->dtype() == util::dtype::float64) {
-        dtype = util::dtype::float64;
-      }
-      else if ((dtype_ == util::dtype::float32  &&
-                (rawother->dtype() == util::dtype::uint64  ||
-                 rawother->dtype() == util::dtype::int64  ||
-                 rawother->dtype() == util::dtype::uint32  ||
-                 rawother->dtype() == util::dtype::int32))  ||
-               (rawother->dtype() == util::dtype::float32  &&
-                (dtype_ == util::dtype::uint64  ||
-                 dtype_ == util::dtype::int64  ||
-                 dtype_ == util::dtype::uint32  ||
-                 dtype_ == util::dtype::int32))) {
-        dtype = util::dtype::float64;
-      }
-      else if (dtype_ == util::dtype::float32  ||
-               rawother->dtype() == util::dtype::float32) {
-        dtype = util::dtype::float32;
-      }
-      else if ((dtype_ == util::dtype::float16  &&
-                (rawother->dtype() == util::dtype::uint64  ||
-                 rawother->dtype() == util::dtype::int64  ||
-                 rawother->dtype() == util::dtype::uint32  ||
-                 rawother->dtype() == util::dtype::int32))  ||
-               (rawother->dtype() == util::dtype::float16  &&
-                (dtype_ == util::dtype::uint64  ||
-                 dtype_ == util::dtype::int64  ||
-                 dtype_ == util::dtype::uint32  ||
-                 dtype_ == util::dtype::int32))) {
-        dtype = util::dtype::float64;
-      }
-      else if ((dtype_ == util::dtype::float16  &&
-                (rawother->dtype() == util::dtype::uint16  ||
-                 rawother->dtype() == util::dtype::int16))  ||
-               (rawother->dtype() == util::dtype::float16  &&
-                (dtype_ == util::dtype::uint16  ||
-                 dtype_ == util::dtype::int16))) {
-        dtype = util::dtype::float32;
-      }
-      else if (dtype_ == util::dtype::float16  ||
-               rawother->dtype() == util::dtype::float16) {
-        dtype = util::dtype::float16;
-      }
-      else if ((dtype_ == util::dtype::uint64  &&
-                util::is_signed(rawother->dtype()))  ||
-               (rawother->dtype() == util::dtype::uint64  &&
-                util::is_signed(dtype_))) {
-        dtype = util::dtype::float64;
-      }
-      else if (dtype_ == util::dtype::uint64  ||
-               rawother->dtype() == util::dtype::uint64) {
-        dtype = util::dtype::uint64;
-      }
-      else if (dtype_ == util::dtype::int64  ||
-               rawother->dtype() == util::dtype::int64) {
-        dtype = util::dtype::int64;
-      }
-      else if ((dtype_ == util::dtype::uint32  &&
-                util::is_signed(rawother->dtype()))  ||
-               (rawother->dtype() == util::dtype::uint32  &&
-                util::is_signed(dtype_))) {
-        dtype = util::dtype::int64;
-      }
-      else if (dtype_ == util::dtype::uint32  ||
-               rawother->dtype() == util::dtype::uint32) {
-        dtype = util::dtype::uint32;
-      }
-      else if (dtype_ == util::dtype::int32  ||
-               rawother->dtype() == util::dtype::int32) {
-        dtype = util::dtype::int32;
-      }
-      else if ((dtype_ == util::dtype::uint16  &&
-                util::is_signed(rawother->dtype()))  ||
-               (rawother->dtype() == util::dtype::uint16  &&
-                util::is_signed(dtype_))) {
-        dtype = util::dtype::int32;
-      }
-      else if (dtype_ == util::dtype::uint16  ||
-               rawother->dtype() == util::dtype::uint16) {
-        dtype = util::dtype::uint16;
-      }
-      else if (dtype_ == util::dtype::int16  ||
-               rawother->dtype() == util::dtype::int16) {
-        dtype = util::dtype::int16;
-      }
-      else if ((dtype_ == util::dtype::uint8  &&
-                util::is_signed(rawother->dtype()))  ||
-               (rawother->dtype() == util::dtype::uint8  &&
-                util::is_signed(dtype_))) {
-        dtype = util::dtype::int16;
-      }
-      else if (dtype_ == util::dtype::uint8  ||
-               rawother->dtype() == util::dtype::uint8) {
-        dtype = util::dtype::uint8;
-      }
-      else if (dtype_ == util::dtype::int8  ||
-               rawother->dtype() == util::dtype::int8) {
-        dtype = util::dtype::int8;
-      }
-      else if (dtype_ == util::dtype::boolean  &&
-               rawother->dtype() == util::dtype::boolean) {
-        dtype = util::dtype::boolean;
-      }
-      // else if (dtype_ == util::dtype::datetime64  &&
-      //          rawother->dtype() == util::dtype::datetime64) {
-      //   dtype = util::dtype::datetime64;
-      // }
-      // else if (dtype_ == util::dtype::timedelta64  &&
-      //          rawother->dtype() == util::dtype::timedelta64) {
-      //   dtype = util::dtype::timedelta64;
-      // }
-      else {
+      util::dtype dtype = merged_dtype(dtype_, rawother->dtype());
+      if (dtype == util::dtype::NOT_PRIMITIVE) {
         throw std::invalid_argument(
           std::string("cannot merge Numpy format \"") + format_
           + std::string("\" with \"") + rawother->format() + std::string("\""));
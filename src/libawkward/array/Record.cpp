@@ -60,6 +60,11 @@ namespace awkward {
     return "Record";
   }
 
+  Content::Kind
+  Record::kind() const {
+    return Kind::Record;
+  }
+
   const IdentitiesPtr
   Record::identities() const {
     IdentitiesPtr recidentities = array_.get()->identities();
@@ -273,6 +278,15 @@ namespace awkward {
     return shallow_copy();
   }
 
+  const ContentPtr
+  Record::packed() const {
+    ContentPtr out =
+      array_.get()->getitem_range_nowrap(at_, at_ + 1).get()->packed();
+    // a packed RecordArray is always a RecordArray
+    return std::make_shared<Record>(
+      std::static_pointer_cast<RecordArray>(out), 0);
+  }
+
   const ContentPtr
   Record::num(int64_t axis, int64_t depth) const {
     int64_t posaxis = axis_wrap_if_negative(axis);
@@ -476,7 +490,7 @@ namespace awkward {
   Record::getitem(const Slice& where) const {
     ContentPtr next = array_.get()->getitem_range_nowrap(at_, at_ + 1);
 
-    SliceItemPtr nexthead = where.head();
+    SliceItemPtr nexthead = SliceMask::tostandard(where.head());
     Slice nexttail = where.tail();
     Index64 nextadvanced(0);
     ContentPtr out = next.get()->getitem_next(nexthead,
@@ -431,6 +431,11 @@ namespace awkward {
     return "RecordArray";
   }
 
+  Content::Kind
+  RecordArray::kind() const {
+    return Kind::RecordArray;
+  }
+
   void
   RecordArray::setidentities() {
     int64_t len = length();
@@ -825,6 +830,37 @@ namespace awkward {
     return shallow_copy();
   }
 
+  const ContentPtr
+  RecordArray::packed() const {
+    ContentPtrVec contents;
+    for (auto content : contents_) {
+      contents.push_back(
+        content.get()->getitem_range_nowrap(0, length_).get()->packed());
+    }
+    return std::make_shared<RecordArray>(identities_,
+                                         parameters_,
+                                         contents,
+                                         recordlookup_,
+                                         length_);
+  }
+
+  const ContentPtr
+  RecordArray::packed_carry(const Index64& nextcarry) const {
+    IdentitiesPtr identities(nullptr);
+    if (identities_.get() != nullptr) {
+      identities = identities_.get()->getitem_carry_64(nextcarry);
+    }
+    ContentPtrVec contents;
+    for (auto content : contents_) {
+      contents.push_back(content.get()->packed_carry(nextcarry));
+    }
+    return std::make_shared<RecordArray>(identities,
+                                         parameters_,
+                                         contents,
+                                         recordlookup_,
+                                         nextcarry.length());
+  }
+
   const ContentPtr
   RecordArray::num(int64_t axis, int64_t depth) const {
     int64_t posaxis = axis_wrap_if_negative(axis);
@@ -891,7 +927,7 @@ namespace awkward {
 
   bool
   RecordArray::mergeable(const ContentPtr& other, bool mergebool) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return mergeable(raw->array(), mergebool);
     }
 
@@ -899,47 +935,47 @@ namespace awkward {
       return false;
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())  ||
-        dynamic_cast<UnionArray8_32*>(other.get())  ||
-        dynamic_cast<UnionArray8_U32*>(other.get())  ||
-        dynamic_cast<UnionArray8_64*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())  ||
+        kind_cast<UnionArray8_32>(other.get())  ||
+        kind_cast<UnionArray8_U32>(other.get())  ||
+        kind_cast<UnionArray8_64>(other.get())) {
       return true;
     }
     else if (IndexedArray32* rawother =
-             dynamic_cast<IndexedArray32*>(other.get())) {
+             kind_cast<IndexedArray32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
 
     if (RecordArray* rawother =
-        dynamic_cast<RecordArray*>(other.get())) {
+        kind_cast<RecordArray>(other.get())) {
       if (istuple()  &&  rawother->istuple()) {
         if (numfields() == rawother->numfields()) {
           for (int64_t i = 0;  i < numfields();  i++) {
@@ -972,9 +1008,56 @@ namespace awkward {
     }
   }
 
+  const ContentPtr
+  RecordArray::merge_many(const ContentPtrVec& others, bool mergebool) const {
+    // only records with the same fields are concatenated at once, with one
+    // merge_many of each field
+    std::vector<const RecordArray*> records = { this };
+    for (auto other : others) {
+      ContentPtr array = other;
+      if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
+        array = raw->array();
+      }
+      if (kind_cast<EmptyArray>(array.get())  &&
+          array.get()->parameters_equal(parameters_)) {
+        continue;
+      }
+      RecordArray* rawother = kind_cast<RecordArray>(array.get());
+      if (rawother == nullptr  ||
+          numfields() == 0  ||
+          istuple() != rawother->istuple()  ||
+          !mergeable(array, mergebool)) {
+        return Content::merge_many(others, mergebool);
+      }
+      records.push_back(rawother);
+    }
+
+    int64_t total = 0;
+    for (auto record : records) {
+      total += record->length();
+    }
+    ContentPtrVec contents;
+    for (int64_t i = 0;  i < numfields();  i++) {
+      ContentPtr mine = field(i).get()->getitem_range_nowrap(0, length());
+      ContentPtrVec theirs;
+      for (size_t j = 1;  j < records.size();  j++) {
+        ContentPtr theirfield = istuple() ? records[j]->field(i)
+                                          : records[j]->field(key(i));
+        theirs.push_back(
+          theirfield.get()->getitem_range_nowrap(0, records[j]->length()));
+      }
+      contents.push_back(mine.get()->merge_many(theirs, mergebool));
+    }
+    return std::make_shared<RecordArray>(Identities::none(),
+                                         parameters_,
+                                         contents,
+                                         recordlookup_,
+                                         total);
+  }
+
   const ContentPtr
   RecordArray::merge(const ContentPtr& other) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return merge(raw->array());
     }
 
@@ -982,56 +1065,56 @@ namespace awkward {
       return merge_as_union(other);
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())) {
       return shallow_copy();
     }
     else if (IndexedArray32* rawother =
-             dynamic_cast<IndexedArray32*>(other.get())) {
+             kind_cast<IndexedArray32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_32* rawother =
-             dynamic_cast<UnionArray8_32*>(other.get())) {
+             kind_cast<UnionArray8_32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_U32* rawother =
-             dynamic_cast<UnionArray8_U32*>(other.get())) {
+             kind_cast<UnionArray8_U32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_64* rawother =
-             dynamic_cast<UnionArray8_64*>(other.get())) {
+             kind_cast<UnionArray8_64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
 
     if (RecordArray* rawother =
-        dynamic_cast<RecordArray*>(other.get())) {
+        kind_cast<RecordArray>(other.get())) {
       int64_t mylength = length();
       int64_t theirlength = rawother->length();
 
@@ -272,6 +272,11 @@ namespace awkward {
     return "RegularArray";
   }
 
+  Content::Kind
+  RegularArray::kind() const {
+    return Kind::RegularArray;
+  }
+
   void
   RegularArray::setidentities(const IdentitiesPtr& identities) {
     if (identities.get() == nullptr) {
@@ -547,6 +552,15 @@ namespace awkward {
       content_.get()->getitem_fields(keys), size_);
   }
 
+  const ContentPtr
+  RegularArray::getitem_jagged_mask(const Index64& offsets,
+                                    const Index8& mask) const {
+    if (offsets.length() != length() + 1  ||  identities_.get() != nullptr) {
+      return Content::getitem_jagged_mask(offsets, mask);
+    }
+    return toListOffsetArray64(true).get()->getitem_jagged_mask(offsets, mask);
+  }
+
   const ContentPtr
   RegularArray::carry(const Index64& carry, bool allow_lazy) const {
     Index64 nextcarry(carry.length()*size_);
@@ -603,6 +617,37 @@ namespace awkward {
     return shallow_copy();
   }
 
+  const ContentPtr
+  RegularArray::packed() const {
+    ContentPtr content =
+      content_.get()->getitem_range_nowrap(0, length()*size_).get()->packed();
+    return std::make_shared<RegularArray>(identities_,
+                                          parameters_,
+                                          content,
+                                          size_);
+  }
+
+  const ContentPtr
+  RegularArray::packed_carry(const Index64& nextcarry) const {
+    Index64 nextcontentcarry(nextcarry.length()*size_);
+    struct Error err = kernel::RegularArray_getitem_carry_64(
+      nextcontentcarry.ptr().get(),
+      nextcarry.ptr().get(),
+      nextcarry.length(),
+      size_);
+    util::handle_error(err, classname(), identities_.get());
+
+    IdentitiesPtr identities(nullptr);
+    if (identities_.get() != nullptr) {
+      identities = identities_.get()->getitem_carry_64(nextcarry);
+    }
+    return std::make_shared<RegularArray>(
+      identities,
+      parameters_,
+      content_.get()->packed_carry(nextcontentcarry),
+      size_);
+  }
+
   const ContentPtr
   RegularArray::num(int64_t axis, int64_t depth) const {
     int64_t posaxis = axis_wrap_if_negative(axis);
@@ -637,7 +682,7 @@ namespace awkward {
 
   bool
   RegularArray::mergeable(const ContentPtr& other, bool mergebool) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return mergeable(raw->array(), mergebool);
     }
 
@@ -645,71 +690,71 @@ namespace awkward {
       return false;
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())  ||
-        dynamic_cast<UnionArray8_32*>(other.get())  ||
-        dynamic_cast<UnionArray8_U32*>(other.get())  ||
-        dynamic_cast<UnionArray8_64*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())  ||
+        kind_cast<UnionArray8_32>(other.get())  ||
+        kind_cast<UnionArray8_U32>(other.get())  ||
+        kind_cast<UnionArray8_64>(other.get())) {
       return true;
     }
     else if (IndexedArray32* rawother =
-             dynamic_cast<IndexedArray32*>(other.get())) {
+             kind_cast<IndexedArray32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return mergeable(rawother->content(), mergebool);
     }
 
     if (RegularArray* rawother =
-        dynamic_cast<RegularArray*>(other.get())) {
+        kind_cast<RegularArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListArray32* rawother =
-             dynamic_cast<ListArray32*>(other.get())) {
+             kind_cast<ListArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListArrayU32* rawother =
-             dynamic_cast<ListArrayU32*>(other.get())) {
+             kind_cast<ListArrayU32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListArray64* rawother =
-             dynamic_cast<ListArray64*>(other.get())) {
+             kind_cast<ListArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListOffsetArray32* rawother =
-             dynamic_cast<ListOffsetArray32*>(other.get())) {
+             kind_cast<ListOffsetArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListOffsetArrayU32* rawother =
-             dynamic_cast<ListOffsetArrayU32*>(other.get())) {
+             kind_cast<ListOffsetArrayU32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ListOffsetArray64* rawother =
-             dynamic_cast<ListOffsetArray64*>(other.get())) {
+             kind_cast<ListOffsetArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else {
@@ -719,7 +764,7 @@ namespace awkward {
 
   const ContentPtr
   RegularArray::merge(const ContentPtr& other) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return merge(raw->array());
     }
 
@@ -727,55 +772,55 @@ namespace awkward {
       return merge_as_union(other);
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())) {
       return shallow_copy();
     }
     else if (IndexedArray32* rawother =
-             dynamic_cast<IndexedArray32*>(other.get())) {
+             kind_cast<IndexedArray32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_32* rawother =
-             dynamic_cast<UnionArray8_32*>(other.get())) {
+             kind_cast<UnionArray8_32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_U32* rawother =
-             dynamic_cast<UnionArray8_U32*>(other.get())) {
+             kind_cast<UnionArray8_U32>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
     else if (UnionArray8_64* rawother =
-             dynamic_cast<UnionArray8_64*>(other.get())) {
+             kind_cast<UnionArray8_64>(other.get())) {
       return rawother->reverse_merge(shallow_copy());
     }
 
-    if (RegularArray* rawother = dynamic_cast<RegularArray*>(other.get())) {
+    if (RegularArray* rawother = kind_cast<RegularArray>(other.get())) {
       if (size_ == rawother->size()) {
         ContentPtr mine =
           content_.get()->getitem_range_nowrap(0, size_*length());
@@ -792,12 +837,12 @@ namespace awkward {
         return toListOffsetArray64(true).get()->merge(other);
       }
     }
-    else if (dynamic_cast<ListArray32*>(other.get())  ||
-             dynamic_cast<ListArrayU32*>(other.get())  ||
-             dynamic_cast<ListArray64*>(other.get())  ||
-             dynamic_cast<ListOffsetArray32*>(other.get())  ||
-             dynamic_cast<ListOffsetArrayU32*>(other.get())  ||
-             dynamic_cast<ListOffsetArray64*>(other.get())) {
+    else if (kind_cast<ListArray32>(other.get())  ||
+             kind_cast<ListArrayU32>(other.get())  ||
+             kind_cast<ListArray64>(other.get())  ||
+             kind_cast<ListOffsetArray32>(other.get())  ||
+             kind_cast<ListOffsetArrayU32>(other.get())  ||
+             kind_cast<ListOffsetArray64>(other.get())) {
       return toListOffsetArray64(true).get()->merge(other);
     }
     else {
@@ -1038,9 +1083,9 @@ namespace awkward {
                                        stable,
                                        keepdims);
     if (RegularArray* raw1 =
-            dynamic_cast<RegularArray*>(out.get())) {
+            kind_cast<RegularArray>(out.get())) {
       if (ListOffsetArray64* raw2 =
-              dynamic_cast<ListOffsetArray64*>(raw1->content().get())) {
+              kind_cast<ListOffsetArray64>(raw1->content().get())) {
         return std::make_shared<RegularArray>(
             raw1->identities(),
             raw1->parameters(),
@@ -1068,9 +1113,9 @@ namespace awkward {
                                        stable,
                                        keepdims);
     if (RegularArray* raw1 =
-            dynamic_cast<RegularArray*>(out.get())) {
+            kind_cast<RegularArray>(out.get())) {
       if (ListOffsetArray64* raw2 =
-              dynamic_cast<ListOffsetArray64*>(raw1->content().get())) {
+              kind_cast<ListOffsetArray64>(raw1->content().get())) {
         return std::make_shared<RegularArray>(
             raw1->identities(),
             raw1->parameters(),
@@ -360,7 +360,8 @@ namespace awkward {
       : Content(identities, parameters)
       , tags_(tags)
       , index_(index)
-      , contents_(contents) {
+      , contents_(contents)
+      , projectionid_(newprojectionid()) {
     if (contents_.empty()) {
       throw std::invalid_argument("UnionArray must have at least one content");
     }
@@ -417,6 +418,15 @@ namespace awkward {
         + std::string(" with ") + std::to_string(numcontents())
         + std::string(" contents"));
     }
+    ArrayCachePtr cache = Content::memoize_projections();
+    std::string key;
+    if (cache.get() != nullptr) {
+      key = projection_key(projectionid_, index);
+      ContentPtr memo = cache.get()->get(key);
+      if (memo.get() != nullptr) {
+        return memo.get()->shallow_copy();
+      }
+    }
     int64_t lentags = tags_.length();
     if (index_.length() < lentags) {
       util::handle_error(
@@ -437,7 +447,13 @@ namespace awkward {
       index);
     util::handle_error(err, classname(), identities_.get());
     Index64 nextcarry(tmpcarry.ptr(), 0, lenout);
-    return contents_[(size_t)index].get()->carry(nextcarry, false);
+    ContentPtr out = contents_[(size_t)index].get()->carry(nextcarry, false);
+
+    if (cache.get() != nullptr) {
+      cache.get()->set(key, out);
+      return out.get()->shallow_copy();
+    }
+    return out;
   }
 
   template <typename T, typename I>
@@ -456,7 +472,7 @@ namespace awkward {
 
     for (size_t i = 0;  i < contents_.size();  i++) {
       if (UnionArray8_32* rawcontent =
-          dynamic_cast<UnionArray8_32*>(contents_[i].get())) {
+          kind_cast<UnionArray8_32>(contents_[i].get())) {
         Index8 innertags = rawcontent->tags();
         Index32 innerindex = rawcontent->index();
         ContentPtrVec innercontents = rawcontent->contents();
@@ -511,7 +527,7 @@ namespace awkward {
         }
       }
       else if (UnionArray8_U32* rawcontent =
-               dynamic_cast<UnionArray8_U32*>(contents_[i].get())) {
+               kind_cast<UnionArray8_U32>(contents_[i].get())) {
         Index8 innertags = rawcontent->tags();
         IndexU32 innerindex = rawcontent->index();
         ContentPtrVec innercontents = rawcontent->contents();
@@ -566,7 +582,7 @@ namespace awkward {
         }
       }
       else if (UnionArray8_64* rawcontent =
-               dynamic_cast<UnionArray8_64*>(contents_[i].get())) {
+               kind_cast<UnionArray8_64>(contents_[i].get())) {
         Index8 innertags = rawcontent->tags();
         Index64 innerindex = rawcontent->index();
         ContentPtrVec innercontents = rawcontent->contents();
@@ -695,6 +711,12 @@ namespace awkward {
     return "UnrecognizedUnionArray";
   }
 
+  template <typename T, typename I>
+  Content::Kind
+  UnionArrayOf<T, I>::kind() const {
+    return ContentKindOf<UnionArrayOf<T, I>>::value();
+  }
+
   template <typename T, typename I>
   void
   UnionArrayOf<T, I>::setidentities() {
@@ -729,6 +751,7 @@ namespace awkward {
   template <typename T, typename I>
   void
   UnionArrayOf<T, I>::setidentities(const IdentitiesPtr& identities) {
+    projectionid_ = newprojectionid();
     if (identities.get() == nullptr) {
       for (auto content : contents_) {
         content.get()->setidentities(identities);
@@ -1273,6 +1296,43 @@ namespace awkward {
     return simplify_uniontype(false);
   }
 
+  template <typename T, typename I>
+  const ContentPtr
+  UnionArrayOf<T, I>::packed() const {
+    int64_t lentags = tags_.length();
+    if (index_.length() < lentags) {
+      util::handle_error(
+        failure("len(index) < len(tags)", kSliceNone, kSliceNone),
+        classname(),
+        identities_.get());
+    }
+    IndexOf<T> tags = tags_.deep_copy();
+    Index64 index = UnionArrayOf<T, int64_t>::regular_index(tags);
+    ContentPtrVec contents;
+    for (int64_t i = 0;  i < numcontents();  i++) {
+      int64_t lenout;
+      Index64 tmpcarry(lentags);
+      struct Error err = kernel::UnionArray_project_64<T, I>(
+        &lenout,
+        tmpcarry.ptr().get(),
+        tags_.ptr().get(),
+        tags_.offset(),
+        index_.ptr().get(),
+        index_.offset(),
+        lentags,
+        i);
+      util::handle_error(err, classname(), identities_.get());
+      Index64 nextcarry(tmpcarry.ptr(), 0, lenout);
+      contents.push_back(
+        contents_[(size_t)i].get()->packed_carry(nextcarry));
+    }
+    return std::make_shared<UnionArrayOf<T, int64_t>>(identities_,
+                                                      parameters_,
+                                                      tags,
+                                                      index,
+                                                      contents);
+  }
+
   template <typename T, typename I>
   const ContentPtr
   UnionArrayOf<T, I>::num(int64_t axis, int64_t depth) const {
@@ -1373,7 +1433,7 @@ namespace awkward {
   bool
   UnionArrayOf<T, I>::mergeable(const ContentPtr& other,
                                 bool mergebool) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return mergeable(raw->array(), mergebool);
     }
 
@@ -1386,7 +1446,7 @@ namespace awkward {
   template <typename T, typename I>
   const ContentPtr
   UnionArrayOf<T, I>::reverse_merge(const ContentPtr& other) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return reverse_merge(raw->array());
     }
 
@@ -1470,7 +1530,7 @@ namespace awkward {
   template <typename T, typename I>
   const ContentPtr
   UnionArrayOf<T, I>::merge(const ContentPtr& other) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return merge(raw->array());
     }
 
@@ -1478,7 +1538,7 @@ namespace awkward {
       return merge_as_union(other);
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())) {
       return shallow_copy();
     }
 
@@ -1534,7 +1594,7 @@ namespace awkward {
 
     ContentPtrVec contents(contents_.begin(), contents_.end());
     if (UnionArray8_32* rawother =
-        dynamic_cast<UnionArray8_32*>(other.get())) {
+        kind_cast<UnionArray8_32>(other.get())) {
       ContentPtrVec other_contents = rawother->contents();
       contents.insert(contents.end(),
                       other_contents.begin(),
@@ -1562,7 +1622,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (UnionArray8_U32* rawother =
-             dynamic_cast<UnionArray8_U32*>(other.get())) {
+             kind_cast<UnionArray8_U32>(other.get())) {
       ContentPtrVec other_contents = rawother->contents();
       contents.insert(contents.end(),
                       other_contents.begin(),
@@ -1590,7 +1650,7 @@ namespace awkward {
                          rawother->identities().get());
     }
     else if (UnionArray8_64* rawother =
-             dynamic_cast<UnionArray8_64*>(other.get())) {
+             kind_cast<UnionArray8_64>(other.get())) {
       ContentPtrVec other_contents = rawother->contents();
       contents.insert(contents.end(),
                       other_contents.begin(),
@@ -1649,7 +1709,7 @@ namespace awkward {
   UnionArrayOf<T, I>::asslice() const {
     ContentPtr simplified = simplify_uniontype(false);
     if (UnionArray8_32* raw =
-        dynamic_cast<UnionArray8_32*>(simplified.get())) {
+        kind_cast<UnionArray8_32>(simplified.get())) {
       if (raw->numcontents() == 1) {
         return raw->content(0).get()->asslice();
       }
@@ -1659,7 +1719,7 @@ namespace awkward {
       }
     }
     else if (UnionArray8_U32* raw =
-             dynamic_cast<UnionArray8_U32*>(simplified.get())) {
+             kind_cast<UnionArray8_U32>(simplified.get())) {
       if (raw->numcontents() == 1) {
         return raw->content(0).get()->asslice();
       }
@@ -1669,7 +1729,7 @@ namespace awkward {
       }
     }
     else if (UnionArray8_64* raw =
-             dynamic_cast<UnionArray8_64*>(simplified.get())) {
+             kind_cast<UnionArray8_64>(simplified.get())) {
       if (raw->numcontents() == 1) {
         return raw->content(0).get()->asslice();
       }
@@ -1749,9 +1809,9 @@ namespace awkward {
                                   bool mask,
                                   bool keepdims) const {
     ContentPtr simplified = simplify_uniontype(true);
-    if (dynamic_cast<UnionArray8_32*>(simplified.get())  ||
-        dynamic_cast<UnionArray8_U32*>(simplified.get())  ||
-        dynamic_cast<UnionArray8_64*>(simplified.get())) {
+    if (kind_cast<UnionArray8_32>(simplified.get())  ||
+        kind_cast<UnionArray8_U32>(simplified.get())  ||
+        kind_cast<UnionArray8_64>(simplified.get())) {
       throw std::invalid_argument(
         std::string("cannot reduce (call '") + reducer.name()
         + std::string("' on) an irreducible ") + classname());
@@ -1828,9 +1888,9 @@ namespace awkward {
                                 bool stable,
                                 bool keepdims) const {
     ContentPtr simplified = simplify_uniontype(true);
-    if (dynamic_cast<UnionArray8_32*>(simplified.get())  ||
-        dynamic_cast<UnionArray8_U32*>(simplified.get())  ||
-        dynamic_cast<UnionArray8_64*>(simplified.get())) {
+    if (kind_cast<UnionArray8_32>(simplified.get())  ||
+        kind_cast<UnionArray8_U32>(simplified.get())  ||
+        kind_cast<UnionArray8_64>(simplified.get())) {
       throw std::invalid_argument(std::string("cannot sort ") + classname());
     }
     return simplified.get()->sort_next(negaxis,
@@ -1852,9 +1912,9 @@ namespace awkward {
                                    bool stable,
                                    bool keepdims) const {
     ContentPtr simplified = simplify_uniontype(true);
-    if (dynamic_cast<UnionArray8_32*>(simplified.get())  ||
-        dynamic_cast<UnionArray8_U32*>(simplified.get())  ||
-        dynamic_cast<UnionArray8_64*>(simplified.get())) {
+    if (kind_cast<UnionArray8_32>(simplified.get())  ||
+        kind_cast<UnionArray8_U32>(simplified.get())  ||
+        kind_cast<UnionArray8_64>(simplified.get())) {
       throw std::invalid_argument(std::string("cannot sort ") + classname());
     }
     return simplified.get()->argsort_next(negaxis,
@@ -1966,9 +2026,9 @@ namespace awkward {
                                                   const S& slicecontent,
                                                   const Slice& tail) const {
     ContentPtr simplified = simplify_uniontype(false);
-    if (dynamic_cast<UnionArray8_32*>(simplified.get())  ||
-        dynamic_cast<UnionArray8_U32*>(simplified.get())  ||
-        dynamic_cast<UnionArray8_64*>(simplified.get())) {
+    if (kind_cast<UnionArray8_32>(simplified.get())  ||
+        kind_cast<UnionArray8_U32>(simplified.get())  ||
+        kind_cast<UnionArray8_64>(simplified.get())) {
       throw std::invalid_argument(
         "cannot apply jagged slices to irreducible union arrays");
     }
@@ -191,14 +191,14 @@ namespace awkward {
 
   const ContentPtr
   UnmaskedArray::simplify_optiontype() const {
-    if (dynamic_cast<IndexedArray32*>(content_.get())        ||
-        dynamic_cast<IndexedArrayU32*>(content_.get())       ||
-        dynamic_cast<IndexedArray64*>(content_.get())        ||
-        dynamic_cast<IndexedOptionArray32*>(content_.get())  ||
-        dynamic_cast<IndexedOptionArray64*>(content_.get())  ||
-        dynamic_cast<ByteMaskedArray*>(content_.get())       ||
-        dynamic_cast<BitMaskedArray*>(content_.get())        ||
-        dynamic_cast<UnmaskedArray*>(content_.get())) {
+    if (kind_cast<IndexedArray32>(content_.get())        ||
+        kind_cast<IndexedArrayU32>(content_.get())       ||
+        kind_cast<IndexedArray64>(content_.get())        ||
+        kind_cast<IndexedOptionArray32>(content_.get())  ||
+        kind_cast<IndexedOptionArray64>(content_.get())  ||
+        kind_cast<ByteMaskedArray>(content_.get())       ||
+        kind_cast<BitMaskedArray>(content_.get())        ||
+        kind_cast<UnmaskedArray>(content_.get())) {
       return content_;
     }
     else {
@@ -224,6 +224,11 @@ namespace awkward {
     return "UnmaskedArray";
   }
 
+  Content::Kind
+  UnmaskedArray::kind() const {
+    return Kind::UnmaskedArray;
+  }
+
   void
   UnmaskedArray::setidentities(const IdentitiesPtr& identities) {
     if (identities.get() == nullptr) {
@@ -556,6 +561,25 @@ namespace awkward {
     return simplify_optiontype();
   }
 
+  const ContentPtr
+  UnmaskedArray::packed() const {
+    return std::make_shared<UnmaskedArray>(identities_,
+                                           parameters_,
+                                           content_.get()->packed());
+  }
+
+  const ContentPtr
+  UnmaskedArray::packed_carry(const Index64& nextcarry) const {
+    IdentitiesPtr identities(nullptr);
+    if (identities_.get() != nullptr) {
+      identities = identities_.get()->getitem_carry_64(nextcarry);
+    }
+    return std::make_shared<UnmaskedArray>(
+      identities,
+      parameters_,
+      content_.get()->packed_carry(nextcarry));
+  }
+
   const ContentPtr
   UnmaskedArray::num(int64_t axis, int64_t depth) const {
     int64_t posaxis = axis_wrap_if_negative(axis);
@@ -597,7 +621,7 @@ namespace awkward {
 
   bool
   UnmaskedArray::mergeable(const ContentPtr& other, bool mergebool) const {
-    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(other.get())) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(other.get())) {
       return mergeable(raw->array(), mergebool);
     }
 
@@ -605,43 +629,43 @@ namespace awkward {
       return false;
     }
 
-    if (dynamic_cast<EmptyArray*>(other.get())  ||
-        dynamic_cast<UnionArray8_32*>(other.get())  ||
-        dynamic_cast<UnionArray8_U32*>(other.get())  ||
-        dynamic_cast<UnionArray8_64*>(other.get())) {
+    if (kind_cast<EmptyArray>(other.get())  ||
+        kind_cast<UnionArray8_32>(other.get())  ||
+        kind_cast<UnionArray8_U32>(other.get())  ||
+        kind_cast<UnionArray8_64>(other.get())) {
       return true;
     }
 
     if (IndexedArray32* rawother =
-        dynamic_cast<IndexedArray32*>(other.get())) {
+        kind_cast<IndexedArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArrayU32* rawother =
-             dynamic_cast<IndexedArrayU32*>(other.get())) {
+             kind_cast<IndexedArrayU32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedArray64* rawother =
-             dynamic_cast<IndexedArray64*>(other.get())) {
+             kind_cast<IndexedArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray32* rawother =
-             dynamic_cast<IndexedOptionArray32*>(other.get())) {
+             kind_cast<IndexedOptionArray32>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (IndexedOptionArray64* rawother =
-             dynamic_cast<IndexedOptionArray64*>(other.get())) {
+             kind_cast<IndexedOptionArray64>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (ByteMaskedArray* rawother =
-             dynamic_cast<ByteMaskedArray*>(other.get())) {
+             kind_cast<ByteMaskedArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (BitMaskedArray* rawother =
-             dynamic_cast<BitMaskedArray*>(other.get())) {
+             kind_cast<BitMaskedArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else if (UnmaskedArray* rawother =
-             dynamic_cast<UnmaskedArray*>(other.get())) {
+             kind_cast<UnmaskedArray>(other.get())) {
       return content_.get()->mergeable(rawother->content(), mergebool);
     }
     else {
@@ -653,7 +677,7 @@ namespace awkward {
   UnmaskedArray::reverse_merge(const ContentPtr& other) const {
     ContentPtr indexedoptionarray = toIndexedOptionArray64();
     IndexedOptionArray64* raw =
-      dynamic_cast<IndexedOptionArray64*>(indexedoptionarray.get());
+      kind_cast<IndexedOptionArray64>(indexedoptionarray.get());
     return raw->reverse_merge(other);
   }
 
@@ -781,7 +805,7 @@ namespace awkward {
                                                              ascending,
                                                              stable,
                                                              keepdims);
-    if (RegularArray* raw = dynamic_cast<RegularArray*>(out.get())) {
+    if (RegularArray* raw = kind_cast<RegularArray>(out.get())) {
       std::shared_ptr<Content> wrapped = std::make_shared<UnmaskedArray>(
           Identities::none(),
           parameters_,
@@ -812,7 +836,7 @@ namespace awkward {
                                                                 ascending,
                                                                 stable,
                                                                 keepdims);
-    if (RegularArray* raw = dynamic_cast<RegularArray*>(out.get())) {
+    if (RegularArray* raw = kind_cast<RegularArray>(out.get())) {
       std::shared_ptr<Content> wrapped = std::make_shared<UnmaskedArray>(
           Identities::none(),
           parameters_,
@@ -1,10 +1,22 @@
 // BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
 
+#include <atomic>
+#include <future>
 #include <iomanip>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 
+#include "awkward/array/BitMaskedArray.h"
+#include "awkward/array/ByteMaskedArray.h"
+#include "awkward/array/IndexedArray.h"
+#include "awkward/array/ListArray.h"
+#include "awkward/array/ListOffsetArray.h"
+#include "awkward/array/NumpyArray.h"
+#include "awkward/array/RecordArray.h"
 #include "awkward/array/RegularArray.h"
+#include "awkward/array/UnmaskedArray.h"
 
 #include "awkward/array/VirtualArray.h"
 
@@ -241,6 +253,149 @@ namespace awkward {
 
   ////////// VirtualArray
 
+  /// @brief Form of `getitem_field(keys[0])` (if `single`) or
+  /// `getitem_fields(keys)` applied to an array of Form `form`, or
+  /// `nullptr` if it cannot be known without generating the array.
+  ///
+  /// This follows the Content implementations: list and option nodes pass
+  /// the projection to their contents and drop their parameters.
+  const FormPtr
+  virtualarray_project_form(const FormPtr& form,
+                            const std::vector<std::string>& keys,
+                            bool single) {
+    FormPtr none(nullptr);
+    if (form.get() == nullptr) {
+      return none;
+    }
+    else if (RecordForm* raw = dynamic_cast<RecordForm*>(form.get())) {
+      for (auto key : keys) {
+        if (!raw->haskey(key)) {
+          // let the generated array raise the error
+          return none;
+        }
+      }
+      std::vector<FormPtr> contents;
+      for (auto key : keys) {
+        FormPtr content = raw->content(key);
+        // slicing a VirtualArray of unknown length to the record's length
+        // would give it a known length
+        if (VirtualForm* virt = dynamic_cast<VirtualForm*>(content.get())) {
+          if (!virt->has_length()) {
+            return none;
+          }
+        }
+        contents.push_back(content);
+      }
+      if (single) {
+        return contents[0];
+      }
+      util::RecordLookupPtr recordlookup(nullptr);
+      if (!raw->istuple()) {
+        recordlookup = std::make_shared<util::RecordLookup>(keys);
+      }
+      return std::make_shared<RecordForm>(raw->has_identities(),
+                                          raw->parameters(),
+                                          FormKey(nullptr),
+                                          recordlookup,
+                                          contents);
+    }
+    else if (ListOffsetForm* raw = dynamic_cast<ListOffsetForm*>(form.get())) {
+      FormPtr content = virtualarray_project_form(raw->content(), keys, single);
+      if (content.get() == nullptr) {
+        return none;
+      }
+      return std::make_shared<ListOffsetForm>(raw->has_identities(),
+                                              util::Parameters(),
+                                              FormKey(nullptr),
+                                              raw->offsets(),
+                                              content);
+    }
+    else if (ListForm* raw = dynamic_cast<ListForm*>(form.get())) {
+      FormPtr content = virtualarray_project_form(raw->content(), keys, single);
+      if (content.get() == nullptr) {
+        return none;
+      }
+      return std::make_shared<ListForm>(raw->has_identities(),
+                                        util::Parameters(),
+                                        FormKey(nullptr),
+                                        raw->starts(),
+                                        raw->stops(),
+                                        content);
+    }
+    else if (RegularForm* raw = dynamic_cast<RegularForm*>(form.get())) {
+      FormPtr content = virtualarray_project_form(raw->content(), keys, single);
+      if (content.get() == nullptr) {
+        return none;
+      }
+      return std::make_shared<RegularForm>(raw->has_identities(),
+                                           util::Parameters(),
+                                           FormKey(nullptr),
+                                           content,
+                                           raw->size());
+    }
+    else if (IndexedForm* raw = dynamic_cast<IndexedForm*>(form.get())) {
+      FormPtr content = virtualarray_project_form(raw->content(), keys, single);
+      if (content.get() == nullptr) {
+        return none;
+      }
+      return std::make_shared<IndexedForm>(raw->has_identities(),
+                                           util::Parameters(),
+                                           FormKey(nullptr),
+                                           raw->index(),
+                                           content);
+    }
+    else if (IndexedOptionForm* raw =
+             dynamic_cast<IndexedOptionForm*>(form.get())) {
+      FormPtr content = virtualarray_project_form(raw->content(), keys, single);
+      if (content.get() == nullptr) {
+        return none;
+      }
+      return std::make_shared<IndexedOptionForm>(raw->has_identities(),
+                                                 util::Parameters(),
+                                                 FormKey(nullptr),
+                                                 raw->index(),
+                                                 content);
+    }
+    else if (ByteMaskedForm* raw = dynamic_cast<ByteMaskedForm*>(form.get())) {
+      FormPtr content = virtualarray_project_form(raw->content(), keys, single);
+      if (content.get() == nullptr) {
+        return none;
+      }
+      return std::make_shared<ByteMaskedForm>(raw->has_identities(),
+                                              util::Parameters(),
+                                              FormKey(nullptr),
+                                              raw->mask(),
+                                              content,
+                                              raw->valid_when());
+    }
+    else if (BitMaskedForm* raw = dynamic_cast<BitMaskedForm*>(form.get())) {
+      FormPtr content = virtualarray_project_form(raw->content(), keys, single);
+      if (content.get() == nullptr) {
+        return none;
+      }
+      return std::make_shared<BitMaskedForm>(raw->has_identities(),
+                                             util::Parameters(),
+                                             FormKey(nullptr),
+                                             raw->mask(),
+                                             content,
+                                             raw->valid_when(),
+                                             raw->lsb_order());
+    }
+    else if (UnmaskedForm* raw = dynamic_cast<UnmaskedForm*>(form.get())) {
+      FormPtr content = virtualarray_project_form(raw->content(), keys, single);
+      if (content.get() == nullptr) {
+        return none;
+      }
+      return std::make_shared<UnmaskedForm>(raw->has_identities(),
+                                            util::Parameters(),
+                                            FormKey(nullptr),
+                                            content);
+    }
+    else {
+      return none;
+    }
+  }
+
   VirtualArray::VirtualArray(const IdentitiesPtr& identities,
                              const util::Parameters& parameters,
                              const ArrayGeneratorPtr& generator,
@@ -284,7 +439,7 @@ namespace awkward {
     if (cache_.get() != nullptr) {
       return cache_.get()->get(cache_key());
     }
-    return ContentPtr(nullptr);
+    return std::atomic_load(&memo_);
   }
 
   kernel::Lib check_key(const std::string& cache_key) {
@@ -299,29 +454,104 @@ namespace awkward {
     return kernel::Lib::cpu_kernels;
   }
 
+  /// @brief Generations in progress, keyed by the cache (or the
+  /// VirtualArray, if it has no cache) and the fully qualified cache key.
+  using VirtualArrayInFlightKey = std::pair<const void*, std::string>;
+  std::mutex virtualarray_inflight_mutex;
+  std::map<VirtualArrayInFlightKey, std::shared_future<ContentPtr>>
+    virtualarray_inflight;
+  /// @brief Number of generations that have finished (successfully or not);
+  /// only incremented with virtualarray_inflight_mutex held.
+  std::atomic<int64_t> virtualarray_finished{0};
+
+  std::atomic<VirtualArray::Waiter> virtualarray_waiter{nullptr};
+
+  void
+  VirtualArray::set_waiter(Waiter waiter) {
+    virtualarray_waiter = waiter;
+  }
+
   const ContentPtr
   VirtualArray::array() const {
-    ContentPtr out(nullptr);
     kernel::Lib src_ptrlib = check_key(cache_key_);
-    if (cache_.get() != nullptr) {
-      if(src_ptrlib != ptr_lib_) {
-        out = cache_.get()->get(cache_key())->copy_to(ptr_lib_);
+    std::string fully_qualified = kernel::fully_qualified_cache_key(cache_key(),
+                                                                    ptr_lib_);
+
+    // fast path: already materialized
+    int64_t finished = virtualarray_finished;
+    ContentPtr out = peek_array();
+    if (out.get() != nullptr) {
+      return (src_ptrlib != ptr_lib_ ? out.get()->copy_to(ptr_lib_) : out);
+    }
+
+    // slow path: become the one thread that generates this key, or wait
+    // for the one that already is
+    VirtualArrayInFlightKey key(cache_.get() != nullptr
+                                  ? (const void*)cache_.get()
+                                  : (const void*)this,
+                                fully_qualified);
+    std::promise<ContentPtr> promise;
+    std::shared_future<ContentPtr> generation;
+    bool leader = false;
+    bool recheck = false;
+    {
+      std::lock_guard<std::mutex> lock(virtualarray_inflight_mutex);
+      recheck = (virtualarray_finished != finished);
+      auto found = virtualarray_inflight.find(key);
+      if (found != virtualarray_inflight.end()) {
+        generation = found->second;
       }
       else {
-        out = cache_.get()->get(cache_key());
+        generation = promise.get_future().share();
+        virtualarray_inflight[key] = generation;
+        leader = true;
       }
     }
-    if (out.get() == nullptr) {
-      if(src_ptrlib != ptr_lib_) {
-        out = generator_.get()->generate_and_check()->copy_to(src_ptrlib);
+    if (!leader) {
+      Waiter waiter = virtualarray_waiter;
+      if (waiter != nullptr) {
+        waiter(generation);
       }
       else {
-        out = generator_.get()->generate_and_check();
+        generation.wait();
       }
+      out = generation.get();
+      return (src_ptrlib != ptr_lib_ ? out.get()->copy_to(ptr_lib_) : out);
     }
-    if (cache_.get() != nullptr) {
-      cache_.get()->set(kernel::fully_qualified_cache_key(cache_key(), ptr_lib_),
-                        out);
+
+    try {
+      // another leader may have finished between our first look and our
+      // registration (only look again if so, to not count another miss)
+      if (recheck) {
+        out = peek_array();
+      }
+      if (out.get() == nullptr) {
+        if (src_ptrlib != ptr_lib_) {
+          out = generator_.get()->generate_and_check()->copy_to(src_ptrlib);
+        }
+        else {
+          out = generator_.get()->generate_and_check();
+        }
+        if (cache_.get() != nullptr) {
+          cache_.get()->set(fully_qualified, out);
+        }
+        else {
+          std::atomic_store(&memo_, out);
+        }
+      }
+      promise.set_value(out);
+    }
+    catch (...) {
+      promise.set_exception(std::current_exception());
+      std::lock_guard<std::mutex> lock(virtualarray_inflight_mutex);
+      virtualarray_inflight.erase(key);
+      virtualarray_finished++;
+      throw;
+    }
+    {
+      std::lock_guard<std::mutex> lock(virtualarray_inflight_mutex);
+      virtualarray_inflight.erase(key);
+      virtualarray_finished++;
     }
     return out;
   }
@@ -336,6 +566,11 @@ namespace awkward {
     return "VirtualArray";
   }
 
+  Content::Kind
+  VirtualArray::kind() const {
+    return Kind::VirtualArray;
+  }
+
   void
   VirtualArray::setidentities(const IdentitiesPtr& identities) {
     throw std::runtime_error("FIXME: VirtualArray::setidentities(identities)");
@@ -498,11 +733,16 @@ namespace awkward {
       return shallow_copy();
     }
 
-    Slice slice;
-    slice.append(SliceRange(start, stop, 1));
-    slice.become_sealed();
-    ArrayGeneratorPtr generator = std::make_shared<SliceGenerator>(
+    // a slice of a slice (or of an array that can be read in ranges) needs
+    // only one generator for this range, not a chain of them
+    ArrayGeneratorPtr generator = generator_.get()->project_range(start, stop);
+    if (generator.get() == nullptr) {
+      Slice slice;
+      slice.append(SliceRange(start, stop, 1));
+      slice.become_sealed();
+      generator = std::make_shared<SliceGenerator>(
                  generator_.get()->form(), stop - start, shallow_copy(), slice);
+    }
     ArrayCachePtr cache(nullptr);
     return std::make_shared<VirtualArray>(Identities::none(),
                                           parameters_,
@@ -517,12 +757,17 @@ namespace awkward {
       return peek.get()->getitem_field(key);
     }
 
-    Slice slice;
-    slice.append(SliceField(key));
-    slice.become_sealed();
-    FormPtr form(nullptr);
-    ArrayGeneratorPtr generator = std::make_shared<SliceGenerator>(
-                 form, generator_.get()->length(), shallow_copy(), slice);
+    FormPtr form = virtualarray_project_form(generator_.get()->form(),
+                                             std::vector<std::string>({ key }),
+                                             true);
+    ArrayGeneratorPtr generator = generator_.get()->project_field(key);
+    if (generator.get() == nullptr) {
+      Slice slice;
+      slice.append(SliceField(key));
+      slice.become_sealed();
+      generator = std::make_shared<SliceGenerator>(
+                   form, generator_.get()->length(), shallow_copy(), slice);
+    }
     ArrayCachePtr cache(nullptr);
     return std::make_shared<VirtualArray>(Identities::none(),
                                           util::Parameters(),
@@ -540,7 +785,9 @@ namespace awkward {
     Slice slice;
     slice.append(SliceFields(keys));
     slice.become_sealed();
-    FormPtr form(nullptr);
+    FormPtr form = virtualarray_project_form(generator_.get()->form(),
+                                             keys,
+                                             false);
     ArrayGeneratorPtr generator = std::make_shared<SliceGenerator>(
                  form, generator_.get()->length(), shallow_copy(), slice);
     ArrayCachePtr cache(nullptr);
@@ -612,8 +859,26 @@ namespace awkward {
     return array().get()->shallow_simplify();
   }
 
+  const ContentPtr
+  VirtualArray::packed() const {
+    return array().get()->packed();
+  }
+
+  const ContentPtr
+  VirtualArray::packed_carry(const Index64& nextcarry) const {
+    return array().get()->packed_carry(nextcarry);
+  }
+
   const ContentPtr
   VirtualArray::num(int64_t axis, int64_t depth) const {
+    // wrapping a negative axis needs the Form; a non-negative one does not
+    int64_t posaxis = (axis >= 0 ? axis : axis_wrap_if_negative(axis));
+    if (posaxis == depth) {
+      // the length may be known without generating the array
+      Index64 out(1);
+      out.setitem_at_nowrap(0, length());
+      return NumpyArray(out).getitem_at_nowrap(0);
+    }
     return array().get()->num(axis, depth);
   }
 
@@ -0,0 +1,1017 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _MSC_VER
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include "awkward/Identities.h"
+#include "awkward/array/BitMaskedArray.h"
+#include "awkward/array/ByteMaskedArray.h"
+#include "awkward/array/EmptyArray.h"
+#include "awkward/array/IndexedArray.h"
+#include "awkward/array/ListArray.h"
+#include "awkward/array/ListOffsetArray.h"
+#include "awkward/array/NumpyArray.h"
+#include "awkward/array/RecordArray.h"
+#include "awkward/array/RegularArray.h"
+#include "awkward/array/UnionArray.h"
+#include "awkward/array/UnmaskedArray.h"
+#include "awkward/array/VirtualArray.h"
+
+#include "awkward/io/arrayset.h"
+
+namespace awkward {
+  const char kArraysetMagic[8] = {'a', 'k', 'a', 'r', 'r', 's', 'e', 't'};
+  const uint64_t kArraysetVersion = 1;
+  const int64_t kArraysetAlignment = 64;
+
+  bool
+  arrayset_little_endian() {
+    int32_t test = 1;
+    return *(int8_t*)&test == 1;
+  }
+
+  int64_t
+  arrayset_aligned(int64_t position) {
+    int64_t remainder = position % kArraysetAlignment;
+    return remainder == 0 ? position
+                          : position + kArraysetAlignment - remainder;
+  }
+
+  /// @class arrayset_unmapper
+  ///
+  /// @brief Used as a `std::shared_ptr` deleter (second argument) to
+  /// unmap a memory-mapped file.
+  class arrayset_unmapper {
+  public:
+    arrayset_unmapper(size_t length): length_(length) { }
+
+    void operator()(void* p) {
+#ifndef _MSC_VER
+      munmap(p, length_);
+#endif
+    }
+
+  private:
+    size_t length_;
+  };
+
+  ////////// writing
+
+  /// @brief A buffer waiting to be written: `ptr` keeps it alive.
+  struct ArraysetOutputBuffer {
+    std::string key;
+    std::shared_ptr<void> ptr;
+    const uint8_t* data;
+    int64_t nbytes;
+  };
+
+  template <typename T>
+  void
+  arrayset_add_index(std::vector<ArraysetOutputBuffer>& buffers,
+                     const std::string& key,
+                     const IndexOf<T>& index) {
+    if (index.ptr_lib() != kernel::Lib::cpu_kernels) {
+      throw std::invalid_argument(
+        "ToArraysetFile: Index buffers must be in main memory");
+    }
+    ArraysetOutputBuffer buffer;
+    buffer.key = key;
+    buffer.ptr = index.ptr();
+    buffer.data = reinterpret_cast<const uint8_t*>(
+                    index.ptr().get() + index.offset());
+    buffer.nbytes = index.length() * (int64_t)sizeof(T);
+    buffers.push_back(buffer);
+  }
+
+  const FormPtr
+  arrayset_fill(const ContentPtr& layout,
+                int64_t& numnodes,
+                std::vector<ArraysetOutputBuffer>& buffers,
+                std::vector<std::pair<std::string, int64_t>>& lengths) {
+    if (layout.get()->identities().get() != nullptr) {
+      throw std::invalid_argument(
+        "ToArraysetFile for an array with Identities");
+    }
+
+    if (VirtualArray* raw = kind_cast<VirtualArray>(layout.get())) {
+      return arrayset_fill(raw->array(), numnodes, buffers, lengths);
+    }
+
+    std::string key = std::string("node") + std::to_string(numnodes);
+    numnodes++;
+    FormKey form_key = std::make_shared<std::string>(key);
+    util::Parameters parameters = layout.get()->parameters();
+    lengths.push_back(
+      std::pair<std::string, int64_t>(key, layout.get()->length()));
+
+    if (kind_cast<EmptyArray>(layout.get())) {
+      return std::make_shared<EmptyForm>(false, parameters, form_key);
+    }
+
+    else if (IndexedArray32* raw =
+             kind_cast<IndexedArray32>(layout.get())) {
+      arrayset_add_index<int32_t>(buffers, key + "-index", raw->index());
+      return std::make_shared<IndexedForm>(
+        false, parameters, form_key, Index::Form::i32,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths));
+    }
+    else if (IndexedArrayU32* raw =
+             kind_cast<IndexedArrayU32>(layout.get())) {
+      arrayset_add_index<uint32_t>(buffers, key + "-index", raw->index());
+      return std::make_shared<IndexedForm>(
+        false, parameters, form_key, Index::Form::u32,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths));
+    }
+    else if (IndexedArray64* raw =
+             kind_cast<IndexedArray64>(layout.get())) {
+      arrayset_add_index<int64_t>(buffers, key + "-index", raw->index());
+      return std::make_shared<IndexedForm>(
+        false, parameters, form_key, Index::Form::i64,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths));
+    }
+
+    else if (IndexedOptionArray32* raw =
+             kind_cast<IndexedOptionArray32>(layout.get())) {
+      arrayset_add_index<int32_t>(buffers, key + "-index", raw->index());
+      return std::make_shared<IndexedOptionForm>(
+        false, parameters, form_key, Index::Form::i32,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths));
+    }
+    else if (IndexedOptionArray64* raw =
+             kind_cast<IndexedOptionArray64>(layout.get())) {
+      arrayset_add_index<int64_t>(buffers, key + "-index", raw->index());
+      return std::make_shared<IndexedOptionForm>(
+        false, parameters, form_key, Index::Form::i64,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths));
+    }
+
+    else if (ByteMaskedArray* raw =
+             kind_cast<ByteMaskedArray>(layout.get())) {
+      arrayset_add_index<int8_t>(buffers, key + "-mask", raw->mask());
+      return std::make_shared<ByteMaskedForm>(
+        false, parameters, form_key, Index::Form::i8,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths),
+        raw->valid_when());
+    }
+
+    else if (BitMaskedArray* raw =
+             kind_cast<BitMaskedArray>(layout.get())) {
+      arrayset_add_index<uint8_t>(buffers, key + "-mask", raw->mask());
+      return std::make_shared<BitMaskedForm>(
+        false, parameters, form_key, Index::Form::u8,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths),
+        raw->valid_when(),
+        raw->lsb_order());
+    }
+
+    else if (UnmaskedArray* raw =
+             kind_cast<UnmaskedArray>(layout.get())) {
+      return std::make_shared<UnmaskedForm>(
+        false, parameters, form_key,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths));
+    }
+
+    else if (ListArray32* raw =
+             kind_cast<ListArray32>(layout.get())) {
+      arrayset_add_index<int32_t>(buffers, key + "-starts", raw->starts());
+      arrayset_add_index<int32_t>(buffers, key + "-stops", raw->stops());
+      return std::make_shared<ListForm>(
+        false, parameters, form_key, Index::Form::i32, Index::Form::i32,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths));
+    }
+    else if (ListArrayU32* raw =
+             kind_cast<ListArrayU32>(layout.get())) {
+      arrayset_add_index<uint32_t>(buffers, key + "-starts", raw->starts());
+      arrayset_add_index<uint32_t>(buffers, key + "-stops", raw->stops());
+      return std::make_shared<ListForm>(
+        false, parameters, form_key, Index::Form::u32, Index::Form::u32,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths));
+    }
+    else if (ListArray64* raw =
+             kind_cast<ListArray64>(layout.get())) {
+      arrayset_add_index<int64_t>(buffers, key + "-starts", raw->starts());
+      arrayset_add_index<int64_t>(buffers, key + "-stops", raw->stops());
+      return std::make_shared<ListForm>(
+        false, parameters, form_key, Index::Form::i64, Index::Form::i64,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths));
+    }
+
+    else if (ListOffsetArray32* raw =
+             kind_cast<ListOffsetArray32>(layout.get())) {
+      arrayset_add_index<int32_t>(buffers, key + "-offsets", raw->offsets());
+      return std::make_shared<ListOffsetForm>(
+        false, parameters, form_key, Index::Form::i32,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths));
+    }
+    else if (ListOffsetArrayU32* raw =
+             kind_cast<ListOffsetArrayU32>(layout.get())) {
+      arrayset_add_index<uint32_t>(buffers, key + "-offsets", raw->offsets());
+      return std::make_shared<ListOffsetForm>(
+        false, parameters, form_key, Index::Form::u32,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths));
+    }
+    else if (ListOffsetArray64* raw =
+             kind_cast<ListOffsetArray64>(layout.get())) {
+      arrayset_add_index<int64_t>(buffers, key + "-offsets", raw->offsets());
+      return std::make_shared<ListOffsetForm>(
+        false, parameters, form_key, Index::Form::i64,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths));
+    }
+
+    else if (NumpyArray* raw =
+             kind_cast<NumpyArray>(layout.get())) {
+      if (raw->isscalar()) {
+        throw std::invalid_argument(
+          "ToArraysetFile cannot write a scalar NumpyArray");
+      }
+      NumpyArray contiguous = raw->contiguous();
+      ArraysetOutputBuffer buffer;
+      buffer.key = key;
+      buffer.ptr = contiguous.ptr();
+      buffer.data = reinterpret_cast<const uint8_t*>(contiguous.byteptr());
+      buffer.nbytes = (int64_t)contiguous.bytelength();
+      buffers.push_back(buffer);
+      std::vector<int64_t> inner_shape;
+      for (size_t i = 1;  i < contiguous.shape().size();  i++) {
+        inner_shape.push_back((int64_t)contiguous.shape()[i]);
+      }
+      return std::make_shared<NumpyForm>(false,
+                                         parameters,
+                                         form_key,
+                                         inner_shape,
+                                         (int64_t)contiguous.itemsize(),
+                                         contiguous.format(),
+                                         contiguous.dtype());
+    }
+
+    else if (RecordArray* raw =
+             kind_cast<RecordArray>(layout.get())) {
+      std::vector<FormPtr> contents;
+      for (auto content : raw->contents()) {
+        contents.push_back(arrayset_fill(content, numnodes, buffers, lengths));
+      }
+      return std::make_shared<RecordForm>(false,
+                                          parameters,
+                                          form_key,
+                                          raw->recordlookup(),
+                                          contents);
+    }
+
+    else if (RegularArray* raw =
+             kind_cast<RegularArray>(layout.get())) {
+      return std::make_shared<RegularForm>(
+        false, parameters, form_key,
+        arrayset_fill(raw->content(), numnodes, buffers, lengths),
+        raw->size());
+    }
+
+    else if (UnionArray8_32* raw =
+             kind_cast<UnionArray8_32>(layout.get())) {
+      arrayset_add_index<int8_t>(buffers, key + "-tags", raw->tags());
+      arrayset_add_index<int32_t>(buffers, key + "-index", raw->index());
+      std::vector<FormPtr> contents;
+      for (auto content : raw->contents()) {
+        contents.push_back(arrayset_fill(content, numnodes, buffers, lengths));
+      }
+      return std::make_shared<UnionForm>(false, parameters, form_key,
+                                         Index::Form::i8, Index::Form::i32,
+                                         contents);
+    }
+    else if (UnionArray8_U32* raw =
+             kind_cast<UnionArray8_U32>(layout.get())) {
+      arrayset_add_index<int8_t>(buffers, key + "-tags", raw->tags());
+      arrayset_add_index<uint32_t>(buffers, key + "-index", raw->index());
+      std::vector<FormPtr> contents;
+      for (auto content : raw->contents()) {
+        contents.push_back(arrayset_fill(content, numnodes, buffers, lengths));
+      }
+      return std::make_shared<UnionForm>(false, parameters, form_key,
+                                         Index::Form::i8, Index::Form::u32,
+                                         contents);
+    }
+    else if (UnionArray8_64* raw =
+             kind_cast<UnionArray8_64>(layout.get())) {
+      arrayset_add_index<int8_t>(buffers, key + "-tags", raw->tags());
+      arrayset_add_index<int64_t>(buffers, key + "-index", raw->index());
+      std::vector<FormPtr> contents;
+      for (auto content : raw->contents()) {
+        contents.push_back(arrayset_fill(content, numnodes, buffers, lengths));
+      }
+      return std::make_shared<UnionForm>(false, parameters, form_key,
+                                         Index::Form::i8, Index::Form::i64,
+                                         contents);
+    }
+
+    else {
+      throw std::invalid_argument(
+        std::string("ToArraysetFile does not support ")
+        + layout.get()->classname());
+    }
+  }
+
+  void
+  arrayset_write_uint64(std::string& out, uint64_t x) {
+    out.append(reinterpret_cast<const char*>(&x), sizeof(uint64_t));
+  }
+
+  void
+  arrayset_write_string(std::string& out, const std::string& x) {
+    arrayset_write_uint64(out, (uint64_t)x.length());
+    out.append(x);
+  }
+
+  void
+  ToArraysetFile(const ContentPtr& array, const std::string& path) {
+    if (!arrayset_little_endian()) {
+      throw std::runtime_error(
+        "ToArraysetFile is only implemented for little-endian machines");
+    }
+
+    ContentPtr layout = array.get()->copy_to(kernel::Lib::cpu_kernels);
+    int64_t numnodes = 0;
+    std::vector<ArraysetOutputBuffer> buffers;
+    std::vector<std::pair<std::string, int64_t>> lengths;
+    FormPtr form = arrayset_fill(layout, numnodes, buffers, lengths);
+    std::string formjson = form.get()->tojson(false, false);
+
+    // The header's size does not depend on the buffer positions (fixed-width
+    // integers), so measure it first, then fill in the positions.
+    int64_t headersize = (int64_t)sizeof(kArraysetMagic)
+                         + 5*(int64_t)sizeof(uint64_t)
+                         + (int64_t)formjson.length();
+    for (auto buffer : buffers) {
+      headersize += 3*(int64_t)sizeof(uint64_t) + (int64_t)buffer.key.length();
+    }
+    for (auto pair : lengths) {
+      headersize += 2*(int64_t)sizeof(uint64_t) + (int64_t)pair.first.length();
+    }
+
+    std::vector<int64_t> positions;
+    int64_t position = arrayset_aligned(headersize);
+    for (auto buffer : buffers) {
+      positions.push_back(position);
+      position = arrayset_aligned(position + buffer.nbytes);
+    }
+
+    std::string header;
+    header.append(kArraysetMagic, sizeof(kArraysetMagic));
+    arrayset_write_uint64(header, kArraysetVersion);
+    arrayset_write_uint64(header, (uint64_t)layout.get()->length());
+    arrayset_write_uint64(header, (uint64_t)formjson.length());
+    arrayset_write_uint64(header, (uint64_t)buffers.size());
+    arrayset_write_uint64(header, (uint64_t)lengths.size());
+    header.append(formjson);
+    for (size_t i = 0;  i < buffers.size();  i++) {
+      arrayset_write_string(header, buffers[i].key);
+      arrayset_write_uint64(header, (uint64_t)positions[i]);
+      arrayset_write_uint64(header, (uint64_t)buffers[i].nbytes);
+    }
+    for (auto pair : lengths) {
+      arrayset_write_string(header, pair.first);
+      arrayset_write_uint64(header, (uint64_t)pair.second);
+    }
+
+#ifdef _MSC_VER
+    FILE* file;
+    if (fopen_s(&file, path.c_str(), "wb") != 0) {
+#else
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+#endif
+      throw std::invalid_argument(
+        std::string("file \"") + path
+        + std::string("\" could not be opened for writing"));
+    }
+
+    const char padding[kArraysetAlignment] = { };
+    bool ok = (fwrite(header.data(), 1, header.length(), file)
+               == header.length());
+    int64_t written = (int64_t)header.length();
+    for (size_t i = 0;  ok  &&  i < buffers.size();  i++) {
+      size_t pad = (size_t)(positions[i] - written);
+      ok = ok  &&  (fwrite(padding, 1, pad, file) == pad);
+      ok = ok  &&  (fwrite(buffers[i].data, 1, (size_t)buffers[i].nbytes, file)
+                    == (size_t)buffers[i].nbytes);
+      written = positions[i] + buffers[i].nbytes;
+    }
+    if (fclose(file) != 0) {
+      ok = false;
+    }
+    if (!ok) {
+      throw std::runtime_error(
+        std::string("could not write all bytes to file \"") + path
+        + std::string("\""));
+    }
+  }
+
+  ////////// reading
+
+  /// @brief Reads header fields in order, checking that they are within
+  /// the file.
+  class ArraysetHeaderReader {
+  public:
+    ArraysetHeaderReader(const uint8_t* data,
+                         int64_t filesize,
+                         const std::string& path)
+        : data_(data)
+        , filesize_(filesize)
+        , position_(0)
+        , path_(path) { }
+
+    void
+      require(int64_t nbytes) const {
+      if (nbytes < 0  ||  position_ + nbytes > filesize_) {
+        throw std::invalid_argument(
+          std::string("file \"") + path_
+          + std::string("\" is truncated or is not an ArraysetFile"));
+      }
+    }
+
+    const std::string
+      bytes(int64_t nbytes) {
+      require(nbytes);
+      std::string out(reinterpret_cast<const char*>(&data_[position_]),
+                      (size_t)nbytes);
+      position_ += nbytes;
+      return out;
+    }
+
+    int64_t
+      uint64() {
+      require((int64_t)sizeof(uint64_t));
+      uint64_t out;
+      std::memcpy(&out, &data_[position_], sizeof(uint64_t));
+      position_ += (int64_t)sizeof(uint64_t);
+      return (int64_t)out;
+    }
+
+    const std::string
+      string() {
+      return bytes(uint64());
+    }
+
+  private:
+    const uint8_t* data_;
+    int64_t filesize_;
+    int64_t position_;
+    const std::string path_;
+  };
+
+  ArraysetFile::ArraysetFile(const std::string& path)
+      : path_(path)
+      , data_(nullptr)
+      , filesize_(0)
+      , form_(nullptr)
+      , length_(0) {
+    if (!arrayset_little_endian()) {
+      throw std::runtime_error(
+        "ArraysetFile is only implemented for little-endian machines");
+    }
+
+#ifndef _MSC_VER
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+      throw std::invalid_argument(
+        std::string("file \"") + path
+        + std::string("\" could not be opened for reading"));
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+      close(fd);
+      throw std::invalid_argument(
+        std::string("file \"") + path + std::string("\" could not be read"));
+    }
+    filesize_ = (int64_t)status.st_size;
+    if (filesize_ > 0) {
+      // Copy-on-write: no write ever reaches the file, and pages that are
+      // never touched are never read.
+      void* mapped = mmap(nullptr,
+                          (size_t)filesize_,
+                          PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE,
+                          fd,
+                          0);
+      close(fd);
+      if (mapped == MAP_FAILED) {
+        throw std::invalid_argument(
+          std::string("file \"") + path
+          + std::string("\" could not be memory-mapped"));
+      }
+      data_ = std::shared_ptr<void>(mapped,
+                                    arrayset_unmapper((size_t)filesize_));
+    }
+    else {
+      close(fd);
+    }
+#else
+    FILE* file;
+    if (fopen_s(&file, path.c_str(), "rb") != 0) {
+      throw std::invalid_argument(
+        std::string("file \"") + path
+        + std::string("\" could not be opened for reading"));
+    }
+    fseek(file, 0, SEEK_END);
+    filesize_ = (int64_t)ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data_ = std::shared_ptr<void>(new uint8_t[(size_t)filesize_],
+                                  kernel::array_deleter<uint8_t>());
+    size_t numread = fread(data_.get(), 1, (size_t)filesize_, file);
+    fclose(file);
+    if (numread != (size_t)filesize_) {
+      throw std::invalid_argument(
+        std::string("file \"") + path + std::string("\" could not be read"));
+    }
+#endif
+
+    ArraysetHeaderReader reader(reinterpret_cast<uint8_t*>(data_.get()),
+                                filesize_,
+                                path);
+    std::string magic = reader.bytes((int64_t)sizeof(kArraysetMagic));
+    if (magic != std::string(kArraysetMagic, sizeof(kArraysetMagic))) {
+      throw std::invalid_argument(
+        std::string("file \"") + path
+        + std::string("\" is not an ArraysetFile"));
+    }
+    int64_t version = reader.uint64();
+    if (version != (int64_t)kArraysetVersion) {
+      throw std::invalid_argument(
+        std::string("file \"") + path
+        + std::string("\" has unsupported ArraysetFile version ")
+        + std::to_string(version));
+    }
+    length_ = reader.uint64();
+    int64_t formsize = reader.uint64();
+    int64_t numbuffers = reader.uint64();
+    int64_t numnodes = reader.uint64();
+    form_ = Form::fromjson(reader.bytes(formsize));
+    for (int64_t i = 0;  i < numbuffers;  i++) {
+      std::string key = reader.string();
+      int64_t offset = reader.uint64();
+      int64_t nbytes = reader.uint64();
+      if (offset < 0  ||  nbytes < 0  ||  offset + nbytes > filesize_) {
+        throw std::invalid_argument(
+          std::string("file \"") + path
+          + std::string("\" is truncated: buffer \"") + key
+          + std::string("\" extends beyond the end of the file"));
+      }
+      buffers_[key] = std::pair<int64_t, int64_t>(offset, nbytes);
+    }
+    for (int64_t i = 0;  i < numnodes;  i++) {
+      std::string key = reader.string();
+      lengths_[key] = reader.uint64();
+    }
+  }
+
+  const std::string
+  ArraysetFile::path() const {
+    return path_;
+  }
+
+  const FormPtr
+  ArraysetFile::form() const {
+    return form_;
+  }
+
+  int64_t
+  ArraysetFile::length() const {
+    return length_;
+  }
+
+  int64_t
+  ArraysetFile::filesize() const {
+    return filesize_;
+  }
+
+  const std::vector<std::string>
+  ArraysetFile::keys() const {
+    std::vector<std::string> out;
+    for (auto pair : buffers_) {
+      out.push_back(pair.first);
+    }
+    return out;
+  }
+
+  bool
+  ArraysetFile::has_buffer(const std::string& key) const {
+    return buffers_.find(key) != buffers_.end();
+  }
+
+  const std::shared_ptr<void>
+  ArraysetFile::buffer(const std::string& key) const {
+    auto it = buffers_.find(key);
+    if (it == buffers_.end()) {
+      throw std::invalid_argument(
+        std::string("buffer \"") + key
+        + std::string("\" not found in file \"") + path_
+        + std::string("\""));
+    }
+    uint8_t* ptr = reinterpret_cast<uint8_t*>(data_.get()) + it->second.first;
+    // Aliasing constructor: shares ownership of the whole mapping.
+    return std::shared_ptr<void>(data_, ptr);
+  }
+
+  int64_t
+  ArraysetFile::buffer_nbytes(const std::string& key) const {
+    auto it = buffers_.find(key);
+    if (it == buffers_.end()) {
+      throw std::invalid_argument(
+        std::string("buffer \"") + key
+        + std::string("\" not found in file \"") + path_
+        + std::string("\""));
+    }
+    return it->second.second;
+  }
+
+  int64_t
+  ArraysetFile::node_length(const std::string& key) const {
+    auto it = lengths_.find(key);
+    if (it == lengths_.end()) {
+      throw std::invalid_argument(
+        std::string("node \"") + key
+        + std::string("\" not found in file \"") + path_
+        + std::string("\""));
+    }
+    return it->second;
+  }
+
+  void
+  ArraysetFile::check_buffer(const std::string& key,
+                             int64_t length,
+                             int64_t itemsize) const {
+    int64_t nbytes = buffer_nbytes(key);
+    // compared by division, so that a corrupt length cannot overflow
+    if (length < 0  ||  (itemsize > 0  &&  length > nbytes / itemsize)) {
+      throw std::invalid_argument(
+        std::string("buffer \"") + key + std::string("\" in file \"")
+        + path_ + std::string("\" has ") + std::to_string(nbytes)
+        + std::string(" bytes, but its node needs ") + std::to_string(length)
+        + std::string(" items of ") + std::to_string(itemsize)
+        + std::string(" bytes"));
+    }
+  }
+
+  template <typename T>
+  const IndexOf<T>
+  ArraysetFile::index(const std::string& key, int64_t length) const {
+    check_buffer(key, length, (int64_t)sizeof(T));
+    std::shared_ptr<void> ptr = buffer(key);
+    return IndexOf<T>(std::shared_ptr<T>(ptr, reinterpret_cast<T*>(ptr.get())),
+                      0,
+                      length);
+  }
+
+  const ContentPtr
+  ArraysetFile::content() const {
+    return content(form_);
+  }
+
+  const ContentPtr
+  ArraysetFile::content(const FormPtr& form) const {
+    if (VirtualForm* raw = dynamic_cast<VirtualForm*>(form.get())) {
+      if (raw->form().get() == nullptr) {
+        throw std::invalid_argument(
+          "ArraysetFile cannot read a VirtualForm without an expected Form");
+      }
+      return content(raw->form());
+    }
+
+    if (form.get()->form_key().get() == nullptr) {
+      throw std::invalid_argument(
+        "ArraysetFile cannot read a Form node without a form_key");
+    }
+    std::string key = *form.get()->form_key().get();
+    util::Parameters parameters = form.get()->parameters();
+    int64_t length = node_length(key);
+
+    if (dynamic_cast<EmptyForm*>(form.get())) {
+      return std::make_shared<EmptyArray>(Identities::none(), parameters);
+    }
+
+    else if (IndexedForm* raw = dynamic_cast<IndexedForm*>(form.get())) {
+      ContentPtr next = content(raw->content());
+      switch (raw->index()) {
+      case Index::Form::i32:
+        return std::make_shared<IndexedArray32>(
+          Identities::none(), parameters,
+          index<int32_t>(key + "-index", length), next);
+      case Index::Form::u32:
+        return std::make_shared<IndexedArrayU32>(
+          Identities::none(), parameters,
+          index<uint32_t>(key + "-index", length), next);
+      case Index::Form::i64:
+        return std::make_shared<IndexedArray64>(
+          Identities::none(), parameters,
+          index<int64_t>(key + "-index", length), next);
+      default:
+        throw std::invalid_argument(
+          "unrecognized IndexedForm index type in ArraysetFile");
+      }
+    }
+
+    else if (IndexedOptionForm* raw =
+             dynamic_cast<IndexedOptionForm*>(form.get())) {
+      ContentPtr next = content(raw->content());
+      switch (raw->index()) {
+      case Index::Form::i32:
+        return std::make_shared<IndexedOptionArray32>(
+          Identities::none(), parameters,
+          index<int32_t>(key + "-index", length), next);
+      case Index::Form::i64:
+        return std::make_shared<IndexedOptionArray64>(
+          Identities::none(), parameters,
+          index<int64_t>(key + "-index", length), next);
+      default:
+        throw std::invalid_argument(
+          "unrecognized IndexedOptionForm index type in ArraysetFile");
+      }
+    }
+
+    else if (ByteMaskedForm* raw = dynamic_cast<ByteMaskedForm*>(form.get())) {
+      return std::make_shared<ByteMaskedArray>(
+        Identities::none(), parameters, index<int8_t>(key + "-mask", length),
+        content(raw->content()), raw->valid_when());
+    }
+
+    else if (BitMaskedForm* raw = dynamic_cast<BitMaskedForm*>(form.get())) {
+      return std::make_shared<BitMaskedArray>(
+        Identities::none(), parameters,
+        index<uint8_t>(key + "-mask", (length + 7) / 8),
+        content(raw->content()), raw->valid_when(), length, raw->lsb_order());
+    }
+
+    else if (UnmaskedForm* raw = dynamic_cast<UnmaskedForm*>(form.get())) {
+      return std::make_shared<UnmaskedArray>(Identities::none(),
+                                             parameters,
+                                             content(raw->content()));
+    }
+
+    else if (ListForm* raw = dynamic_cast<ListForm*>(form.get())) {
+      ContentPtr next = content(raw->content());
+      switch (raw->starts()) {
+      case Index::Form::i32:
+        return std::make_shared<ListArray32>(
+          Identities::none(), parameters,
+          index<int32_t>(key + "-starts", length),
+          index<int32_t>(key + "-stops", length), next);
+      case Index::Form::u32:
+        return std::make_shared<ListArrayU32>(
+          Identities::none(), parameters,
+          index<uint32_t>(key + "-starts", length),
+          index<uint32_t>(key + "-stops", length), next);
+      case Index::Form::i64:
+        return std::make_shared<ListArray64>(
+          Identities::none(), parameters,
+          index<int64_t>(key + "-starts", length),
+          index<int64_t>(key + "-stops", length), next);
+      default:
+        throw std::invalid_argument(
+          "unrecognized ListForm starts type in ArraysetFile");
+      }
+    }
+
+    else if (ListOffsetForm* raw = dynamic_cast<ListOffsetForm*>(form.get())) {
+      ContentPtr next = content(raw->content());
+      switch (raw->offsets()) {
+      case Index::Form::i32:
+        return std::make_shared<ListOffsetArray32>(
+          Identities::none(), parameters,
+          index<int32_t>(key + "-offsets", length + 1), next);
+      case Index::Form::u32:
+        return std::make_shared<ListOffsetArrayU32>(
+          Identities::none(), parameters,
+          index<uint32_t>(key + "-offsets", length + 1), next);
+      case Index::Form::i64:
+        return std::make_shared<ListOffsetArray64>(
+          Identities::none(), parameters,
+          index<int64_t>(key + "-offsets", length + 1), next);
+      default:
+        throw std::invalid_argument(
+          "unrecognized ListOffsetForm offsets type in ArraysetFile");
+      }
+    }
+
+    else if (NumpyForm* raw = dynamic_cast<NumpyForm*>(form.get())) {
+      std::vector<ssize_t> shape({ (ssize_t)length });
+      std::vector<ssize_t> strides({ 0 });
+      ssize_t stride = (ssize_t)raw->itemsize();
+      for (auto x : raw->inner_shape()) {
+        shape.push_back((ssize_t)x);
+        strides.push_back(0);
+      }
+      for (size_t i = shape.size();  i > 0;  i--) {
+        strides[i - 1] = stride;
+        stride *= shape[i - 1];
+      }
+      check_buffer(key, (int64_t)shape[0], (int64_t)strides[0]);
+      return std::make_shared<NumpyArray>(Identities::none(),
+                                          parameters,
+                                          buffer(key),
+                                          shape,
+                                          strides,
+                                          0,
+                                          (ssize_t)raw->itemsize(),
+                                          raw->format(),
+                                          raw->dtype());
+    }
+
+    else if (RecordForm* raw = dynamic_cast<RecordForm*>(form.get())) {
+      ContentPtrVec contents;
+      for (auto content_form : raw->contents()) {
+        contents.push_back(content(content_form));
+      }
+      return std::make_shared<RecordArray>(Identities::none(),
+                                           parameters,
+                                           contents,
+                                           raw->recordlookup(),
+                                           length);
+    }
+
+    else if (RegularForm* raw = dynamic_cast<RegularForm*>(form.get())) {
+      return std::make_shared<RegularArray>(Identities::none(),
+                                            parameters,
+                                            content(raw->content()),
+                                            raw->size());
+    }
+
+    else if (UnionForm* raw = dynamic_cast<UnionForm*>(form.get())) {
+      ContentPtrVec contents;
+      for (auto content_form : raw->contents()) {
+        contents.push_back(content(content_form));
+      }
+      Index8 tags = index<int8_t>(key + "-tags", length);
+      switch (raw->index()) {
+      case Index::Form::i32:
+        return std::make_shared<UnionArray8_32>(
+          Identities::none(), parameters, tags,
+          index<int32_t>(key + "-index", length), contents);
+      case Index::Form::u32:
+        return std::make_shared<UnionArray8_U32>(
+          Identities::none(), parameters, tags,
+          index<uint32_t>(key + "-index", length), contents);
+      case Index::Form::i64:
+        return std::make_shared<UnionArray8_64>(
+          Identities::none(), parameters, tags,
+          index<int64_t>(key + "-index", length), contents);
+      default:
+        throw std::invalid_argument(
+          "unrecognized UnionForm index type in ArraysetFile");
+      }
+    }
+
+    else {
+      throw std::invalid_argument(
+        std::string("ArraysetFile does not support Form: ")
+        + form.get()->tostring());
+    }
+  }
+
+  ////////// ArraysetGenerator
+
+  ArraysetGenerator::ArraysetGenerator(const FormPtr& form,
+                                       int64_t length,
+                                       const ArraysetFilePtr& file,
+                                       int64_t start)
+      : ArrayGenerator(form, length)
+      , file_(file)
+      , start_(start) {
+    if (form.get() == nullptr) {
+      throw std::invalid_argument(
+        "ArraysetGenerator requires a Form with the file's form_keys");
+    }
+    if (start < 0) {
+      throw std::invalid_argument(
+        "ArraysetGenerator start must be non-negative");
+    }
+  }
+
+  const ArraysetFilePtr
+  ArraysetGenerator::file() const {
+    return file_;
+  }
+
+  int64_t
+  ArraysetGenerator::start() const {
+    return start_;
+  }
+
+  const ContentPtr
+  ArraysetGenerator::generate() const {
+    ContentPtr out = file_.get()->content(form_);
+    // the buffers are not copied, so taking a range reads only that range
+    int64_t stop = (length_ >= 0 ? start_ + length_ : out.get()->length());
+    if (start_ != 0  ||  stop != out.get()->length()) {
+      return out.get()->getitem_range(start_, stop);
+    }
+    return out;
+  }
+
+  const std::string
+  ArraysetGenerator::tostring_part(const std::string& indent,
+                                   const std::string& pre,
+                                   const std::string& post) const {
+    std::stringstream out;
+    out << indent << pre << "<ArraysetGenerator path=\""
+        << file_.get()->path() << "\"";
+    if (form_.get()->form_key().get() != nullptr) {
+      out << " form_key=\"" << *form_.get()->form_key().get() << "\"";
+    }
+    if (start_ != 0) {
+      out << " start=\"" << start_ << "\"";
+    }
+    if (length_ >= 0) {
+      out << " length=\"" << length_ << "\"";
+    }
+    out << "/>" << post;
+    return out.str();
+  }
+
+  const std::shared_ptr<ArrayGenerator>
+  ArraysetGenerator::shallow_copy() const {
+    return std::make_shared<ArraysetGenerator>(form_, length_, file_, start_);
+  }
+
+  const std::shared_ptr<ArrayGenerator>
+  ArraysetGenerator::with_form(const FormPtr& form) const {
+    return std::make_shared<ArraysetGenerator>(form, length_, file_, start_);
+  }
+
+  const std::shared_ptr<ArrayGenerator>
+  ArraysetGenerator::with_length(int64_t length) const {
+    return std::make_shared<ArraysetGenerator>(form_, length, file_, start_);
+  }
+
+  const std::shared_ptr<ArrayGenerator>
+  ArraysetGenerator::project_field(const std::string& key) const {
+    RecordForm* raw = dynamic_cast<RecordForm*>(form_.get());
+    if (raw == nullptr  ||  !raw->haskey(key)  ||  length_ < 0) {
+      return std::shared_ptr<ArrayGenerator>(nullptr);
+    }
+    FormPtr field = raw->content(key);
+    // fields are written as they are, so they can be longer than the record
+    // (generate takes only the entries of the record)
+    FormKey form_key = field.get()->form_key();
+    if (form_key.get() == nullptr  ||
+        file_.get()->node_length(*form_key.get()) < start_ + length_) {
+      return std::shared_ptr<ArrayGenerator>(nullptr);
+    }
+    return std::make_shared<ArraysetGenerator>(field, length_, file_, start_);
+  }
+
+  const std::shared_ptr<ArrayGenerator>
+  ArraysetGenerator::project_range(int64_t start, int64_t stop) const {
+    if (length_ < 0) {
+      return std::shared_ptr<ArrayGenerator>(nullptr);
+    }
+    return std::make_shared<ArraysetGenerator>(form_,
+                                               stop - start,
+                                               file_,
+                                               start_ + start);
+  }
+
+  ////////// whole files
+
+  const ContentPtr
+  FromArraysetFile(const std::string& path) {
+    return ArraysetFile(path).content();
+  }
+
+  const ContentPtr
+  FromArraysetFileLazy(const std::string& path, const ArrayCachePtr& cache) {
+    ArraysetFilePtr file = std::make_shared<ArraysetFile>(path);
+    FormPtr form = file.get()->form();
+    if (RecordForm* raw = dynamic_cast<RecordForm*>(form.get())) {
+      int64_t length = file.get()->node_length(*raw->form_key().get());
+      ContentPtrVec contents;
+      for (auto content_form : raw->contents()) {
+        ArrayGeneratorPtr generator =
+          std::make_shared<ArraysetGenerator>(content_form, length, file);
+        contents.push_back(std::make_shared<VirtualArray>(Identities::none(),
+                                                          util::Parameters(),
+                                                          generator,
+                                                          cache));
+      }
+      return std::make_shared<RecordArray>(Identities::none(),
+                                           raw->parameters(),
+                                           contents,
+                                           raw->recordlookup(),
+                                           length);
+    }
+    else {
+      ArrayGeneratorPtr generator =
+        std::make_shared<ArraysetGenerator>(form, file.get()->length(), file);
+      return std::make_shared<VirtualArray>(Identities::none(),
+                                            util::Parameters(),
+                                            generator,
+                                            cache);
+    }
+  }
+}
@@ -0,0 +1,1011 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include "awkward/Identities.h"
+#include "awkward/array/BitMaskedArray.h"
+#include "awkward/array/ByteMaskedArray.h"
+#include "awkward/array/EmptyArray.h"
+#include "awkward/array/IndexedArray.h"
+#include "awkward/array/ListArray.h"
+#include "awkward/array/ListOffsetArray.h"
+#include "awkward/array/NumpyArray.h"
+#include "awkward/array/RecordArray.h"
+#include "awkward/array/RegularArray.h"
+#include "awkward/array/UnionArray.h"
+#include "awkward/array/UnmaskedArray.h"
+#include "awkward/array/VirtualArray.h"
+
+#include "awkward/io/arrow.h"
+
+namespace awkward {
+  ////////// bitmaps (Arrow's validity: least significant bit first, 1 = valid)
+
+  const std::shared_ptr<uint8_t>
+  arrow_new_bitmap(int64_t length) {
+    size_t nbytes = (size_t)((length + 7) / 8);
+    std::shared_ptr<uint8_t> out(new uint8_t[nbytes == 0 ? 1 : nbytes],
+                                 kernel::array_deleter<uint8_t>());
+    std::memset(out.get(), 0, nbytes);
+    return out;
+  }
+
+  /// @brief Combines a new validity bitmap with the one inherited from
+  /// outer option types (if any), in place.
+  const std::shared_ptr<uint8_t>
+  arrow_and_bitmap(const std::shared_ptr<uint8_t>& bitmap,
+                   const std::shared_ptr<uint8_t>& validity,
+                   int64_t length) {
+    if (validity.get() != nullptr) {
+      uint8_t* out = bitmap.get();
+      const uint8_t* other = validity.get();
+      for (int64_t i = 0;  i < (length + 7) / 8;  i++) {
+        out[i] &= other[i];
+      }
+    }
+    return bitmap;
+  }
+
+  ////////// export
+
+  /// @brief Producer-specific data of an exported ArrowSchema.
+  struct ArrowExportSchema {
+    std::string format;
+    std::string name;
+    std::vector<ArrowSchema> children;
+    std::vector<ArrowSchema*> childptrs;
+    ArrowSchema dictionary;
+  };
+
+  /// @brief Producer-specific data of an exported ArrowArray: `owners` keep
+  /// the buffers alive until the consumer releases it.
+  struct ArrowExportArray {
+    std::vector<std::shared_ptr<void>> owners;
+    std::vector<const void*> buffers;
+    std::vector<ArrowArray> children;
+    std::vector<ArrowArray*> childptrs;
+    ArrowArray dictionary;
+  };
+
+  void
+  arrow_release_schema(ArrowSchema* schema) {
+    ArrowExportSchema* data =
+      reinterpret_cast<ArrowExportSchema*>(schema->private_data);
+    // children may have been moved out by the consumer, leaving them
+    // marked as released
+    for (auto& child : data->children) {
+      if (child.release != nullptr) {
+        child.release(&child);
+      }
+    }
+    if (schema->dictionary != nullptr  &&
+        schema->dictionary->release != nullptr) {
+      schema->dictionary->release(schema->dictionary);
+    }
+    delete data;
+    schema->release = nullptr;
+  }
+
+  void
+  arrow_release_array(ArrowArray* array) {
+    ArrowExportArray* data =
+      reinterpret_cast<ArrowExportArray*>(array->private_data);
+    for (auto& child : data->children) {
+      if (child.release != nullptr) {
+        child.release(&child);
+      }
+    }
+    if (array->dictionary != nullptr  &&
+        array->dictionary->release != nullptr) {
+      array->dictionary->release(array->dictionary);
+    }
+    delete data;
+    array->release = nullptr;
+  }
+
+  void
+  arrow_export(const ContentPtr& layout,
+               const std::string& name,
+               const std::shared_ptr<uint8_t>& validity,
+               ArrowSchema* schema,
+               ArrowArray* array);
+
+  /// @brief Fills one exported node and recursively exports its children
+  /// and dictionary. The validity bitmap (or a null pointer) is prepended
+  /// to `buffers` if `has_validity_buffer`.
+  void
+  arrow_export_node(ArrowSchema* schema,
+                    ArrowArray* array,
+                    const std::string& format,
+                    const std::string& name,
+                    int64_t length,
+                    const std::shared_ptr<uint8_t>& validity,
+                    bool has_validity_buffer,
+                    const std::vector<std::shared_ptr<void>>& owners,
+                    const std::vector<const void*>& buffers,
+                    const std::vector<std::string>& childnames,
+                    const ContentPtrVec& children,
+                    const ContentPtr& dictionary) {
+    ArrowExportSchema* schemadata = new ArrowExportSchema();
+    ArrowExportArray* arraydata = new ArrowExportArray();
+
+    schemadata->format = format;
+    schemadata->name = name;
+    schemadata->children.resize(children.size());
+    for (auto& child : schemadata->children) {
+      std::memset(&child, 0, sizeof(ArrowSchema));
+      schemadata->childptrs.push_back(&child);
+    }
+
+    arraydata->owners = owners;
+    if (has_validity_buffer) {
+      arraydata->owners.push_back(validity);
+      arraydata->buffers.push_back(validity.get());
+    }
+    arraydata->buffers.insert(arraydata->buffers.end(),
+                              buffers.begin(),
+                              buffers.end());
+    arraydata->children.resize(children.size());
+    for (auto& child : arraydata->children) {
+      std::memset(&child, 0, sizeof(ArrowArray));
+      arraydata->childptrs.push_back(&child);
+    }
+
+    schema->format = schemadata->format.c_str();
+    schema->name = schemadata->name.c_str();
+    schema->metadata = nullptr;
+    schema->flags = (validity.get() != nullptr ? ARROW_FLAG_NULLABLE : 0);
+    schema->n_children = (int64_t)children.size();
+    schema->children = schemadata->childptrs.data();
+    schema->dictionary = nullptr;
+    schema->release = arrow_release_schema;
+    schema->private_data = schemadata;
+
+    array->length = length;
+    array->null_count = (validity.get() != nullptr ? -1 : 0);
+    array->offset = 0;
+    array->n_buffers = (int64_t)arraydata->buffers.size();
+    array->n_children = (int64_t)children.size();
+    array->buffers = arraydata->buffers.data();
+    array->children = arraydata->childptrs.data();
+    array->dictionary = nullptr;
+    array->release = arrow_release_array;
+    array->private_data = arraydata;
+
+    try {
+      for (size_t i = 0;  i < children.size();  i++) {
+        arrow_export(children[i],
+                     childnames[i],
+                     std::shared_ptr<uint8_t>(nullptr),
+                     &schemadata->children[i],
+                     &arraydata->children[i]);
+      }
+      if (dictionary.get() != nullptr) {
+        std::memset(&schemadata->dictionary, 0, sizeof(ArrowSchema));
+        std::memset(&arraydata->dictionary, 0, sizeof(ArrowArray));
+        schema->dictionary = &schemadata->dictionary;
+        array->dictionary = &arraydata->dictionary;
+        arrow_export(dictionary,
+                     "",
+                     std::shared_ptr<uint8_t>(nullptr),
+                     schema->dictionary,
+                     array->dictionary);
+      }
+    }
+    catch (...) {
+      schema->release(schema);
+      array->release(array);
+      throw;
+    }
+  }
+
+  template <typename T>
+  void
+  arrow_export_list(const ListOffsetArrayOf<T>* raw,
+                    const std::string& name,
+                    const std::shared_ptr<uint8_t>& validity,
+                    const std::string& listformat,
+                    const std::string& stringformat,
+                    const std::string& bytesformat,
+                    ArrowSchema* schema,
+                    ArrowArray* array) {
+    IndexOf<T> offsets = raw->offsets();
+    std::vector<std::shared_ptr<void>> owners({ offsets.ptr() });
+    std::vector<const void*> buffers({ offsets.ptr().get() +
+                                       offsets.offset() });
+
+    std::string format = listformat;
+    if (raw->parameter_equals("__array__", "\"string\"")) {
+      format = stringformat;
+    }
+    else if (raw->parameter_equals("__array__", "\"bytestring\"")) {
+      format = bytesformat;
+    }
+    if (format != listformat) {
+      if (NumpyArray* content =
+          kind_cast<NumpyArray>(raw->content().get())) {
+        NumpyArray contiguous = content->contiguous();
+        owners.push_back(contiguous.ptr());
+        buffers.push_back(contiguous.byteptr());
+        arrow_export_node(schema, array, format, name, raw->length(),
+                          validity, true, owners, buffers,
+                          std::vector<std::string>(), ContentPtrVec(),
+                          ContentPtr(nullptr));
+        return;
+      }
+      format = listformat;
+    }
+
+    arrow_export_node(schema, array, format, name, raw->length(),
+                      validity, true, owners, buffers,
+                      std::vector<std::string>({ "item" }),
+                      ContentPtrVec({ raw->content() }),
+                      ContentPtr(nullptr));
+  }
+
+  template <typename T, bool ISOPTION>
+  void
+  arrow_export_indexed(const IndexedArrayOf<T, ISOPTION>* raw,
+                       const std::string& name,
+                       const std::shared_ptr<uint8_t>& validity,
+                       const std::string& indexformat,
+                       ArrowSchema* schema,
+                       ArrowArray* array) {
+    IndexOf<T> index = raw->index();
+    std::shared_ptr<void> owner = index.ptr();
+    const void* buffer = index.ptr().get() + index.offset();
+    std::shared_ptr<uint8_t> bitmap = validity;
+
+    if (ISOPTION) {
+      // Arrow dictionary indexes can't be negative: point missing values at
+      // item 0 and mask them out
+      int64_t length = index.length();
+      std::shared_ptr<T> nonnegative(new T[(size_t)(length == 0 ? 1 : length)],
+                                     kernel::array_deleter<T>());
+      bitmap = arrow_new_bitmap(length);
+      for (int64_t i = 0;  i < length;  i++) {
+        T x = index.getitem_at_nowrap(i);
+        if (x >= 0) {
+          nonnegative.get()[i] = x;
+          bitmap.get()[i >> 3] |= (uint8_t)(1 << (i & 7));
+        }
+        else {
+          nonnegative.get()[i] = 0;
+        }
+      }
+      bitmap = arrow_and_bitmap(bitmap, validity, length);
+      owner = nonnegative;
+      buffer = nonnegative.get();
+    }
+
+    arrow_export_node(schema, array, indexformat, name, raw->length(),
+                      bitmap, true,
+                      std::vector<std::shared_ptr<void>>({ owner }),
+                      std::vector<const void*>({ buffer }),
+                      std::vector<std::string>(), ContentPtrVec(),
+                      raw->content());
+  }
+
+  template <typename I>
+  const ContentPtr
+  arrow_union_index32(const UnionArrayOf<int8_t, I>* raw) {
+    Index32 index(raw->length());
+    IndexOf<I> original = raw->index();
+    for (int64_t i = 0;  i < raw->length();  i++) {
+      I x = original.getitem_at_nowrap(i);
+      if ((int64_t)x > (int64_t)kMaxInt32) {
+        throw std::invalid_argument(
+          "ToArrow: UnionArray index does not fit in 32 bits");
+      }
+      index.setitem_at_nowrap(i, (int32_t)x);
+    }
+    return std::make_shared<UnionArray8_32>(Identities::none(),
+                                            raw->parameters(),
+                                            raw->tags(),
+                                            index,
+                                            raw->contents());
+  }
+
+  void
+  arrow_export(const ContentPtr& layout,
+               const std::string& name,
+               const std::shared_ptr<uint8_t>& validity,
+               ArrowSchema* schema,
+               ArrowArray* array) {
+    std::vector<std::shared_ptr<void>> noowners;
+    std::vector<const void*> nobuffers;
+    std::vector<std::string> nonames;
+    ContentPtrVec nochildren;
+    ContentPtr nodictionary(nullptr);
+
+    if (VirtualArray* raw = kind_cast<VirtualArray>(layout.get())) {
+      arrow_export(raw->array(), name, validity, schema, array);
+    }
+
+    else if (kind_cast<EmptyArray>(layout.get())) {
+      arrow_export_node(schema, array, "n", name, 0,
+                        std::shared_ptr<uint8_t>(nullptr), false,
+                        noowners, nobuffers, nonames, nochildren,
+                        nodictionary);
+    }
+
+    else if (NumpyArray* raw = kind_cast<NumpyArray>(layout.get())) {
+      if (raw->isscalar()) {
+        throw std::invalid_argument("ToArrow cannot export a scalar");
+      }
+      if (raw->ndim() > 1) {
+        arrow_export(raw->toRegularArray(), name, validity, schema, array);
+        return;
+      }
+      NumpyArray contiguous = raw->contiguous();
+      int64_t length = contiguous.length();
+      std::shared_ptr<void> owner = contiguous.ptr();
+      const void* buffer = contiguous.byteptr();
+      const uint8_t* bytes = reinterpret_cast<const uint8_t*>(buffer);
+      std::string format;
+      switch (contiguous.dtype()) {
+        case util::dtype::boolean: {
+          std::shared_ptr<uint8_t> bits = arrow_new_bitmap(length);
+          for (int64_t i = 0;  i < length;  i++) {
+            if (bytes[i] != 0) {
+              bits.get()[i >> 3] |= (uint8_t)(1 << (i & 7));
+            }
+          }
+          owner = bits;
+          buffer = bits.get();
+          format = "b";
+          break;
+        }
+        case util::dtype::int8:    format = "c"; break;
+        case util::dtype::int16:   format = "s"; break;
+        case util::dtype::int32:   format = "i"; break;
+        case util::dtype::int64:   format = "l"; break;
+        case util::dtype::uint8:   format = "C"; break;
+        case util::dtype::uint16:  format = "S"; break;
+        case util::dtype::uint32:  format = "I"; break;
+        case util::dtype::uint64:  format = "L"; break;
+        case util::dtype::float16: format = "e"; break;
+        case util::dtype::float32: format = "f"; break;
+        case util::dtype::float64: format = "g"; break;
+        default:
+          throw std::invalid_argument(
+            std::string("ToArrow cannot export NumpyArray with format \"")
+            + contiguous.format() + std::string("\""));
+      }
+      arrow_export_node(schema, array, format, name, length,
+                        validity, true,
+                        std::vector<std::shared_ptr<void>>({ owner }),
+                        std::vector<const void*>({ buffer }),
+                        nonames, nochildren, nodictionary);
+    }
+
+    else if (RegularArray* raw = kind_cast<RegularArray>(layout.get())) {
+      int64_t length = raw->length();
+      arrow_export_node(schema, array,
+                        std::string("+w:") + std::to_string(raw->size()),
+                        name, length, validity, true, noowners, nobuffers,
+                        std::vector<std::string>({ "item" }),
+                        ContentPtrVec({ raw->content().get()->
+                          getitem_range_nowrap(0, length*raw->size()) }),
+                        nodictionary);
+    }
+
+    else if (ListOffsetArray32* raw =
+             kind_cast<ListOffsetArray32>(layout.get())) {
+      arrow_export_list<int32_t>(raw, name, validity, "+l", "u", "z",
+                                 schema, array);
+    }
+    else if (ListOffsetArray64* raw =
+             kind_cast<ListOffsetArray64>(layout.get())) {
+      arrow_export_list<int64_t>(raw, name, validity, "+L", "U", "Z",
+                                 schema, array);
+    }
+    else if (ListOffsetArrayU32* raw =
+             kind_cast<ListOffsetArrayU32>(layout.get())) {
+      arrow_export(raw->toListOffsetArray64(false),
+                   name, validity, schema, array);
+    }
+    else if (ListArray32* raw = kind_cast<ListArray32>(layout.get())) {
+      arrow_export(raw->toListOffsetArray64(false),
+                   name, validity, schema, array);
+    }
+    else if (ListArrayU32* raw = kind_cast<ListArrayU32>(layout.get())) {
+      arrow_export(raw->toListOffsetArray64(false),
+                   name, validity, schema, array);
+    }
+    else if (ListArray64* raw = kind_cast<ListArray64>(layout.get())) {
+      arrow_export(raw->toListOffsetArray64(false),
+                   name, validity, schema, array);
+    }
+
+    else if (RecordArray* raw = kind_cast<RecordArray>(layout.get())) {
+      int64_t length = raw->length();
+      ContentPtrVec children;
+      for (auto content : raw->contents()) {
+        children.push_back(content.get()->getitem_range_nowrap(0, length));
+      }
+      arrow_export_node(schema, array, "+s", name, length,
+                        validity, true, noowners, nobuffers,
+                        raw->keys(), children, nodictionary);
+    }
+
+    else if (UnionArray8_32* raw =
+             kind_cast<UnionArray8_32>(layout.get())) {
+      if (validity.get() != nullptr) {
+        throw std::invalid_argument(
+          "ToArrow cannot export an option-type union: Arrow unions have no "
+          "validity bitmap");
+      }
+      std::string format("+ud:");
+      std::vector<std::string> childnames;
+      for (int64_t i = 0;  i < raw->numcontents();  i++) {
+        format += (i == 0 ? "" : ",") + std::to_string(i);
+        childnames.push_back(std::to_string(i));
+      }
+      Index8 tags = raw->tags();
+      Index32 index = raw->index();
+      arrow_export_node(schema, array, format, name, raw->length(),
+                        validity, false,
+                        std::vector<std::shared_ptr<void>>({ tags.ptr(),
+                                                             index.ptr() }),
+                        std::vector<const void*>({
+                          tags.ptr().get() + tags.offset(),
+                          index.ptr().get() + index.offset() }),
+                        childnames, raw->contents(), nodictionary);
+    }
+    else if (UnionArray8_U32* raw =
+             kind_cast<UnionArray8_U32>(layout.get())) {
+      arrow_export(arrow_union_index32<uint32_t>(raw),
+                   name, validity, schema, array);
+    }
+    else if (UnionArray8_64* raw =
+             kind_cast<UnionArray8_64>(layout.get())) {
+      arrow_export(arrow_union_index32<int64_t>(raw),
+                   name, validity, schema, array);
+    }
+
+    else if (IndexedArray32* raw =
+             kind_cast<IndexedArray32>(layout.get())) {
+      arrow_export_indexed<int32_t, false>(raw, name, validity, "i",
+                                           schema, array);
+    }
+    else if (IndexedArrayU32* raw =
+             kind_cast<IndexedArrayU32>(layout.get())) {
+      arrow_export_indexed<uint32_t, false>(raw, name, validity, "I",
+                                            schema, array);
+    }
+    else if (IndexedArray64* raw =
+             kind_cast<IndexedArray64>(layout.get())) {
+      arrow_export_indexed<int64_t, false>(raw, name, validity, "l",
+                                           schema, array);
+    }
+    else if (IndexedOptionArray32* raw =
+             kind_cast<IndexedOptionArray32>(layout.get())) {
+      arrow_export_indexed<int32_t, true>(raw, name, validity, "i",
+                                          schema, array);
+    }
+    else if (IndexedOptionArray64* raw =
+             kind_cast<IndexedOptionArray64>(layout.get())) {
+      arrow_export_indexed<int64_t, true>(raw, name, validity, "l",
+                                          schema, array);
+    }
+
+    else if (ByteMaskedArray* raw =
+             kind_cast<ByteMaskedArray>(layout.get())) {
+      int64_t length = raw->length();
+      Index8 mask = raw->mask();
+      std::shared_ptr<uint8_t> bitmap = arrow_new_bitmap(length);
+      for (int64_t i = 0;  i < length;  i++) {
+        if ((mask.getitem_at_nowrap(i) != 0) == raw->valid_when()) {
+          bitmap.get()[i >> 3] |= (uint8_t)(1 << (i & 7));
+        }
+      }
+      arrow_export(raw->content().get()->getitem_range_nowrap(0, length),
+                   name,
+                   arrow_and_bitmap(bitmap, validity, length),
+                   schema,
+                   array);
+    }
+
+    else if (BitMaskedArray* raw =
+             kind_cast<BitMaskedArray>(layout.get())) {
+      int64_t length = raw->length();
+      IndexU8 mask = raw->mask();
+      std::shared_ptr<uint8_t> bitmap;
+      if (raw->lsb_order()  &&  raw->valid_when()  &&
+          validity.get() == nullptr) {
+        // same convention as Arrow: share the mask
+        bitmap = std::shared_ptr<uint8_t>(mask.ptr(),
+                                          mask.ptr().get() + mask.offset());
+      }
+      else {
+        bitmap = arrow_new_bitmap(length);
+        for (int64_t i = 0;  i < length;  i++) {
+          uint8_t byte = mask.getitem_at_nowrap(i >> 3);
+          int64_t bit = (raw->lsb_order() ? (i & 7) : 7 - (i & 7));
+          if ((((byte >> bit) & 1) != 0) == raw->valid_when()) {
+            bitmap.get()[i >> 3] |= (uint8_t)(1 << (i & 7));
+          }
+        }
+        bitmap = arrow_and_bitmap(bitmap, validity, length);
+      }
+      arrow_export(raw->content().get()->getitem_range_nowrap(0, length),
+                   name,
+                   bitmap,
+                   schema,
+                   array);
+    }
+
+    else if (UnmaskedArray* raw =
+             kind_cast<UnmaskedArray>(layout.get())) {
+      arrow_export(raw->content(), name, validity, schema, array);
+    }
+
+    else {
+      throw std::runtime_error(
+        std::string("ToArrow: unrecognized Content type: ")
+        + layout.get()->classname());
+    }
+  }
+
+  void
+  ToArrow(const ContentPtr& array,
+          struct ArrowSchema* schema,
+          struct ArrowArray* out) {
+    if (array.get()->isscalar()) {
+      throw std::invalid_argument("ToArrow cannot export a scalar");
+    }
+    arrow_export(array.get()->copy_to(kernel::Lib::cpu_kernels),
+                 "",
+                 std::shared_ptr<uint8_t>(nullptr),
+                 schema,
+                 out);
+  }
+
+  ////////// import
+
+  /// @class arrow_releaser
+  ///
+  /// @brief Used as a `std::shared_ptr` deleter (second argument) to
+  /// release an imported ArrowArray (and with it, all of its children).
+  class arrow_releaser {
+  public:
+    void operator()(ArrowArray* array) {
+      if (array->release != nullptr) {
+        array->release(array);
+      }
+      delete array;
+    }
+  };
+
+  /// @brief Buffer `i` of `array`, sharing ownership with the imported
+  /// ArrowArray. Missing buffers (allowed when they would be empty) are
+  /// replaced by a zeroed allocation of `minlength` items.
+  template <typename T>
+  const std::shared_ptr<T>
+  arrow_buffer(const ArrowArray* array,
+               int64_t i,
+               int64_t minlength,
+               const std::shared_ptr<ArrowArray>& owner) {
+    if (i >= array->n_buffers) {
+      throw std::invalid_argument(
+        std::string("FromArrow: expected at least ") + std::to_string(i + 1)
+        + std::string(" buffers, found ") + std::to_string(array->n_buffers));
+    }
+    const void* buffer = array->buffers[i];
+    if (buffer == nullptr) {
+      size_t length = (size_t)(minlength < 1 ? 1 : minlength);
+      std::shared_ptr<T> out(new T[length], kernel::array_deleter<T>());
+      std::memset(out.get(), 0, length*sizeof(T));
+      return out;
+    }
+    return std::shared_ptr<T>(owner,
+                              reinterpret_cast<T*>(const_cast<void*>(buffer)));
+  }
+
+  const NumpyArray
+  arrow_numpyarray(const std::shared_ptr<void>& ptr,
+                   int64_t length,
+                   util::dtype dtype,
+                   const util::Parameters& parameters) {
+    ssize_t itemsize = (ssize_t)util::dtype_to_itemsize(dtype);
+    std::vector<ssize_t> shape({ (ssize_t)length });
+    std::vector<ssize_t> strides({ itemsize });
+    return NumpyArray(Identities::none(),
+                      parameters,
+                      ptr,
+                      shape,
+                      strides,
+                      0,
+                      itemsize,
+                      util::dtype_to_format(dtype),
+                      dtype);
+  }
+
+  const std::vector<int64_t>
+  arrow_union_typeids(const std::string& format) {
+    std::vector<int64_t> out;
+    std::stringstream in(format.substr(4, std::string::npos));
+    std::string item;
+    while (std::getline(in, item, ',')) {
+      out.push_back((int64_t)std::stol(item));
+    }
+    return out;
+  }
+
+  const Index8
+  arrow_union_tags(const ArrowArray* array,
+                   int64_t first,
+                   int64_t length,
+                   const std::vector<int64_t>& typeids,
+                   const std::shared_ptr<ArrowArray>& owner) {
+    Index8 tags(arrow_buffer<int8_t>(array, first, length, owner), 0, length);
+    bool identity = true;
+    for (size_t i = 0;  i < typeids.size();  i++) {
+      identity = identity  &&  (typeids[i] == (int64_t)i);
+    }
+    if (identity) {
+      return tags;
+    }
+    std::map<int64_t, int8_t> tagof;
+    for (size_t i = 0;  i < typeids.size();  i++) {
+      tagof[typeids[i]] = (int8_t)i;
+    }
+    Index8 mapped(length);
+    for (int64_t i = 0;  i < length;  i++) {
+      mapped.setitem_at_nowrap(i, tagof[tags.getitem_at_nowrap(i)]);
+    }
+    return mapped;
+  }
+
+  const Index32
+  arrow_union_index(const ArrowArray* array,
+                    int64_t first,
+                    int64_t length,
+                    bool dense,
+                    const std::shared_ptr<ArrowArray>& owner) {
+    if (dense) {
+      return Index32(arrow_buffer<int32_t>(array, first + 1, length, owner),
+                     0,
+                     length);
+    }
+    Index32 index(length);
+    for (int64_t i = 0;  i < length;  i++) {
+      index.setitem_at_nowrap(i, (int32_t)i);
+    }
+    return index;
+  }
+
+  template <typename T>
+  const ContentPtr
+  arrow_import_indexed(const ArrowArray* array,
+                       int64_t length,
+                       const ContentPtr& dictionary,
+                       const std::shared_ptr<ArrowArray>& owner) {
+    IndexOf<T> index(arrow_buffer<T>(array, 1, length, owner), 0, length);
+    return std::make_shared<IndexedArrayOf<T, false>>(Identities::none(),
+                                                      util::Parameters(),
+                                                      index,
+                                                      dictionary);
+  }
+
+  template <typename T>
+  const ContentPtr
+  arrow_import_indexed64(const ArrowArray* array,
+                         int64_t length,
+                         const ContentPtr& dictionary,
+                         const std::shared_ptr<ArrowArray>& owner) {
+    std::shared_ptr<T> original = arrow_buffer<T>(array, 1, length, owner);
+    Index64 index(length);
+    for (int64_t i = 0;  i < length;  i++) {
+      index.setitem_at_nowrap(i, (int64_t)original.get()[i]);
+    }
+    return std::make_shared<IndexedArray64>(Identities::none(),
+                                            util::Parameters(),
+                                            index,
+                                            dictionary);
+  }
+
+  const ContentPtr
+  arrow_import(const ArrowSchema* schema,
+               const ArrowArray* array,
+               const std::shared_ptr<ArrowArray>& owner) {
+    if (schema->n_children != array->n_children) {
+      throw std::invalid_argument(
+        "FromArrow: ArrowSchema and ArrowArray have different numbers of "
+        "children");
+    }
+    std::string format(schema->format);
+    // build the node from item 0 and slice it at the end, so that no
+    // buffer (not even a bitmap) has to be shifted
+    int64_t length = array->offset + array->length;
+    bool has_validity = true;
+    ContentPtr out(nullptr);
+
+    if (schema->dictionary != nullptr) {
+      if (array->dictionary == nullptr) {
+        throw std::invalid_argument(
+          "FromArrow: dictionary-encoded ArrowArray without dictionary");
+      }
+      ContentPtr dictionary = arrow_import(schema->dictionary,
+                                           array->dictionary,
+                                           owner);
+      if (format == "i") {
+        out = arrow_import_indexed<int32_t>(array, length, dictionary, owner);
+      }
+      else if (format == "I") {
+        out = arrow_import_indexed<uint32_t>(array, length, dictionary, owner);
+      }
+      else if (format == "l") {
+        out = arrow_import_indexed<int64_t>(array, length, dictionary, owner);
+      }
+      else if (format == "c") {
+        out = arrow_import_indexed64<int8_t>(array, length, dictionary, owner);
+      }
+      else if (format == "C") {
+        out = arrow_import_indexed64<uint8_t>(array, length, dictionary,
+                                              owner);
+      }
+      else if (format == "s") {
+        out = arrow_import_indexed64<int16_t>(array, length, dictionary,
+                                              owner);
+      }
+      else if (format == "S") {
+        out = arrow_import_indexed64<uint16_t>(array, length, dictionary,
+                                               owner);
+      }
+      else if (format == "L") {
+        out = arrow_import_indexed64<uint64_t>(array, length, dictionary,
+                                               owner);
+      }
+      else {
+        throw std::invalid_argument(
+          std::string("FromArrow: unsupported dictionary index format \"")
+          + format + std::string("\""));
+      }
+    }
+
+    else if (format == "n") {
+      has_validity = false;
+      ContentPtr empty = std::make_shared<EmptyArray>(Identities::none(),
+                                                      util::Parameters());
+      if (length == 0) {
+        out = empty;
+      }
+      else {
+        Index64 index(length);
+        for (int64_t i = 0;  i < length;  i++) {
+          index.setitem_at_nowrap(i, -1);
+        }
+        out = std::make_shared<IndexedOptionArray64>(Identities::none(),
+                                                     util::Parameters(),
+                                                     index,
+                                                     empty);
+      }
+    }
+
+    else if (format == "b") {
+      std::shared_ptr<uint8_t> bits =
+        arrow_buffer<uint8_t>(array, 1, (length + 7) / 8, owner);
+      std::shared_ptr<void> ptr(new bool[(size_t)(length == 0 ? 1 : length)],
+                                kernel::array_deleter<bool>());
+      bool* bools = reinterpret_cast<bool*>(ptr.get());
+      for (int64_t i = 0;  i < length;  i++) {
+        bools[i] = ((bits.get()[i >> 3] >> (i & 7)) & 1) != 0;
+      }
+      out = std::make_shared<NumpyArray>(
+        arrow_numpyarray(ptr, length, util::dtype::boolean,
+                         util::Parameters()));
+    }
+
+    else if (format.length() == 1  &&
+             std::string("cCsSiIlLefg").find(format) != std::string::npos) {
+      util::dtype dtype;
+      switch (format[0]) {
+        case 'c': dtype = util::dtype::int8; break;
+        case 'C': dtype = util::dtype::uint8; break;
+        case 's': dtype = util::dtype::int16; break;
+        case 'S': dtype = util::dtype::uint16; break;
+        case 'i': dtype = util::dtype::int32; break;
+        case 'I': dtype = util::dtype::uint32; break;
+        case 'l': dtype = util::dtype::int64; break;
+        case 'L': dtype = util::dtype::uint64; break;
+        case 'e': dtype = util::dtype::float16; break;
+        case 'f': dtype = util::dtype::float32; break;
+        default:  dtype = util::dtype::float64;
+      }
+      int64_t itemsize = util::dtype_to_itemsize(dtype);
+      out = std::make_shared<NumpyArray>(
+        arrow_numpyarray(arrow_buffer<uint8_t>(array, 1, length*itemsize,
+                                               owner),
+                         length, dtype, util::Parameters()));
+    }
+
+    else if (format == "u"  ||  format == "z") {
+      Index32 offsets(arrow_buffer<int32_t>(array, 1, length + 1, owner),
+                      0,
+                      length + 1);
+      int64_t numbytes = offsets.getitem_at_nowrap(length);
+      util::Parameters contentparams;
+      util::Parameters listparams;
+      contentparams["__array__"] = (format == "u" ? "\"char\"" : "\"byte\"");
+      listparams["__array__"] = (format == "u" ? "\"string\""
+                                               : "\"bytestring\"");
+      ContentPtr content = std::make_shared<NumpyArray>(
+        arrow_numpyarray(arrow_buffer<uint8_t>(array, 2, numbytes, owner),
+                         numbytes, util::dtype::uint8, contentparams));
+      out = std::make_shared<ListOffsetArray32>(Identities::none(),
+                                                listparams,
+                                                offsets,
+                                                content);
+    }
+    else if (format == "U"  ||  format == "Z") {
+      Index64 offsets(arrow_buffer<int64_t>(array, 1, length + 1, owner),
+                      0,
+                      length + 1);
+      int64_t numbytes = offsets.getitem_at_nowrap(length);
+      util::Parameters contentparams;
+      util::Parameters listparams;
+      contentparams["__array__"] = (format == "U" ? "\"char\"" : "\"byte\"");
+      listparams["__array__"] = (format == "U" ? "\"string\""
+                                               : "\"bytestring\"");
+      ContentPtr content = std::make_shared<NumpyArray>(
+        arrow_numpyarray(arrow_buffer<uint8_t>(array, 2, numbytes, owner),
+                         numbytes, util::dtype::uint8, contentparams));
+      out = std::make_shared<ListOffsetArray64>(Identities::none(),
+                                                listparams,
+                                                offsets,
+                                                content);
+    }
+
+    else if (format == "+l"  ||  format == "+L") {
+      if (array->n_children != 1) {
+        throw std::invalid_argument("FromArrow: list must have one child");
+      }
+      ContentPtr content = arrow_import(schema->children[0],
+                                        array->children[0],
+                                        owner);
+      if (format == "+l") {
+        Index32 offsets(arrow_buffer<int32_t>(array, 1, length + 1, owner),
+                        0,
+                        length + 1);
+        out = std::make_shared<ListOffsetArray32>(Identities::none(),
+                                                  util::Parameters(),
+                                                  offsets,
+                                                  content);
+      }
+      else {
+        Index64 offsets(arrow_buffer<int64_t>(array, 1, length + 1, owner),
+                        0,
+                        length + 1);
+        out = std::make_shared<ListOffsetArray64>(Identities::none(),
+                                                  util::Parameters(),
+                                                  offsets,
+                                                  content);
+      }
+    }
+
+    else if (format.substr(0, 3) == "+w:") {
+      if (array->n_children != 1) {
+        throw std::invalid_argument(
+          "FromArrow: fixed-size list must have one child");
+      }
+      int64_t size = (int64_t)std::stol(format.substr(3, std::string::npos));
+      ContentPtr content = arrow_import(schema->children[0],
+                                        array->children[0],
+                                        owner);
+      out = std::make_shared<RegularArray>(
+        Identities::none(),
+        util::Parameters(),
+        content.get()->getitem_range_nowrap(0, length*size),
+        size);
+    }
+
+    else if (format == "+s") {
+      ContentPtrVec contents;
+      util::RecordLookupPtr recordlookup =
+        std::make_shared<util::RecordLookup>();
+      bool istuple = true;
+      for (int64_t i = 0;  i < array->n_children;  i++) {
+        contents.push_back(arrow_import(schema->children[i],
+                                        array->children[i],
+                                        owner));
+        std::string key(schema->children[i]->name == nullptr
+                          ? "" : schema->children[i]->name);
+        istuple = istuple  &&  (key == std::to_string(i));
+        recordlookup.get()->push_back(key);
+      }
+      out = std::make_shared<RecordArray>(Identities::none(),
+                                          util::Parameters(),
+                                          contents,
+                                          (istuple ? util::RecordLookupPtr(nullptr)
+                                                   : recordlookup),
+                                          length);
+    }
+
+    else if (format.substr(0, 4) == "+ud:"  ||  format.substr(0, 4) == "+us:") {
+      has_validity = false;
+      bool dense = (format[2] == 'd');
+      // before Arrow 1.0, unions had a validity buffer, too
+      int64_t first = (array->n_buffers == (dense ? 3 : 2) ? 1 : 0);
+      std::vector<int64_t> typeids = arrow_union_typeids(format);
+      if ((int64_t)typeids.size() != array->n_children) {
+        throw std::invalid_argument(
+          "FromArrow: union type ids do not match its children");
+      }
+      ContentPtrVec contents;
+      for (int64_t i = 0;  i < array->n_children;  i++) {
+        contents.push_back(arrow_import(schema->children[i],
+                                        array->children[i],
+                                        owner));
+      }
+
+      out = std::make_shared<UnionArray8_32>(
+        Identities::none(),
+        util::Parameters(),
+        arrow_union_tags(array, first, length, typeids, owner),
+        arrow_union_index(array, first, length, dense, owner),
+        contents);
+    }
+
+    else {
+      throw std::invalid_argument(
+        std::string("FromArrow: unsupported Arrow format \"") + format
+        + std::string("\""));
+    }
+
+    if (has_validity  &&
+        array->null_count != 0  &&
+        array->n_buffers > 0  &&
+        array->buffers[0] != nullptr) {
+      IndexU8 mask(arrow_buffer<uint8_t>(array, 0, (length + 7) / 8, owner),
+                   0,
+                   (length + 7) / 8);
+      out = std::make_shared<BitMaskedArray>(Identities::none(),
+                                             util::Parameters(),
+                                             mask,
+                                             out,
+                                             true,
+                                             length,
+                                             true);
+    }
+    if (array->offset != 0) {
+      out = out.get()->getitem_range_nowrap(array->offset, length);
+    }
+    return out;
+  }
+
+  const ContentPtr
+  FromArrow(struct ArrowSchema* schema, struct ArrowArray* array) {
+    if (array->release == nullptr) {
+      if (schema->release != nullptr) {
+        schema->release(schema);
+      }
+      throw std::invalid_argument(
+        "FromArrow: ArrowArray has already been released");
+    }
+    // move the struct (the producer's pointers stay valid) and mark the
+    // original as released
+    std::shared_ptr<ArrowArray> owner(new ArrowArray(*array),
+                                      arrow_releaser());
+    array->release = nullptr;
+
+    ContentPtr out(nullptr);
+    try {
+      out = arrow_import(schema, owner.get(), owner);
+    }
+    catch (...) {
+      if (schema->release != nullptr) {
+        schema->release(schema);
+      }
+      throw;
+    }
+    if (schema->release != nullptr) {
+      schema->release(schema);
+    }
+    return out;
+  }
+
+}
@@ -1,6 +1,10 @@
 // BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
 
+#include <algorithm>
 #include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
 
 #include "awkward/Content.h"
 #include "awkward/Identities.h"
@@ -10,51 +14,422 @@
 #include "awkward/io/root.h"
 
 namespace awkward {
+  bool
+  FromROOT_little_endian() {
+    int32_t test = 1;
+    return *(int8_t*)&test == 1;
+  }
+
+  uint32_t
+  FromROOT_read_bigendian(const uint8_t* ptr, bool little_endian) {
+    uint32_t value;
+    std::memcpy(&value, ptr, sizeof(uint32_t));
+    if (little_endian) {
+      value = ((value >> 24) & 0xff)     |  // move byte 3 to byte 0
+              ((value <<  8) & 0xff0000) |  // move byte 1 to byte 2
+              ((value >>  8) & 0xff00)   |  // move byte 2 to byte 1
+              ((value << 24) & 0xff000000); // byte 0 to byte 3
+    }
+    return value;
+  }
+
+  // The loops below are written so that compilers turn them into vector
+  // byte shuffles; they are only called on whole contiguous runs.
+
   void
-  FromROOT_nestedvector_fill(std::vector<GrowableBuffer<int64_t>>& levels,
-                             GrowableBuffer<int64_t>& bytepos_tocopy,
-                             int64_t& bytepos,
-                             const NumpyArray& rawdata,
-                             int64_t whichlevel,
-                             int64_t itemsize) {
-    if (whichlevel == (int64_t)levels.size()) {
-      bytepos_tocopy.append(bytepos);
-      bytepos += itemsize;
+  FromROOT_byteswap16(uint8_t* toptr, const uint8_t* fromptr, int64_t n) {
+    for (int64_t i = 0;  i < n;  i++) {
+      uint16_t x;
+      std::memcpy(&x, &fromptr[i*2], 2);
+      x = (uint16_t)((x >> 8) | (x << 8));
+      std::memcpy(&toptr[i*2], &x, 2);
     }
+  }
+
+  void
+  FromROOT_byteswap32(uint8_t* toptr, const uint8_t* fromptr, int64_t n) {
+    for (int64_t i = 0;  i < n;  i++) {
+      uint32_t x;
+      std::memcpy(&x, &fromptr[i*4], 4);
+      x = ((x >> 24) & 0xff)     |
+          ((x <<  8) & 0xff0000) |
+          ((x >>  8) & 0xff00)   |
+          ((x << 24) & 0xff000000);
+      std::memcpy(&toptr[i*4], &x, 4);
+    }
+  }
 
+  void
+  FromROOT_byteswap64(uint8_t* toptr, const uint8_t* fromptr, int64_t n) {
+    for (int64_t i = 0;  i < n;  i++) {
+      uint64_t x;
+      std::memcpy(&x, &fromptr[i*8], 8);
+      x = ((x >> 56) & 0xffULL)               |
+          ((x >> 40) & 0xff00ULL)             |
+          ((x >> 24) & 0xff0000ULL)           |
+          ((x >>  8) & 0xff000000ULL)         |
+          ((x <<  8) & 0xff00000000ULL)       |
+          ((x << 24) & 0xff0000000000ULL)     |
+          ((x << 40) & 0xff000000000000ULL)   |
+          ((x << 56) & 0xff00000000000000ULL);
+      std::memcpy(&toptr[i*8], &x, 8);
+    }
+  }
+
+  void
+  FromROOT_byteswap_copy(uint8_t* toptr,
+                         const uint8_t* fromptr,
+                         int64_t n,
+                         int64_t itemsize) {
+    switch (itemsize) {
+      case 2:
+        FromROOT_byteswap16(toptr, fromptr, n);
+        break;
+      case 4:
+        FromROOT_byteswap32(toptr, fromptr, n);
+        break;
+      case 8:
+        FromROOT_byteswap64(toptr, fromptr, n);
+        break;
+      default:
+        for (int64_t i = 0;  i < n;  i++) {
+          for (int64_t j = 0;  j < itemsize;  j++) {
+            toptr[i*itemsize + j] = fromptr[i*itemsize + itemsize - 1 - j];
+          }
+        }
+    }
+  }
+
+  /// @brief Walks the length headers of one entry without recursion,
+  /// calling `onlist(whichlevel, length, bytepos)` for every `std::vector`
+  /// in preorder, where `bytepos` is just past its length header (the start
+  /// of its leaves, if `whichlevel` is the deepest level).
+  ///
+  /// `remaining` has one slot per level and is reused between entries.
+  template <typename F>
+  void
+  FromROOT_nestedvector_walk(int64_t bytepos,
+                             const uint8_t* fromptr,
+                             int64_t nbytes,
+                             int64_t depth,
+                             int64_t itemsize,
+                             bool little_endian,
+                             std::vector<uint32_t>& remaining,
+                             F& onlist) {
+    int64_t whichlevel = 0;
+    remaining[0] = 1;
+    while (whichlevel >= 0) {
+      if (remaining[(size_t)whichlevel] == 0) {
+        whichlevel--;
+        continue;
+      }
+      remaining[(size_t)whichlevel]--;
+
+      if (bytepos + (int64_t)sizeof(uint32_t) > nbytes) {
+        throw std::invalid_argument(
+          "FromROOT_nestedvector: length header beyond the end of rawdata");
+      }
+      uint32_t length = FromROOT_read_bigendian(&fromptr[bytepos],
+                                                little_endian);
+      bytepos += sizeof(uint32_t);
+      onlist(whichlevel, length, bytepos);
+
+      if (whichlevel == depth - 1) {
+        if (bytepos + (int64_t)length*itemsize > nbytes) {
+          throw std::invalid_argument(
+            "FromROOT_nestedvector: data beyond the end of rawdata");
+        }
+        bytepos += (int64_t)length*itemsize;
+      }
+      else {
+        whichlevel++;
+        remaining[(size_t)whichlevel] = length;
+      }
+    }
+  }
+
+  /// @brief Copies `count` leaves, byteswapping them if necessary.
+  void
+  FromROOT_nestedvector_copy(uint8_t* toptr,
+                             const uint8_t* fromptr,
+                             int64_t count,
+                             int64_t itemsize,
+                             bool byteswap) {
+    if (byteswap  &&  itemsize > 1) {
+      FromROOT_byteswap_copy(toptr, fromptr, count, itemsize);
+    }
     else {
-      uint32_t bigendian =
-        *reinterpret_cast<uint32_t*>(rawdata.byteptr((ssize_t)bytepos));
-
-      // FIXME: check native endianness
-      uint32_t length =
-        ((bigendian >> 24) & 0xff)     |  // move byte 3 to byte 0
-        ((bigendian <<  8) & 0xff0000) |  // move byte 1 to byte 2
-        ((bigendian >>  8) & 0xff00)   |  // move byte 2 to byte 1
-        ((bigendian << 24) & 0xff000000); // byte 0 to byte 3
-
-      bytepos += sizeof(int32_t);
-      for (uint32_t i = 0;  i < length;  i++) {
-        FromROOT_nestedvector_fill(levels,
-                                   bytepos_tocopy,
-                                   bytepos,
-                                   rawdata,
-                                   whichlevel + 1,
-                                   itemsize);
+      std::memcpy(toptr, fromptr, (size_t)(count*itemsize));
+    }
+  }
+
+  /// @brief Parallel counting pass: number of `std::vectors` at each level
+  /// (`counts[0]` to `counts[depth - 1]`) and number of leaves
+  /// (`counts[depth]`) in entries `start` to `stop`.
+  void
+  FromROOT_nestedvector_count(const int64_t* byteoffsets,
+                              int64_t start,
+                              int64_t stop,
+                              const uint8_t* fromptr,
+                              int64_t nbytes,
+                              int64_t depth,
+                              int64_t itemsize,
+                              bool little_endian,
+                              int64_t* counts) {
+    std::vector<uint32_t> remaining((size_t)depth, 0);
+    auto onlist = [&](int64_t whichlevel, uint32_t length, int64_t) -> void {
+      counts[whichlevel]++;
+      counts[whichlevel + 1] += (whichlevel == depth - 1 ? length : 0);
+    };
+    for (int64_t i = start;  i < stop;  i++) {
+      FromROOT_nestedvector_walk(byteoffsets[i],
+                                 fromptr,
+                                 nbytes,
+                                 depth,
+                                 itemsize,
+                                 little_endian,
+                                 remaining,
+                                 onlist);
+    }
+  }
+
+  /// @brief Parallel filling pass: writes the offsets and leaves of entries
+  /// `start` to `stop` into their disjoint slices of the output, given by
+  /// `starts` (the prefix sum of the counts of all earlier ranges).
+  void
+  FromROOT_nestedvector_fillrange(const int64_t* byteoffsets,
+                                  int64_t start,
+                                  int64_t stop,
+                                  const uint8_t* fromptr,
+                                  int64_t nbytes,
+                                  int64_t depth,
+                                  int64_t itemsize,
+                                  bool little_endian,
+                                  bool byteswap,
+                                  const int64_t* starts,
+                                  const std::vector<int64_t*>& offsets,
+                                  uint8_t* toptr) {
+    std::vector<int64_t> position(starts, starts + depth + 1);
+    std::vector<uint32_t> remaining((size_t)depth, 0);
+    auto onlist = [&](int64_t whichlevel,
+                      uint32_t length,
+                      int64_t bytepos) -> void {
+      int64_t* level = offsets[(size_t)whichlevel];
+      int64_t& here = position[(size_t)whichlevel];
+      int64_t& below = position[(size_t)whichlevel + 1];
+      // in preorder, none of this list's children have been seen yet, so
+      // the next level's position is the global number of earlier children
+      level[here + 1] = below + length;
+      here++;
+      if (whichlevel == depth - 1) {
+        FromROOT_nestedvector_copy(&toptr[below*itemsize],
+                                   &fromptr[bytepos],
+                                   length,
+                                   itemsize,
+                                   byteswap);
+        below += length;
+      }
+    };
+    for (int64_t i = start;  i < stop;  i++) {
+      FromROOT_nestedvector_walk(byteoffsets[i],
+                                 fromptr,
+                                 nbytes,
+                                 depth,
+                                 itemsize,
+                                 little_endian,
+                                 remaining,
+                                 onlist);
+    }
+  }
+
+  /// @brief Runs `task(0)` to `task(numthreads - 1)` concurrently (task 0
+  /// on the calling thread) and rethrows the first exception, if any.
+  template <typename F>
+  void
+  FromROOT_parallel(int64_t numthreads, const F& task) {
+    std::vector<std::exception_ptr> errors((size_t)numthreads);
+    std::vector<std::thread> threads;
+    for (int64_t t = 1;  t < numthreads;  t++) {
+      threads.push_back(std::thread([&task, &errors, t]() -> void {
+        try {
+          task(t);
+        }
+        catch (...) {
+          errors[(size_t)t] = std::current_exception();
+        }
+      }));
+    }
+    try {
+      task(0);
+    }
+    catch (...) {
+      errors[0] = std::current_exception();
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (auto error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
       }
-      int64_t previous = levels[(unsigned int)whichlevel].getitem_at_nowrap(
-        levels[(unsigned int)whichlevel].length() - 1);
-      levels[(unsigned int)whichlevel].append(previous + length);
     }
   }
 
+  void
+  FromROOT_nestedvector_sequential(const Index64& byteoffsets,
+                                   const uint8_t* fromptr,
+                                   int64_t nbytes,
+                                   int64_t depth,
+                                   int64_t itemsize,
+                                   bool little_endian,
+                                   bool byteswap,
+                                   const ArrayBuilderOptions& options,
+                                   std::vector<Index64>& offsets,
+                                   std::shared_ptr<void>& ptr,
+                                   int64_t& numleaves) {
+    // pass 1: length headers only, recording where each run of contiguous
+    // leaves starts
+
+    std::vector<GrowableBuffer<int64_t>> levels;
+    for (int64_t i = 0;  i < depth;  i++) {
+      levels.push_back(GrowableBuffer<int64_t>(options));
+      levels[(size_t)i].append(0);
+    }
+    GrowableBuffer<int64_t> runs(options);
+    std::vector<uint32_t> remaining((size_t)depth, 0);
+    auto onlist = [&](int64_t whichlevel,
+                      uint32_t length,
+                      int64_t bytepos) -> void {
+      GrowableBuffer<int64_t>& level = levels[(size_t)whichlevel];
+      level.append(level.getitem_at_nowrap(level.length() - 1) + length);
+      if (whichlevel == depth - 1) {
+        runs.append(bytepos);
+      }
+    };
+    for (int64_t i = 0;  i < byteoffsets.length() - 1;  i++) {
+      FromROOT_nestedvector_walk(byteoffsets.getitem_at_nowrap(i),
+                                 fromptr,
+                                 nbytes,
+                                 depth,
+                                 itemsize,
+                                 little_endian,
+                                 remaining,
+                                 onlist);
+    }
+
+    // pass 2: copy each contiguous run of leaves
+
+    const GrowableBuffer<int64_t>& leaves = levels[(size_t)(depth - 1)];
+    numleaves = leaves.getitem_at_nowrap(leaves.length() - 1);
+    ptr = std::shared_ptr<void>(new uint8_t[(size_t)(numleaves*itemsize)],
+                                kernel::array_deleter<uint8_t>());
+    uint8_t* toptr = reinterpret_cast<uint8_t*>(ptr.get());
+    for (int64_t i = 0;  i < runs.length();  i++) {
+      int64_t start = leaves.getitem_at_nowrap(i);
+      FromROOT_nestedvector_copy(&toptr[start*itemsize],
+                                 &fromptr[runs.getitem_at_nowrap(i)],
+                                 leaves.getitem_at_nowrap(i + 1) - start,
+                                 itemsize,
+                                 byteswap);
+    }
+
+    for (int64_t i = 0;  i < depth;  i++) {
+      offsets.push_back(Index64(levels[(size_t)i].ptr(),
+                                0,
+                                levels[(size_t)i].length()));
+    }
+  }
+
+  void
+  FromROOT_nestedvector_parallel(const Index64& byteoffsets,
+                                 const uint8_t* fromptr,
+                                 int64_t nbytes,
+                                 int64_t depth,
+                                 int64_t itemsize,
+                                 bool little_endian,
+                                 bool byteswap,
+                                 int64_t numthreads,
+                                 std::vector<Index64>& offsets,
+                                 std::shared_ptr<void>& ptr,
+                                 int64_t& numleaves) {
+    int64_t numentries = byteoffsets.length() - 1;
+    const int64_t* entrypos = byteoffsets.ptr().get() + byteoffsets.offset();
+    int64_t width = depth + 1;
+
+    // split the entries into ranges with about the same number of bytes
+    std::vector<int64_t> bounds((size_t)numthreads + 1);
+    bounds[0] = 0;
+    bounds[(size_t)numthreads] = numentries;
+    int64_t firstbyte = entrypos[0];
+    int64_t totalbytes = entrypos[numentries] - firstbyte;
+    for (int64_t t = 1;  t < numthreads;  t++) {
+      int64_t target = firstbyte + (totalbytes * t) / numthreads;
+      int64_t bound = std::lower_bound(entrypos,
+                                       entrypos + numentries,
+                                       target) - entrypos;
+      bounds[(size_t)t] = std::max(bound, bounds[(size_t)t - 1]);
+    }
+
+    // counting pass
+    std::vector<int64_t> counts((size_t)(numthreads*width), 0);
+    FromROOT_parallel(numthreads, [&](int64_t t) -> void {
+      FromROOT_nestedvector_count(entrypos,
+                                  bounds[(size_t)t],
+                                  bounds[(size_t)t + 1],
+                                  fromptr,
+                                  nbytes,
+                                  depth,
+                                  itemsize,
+                                  little_endian,
+                                  &counts[(size_t)(t*width)]);
+    });
+
+    // exclusive prefix sum of the counts, for each level and the leaves
+    std::vector<int64_t> starts((size_t)(numthreads*width), 0);
+    std::vector<int64_t> totals((size_t)width, 0);
+    for (int64_t t = 0;  t < numthreads;  t++) {
+      for (int64_t k = 0;  k < width;  k++) {
+        starts[(size_t)(t*width + k)] = totals[(size_t)k];
+        totals[(size_t)k] += counts[(size_t)(t*width + k)];
+      }
+    }
+
+    std::vector<int64_t*> rawoffsets;
+    for (int64_t k = 0;  k < depth;  k++) {
+      offsets.push_back(Index64(totals[(size_t)k] + 1));
+      rawoffsets.push_back(offsets.back().ptr().get());
+      rawoffsets.back()[0] = 0;
+    }
+    numleaves = totals[(size_t)depth];
+    ptr = std::shared_ptr<void>(new uint8_t[(size_t)(numleaves*itemsize)],
+                                kernel::array_deleter<uint8_t>());
+    uint8_t* toptr = reinterpret_cast<uint8_t*>(ptr.get());
+
+    // filling pass, into disjoint slices of the output
+    FromROOT_parallel(numthreads, [&](int64_t t) -> void {
+      FromROOT_nestedvector_fillrange(entrypos,
+                                      bounds[(size_t)t],
+                                      bounds[(size_t)t + 1],
+                                      fromptr,
+                                      nbytes,
+                                      depth,
+                                      itemsize,
+                                      little_endian,
+                                      byteswap,
+                                      &starts[(size_t)(t*width)],
+                                      rawoffsets,
+                                      toptr);
+    });
+  }
+
   const ContentPtr
   FromROOT_nestedvector(const Index64& byteoffsets,
                         const NumpyArray& rawdata,
                         int64_t depth,
                         int64_t itemsize,
                         std::string format,
-                        const ArrayBuilderOptions& options) {
+                        const ArrayBuilderOptions& options,
+                        int64_t numthreads) {
     if (depth <= 0) {
       throw std::runtime_error("FromROOT_nestedvector: depth <= 0");
     }
@@ -62,44 +437,62 @@ namespace awkward {
       throw std::runtime_error("FromROOT_nestedvector: rawdata.ndim() != 1");
     }
 
-    Index64 level0(byteoffsets.length());
-    level0.setitem_at_nowrap(0, 0);
+    bool little_endian = FromROOT_little_endian();
+    const uint8_t* fromptr =
+      reinterpret_cast<const uint8_t*>(rawdata.ptr().get()) +
+      rawdata.byteoffset();
+    int64_t nbytes = rawdata.length() * (int64_t)rawdata.itemsize();
 
-    std::vector<GrowableBuffer<int64_t>> levels;
-    for (int64_t i = 0;  i < depth;  i++) {
-      levels.push_back(GrowableBuffer<int64_t>(options));
-      levels[(size_t)i].append(0);
+    // convert big-endian data to native order if the format says it is
+    // big-endian
+    bool byteswap = false;
+    if (format.length() > 1) {
+      std::string endianness = format.substr(0, 1);
+      if (((endianness == ">"  ||  endianness == "!")  &&  little_endian)  ||
+          (endianness == "<"  &&  !little_endian)) {
+        byteswap = true;
+        format = format.substr(1, format.length() - 1);
+      }
     }
 
-    GrowableBuffer<int64_t> bytepos_tocopy(options);
+    if (numthreads <= 0) {
+      numthreads = (int64_t)std::thread::hardware_concurrency();
+    }
+    numthreads = std::min(numthreads, byteoffsets.length() - 1);
 
-    for (int64_t i = 0;  i < byteoffsets.length() - 1;  i++) {
-      int64_t bytepos = byteoffsets.getitem_at_nowrap(i);
-      FromROOT_nestedvector_fill(levels,
-                                 bytepos_tocopy,
-                                 bytepos,
-                                 rawdata,
-                                 0,
-                                 itemsize);
-      level0.setitem_at_nowrap(i + 1, levels[0].length());
-    }
-
-    std::shared_ptr<void> ptr(
-      new uint8_t[(size_t)(bytepos_tocopy.length()*itemsize)],
-      kernel::array_deleter<uint8_t>());
-    ssize_t offset = rawdata.byteoffset();
-    uint8_t* toptr = reinterpret_cast<uint8_t*>(ptr.get());
-    uint8_t* fromptr = reinterpret_cast<uint8_t*>(rawdata.ptr().get());
-    for (int64_t i = 0;  i < bytepos_tocopy.length();  i++) {
-      ssize_t bytepos = (ssize_t)bytepos_tocopy.getitem_at_nowrap(i);
-      std::memcpy(&toptr[(ssize_t)(i*itemsize)],
-                  &fromptr[offset + bytepos],
-                  (size_t)itemsize);
+    std::vector<Index64> offsets;
+    std::shared_ptr<void> ptr(nullptr);
+    int64_t numleaves;
+    if (numthreads <= 1) {
+      FromROOT_nestedvector_sequential(byteoffsets,
+                                       fromptr,
+                                       nbytes,
+                                       depth,
+                                       itemsize,
+                                       little_endian,
+                                       byteswap,
+                                       options,
+                                       offsets,
+                                       ptr,
+                                       numleaves);
+    }
+    else {
+      FromROOT_nestedvector_parallel(byteoffsets,
+                                     fromptr,
+                                     nbytes,
+                                     depth,
+                                     itemsize,
+                                     little_endian,
+                                     byteswap,
+                                     numthreads,
+                                     offsets,
+                                     ptr,
+                                     numleaves);
     }
 
     util::dtype dtype = util::format_to_dtype(format, itemsize);
 
-    std::vector<ssize_t> shape = { (ssize_t)bytepos_tocopy.length() };
+    std::vector<ssize_t> shape = { (ssize_t)numleaves };
     std::vector<ssize_t> strides = { (ssize_t)itemsize };
     ContentPtr out = std::make_shared<NumpyArray>(Identities::none(),
                                                   util::Parameters(),
@@ -112,10 +505,9 @@ namespace awkward {
                                                   dtype);
 
     for (int64_t i = depth - 1;  i >= 0;  i--) {
-      Index64 index(levels[(size_t)i].ptr(), 0, levels[(size_t)i].length());
       out = std::make_shared<ListOffsetArray64>(Identities::none(),
                                                 util::Parameters(),
-                                                index,
+                                                offsets[(size_t)i],
                                                 out);
     }
     return out;
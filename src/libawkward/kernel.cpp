@@ -6,6 +6,7 @@
 #include "awkward/cpu-kernels/getitem.h"
 #include "awkward/cpu-kernels/identities.h"
 #include "awkward/cpu-kernels/reducers.h"
+#include "awkward/cpu-kernels/elementwise.h"
 
 #ifdef BUILD_CUDA_KERNELS
 #include "awkward/cuda-kernels/identities.h"
@@ -1528,6 +1529,24 @@ namespace kernel {
       stride);
   }
 
+  ERROR NumpyArray_getitem_boolean_compact(
+    uint8_t* toptr,
+    const uint8_t* fromptr,
+    int64_t byteoffset,
+    int64_t stride,
+    const int8_t* mask,
+    int64_t maskoffset,
+    int64_t length) {
+    return awkward_NumpyArray_getitem_boolean_compact(
+      toptr,
+      fromptr,
+      byteoffset,
+      stride,
+      mask,
+      maskoffset,
+      length);
+  }
+
   ERROR NumpyArray_getitem_boolean_nonzero_64(
     int64_t *toptr,
     const int8_t *fromptr,
@@ -2331,6 +2350,69 @@ namespace kernel {
       masklength);
   }
 
+  template<>
+  ERROR ListOffsetArray_getitem_jagged_mask_64(
+    int64_t* tooffsets,
+    const int32_t* fromoffsets,
+    int64_t fromoffsetsoffset,
+    const int64_t* maskoffsets,
+    int64_t maskoffsetsoffset,
+    const int8_t* mask,
+    int64_t maskoffset,
+    int64_t length) {
+    return awkward_ListOffsetArray32_getitem_jagged_mask_64(
+      tooffsets,
+      fromoffsets,
+      fromoffsetsoffset,
+      maskoffsets,
+      maskoffsetsoffset,
+      mask,
+      maskoffset,
+      length);
+  }
+
+  template<>
+  ERROR ListOffsetArray_getitem_jagged_mask_64(
+    int64_t* tooffsets,
+    const uint32_t* fromoffsets,
+    int64_t fromoffsetsoffset,
+    const int64_t* maskoffsets,
+    int64_t maskoffsetsoffset,
+    const int8_t* mask,
+    int64_t maskoffset,
+    int64_t length) {
+    return awkward_ListOffsetArrayU32_getitem_jagged_mask_64(
+      tooffsets,
+      fromoffsets,
+      fromoffsetsoffset,
+      maskoffsets,
+      maskoffsetsoffset,
+      mask,
+      maskoffset,
+      length);
+  }
+
+  template<>
+  ERROR ListOffsetArray_getitem_jagged_mask_64(
+    int64_t* tooffsets,
+    const int64_t* fromoffsets,
+    int64_t fromoffsetsoffset,
+    const int64_t* maskoffsets,
+    int64_t maskoffsetsoffset,
+    const int8_t* mask,
+    int64_t maskoffset,
+    int64_t length) {
+    return awkward_ListOffsetArray64_getitem_jagged_mask_64(
+      tooffsets,
+      fromoffsets,
+      fromoffsetsoffset,
+      maskoffsets,
+      maskoffsetsoffset,
+      mask,
+      maskoffset,
+      length);
+  }
+
   ERROR IndexedArray_getitem_adjust_outindex_64(
     int8_t *tomask,
     int64_t *toindex,
@@ -3147,6 +3229,74 @@ namespace kernel {
       validwhen);
   }
 
+  ERROR BitMaskedArray_numnull(
+    int64_t *numnull,
+    const uint8_t *mask,
+    int64_t maskoffset,
+    int64_t length,
+    bool validwhen,
+    bool lsb_order) {
+    return awkward_BitMaskedArray_numnull(
+      numnull,
+      mask,
+      maskoffset,
+      length,
+      validwhen,
+      lsb_order);
+  }
+
+  ERROR BitMaskedArray_getitem_nextcarry_64(
+    int64_t *tocarry,
+    const uint8_t *mask,
+    int64_t maskoffset,
+    int64_t length,
+    bool validwhen,
+    bool lsb_order) {
+    return awkward_BitMaskedArray_getitem_nextcarry_64(
+      tocarry,
+      mask,
+      maskoffset,
+      length,
+      validwhen,
+      lsb_order);
+  }
+
+  ERROR BitMaskedArray_getitem_nextcarry_outindex_64(
+    int64_t *tocarry,
+    int64_t *outindex,
+    const uint8_t *mask,
+    int64_t maskoffset,
+    int64_t length,
+    bool validwhen,
+    bool lsb_order) {
+    return awkward_BitMaskedArray_getitem_nextcarry_outindex_64(
+      tocarry,
+      outindex,
+      mask,
+      maskoffset,
+      length,
+      validwhen,
+      lsb_order);
+  }
+
+  ERROR BitMaskedArray_getitem_carry_64(
+    uint8_t *tomask,
+    const uint8_t *frommask,
+    int64_t frommaskoffset,
+    int64_t lenmask,
+    const int64_t *fromcarry,
+    int64_t lencarry,
+    bool lsb_order) {
+    return awkward_BitMaskedArray_getitem_carry_64(
+      tomask,
+      frommask,
+      frommaskoffset,
+      lenmask,
+      fromcarry,
+      lencarry,
+      lsb_order);
+  }
+
   ERROR Content_getitem_next_missing_jagged_getmaskstartstop(
       int64_t *index_in, int64_t index_in_offset, int64_t *offsets_in,
       int64_t offsets_in_offset, int64_t *mask_out, int64_t *starts_out,
@@ -9627,6 +9777,30 @@ namespace kernel {
       validwhen);
   }
 
+  ERROR BitMaskedArray_reduce_next_64(
+    int64_t *nextcarry,
+    int64_t *nextparents,
+    int64_t *outindex,
+    const uint8_t *mask,
+    int64_t maskoffset,
+    const int64_t *parents,
+    int64_t parentsoffset,
+    int64_t length,
+    bool validwhen,
+    bool lsb_order) {
+    return awkward_BitMaskedArray_reduce_next_64(
+      nextcarry,
+      nextparents,
+      outindex,
+      mask,
+      maskoffset,
+      parents,
+      parentsoffset,
+      length,
+      validwhen,
+      lsb_order);
+  }
+
   /////////////////////////////////// awkward/cpu-kernels/sorting.h
 
   ERROR sorting_ranges(
@@ -10147,4 +10321,449 @@ namespace kernel {
       nextparents,
       nextparentsoffset);
   }
+
+  /////////////////////////////////// awkward/cpu-kernels/elementwise.h
+
+  template<>
+  ERROR elementwise_binary(
+    double* toptr,
+    const double* leftptr,
+    int64_t leftoffset,
+    int64_t leftstride,
+    const double* rightptr,
+    int64_t rightoffset,
+    int64_t rightstride,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_binary_float64(
+      toptr,
+      leftptr,
+      leftoffset,
+      leftstride,
+      rightptr,
+      rightoffset,
+      rightstride,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_binary(
+    float* toptr,
+    const float* leftptr,
+    int64_t leftoffset,
+    int64_t leftstride,
+    const float* rightptr,
+    int64_t rightoffset,
+    int64_t rightstride,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_binary_float32(
+      toptr,
+      leftptr,
+      leftoffset,
+      leftstride,
+      rightptr,
+      rightoffset,
+      rightstride,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_binary(
+    int64_t* toptr,
+    const int64_t* leftptr,
+    int64_t leftoffset,
+    int64_t leftstride,
+    const int64_t* rightptr,
+    int64_t rightoffset,
+    int64_t rightstride,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_binary_int64(
+      toptr,
+      leftptr,
+      leftoffset,
+      leftstride,
+      rightptr,
+      rightoffset,
+      rightstride,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_binary(
+    int32_t* toptr,
+    const int32_t* leftptr,
+    int64_t leftoffset,
+    int64_t leftstride,
+    const int32_t* rightptr,
+    int64_t rightoffset,
+    int64_t rightstride,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_binary_int32(
+      toptr,
+      leftptr,
+      leftoffset,
+      leftstride,
+      rightptr,
+      rightoffset,
+      rightstride,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_binary(
+    bool* toptr,
+    const bool* leftptr,
+    int64_t leftoffset,
+    int64_t leftstride,
+    const bool* rightptr,
+    int64_t rightoffset,
+    int64_t rightstride,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_binary_bool(
+      toptr,
+      leftptr,
+      leftoffset,
+      leftstride,
+      rightptr,
+      rightoffset,
+      rightstride,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_compare(
+    bool* toptr,
+    const double* leftptr,
+    int64_t leftoffset,
+    int64_t leftstride,
+    const double* rightptr,
+    int64_t rightoffset,
+    int64_t rightstride,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_compare_float64(
+      toptr,
+      leftptr,
+      leftoffset,
+      leftstride,
+      rightptr,
+      rightoffset,
+      rightstride,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_compare(
+    bool* toptr,
+    const float* leftptr,
+    int64_t leftoffset,
+    int64_t leftstride,
+    const float* rightptr,
+    int64_t rightoffset,
+    int64_t rightstride,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_compare_float32(
+      toptr,
+      leftptr,
+      leftoffset,
+      leftstride,
+      rightptr,
+      rightoffset,
+      rightstride,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_compare(
+    bool* toptr,
+    const int64_t* leftptr,
+    int64_t leftoffset,
+    int64_t leftstride,
+    const int64_t* rightptr,
+    int64_t rightoffset,
+    int64_t rightstride,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_compare_int64(
+      toptr,
+      leftptr,
+      leftoffset,
+      leftstride,
+      rightptr,
+      rightoffset,
+      rightstride,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_compare(
+    bool* toptr,
+    const int32_t* leftptr,
+    int64_t leftoffset,
+    int64_t leftstride,
+    const int32_t* rightptr,
+    int64_t rightoffset,
+    int64_t rightstride,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_compare_int32(
+      toptr,
+      leftptr,
+      leftoffset,
+      leftstride,
+      rightptr,
+      rightoffset,
+      rightstride,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_compare(
+    bool* toptr,
+    const bool* leftptr,
+    int64_t leftoffset,
+    int64_t leftstride,
+    const bool* rightptr,
+    int64_t rightoffset,
+    int64_t rightstride,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_compare_bool(
+      toptr,
+      leftptr,
+      leftoffset,
+      leftstride,
+      rightptr,
+      rightoffset,
+      rightstride,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_unary(
+    double* toptr,
+    const double* fromptr,
+    int64_t fromoffset,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_unary_float64(
+      toptr,
+      fromptr,
+      fromoffset,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_unary(
+    float* toptr,
+    const float* fromptr,
+    int64_t fromoffset,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_unary_float32(
+      toptr,
+      fromptr,
+      fromoffset,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_unary(
+    int64_t* toptr,
+    const int64_t* fromptr,
+    int64_t fromoffset,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_unary_int64(
+      toptr,
+      fromptr,
+      fromoffset,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_unary(
+    int32_t* toptr,
+    const int32_t* fromptr,
+    int64_t fromoffset,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_unary_int32(
+      toptr,
+      fromptr,
+      fromoffset,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_unary(
+    bool* toptr,
+    const bool* fromptr,
+    int64_t fromoffset,
+    int64_t length,
+    int64_t op) {
+    return awkward_elementwise_unary_bool(
+      toptr,
+      fromptr,
+      fromoffset,
+      length,
+      op);
+  }
+
+  template<>
+  ERROR elementwise_program<int64_t, int64_t>(
+    int64_t* toptr,
+    const void* const* inputptrs,
+    const int64_t* inputoffsets,
+    const int64_t* inputstrides,
+    const int64_t* inputdtypes,
+    const int64_t* program,
+    int64_t programlength,
+    const double* constants,
+    int64_t length) {
+    return awkward_elementwise_program_int64(
+      toptr,
+      inputptrs,
+      inputoffsets,
+      inputstrides,
+      inputdtypes,
+      program,
+      programlength,
+      constants,
+      length);
+  }
+
+  template<>
+  ERROR elementwise_program<float, float>(
+    float* toptr,
+    const void* const* inputptrs,
+    const int64_t* inputoffsets,
+    const int64_t* inputstrides,
+    const int64_t* inputdtypes,
+    const int64_t* program,
+    int64_t programlength,
+    const double* constants,
+    int64_t length) {
+    return awkward_elementwise_program_float32(
+      toptr,
+      inputptrs,
+      inputoffsets,
+      inputstrides,
+      inputdtypes,
+      program,
+      programlength,
+      constants,
+      length);
+  }
+
+  template<>
+  ERROR elementwise_program<double, double>(
+    double* toptr,
+    const void* const* inputptrs,
+    const int64_t* inputoffsets,
+    const int64_t* inputstrides,
+    const int64_t* inputdtypes,
+    const int64_t* program,
+    int64_t programlength,
+    const double* constants,
+    int64_t length) {
+    return awkward_elementwise_program_float64(
+      toptr,
+      inputptrs,
+      inputoffsets,
+      inputstrides,
+      inputdtypes,
+      program,
+      programlength,
+      constants,
+      length);
+  }
+
+  template<>
+  ERROR elementwise_program<bool, int64_t>(
+    bool* toptr,
+    const void* const* inputptrs,
+    const int64_t* inputoffsets,
+    const int64_t* inputstrides,
+    const int64_t* inputdtypes,
+    const int64_t* program,
+    int64_t programlength,
+    const double* constants,
+    int64_t length) {
+    return awkward_elementwise_program_bool_int64(
+      toptr,
+      inputptrs,
+      inputoffsets,
+      inputstrides,
+      inputdtypes,
+      program,
+      programlength,
+      constants,
+      length);
+  }
+
+  template<>
+  ERROR elementwise_program<bool, float>(
+    bool* toptr,
+    const void* const* inputptrs,
+    const int64_t* inputoffsets,
+    const int64_t* inputstrides,
+    const int64_t* inputdtypes,
+    const int64_t* program,
+    int64_t programlength,
+    const double* constants,
+    int64_t length) {
+    return awkward_elementwise_program_bool_float32(
+      toptr,
+      inputptrs,
+      inputoffsets,
+      inputstrides,
+      inputdtypes,
+      program,
+      programlength,
+      constants,
+      length);
+  }
+
+  template<>
+  ERROR elementwise_program<bool, double>(
+    bool* toptr,
+    const void* const* inputptrs,
+    const int64_t* inputoffsets,
+    const int64_t* inputstrides,
+    const int64_t* inputdtypes,
+    const int64_t* program,
+    int64_t programlength,
+    const double* constants,
+    int64_t length) {
+    return awkward_elementwise_program_bool_float64(
+      toptr,
+      inputptrs,
+      inputoffsets,
+      inputstrides,
+      inputdtypes,
+      program,
+      programlength,
+      constants,
+      length);
+  }
 }
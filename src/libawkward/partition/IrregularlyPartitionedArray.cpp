@@ -1,5 +1,6 @@
 // BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
 
+#include <algorithm>
 #include <sstream>
 
 #include "awkward/array/UnionArray.h"
@@ -47,17 +48,15 @@ namespace awkward {
       index = -1;
       return;
     }
-    int64_t start = 0;
-    for (int64_t i = 0;  i < numpartitions();  i++) {
-      if (at < stops_[(size_t)i]) {
-        partitionid = i;
-        index = at - start;
-        return;
-      }
-      start = stops_[(size_t)i];
+    // the first partition that stops after at (skipping empty partitions)
+    auto it = std::upper_bound(stops_.begin(), stops_.end(), at);
+    partitionid = (int64_t)(it - stops_.begin());
+    if (partitionid == numpartitions()) {
+      index = 0;
+    }
+    else {
+      index = at - start(partitionid);
     }
-    partitionid = numpartitions();
-    index = 0;
   }
 
   PartitionedArrayPtr
@@ -0,0 +1,183 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "awkward/array/RecordArray.h"
+#include "awkward/array/VirtualArray.h"
+
+#include "awkward/partition/PartitionPrefetcher.h"
+
+namespace awkward {
+  /// @brief Materializes every VirtualArray in `content` (directly or as
+  /// fields of a RecordArray) and returns the number of bytes generated.
+  int64_t
+  partitionprefetcher_materialize(const ContentPtr& content) {
+    if (VirtualArray* raw = dynamic_cast<VirtualArray*>(content.get())) {
+      ContentPtr out = raw->array();
+      return out.get()->nbytes() + partitionprefetcher_materialize(out);
+    }
+    else if (RecordArray* raw = dynamic_cast<RecordArray*>(content.get())) {
+      int64_t out = 0;
+      for (auto field : raw->contents()) {
+        out += partitionprefetcher_materialize(field);
+      }
+      return out;
+    }
+    else {
+      return 0;
+    }
+  }
+
+  bool
+  partitionprefetcher_ready(const std::shared_future<int64_t>& task) {
+    return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }
+
+  PartitionPrefetcher::PartitionPrefetcher(const PartitionedArrayPtr& array,
+                                           int64_t depth,
+                                           int64_t max_inflight_bytes)
+      : array_(array)
+      , depth_(depth)
+      , max_inflight_bytes_(max_inflight_bytes)
+      , inflight_bytes_(0)
+      , total_bytes_(0)
+      , total_count_(0) {
+    if (array_.get() == nullptr) {
+      throw std::invalid_argument(
+        "PartitionPrefetcher array must not be None");
+    }
+    if (depth_ < 1) {
+      throw std::invalid_argument(
+        "PartitionPrefetcher depth must be at least 1");
+    }
+  }
+
+  PartitionPrefetcher::~PartitionPrefetcher() {
+    wait();
+  }
+
+  const PartitionedArrayPtr
+  PartitionPrefetcher::array() const {
+    return array_;
+  }
+
+  int64_t
+  PartitionPrefetcher::depth() const {
+    return depth_;
+  }
+
+  int64_t
+  PartitionPrefetcher::max_inflight_bytes() const {
+    return max_inflight_bytes_;
+  }
+
+  int64_t
+  PartitionPrefetcher::inflight_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return inflight_bytes_;
+  }
+
+  const ContentPtr
+  PartitionPrefetcher::partition(int64_t partitionid) {
+    ContentPtr out = array_.get()->partition(partitionid);
+
+    std::shared_future<int64_t> prefetch;
+    bool prefetched = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      // hand out this partition and give up on any that were skipped
+      for (auto it = started_.begin();
+           it != started_.end()  &&  it->first <= partitionid;
+           it = started_.erase(it)) {
+        if (it->first == partitionid) {
+          prefetch = it->second;
+          prefetched = true;
+        }
+        auto done = finished_.find(it->first);
+        if (done != finished_.end()) {
+          inflight_bytes_ -= done->second;
+          finished_.erase(done);
+        }
+      }
+      schedule(partitionid);
+    }
+
+    if (prefetched) {
+      prefetch.get();
+    }
+    else {
+      int64_t bytes = partitionprefetcher_materialize(out);
+      std::lock_guard<std::mutex> lock(mutex_);
+      total_bytes_ += bytes;
+      total_count_++;
+    }
+    return out;
+  }
+
+  void
+  PartitionPrefetcher::wait() {
+    std::vector<std::shared_future<int64_t>> tasks;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks = tasks_;
+    }
+    // the tasks need mutex_ to finish, so wait for them without it
+    for (auto task : tasks) {
+      task.wait();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.erase(std::remove_if(tasks_.begin(),
+                                tasks_.end(),
+                                partitionprefetcher_ready),
+                 tasks_.end());
+  }
+
+  void
+  PartitionPrefetcher::schedule(int64_t partitionid) {
+    // forget tasks that are done (destroying one that is still running
+    // would block)
+    tasks_.erase(std::remove_if(tasks_.begin(),
+                                tasks_.end(),
+                                partitionprefetcher_ready),
+                 tasks_.end());
+
+    int64_t numpartitions = array_.get()->numpartitions();
+    for (int64_t i = partitionid + 1;
+         i <= partitionid + depth_  &&  i < numpartitions;
+         i++) {
+      if (started_.find(i) != started_.end()) {
+        continue;
+      }
+      if (max_inflight_bytes_ >= 0) {
+        int64_t estimate = (total_count_ == 0 ? 0
+                                              : total_bytes_ / total_count_);
+        int64_t unfinished = (int64_t)started_.size() -
+                             (int64_t)finished_.size();
+        // until one partition's size is known, prefetch one at a time
+        if ((total_count_ == 0  &&  unfinished > 0)  ||
+            inflight_bytes_ + (unfinished + 1)*estimate >
+            max_inflight_bytes_) {
+          break;
+        }
+      }
+      std::shared_future<int64_t> task = std::async(std::launch::async,
+        [this, i]() -> int64_t {
+          int64_t bytes = partitionprefetcher_materialize(
+                            array_.get()->partition(i));
+          std::lock_guard<std::mutex> lock(mutex_);
+          total_bytes_ += bytes;
+          total_count_++;
+          // only count it if it has not already been requested (or skipped)
+          if (started_.find(i) != started_.end()) {
+            finished_[i] = bytes;
+            inflight_bytes_ += bytes;
+          }
+          return bytes;
+        }).share();
+      started_[i] = task;
+      tasks_.push_back(task);
+    }
+  }
+}
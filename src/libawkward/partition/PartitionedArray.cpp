@@ -1,10 +1,217 @@
 // BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <system_error>
+#include <thread>
+
+#include "awkward/array/BitMaskedArray.h"
+#include "awkward/array/ByteMaskedArray.h"
+#include "awkward/array/EmptyArray.h"
+#include "awkward/array/IndexedArray.h"
+#include "awkward/array/ListArray.h"
+#include "awkward/array/ListOffsetArray.h"
+#include "awkward/array/NumpyArray.h"
+#include "awkward/array/RecordArray.h"
+#include "awkward/array/RegularArray.h"
+#include "awkward/array/UnionArray.h"
+#include "awkward/array/UnmaskedArray.h"
+#include "awkward/array/VirtualArray.h"
 #include "awkward/partition/IrregularlyPartitionedArray.h"
 
 #include "awkward/partition/PartitionedArray.h"
 
 namespace awkward {
+  /// @brief Calls `task(i)` for each `i` from `0` to `length` on up to
+  /// `nthreads` threads (the calling thread being one of them), then
+  /// rethrows the exception of the lowest `i` that failed, if any.
+  void
+  partitionedarray_parallel(int64_t length,
+                            int64_t nthreads,
+                            const std::function<void(int64_t)>& task) {
+    if (nthreads <= 0) {
+      nthreads = (int64_t)std::thread::hardware_concurrency();
+    }
+    nthreads = std::max((int64_t)1, std::min(nthreads, length));
+
+    std::vector<std::exception_ptr> errors((size_t)length);
+    std::atomic<int64_t> next(0);
+    auto worker = [&]() -> void {
+      for (int64_t i = next++;  i < length;  i = next++) {
+        try {
+          task(i);
+        }
+        catch (...) {
+          errors[(size_t)i] = std::current_exception();
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (int64_t i = 1;  i < nthreads;  i++) {
+      try {
+        threads.push_back(std::thread(worker));
+      }
+      catch (const std::system_error&) {
+        // fewer threads than requested is not an error
+        break;
+      }
+    }
+    worker();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (auto error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+  }
+
+  /// @brief Number of bytes in each entry of an Index with this Form.
+  double
+  partitionedarray_indexbytes(Index::Form form) {
+    switch (form) {
+      case Index::Form::i8:
+      case Index::Form::u8:
+        return 1.0;
+      case Index::Form::i32:
+      case Index::Form::u32:
+        return 4.0;
+      default:
+        return 8.0;
+    }
+  }
+
+  /// @brief Estimates the number of bytes per entry of an array with this
+  /// Form (assuming one item per list), or returns `-1` if unknown.
+  double
+  partitionedarray_rowbytes(const FormPtr& form) {
+    if (form.get() == nullptr) {
+      return -1.0;
+    }
+    else if (NumpyForm* raw = dynamic_cast<NumpyForm*>(form.get())) {
+      double out = (double)raw->itemsize();
+      for (auto x : raw->inner_shape()) {
+        out *= (double)x;
+      }
+      return out;
+    }
+    else if (dynamic_cast<EmptyForm*>(form.get())) {
+      return 0.0;
+    }
+    else if (RecordForm* raw = dynamic_cast<RecordForm*>(form.get())) {
+      double out = 0.0;
+      for (auto content : raw->contents()) {
+        double field = partitionedarray_rowbytes(content);
+        if (field < 0.0) {
+          return -1.0;
+        }
+        out += field;
+      }
+      return out;
+    }
+    else if (RegularForm* raw = dynamic_cast<RegularForm*>(form.get())) {
+      double content = partitionedarray_rowbytes(raw->content());
+      return (content < 0.0 ? -1.0 : (double)raw->size() * content);
+    }
+
+    double index = 0.0;
+    FormPtr content(nullptr);
+    if (ListOffsetForm* raw = dynamic_cast<ListOffsetForm*>(form.get())) {
+      index = partitionedarray_indexbytes(raw->offsets());
+      content = raw->content();
+    }
+    else if (ListForm* raw = dynamic_cast<ListForm*>(form.get())) {
+      index = partitionedarray_indexbytes(raw->starts()) +
+              partitionedarray_indexbytes(raw->stops());
+      content = raw->content();
+    }
+    else if (IndexedForm* raw = dynamic_cast<IndexedForm*>(form.get())) {
+      index = partitionedarray_indexbytes(raw->index());
+      content = raw->content();
+    }
+    else if (IndexedOptionForm* raw =
+             dynamic_cast<IndexedOptionForm*>(form.get())) {
+      index = partitionedarray_indexbytes(raw->index());
+      content = raw->content();
+    }
+    else if (ByteMaskedForm* raw = dynamic_cast<ByteMaskedForm*>(form.get())) {
+      index = 1.0;
+      content = raw->content();
+    }
+    else if (BitMaskedForm* raw = dynamic_cast<BitMaskedForm*>(form.get())) {
+      index = 1.0 / 8.0;
+      content = raw->content();
+    }
+    else if (UnmaskedForm* raw = dynamic_cast<UnmaskedForm*>(form.get())) {
+      content = raw->content();
+    }
+    else if (UnionForm* raw = dynamic_cast<UnionForm*>(form.get())) {
+      // tags and index, plus the largest of the possible contents
+      double out = -1.0;
+      for (auto x : raw->contents()) {
+        out = std::max(out, partitionedarray_rowbytes(x));
+      }
+      return (out < 0.0 ? -1.0 : 1.0 + partitionedarray_indexbytes(
+                                         raw->index()) + out);
+    }
+    else if (VirtualForm* raw = dynamic_cast<VirtualForm*>(form.get())) {
+      return (raw->has_form() ? partitionedarray_rowbytes(raw->form())
+                              : -1.0);
+    }
+    else {
+      return -1.0;
+    }
+    double out = partitionedarray_rowbytes(content);
+    return (out < 0.0 ? -1.0 : index + out);
+  }
+
+  /// @brief Returns the number of bytes in `content` (which has `length`
+  /// entries) without materializing VirtualArrays, or `-1` if it cannot be
+  /// estimated.
+  double
+  partitionedarray_nbytes(const ContentPtr& content, int64_t length) {
+    if (VirtualArray* raw = kind_cast<VirtualArray>(content.get())) {
+      ContentPtr peek = raw->peek_array();
+      if (peek.get() != nullptr) {
+        return (double)peek.get()->nbytes();
+      }
+      double rowbytes = partitionedarray_rowbytes(raw->generator().get()->form());
+      return (rowbytes < 0.0 ? -1.0 : rowbytes * (double)length);
+    }
+    else if (RecordArray* raw = kind_cast<RecordArray>(content.get())) {
+      double out = 0.0;
+      for (auto field : raw->contents()) {
+        double bytes = partitionedarray_nbytes(field, length);
+        if (bytes < 0.0) {
+          return -1.0;
+        }
+        out += bytes;
+      }
+      return out;
+    }
+    else {
+      return (double)content.get()->nbytes();
+    }
+  }
+
+  /// @brief Returns a PartitionedArray of `partitions` with stops at their
+  /// lengths.
+  const PartitionedArrayPtr
+  partitionedarray_frompartitions(const ContentPtrVec& partitions) {
+    std::vector<int64_t> stops;
+    int64_t total_length = 0;
+    for (auto partition : partitions) {
+      total_length += partition.get()->length();
+      stops.push_back(total_length);
+    }
+    return std::make_shared<IrregularlyPartitionedArray>(partitions, stops);
+  }
+
   PartitionedArray::PartitionedArray(const ContentPtrVec& partitions)
       : partitions_(partitions) {
     if (partitions_.empty()) {
@@ -93,6 +300,36 @@ namespace awkward {
     return getitem_at_nowrap(regular_at);
   }
 
+  void
+  PartitionedArray::partitionids_indexes_at(
+    const std::vector<int64_t>& at,
+    std::vector<int64_t>& partitionids,
+    std::vector<int64_t>& indexes) const {
+    partitionids.resize(at.size());
+    indexes.resize(at.size());
+    int64_t n = numpartitions();
+    int64_t partitionid = 0;
+    int64_t previous = 0;
+    for (size_t i = 0;  i < at.size();  i++) {
+      if (at[i] < previous) {
+        partitionid_index_at(at[i], partitionids[i], indexes[i]);
+        if (partitionids[i] >= 0) {
+          partitionid = partitionids[i];
+        }
+      }
+      else {
+        while (partitionid < n  &&  at[i] >= stop(partitionid)) {
+          partitionid++;
+        }
+        partitionids[i] = partitionid;
+        indexes[i] = (partitionid == n ? 0 : at[i] - start(partitionid));
+      }
+      if (at[i] >= 0) {
+        previous = at[i];
+      }
+    }
+  }
+
   const ContentPtr
   PartitionedArray::getitem_at_nowrap(int64_t at) const {
     int64_t partitionid;
@@ -250,4 +487,199 @@ namespace awkward {
     }
     return std::make_shared<IrregularlyPartitionedArray>(partitions, stops);
   }
+
+  const PartitionedArrayPtr
+  PartitionedArray::repartition_by_bytes(int64_t target_bytes) const {
+    if (target_bytes <= 0) {
+      throw std::invalid_argument(
+        "repartition_by_bytes target_bytes must be positive");
+    }
+    double target = (double)target_bytes;
+    double tolerance = target / 4.0;
+
+    // partitions whose size can't be estimated get the average bytes per
+    // entry of the others
+    std::vector<double> nbytes;
+    double known_bytes = 0.0;
+    int64_t known_length = 0;
+    for (int64_t i = 0;  i < numpartitions();  i++) {
+      int64_t len = stop(i) - start(i);
+      nbytes.push_back(partitionedarray_nbytes(partitions_[(size_t)i], len));
+      if (nbytes.back() >= 0.0) {
+        known_bytes += nbytes.back();
+        known_length += len;
+      }
+    }
+    double average = (known_length == 0 ? 8.0
+                                        : known_bytes / (double)known_length);
+
+    std::vector<int64_t> stops;
+    double current = 0.0;
+    for (int64_t i = 0;  i < numpartitions();  i++) {
+      int64_t len = stop(i) - start(i);
+      if (len == 0) {
+        continue;
+      }
+      double rowbytes = (nbytes[(size_t)i] >= 0.0 ? nbytes[(size_t)i]
+                                                  : average * (double)len)
+                        / (double)len;
+      int64_t pos = 0;
+      while (pos < len) {
+        double rest = rowbytes * (double)(len - pos);
+        if (current + rest < target - tolerance) {
+          // all of the rest of this partition fits in the current one
+          current += rest;
+          break;
+        }
+        int64_t rows = len - pos;
+        if (rowbytes > 0.0) {
+          rows = std::max((int64_t)1,
+                          (int64_t)std::ceil((target - current) / rowbytes));
+        }
+        if (pos + rows >= len  ||
+            rowbytes * (double)(len - pos - rows) < tolerance) {
+          // close enough to this partition's boundary
+          rows = len - pos;
+        }
+        pos += rows;
+        stops.push_back(start(i) + pos);
+        current = 0.0;
+      }
+    }
+    if (stops.empty()  ||  stops.back() != length()) {
+      stops.push_back(length());
+    }
+    return repartition(stops);
+  }
+
+  const ContentPtr
+  PartitionedArray::tocontent() const {
+    ContentPtrVec others(std::next(partitions_.begin()), partitions_.end());
+    return partitions_[0].get()->merge_many(others, false);
+  }
+
+  bool
+  PartitionedArray::is_partition_axis(int64_t axis) const {
+    std::pair<bool, int64_t> branchdepth = partitions_[0].get()->branch_depth();
+    bool branch = branchdepth.first;
+    int64_t depth = branchdepth.second;
+    int64_t negaxis = -axis;
+    if (!branch  &&  negaxis <= 0) {
+      negaxis += depth;
+    }
+    return !branch  &&  negaxis == depth;
+  }
+
+  const PartitionedArrayPtr
+  PartitionedArray::map(
+    const std::function<const ContentPtr(const ContentPtr&)>& fn,
+    int64_t nthreads) const {
+    ContentPtrVec out(partitions_.size());
+    partitionedarray_parallel(numpartitions(), nthreads,
+      [&](int64_t i) -> void {
+        out[(size_t)i] = fn(partitions_[(size_t)i]);
+      });
+    return partitionedarray_frompartitions(out);
+  }
+
+  const ContentPtr
+  PartitionedArray::reduce(const Reducer& reducer,
+                           int64_t axis,
+                           bool mask,
+                           bool keepdims,
+                           int64_t nthreads) const {
+    if (!is_partition_axis(axis)) {
+      return map([&](const ContentPtr& x) -> const ContentPtr {
+                   return x.get()->reduce(reducer, axis, mask, keepdims);
+                 }, nthreads).get()->tocontent();
+    }
+
+    // how partial results combine into the full result
+    std::shared_ptr<Reducer> combiner(nullptr);
+    if (dynamic_cast<const ReducerCount*>(&reducer)         ||
+        dynamic_cast<const ReducerCountNonzero*>(&reducer)  ||
+        dynamic_cast<const ReducerSum*>(&reducer)) {
+      combiner = std::make_shared<ReducerSum>();
+    }
+    else if (dynamic_cast<const ReducerProd*>(&reducer)) {
+      combiner = std::make_shared<ReducerProd>();
+    }
+    else if (dynamic_cast<const ReducerAny*>(&reducer)) {
+      combiner = std::make_shared<ReducerAny>();
+    }
+    else if (dynamic_cast<const ReducerAll*>(&reducer)) {
+      combiner = std::make_shared<ReducerAll>();
+    }
+    else if (dynamic_cast<const ReducerMin*>(&reducer)) {
+      combiner = std::make_shared<ReducerMin>();
+    }
+    else if (dynamic_cast<const ReducerMax*>(&reducer)) {
+      combiner = std::make_shared<ReducerMax>();
+    }
+    else {
+      return tocontent().get()->reduce(reducer, axis, mask, keepdims);
+    }
+
+    // keepdims makes each partial result a length-1 array, so that they
+    // concatenate into an array with the same axis to reduce
+    ContentPtrVec partials(partitions_.size());
+    partitionedarray_parallel(numpartitions(), nthreads,
+      [&](int64_t i) -> void {
+        partials[(size_t)i] = partitions_[(size_t)i].get()->reduce(
+          reducer, axis, mask, true);
+      });
+    ContentPtrVec others(std::next(partials.begin()), partials.end());
+    ContentPtr combined = partials[0].get()->merge_many(others, false);
+    return combined.get()->reduce(*combiner.get(), axis, mask, keepdims);
+  }
+
+  const PartitionedArrayPtr
+  PartitionedArray::sort(int64_t axis,
+                         bool ascending,
+                         bool stable,
+                         int64_t nthreads) const {
+    if (is_partition_axis(axis)) {
+      ContentPtrVec partitions(
+        { tocontent().get()->sort(axis, ascending, stable) });
+      return partitionedarray_frompartitions(partitions);
+    }
+    return map([&](const ContentPtr& x) -> const ContentPtr {
+                 return x.get()->sort(axis, ascending, stable);
+               }, nthreads);
+  }
+
+  const PartitionedArrayPtr
+  PartitionedArray::getitem(const Slice& where, int64_t nthreads) const {
+    if (where.length() == 0) {
+      return shallow_copy();
+    }
+    SliceItemPtr head = where.head();
+    if (SliceRange* raw = dynamic_cast<SliceRange*>(head.get())) {
+      PartitionedArrayPtr out = getitem_range(raw->start(),
+                                              raw->stop(),
+                                              raw->step());
+      Slice tail = where.tail();
+      if (tail.length() == 0) {
+        return out;
+      }
+      Slice within = tail.prepended(
+        std::make_shared<SliceRange>(Slice::none(), Slice::none(), 1));
+      return out.get()->map([&](const ContentPtr& x) -> const ContentPtr {
+                              return x.get()->getitem(within);
+                            }, nthreads);
+    }
+    else if (dynamic_cast<SliceField*>(head.get())     ||
+             dynamic_cast<SliceFields*>(head.get())    ||
+             dynamic_cast<SliceEllipsis*>(head.get())) {
+      return map([&](const ContentPtr& x) -> const ContentPtr {
+                   return x.get()->getitem(where);
+                 }, nthreads);
+    }
+    else {
+      throw std::invalid_argument(
+        std::string("cannot slice ") + classname()
+        + std::string(" partition by partition with ") + head.get()->tostring()
+        + std::string("; use getitem_at or tocontent"));
+    }
+  }
 }
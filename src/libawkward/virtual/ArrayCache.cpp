@@ -1,12 +1,32 @@
 // BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
 
 #include <atomic>
+#include <cstdio>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+  #include <process.h>
+#else
+  #include <unistd.h>
+#endif
+
+#include "awkward/io/arrayset.h"
 
 #include "awkward/virtual/ArrayCache.h"
 
 namespace awkward {
   std::atomic<int64_t> numkeys{0};
 
+  ArrayCache::ArrayCache()
+      : stats_hits_(0)
+      , stats_misses_(0)
+      , stats_sets_(0)
+      , stats_evictions_(0) { }
+
+  ArrayCache::~ArrayCache() = default;
+
   const std::string
   ArrayCache::newkey() {
     std::string out = std::string("ak") + std::to_string(numkeys);
@@ -14,7 +34,460 @@ namespace awkward {
     return out;
   }
 
+  int64_t
+  ArrayCache::resident_bytes() const {
+    return -1;
+  }
+
+  const ArrayCacheStats
+  ArrayCache::stats() const {
+    return ArrayCacheStats({ stats_hits_.load(),
+                             stats_misses_.load(),
+                             stats_sets_.load(),
+                             stats_evictions_.load(),
+                             resident_bytes() });
+  }
+
+  void
+  ArrayCache::reset_stats() {
+    stats_hits_ = 0;
+    stats_misses_ = 0;
+    stats_sets_ = 0;
+    stats_evictions_ = 0;
+  }
+
   // Note: if you're creating a pure C++ cache (and it's not ridiculously
   // large), define it in
   // include/awkward/virtual/ArrayCache.h and implement it in this file.
+
+  ////////// LRUArrayCache
+
+  LRUArrayCache::LRUArrayCache(int64_t limit_bytes)
+      : limit_bytes_(limit_bytes)
+      , current_bytes_(0) {
+    if (limit_bytes < 0) {
+      throw std::invalid_argument("LRUArrayCache limit_bytes must be >= 0");
+    }
+  }
+
+  int64_t
+  LRUArrayCache::limit_bytes() const {
+    return limit_bytes_;
+  }
+
+  int64_t
+  LRUArrayCache::current_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_bytes_;
+  }
+
+  int64_t
+  LRUArrayCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (int64_t)lookup_.size();
+  }
+
+  const std::vector<std::string>
+  LRUArrayCache::keys() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> out;
+    for (auto entry : order_) {
+      out.push_back(entry.key);
+    }
+    return out;
+  }
+
+  bool
+  LRUArrayCache::has(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lookup_.find(key) != lookup_.end();
+  }
+
+  ContentPtr
+  LRUArrayCache::get(const std::string& key) const {
+    ContentPtr out = lookup(key);
+    if (out.get() == nullptr) {
+      stats_misses_++;
+    }
+    else {
+      stats_hits_++;
+    }
+    return out;
+  }
+
+  void
+  LRUArrayCache::set(const std::string& key, const ContentPtr& value) {
+    stats_sets_++;
+    insert(key, value);
+  }
+
+  ContentPtr
+  LRUArrayCache::lookup(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = lookup_.find(key);
+    if (found == lookup_.end()) {
+      return ContentPtr(nullptr);
+    }
+    // move to the front without invalidating any iterators
+    order_.splice(order_.begin(), order_, found->second);
+    return found->second->value;
+  }
+
+  void
+  LRUArrayCache::insert(const std::string& key, const ContentPtr& value) {
+    // nbytes walks the whole tree, so compute it before taking the lock
+    int64_t nbytes = value.get()->nbytes();
+
+    EntryList dropped;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto found = lookup_.find(key);
+      if (found != lookup_.end()) {
+        if (found->second->value.get() == value.get()) {
+          order_.splice(order_.begin(), order_, found->second);
+          return;
+        }
+        remove_entry(found->second);
+      }
+      if (nbytes > limit_bytes_) {
+        dropped.push_back(Entry({ key, value, nbytes }));
+      }
+      else {
+        while (current_bytes_ + nbytes > limit_bytes_  &&  !order_.empty()) {
+          auto last = std::prev(order_.end());
+          current_bytes_ -= last->nbytes;
+          lookup_.erase(last->key);
+          dropped.splice(dropped.end(), order_, last);
+          stats_evictions_++;
+        }
+        order_.push_front(Entry({ key, value, nbytes }));
+        lookup_[key] = order_.begin();
+        current_bytes_ += nbytes;
+      }
+    }
+    // without the lock: subclasses may take their time with these
+    for (auto entry : dropped) {
+      evicted(entry.key, entry.value);
+    }
+  }
+
+  void
+  LRUArrayCache::evicted(const std::string& key, const ContentPtr& value) { }
+
+  bool
+  LRUArrayCache::remove(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = lookup_.find(key);
+    if (found == lookup_.end()) {
+      return false;
+    }
+    remove_entry(found->second);
+    return true;
+  }
+
+  void
+  LRUArrayCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    order_.clear();
+    lookup_.clear();
+    current_bytes_ = 0;
+  }
+
+  int64_t
+  LRUArrayCache::resident_bytes() const {
+    return current_bytes();
+  }
+
+  void
+  LRUArrayCache::remove_entry(EntryList::iterator entry) {
+    current_bytes_ -= entry->nbytes;
+    lookup_.erase(entry->key);
+    order_.erase(entry);
+  }
+
+  const std::string
+  LRUArrayCache::tostring_part(const std::string& indent,
+                               const std::string& pre,
+                               const std::string& post) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::stringstream out;
+    out << indent << pre << "<LRUArrayCache limit_bytes=\"" << limit_bytes_
+        << "\" current_bytes=\"" << current_bytes_ << "\" size=\""
+        << lookup_.size() << "\"/>" << post;
+    return out.str();
+  }
+
+  ////////// TieredArrayCache
+
+  /// @brief A new file name in `directory` that is unique across processes.
+  const std::string
+  tieredarraycache_path(const std::string& directory) {
+#ifdef _MSC_VER
+    int64_t pid = (int64_t)_getpid();
+#else
+    int64_t pid = (int64_t)getpid();
+#endif
+    return directory + std::string("/awkward-spill-") + std::to_string(pid)
+           + std::string("-") + ArrayCache::newkey()
+           + std::string(".arrayset");
+  }
+
+  TieredArrayCache::TieredArrayCache(int64_t limit_bytes,
+                                     const std::string& directory,
+                                     int64_t disk_limit_bytes)
+      : LRUArrayCache(limit_bytes)
+      , directory_(directory)
+      , disk_limit_bytes_(disk_limit_bytes)
+      , disk_bytes_(0)
+      , numpending_(0)
+      , spills_(0)
+      , disk_hits_(0)
+      , spill_failures_(0) {
+    std::string probe = tieredarraycache_path(directory_);
+    FILE* file = std::fopen(probe.c_str(), "wb");
+    if (file == nullptr) {
+      throw std::invalid_argument(
+        std::string("TieredArrayCache directory is not writable: ")
+        + directory_);
+    }
+    std::fclose(file);
+    std::remove(probe.c_str());
+  }
+
+  TieredArrayCache::~TieredArrayCache() {
+    std::lock_guard<std::mutex> lock(disk_mutex_);
+    while (!disk_order_.empty()) {
+      remove_disk_entry(disk_order_.begin());
+    }
+  }
+
+  const std::string
+  TieredArrayCache::directory() const {
+    return directory_;
+  }
+
+  int64_t
+  TieredArrayCache::disk_limit_bytes() const {
+    return disk_limit_bytes_;
+  }
+
+  int64_t
+  TieredArrayCache::disk_bytes() const {
+    std::lock_guard<std::mutex> lock(disk_mutex_);
+    return disk_bytes_;
+  }
+
+  const std::vector<std::string>
+  TieredArrayCache::disk_keys() const {
+    std::lock_guard<std::mutex> lock(disk_mutex_);
+    std::vector<std::string> out;
+    for (auto entry : disk_order_) {
+      out.push_back(entry.key);
+    }
+    return out;
+  }
+
+  int64_t
+  TieredArrayCache::spills() const {
+    return spills_;
+  }
+
+  int64_t
+  TieredArrayCache::disk_hits() const {
+    return disk_hits_;
+  }
+
+  int64_t
+  TieredArrayCache::spill_failures() const {
+    return spill_failures_;
+  }
+
+  bool
+  TieredArrayCache::has(const std::string& key) const {
+    if (LRUArrayCache::has(key)) {
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(disk_mutex_);
+    return disk_lookup_.find(key) != disk_lookup_.end();
+  }
+
+  ContentPtr
+  TieredArrayCache::get(const std::string& key) const {
+    ContentPtr out = lookup(key);
+    if (out.get() != nullptr) {
+      stats_hits_++;
+      return out;
+    }
+
+    std::shared_ptr<ArraysetFile> file(nullptr);
+    {
+      std::lock_guard<std::mutex> lock(disk_mutex_);
+      auto found = disk_lookup_.find(key);
+      if (found == disk_lookup_.end()) {
+        stats_misses_++;
+        return ContentPtr(nullptr);
+      }
+      disk_order_.splice(disk_order_.begin(), disk_order_, found->second);
+      if (found->second->file.get() == nullptr) {
+        try {
+          found->second->file =
+            std::make_shared<ArraysetFile>(found->second->path);
+        }
+        catch (std::exception& err) {
+          const_cast<TieredArrayCache*>(this)->remove_disk_entry(
+            found->second);
+          stats_misses_++;
+          return ContentPtr(nullptr);
+        }
+      }
+      file = found->second->file;
+    }
+
+    out = file.get()->content();
+    {
+      std::lock_guard<std::mutex> lock(disk_mutex_);
+      auto found = disk_lookup_.find(key);
+      if (found != disk_lookup_.end()  &&  found->second->file == file) {
+        found->second->value = out;
+      }
+    }
+    stats_hits_++;
+    disk_hits_++;
+    // back in memory, but its file stays, so evicting it again is free
+    const_cast<TieredArrayCache*>(this)->insert(key, out);
+    return out;
+  }
+
+  void
+  TieredArrayCache::set(const std::string& key, const ContentPtr& value) {
+    {
+      std::lock_guard<std::mutex> lock(disk_mutex_);
+      pending_.erase(key);
+      auto found = disk_lookup_.find(key);
+      if (found != disk_lookup_.end()) {
+        remove_disk_entry(found->second);
+      }
+    }
+    LRUArrayCache::set(key, value);
+  }
+
+  bool
+  TieredArrayCache::remove(const std::string& key) {
+    bool out = LRUArrayCache::remove(key);
+    std::lock_guard<std::mutex> lock(disk_mutex_);
+    pending_.erase(key);
+    auto found = disk_lookup_.find(key);
+    if (found != disk_lookup_.end()) {
+      remove_disk_entry(found->second);
+      out = true;
+    }
+    return out;
+  }
+
+  void
+  TieredArrayCache::clear() {
+    LRUArrayCache::clear();
+    std::lock_guard<std::mutex> lock(disk_mutex_);
+    pending_.clear();
+    while (!disk_order_.empty()) {
+      remove_disk_entry(disk_order_.begin());
+    }
+  }
+
+  void
+  TieredArrayCache::reset_stats() {
+    LRUArrayCache::reset_stats();
+    spills_ = 0;
+    disk_hits_ = 0;
+    spill_failures_ = 0;
+  }
+
+  void
+  TieredArrayCache::evicted(const std::string& key, const ContentPtr& value) {
+    int64_t which;
+    {
+      std::lock_guard<std::mutex> lock(disk_mutex_);
+      auto found = disk_lookup_.find(key);
+      if (found != disk_lookup_.end()) {
+        if (found->second->value.lock() == value) {
+          disk_order_.splice(disk_order_.begin(), disk_order_, found->second);
+          return;
+        }
+        remove_disk_entry(found->second);
+      }
+      // a newer array was set while this one was being evicted
+      if (LRUArrayCache::has(key)) {
+        return;
+      }
+      which = ++numpending_;
+      pending_[key] = which;
+    }
+
+    // write without the lock; a cache drops what it cannot keep, but
+    // counts it
+    std::string path = tieredarraycache_path(directory_);
+    int64_t nbytes = -1;
+    try {
+      ToArraysetFile(value, path);
+      FILE* file = std::fopen(path.c_str(), "rb");
+      if (file != nullptr) {
+        std::fseek(file, 0, SEEK_END);
+        nbytes = (int64_t)std::ftell(file);
+        std::fclose(file);
+      }
+    }
+    catch (std::exception& err) {
+      nbytes = -1;
+    }
+
+    std::lock_guard<std::mutex> lock(disk_mutex_);
+    auto found = pending_.find(key);
+    bool current = (found != pending_.end()  &&  found->second == which);
+    if (current) {
+      pending_.erase(found);
+    }
+    if (nbytes < 0) {
+      spill_failures_++;
+    }
+    if (!current  ||
+        nbytes < 0  ||
+        (disk_limit_bytes_ >= 0  &&  nbytes > disk_limit_bytes_)) {
+      std::remove(path.c_str());
+      return;
+    }
+    while (disk_limit_bytes_ >= 0  &&
+           disk_bytes_ + nbytes > disk_limit_bytes_  &&
+           !disk_order_.empty()) {
+      remove_disk_entry(std::prev(disk_order_.end()));
+    }
+    disk_order_.push_front(DiskEntry({ key, path, nbytes, nullptr,
+                                       std::weak_ptr<Content>() }));
+    disk_lookup_[key] = disk_order_.begin();
+    disk_bytes_ += nbytes;
+    spills_++;
+  }
+
+  void
+  TieredArrayCache::remove_disk_entry(DiskEntryList::iterator entry) {
+    // arrays that were read from the file keep its mapping alive
+    std::remove(entry->path.c_str());
+    disk_bytes_ -= entry->nbytes;
+    disk_lookup_.erase(entry->key);
+    disk_order_.erase(entry);
+  }
+
+  const std::string
+  TieredArrayCache::tostring_part(const std::string& indent,
+                                  const std::string& pre,
+                                  const std::string& post) const {
+    int64_t current_bytes = LRUArrayCache::current_bytes();
+    int64_t size = LRUArrayCache::size();
+    std::lock_guard<std::mutex> lock(disk_mutex_);
+    std::stringstream out;
+    out << indent << pre << "<TieredArrayCache limit_bytes=\"" << limit_bytes()
+        << "\" current_bytes=\"" << current_bytes << "\" size=\"" << size
+        << "\" directory=\"" << directory_ << "\" disk_bytes=\"" << disk_bytes_
+        << "\" disk_size=\"" << disk_lookup_.size() << "\"/>" << post;
+    return out.str();
+  }
 }
@@ -1,7 +1,9 @@
 // BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
 
+#include <chrono>
 #include "sstream"
 
+#include "awkward/kernel.h"
 #include "awkward/array/VirtualArray.h"
 
 #include "awkward/virtual/ArrayGenerator.h"
@@ -9,7 +11,10 @@
 namespace awkward {
   ArrayGenerator::ArrayGenerator(const FormPtr& form, int64_t length)
       : form_(form)
-      , length_(length) { }
+      , length_(length)
+      , stats_calls_(0)
+      , stats_wall_time_ns_(0)
+      , stats_bytes_(0) { }
 
   ArrayGenerator::~ArrayGenerator() = default;
 
@@ -25,6 +30,7 @@ namespace awkward {
 
   const ContentPtr
   ArrayGenerator::generate_and_check() const {
+    auto start = std::chrono::steady_clock::now();
     ContentPtr out = generate();
     if (length_ >= 0  &&  length_ != out.get()->length()) {
       throw std::invalid_argument(
@@ -39,9 +45,38 @@ namespace awkward {
           + form_.get()->tostring() + std::string("\n\nbut generated:\n\n")
           + out.get()->form(true).get()->tostring());
     }
+    auto stop = std::chrono::steady_clock::now();
+    stats_calls_++;
+    stats_wall_time_ns_ += (int64_t)std::chrono::duration_cast<
+      std::chrono::nanoseconds>(stop - start).count();
+    stats_bytes_ += out.get()->nbytes();
     return out;
   }
 
+  const ArrayGeneratorStats
+  ArrayGenerator::stats() const {
+    return ArrayGeneratorStats({ stats_calls_.load(),
+                                 stats_wall_time_ns_.load(),
+                                 stats_bytes_.load() });
+  }
+
+  void
+  ArrayGenerator::reset_stats() {
+    stats_calls_ = 0;
+    stats_wall_time_ns_ = 0;
+    stats_bytes_ = 0;
+  }
+
+  const std::shared_ptr<ArrayGenerator>
+  ArrayGenerator::project_field(const std::string& key) const {
+    return std::shared_ptr<ArrayGenerator>(nullptr);
+  }
+
+  const std::shared_ptr<ArrayGenerator>
+  ArrayGenerator::project_range(int64_t start, int64_t stop) const {
+    return std::shared_ptr<ArrayGenerator>(nullptr);
+  }
+
   SliceGenerator::SliceGenerator(const FormPtr& form,
                                  int64_t length,
                                  const ContentPtr& content,
@@ -66,7 +101,25 @@ namespace awkward {
       SliceItemPtr head = slice_.head();
       if (SliceRange* raw = dynamic_cast<SliceRange*>(head.get())) {
         if (raw->step() == 1) {
-          if (VirtualArray* a = dynamic_cast<VirtualArray*>(content_.get())) {
+          if (VirtualArray* a = kind_cast<VirtualArray>(content_.get())) {
+            ContentPtr peek = a->peek_array();
+            if (peek.get() != nullptr) {
+              return peek.get()->getitem_range(raw->start(), raw->stop());
+            }
+            // read only this range, if the source's generator can
+            int64_t length = a->generator().get()->length();
+            if (length >= 0) {
+              int64_t regular_start = raw->start();
+              int64_t regular_stop = raw->stop();
+              kernel::regularize_rangeslice(&regular_start, &regular_stop,
+                true, raw->start() != Slice::none(),
+                raw->stop() != Slice::none(), length);
+              ArrayGeneratorPtr ranged = a->generator().get()->project_range(
+                                                  regular_start, regular_stop);
+              if (ranged.get() != nullptr) {
+                return ranged.get()->generate_and_check();
+              }
+            }
             return a->array().get()->getitem_range(raw->start(), raw->stop());
           }
           else {
@@ -75,7 +128,7 @@ namespace awkward {
         }
       }
     }
-    if (VirtualArray* a = dynamic_cast<VirtualArray*>(content_.get())) {
+    if (VirtualArray* a = kind_cast<VirtualArray>(content_.get())) {
       return a->array().get()->getitem(slice_);
     }
     else {
@@ -119,4 +172,27 @@ namespace awkward {
                                             content_,
                                             slice_);
   }
+
+  const std::shared_ptr<ArrayGenerator>
+  SliceGenerator::project_range(int64_t start, int64_t stop) const {
+    if (slice_.length() == 1) {
+      SliceItemPtr head = slice_.head();
+      if (SliceRange* raw = dynamic_cast<SliceRange*>(head.get())) {
+        if (raw->step() == 1  &&
+            raw->start() != Slice::none()  &&
+            raw->start() >= 0) {
+          Slice slice;
+          slice.append(SliceRange(raw->start() + start,
+                                  raw->start() + stop,
+                                  1));
+          slice.become_sealed();
+          return std::make_shared<SliceGenerator>(form_,
+                                                  stop - start,
+                                                  content_,
+                                                  slice);
+        }
+      }
+    }
+    return std::shared_ptr<ArrayGenerator>(nullptr);
+  }
 }
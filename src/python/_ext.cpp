@@ -88,6 +88,9 @@ PYBIND11_MODULE(_ext, m) {
     return toslice(obj).tostring();
   });
 
+  make_broadcast_and_apply(m, "_broadcast_and_apply");
+  make_ElementwiseExpression(m, "ElementwiseExpression");
+
   ////////// types.h
 
   make_Type(m, "Type");
@@ -121,16 +124,23 @@ PYBIND11_MODULE(_ext, m) {
 
   make_PyArrayGenerator(m, "ArrayGenerator");
   make_SliceGenerator(m, "SliceGenerator");
+  make_ArraysetGenerator(m, "ArraysetGenerator");
   make_PyArrayCache(m, "ArrayCache");
+  make_LRUArrayCache(m, "LRUArrayCache");
+  make_TieredArrayCache(m, "TieredArrayCache");
+  ak::VirtualArray::set_waiter(&wait_without_gil);
 
   ////////// io.h
 
   make_fromjson(m, "fromjson");
   make_fromroot_nestedvector(m, "fromroot_nestedvector");
+  make_toarrayset_file(m, "toarrayset_file");
+  make_fromarrayset_file(m, "fromarrayset_file");
 
   ////////// partition.h
 
   make_PartitionedArray(m, "PartitionedArray");
   make_IrregularlyPartitionedArray(m, "IrregularlyPartitionedArray");
+  make_PartitionPrefetcher(m, "PartitionPrefetcher");
 
 }
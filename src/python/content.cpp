@@ -154,95 +154,95 @@ unbox_content(const py::handle& obj) {
     throw std::invalid_argument(
       "content argument must be a Content subtype (excluding Record)");
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::NumpyArray*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::EmptyArray*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::IndexedArray32*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::IndexedArrayU32*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::IndexedArray64*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::IndexedOptionArray32*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::IndexedOptionArray64*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::ByteMaskedArray*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::BitMaskedArray*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::UnmaskedArray*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::ListArray32*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::ListArrayU32*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::ListArray64*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::ListOffsetArray32*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::ListOffsetArrayU32*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::ListOffsetArray64*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::RecordArray*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::RegularArray*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::UnionArray8_32*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::UnionArray8_U32*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::UnionArray8_64*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::VirtualArray*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   throw std::invalid_argument("content argument must be a Content subtype");
 }
 
@@ -251,11 +251,11 @@ unbox_identities(const py::handle& obj) {
   try {
     return obj.cast<ak::Identities32*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   try {
     return obj.cast<ak::Identities64*>()->shallow_copy();
   }
-  catch (py::cast_error err) { }
+  catch (const py::cast_error&) { }
   throw std::invalid_argument("id argument must be an Identities subtype");
 }
 
@@ -335,6 +335,61 @@ bool handle_as_numpy(const std::shared_ptr<ak::Content>& content) {
   }
 }
 
+/// @brief Returns a SliceJagged64 of a SliceMask if `content` is one level
+/// of lists of booleans (which can be applied without nonzero), or `nullptr`.
+ak::SliceItemPtr
+toslice_jaggedmask(const ak::ContentPtr& content) {
+  ak::ContentPtr lists(nullptr);
+  if (ak::ListOffsetArray64* raw =
+      ak::kind_cast<ak::ListOffsetArray64>(content.get())) {
+    lists = raw->toListOffsetArray64(true);
+  }
+  else if (ak::ListOffsetArray32* raw =
+           ak::kind_cast<ak::ListOffsetArray32>(content.get())) {
+    lists = raw->toListOffsetArray64(true);
+  }
+  else if (ak::ListOffsetArrayU32* raw =
+           ak::kind_cast<ak::ListOffsetArrayU32>(content.get())) {
+    lists = raw->toListOffsetArray64(true);
+  }
+  else if (ak::ListArray64* raw =
+           ak::kind_cast<ak::ListArray64>(content.get())) {
+    lists = raw->toListOffsetArray64(true);
+  }
+  else if (ak::ListArray32* raw =
+           ak::kind_cast<ak::ListArray32>(content.get())) {
+    lists = raw->toListOffsetArray64(true);
+  }
+  else if (ak::ListArrayU32* raw =
+           ak::kind_cast<ak::ListArrayU32>(content.get())) {
+    lists = raw->toListOffsetArray64(true);
+  }
+  ak::ListOffsetArray64* raw =
+    ak::kind_cast<ak::ListOffsetArray64>(lists.get());
+  if (raw == nullptr) {
+    return ak::SliceItemPtr(nullptr);
+  }
+
+  ak::Index64 offsets = raw->offsets();
+  ak::NumpyArray* flat =
+    ak::kind_cast<ak::NumpyArray>(raw->content().get());
+  if (flat == nullptr  ||
+      flat->ndim() != 1  ||
+      flat->dtype() != ak::util::dtype::boolean  ||
+      flat->strides()[0] != 1  ||
+      flat->ptr_lib() != ak::kernel::Lib::cpu_kernels  ||
+      flat->length() < offsets.getitem_at_nowrap(offsets.length() - 1)) {
+    return ak::SliceItemPtr(nullptr);
+  }
+  ak::Index8 mask(
+    std::shared_ptr<int8_t>(flat->ptr(),
+                            reinterpret_cast<int8_t*>(flat->ptr().get())),
+    flat->byteoffset(),
+    offsets.getitem_at_nowrap(offsets.length() - 1));
+  return std::make_shared<ak::SliceJagged64>(
+    offsets, std::make_shared<ak::SliceMask>(mask));
+}
+
 void
 toslice_part(ak::Slice& slice, py::object obj) {
   int64_t length_before = slice.length();
@@ -479,6 +534,10 @@ toslice_part(ak::Slice& slice, py::object obj) {
           }
           slice.append(std::make_shared<ak::SliceFields>(strings));
         }
+        else if (ak::SliceItemPtr jaggedmask = toslice_jaggedmask(content)) {
+          // a jagged mask is applied directly, without nonzero
+          slice.append(jaggedmask);
+        }
         else {
           slice.append(content.get()->asslice());
         }
@@ -491,7 +550,20 @@ toslice_part(ak::Slice& slice, py::object obj) {
         }
 
         py::buffer_info info = array.request();
-        if (info.format.compare("?") == 0) {
+        if (info.format.compare("?") == 0  &&
+            info.ndim == 1  &&
+            info.strides[0] == 1) {
+          // a flat, contiguous mask is applied directly, without nonzero
+          ak::Index8 mask(
+            std::shared_ptr<int8_t>(
+              reinterpret_cast<int8_t*>(info.ptr),
+              pyobject_deleter<int8_t>(array.ptr())),
+            0,
+            (int64_t)info.shape[0]);
+          slice.append(ak::SliceMask(mask));
+        }
+
+        else if (info.format.compare("?") == 0) {
           py::object nonzero_tuple =
             py::module::import("numpy").attr("nonzero")(array);
           for (auto x : nonzero_tuple.cast<py::tuple>()) {
@@ -592,7 +664,7 @@ check_maxdecimals(const py::object& maxdecimals) {
   try {
     return maxdecimals.cast<int64_t>();
   }
-  catch (py::cast_error err) {
+  catch (const py::cast_error&) {
     throw std::invalid_argument("maxdecimals must be None or an integer");
   }
 }
@@ -883,6 +955,18 @@ make_Content(const py::handle& m, const std::string& name) {
              .def("axis_wrap_if_negative",
                &ak::Content::axis_wrap_if_negative,
                py::arg("axis"))
+             .def_static("lazy_carry", &ak::Content::lazy_carry)
+             .def_static("set_lazy_carry",
+               &ak::Content::set_lazy_carry,
+               py::arg("lazy_carry"))
+             .def_static("memoize_projections", []() -> py::object {
+               return box_arraycache(ak::Content::memoize_projections());
+             })
+             .def_static("set_memoize_projections",
+                         [](const py::object& cache) -> void {
+               ak::Content::set_memoize_projections(
+                 unbox_arraycache(cache, "set_memoize_projections"));
+             }, py::arg("cache"))
   ;
 }
 
@@ -1077,6 +1161,7 @@ content_methods(py::class_<T, std::shared_ptr<T>, ak::Content>& x) {
                py::arg("copyarrays") = true,
                py::arg("copyindexes") = true,
                py::arg("copyidentities") = true)
+          .def("packed", &T::packed)
           .def_property_readonly("identity", &identity<T>)
           .def_property_readonly("numfields", &T::numfields)
           .def("fieldindex", &T::fieldindex)
@@ -1150,6 +1235,15 @@ content_methods(py::class_<T, std::shared_ptr<T>, ak::Content>& x) {
                [](const T& self, const py::object& other) -> py::object {
             return box(self.merge(unbox_content(other)));
           })
+          .def("merge_many",
+               [](const T& self, const py::iterable& others, bool mergebool)
+               -> py::object {
+            ak::ContentPtrVec contents;
+            for (auto x : others) {
+              contents.push_back(unbox_content(x.cast<py::object>()));
+            }
+            return box(self.merge_many(contents, mergebool));
+          }, py::arg("others"), py::arg("mergebool") = false)
           .def("merge_as_union",
                [](const T& self, const py::object& other) -> py::object {
             return box(self.merge_as_union(unbox_content(other)));
@@ -1741,6 +1835,9 @@ make_Record(const py::handle& m, const std::string& name) {
         return self.array();
       })
       .def_property_readonly("at", &ak::Record::at)
+      .def("packed", [](const ak::Record& self) -> py::object {
+        return box(self.packed());
+      })
       .def_property_readonly("istuple", &ak::Record::istuple)
       .def_property_readonly("numfields", &ak::Record::numfields)
       .def("fieldindex", &ak::Record::fieldindex)
@@ -1898,12 +1995,12 @@ make_RecordArray(const py::handle& m, const std::string& name) {
             std::string mywhere = where.cast<std::string>();
             return box(self.setitem_field(mywhere, mywhat));
           }
-          catch (py::cast_error err) {
+          catch (const py::cast_error&) {
             try {
               int64_t mywhere = where.cast<int64_t>();
               return box(self.setitem_field(mywhere, mywhat));
             }
-            catch (py::cast_error err) {
+            catch (const py::cast_error&) {
               throw std::invalid_argument("where must be None, int, or str");
             }
           }
@@ -2063,32 +2160,28 @@ make_VirtualArray(const py::handle& m, const std::string& name) {
         try {
           gen = generator.cast<std::shared_ptr<PyArrayGenerator>>();
         }
-        catch (py::cast_error err) {
+        catch (const py::cast_error&) {
           try {
             gen = generator.cast<std::shared_ptr<ak::SliceGenerator>>();
           }
-          catch (py::cast_error err) {
-            throw std::invalid_argument(
-                "VirtualArray 'generator' must be an ArrayGenerator or a "
-                "SliceGenerator");
-          }
-        }
-        std::shared_ptr<PyArrayCache> cppcache(nullptr);
-        if (!cache.is(py::none())) {
-          try {
-            cppcache = cache.cast<std::shared_ptr<PyArrayCache>>();
-          }
-          catch (py::cast_error err) {
-            throw std::invalid_argument(
-                "VirtualArray 'cache' must be an ArrayCache or None");
+          catch (const py::cast_error&) {
+            try {
+              gen = generator.cast<std::shared_ptr<ak::ArraysetGenerator>>();
+            }
+            catch (const py::cast_error&) {
+              throw std::invalid_argument(
+                  "VirtualArray 'generator' must be an ArrayGenerator, a "
+                  "SliceGenerator, or an ArraysetGenerator");
+            }
           }
         }
+        ak::ArrayCachePtr cppcache = unbox_arraycache(cache, "VirtualArray");
         if (!cache_key.is(py::none())) {
           std::string cppcache_key;
           try {
             cppcache_key = cache_key.cast<std::string>();
           }
-          catch (py::cast_error err) {
+          catch (const py::cast_error&) {
             throw std::invalid_argument(
                 "VirtualArray 'cache_key' must be a string or None");
           }
@@ -2122,6 +2215,10 @@ make_VirtualArray(const py::handle& m, const std::string& name) {
                std::dynamic_pointer_cast<ak::SliceGenerator>(gen)) {
           return py::cast(ptr);
         }
+        else if (std::shared_ptr<ak::ArraysetGenerator> ptr =
+               std::dynamic_pointer_cast<ak::ArraysetGenerator>(gen)) {
+          return py::cast(ptr);
+        }
         else {
           throw std::invalid_argument(
                   "VirtualArray's generator is not a Python function");
@@ -2129,18 +2226,7 @@ make_VirtualArray(const py::handle& m, const std::string& name) {
       })
       .def_property_readonly("cache", [](const ak::VirtualArray& self)
                                       -> py::object {
-        std::shared_ptr<ak::ArrayCache> cache = self.cache();
-        if (cache.get() == nullptr) {
-          return py::none();
-        }
-        if (std::shared_ptr<PyArrayCache> ptr =
-               std::dynamic_pointer_cast<PyArrayCache>(cache)) {
-          return py::cast(ptr);
-        }
-        else {
-          throw std::invalid_argument(
-                  "VirtualArray's cache is not a Python MutableMapping");
-        }
+        return box_arraycache(self.cache());
       })
       .def_property_readonly("peek_array", [](const ak::VirtualArray& self)
                                            -> py::object {
@@ -2159,3 +2245,125 @@ make_VirtualArray(const py::handle& m, const std::string& name) {
       .def_property_readonly("cache_key", &ak::VirtualArray::cache_key)
   );
 }
+
+////////// broadcast_and_apply
+
+template <typename T>
+ak::ContentPtr
+scalar_to_numpyarray(T value, ak::util::dtype dtype) {
+  std::shared_ptr<T> ptr = kernel::ptr_alloc<T>(kernel::Lib::cpu_kernels, 1);
+  ptr.get()[0] = value;
+  return std::make_shared<ak::NumpyArray>(ak::Identities::none(),
+                                          ak::util::Parameters(),
+                                          ptr,
+                                          std::vector<ssize_t>(),
+                                          std::vector<ssize_t>(),
+                                          0,
+                                          (ssize_t)sizeof(T),
+                                          ak::util::dtype_to_format(dtype),
+                                          dtype);
+}
+
+/// @brief Converts layouts and Python bool, int, and float scalars into
+/// inputs for ak::broadcast_and_apply, returning `false` if any of them
+/// can't be converted.
+bool
+elementwise_inputs(const py::iterable& inputs, ak::ContentPtrVec& contents) {
+  for (auto x : inputs) {
+    if (py::isinstance<py::bool_>(x)) {
+      contents.push_back(scalar_to_numpyarray<bool>(
+        x.cast<bool>(), ak::util::dtype::boolean));
+    }
+    else if (py::isinstance<py::int_>(x)) {
+      int64_t value;
+      try {
+        value = x.cast<int64_t>();
+      }
+      catch (const py::cast_error&) {
+        return false;
+      }
+      contents.push_back(scalar_to_numpyarray<int64_t>(
+        value, ak::util::dtype::int64));
+    }
+    else if (py::isinstance<py::float_>(x)) {
+      contents.push_back(scalar_to_numpyarray<double>(
+        x.cast<double>(), ak::util::dtype::float64));
+    }
+    else if (py::isinstance<ak::Content>(x)) {
+      contents.push_back(unbox_content(x));
+    }
+    else {
+      return false;
+    }
+  }
+  return true;
+}
+
+void
+make_broadcast_and_apply(py::module& m, const std::string& name) {
+  m.def(name.c_str(),
+        [](const std::string& ufunc, const py::iterable& inputs)
+        -> py::object {
+    if (!ak::ElementwiseUfunc::has(ufunc)) {
+      return py::none();
+    }
+    ak::ElementwiseUfunc function(ufunc);
+    ak::ContentPtrVec contents;
+    if (!elementwise_inputs(inputs, contents)) {
+      return py::none();
+    }
+    ak::ContentPtr out(nullptr);
+    {
+      py::gil_scoped_release release;
+      try {
+        out = ak::broadcast_and_apply(contents, function);
+      }
+      catch (const std::invalid_argument&) {
+        // unsupported here: the Python implementation decides
+      }
+    }
+    if (out.get() == nullptr) {
+      return py::none();
+    }
+    return box(out);
+  }, py::arg("ufunc"), py::arg("inputs"));
+}
+
+////////// ElementwiseExpression
+
+py::class_<ak::ElementwiseExpression,
+           std::shared_ptr<ak::ElementwiseExpression>>
+make_ElementwiseExpression(const py::handle& m, const std::string& name) {
+  return py::class_<ak::ElementwiseExpression,
+                    std::shared_ptr<ak::ElementwiseExpression>>(m,
+                                                                name.c_str())
+      .def(py::init([](const std::vector<std::string>& program)
+                    -> ak::ElementwiseExpression {
+        return ak::ElementwiseExpression(program);
+      }), py::arg("program"))
+      .def("__repr__", [](const ak::ElementwiseExpression& self)
+                       -> std::string {
+        return std::string("<ElementwiseExpression program=\"")
+               + self.name() + std::string("\"/>");
+      })
+      .def_property_readonly("program", &ak::ElementwiseExpression::program)
+      .def_property_readonly("numinputs",
+                             &ak::ElementwiseExpression::numinputs)
+      .def_property_readonly("isboolean",
+                             &ak::ElementwiseExpression::isboolean)
+      .def("apply", [](const ak::ElementwiseExpression& self,
+                       const py::iterable& inputs) -> py::object {
+        ak::ContentPtrVec contents;
+        if (!elementwise_inputs(inputs, contents)) {
+          throw std::invalid_argument(
+            "ElementwiseExpression inputs must be layouts or numbers");
+        }
+        ak::ContentPtr out(nullptr);
+        {
+          py::gil_scoped_release release;
+          out = ak::broadcast_and_apply(contents, self);
+        }
+        return box(out);
+      }, py::arg("inputs"))
+  ;
+}
@@ -6,9 +6,13 @@
 #include "awkward/Index.h"
 #include "awkward/array/NumpyArray.h"
 #include "awkward/builder/ArrayBuilderOptions.h"
+#include "awkward/io/arrayset.h"
 #include "awkward/io/json.h"
 #include "awkward/io/root.h"
 
+#include "awkward/python/content.h"
+#include "awkward/python/virtual.h"
+
 #include "awkward/python/io.h"
 
 namespace ak = awkward;
@@ -77,18 +81,49 @@ make_fromroot_nestedvector(py::module& m, const std::string& name) {
            int64_t itemsize,
            const std::string& format,
            int64_t initial,
-           double resize) -> std::shared_ptr<ak::Content> {
+           double resize,
+           int64_t numthreads) -> std::shared_ptr<ak::Content> {
       return FromROOT_nestedvector(byteoffsets,
                                    rawdata,
                                    depth,
                                    itemsize,
                                    format,
-                                   ak::ArrayBuilderOptions(initial, resize));
+                                   ak::ArrayBuilderOptions(initial, resize),
+                                   numthreads);
   }, py::arg("byteoffsets"),
      py::arg("rawdata"),
      py::arg("depth"),
      py::arg("itemsize"),
      py::arg("format"),
      py::arg("initial") = 1024,
-     py::arg("resize") = 1.5);
+     py::arg("resize") = 1.5,
+     py::arg("numthreads") = 1,
+     py::call_guard<py::gil_scoped_release>());
+}
+
+////////// arrayset file
+
+void
+make_toarrayset_file(py::module& m, const std::string& name) {
+  m.def(name.c_str(),
+        [](const py::object& array, const std::string& path) -> void {
+      ak::ToArraysetFile(unbox_content(array), path);
+  }, py::arg("array"),
+     py::arg("path"));
+}
+
+void
+make_fromarrayset_file(py::module& m, const std::string& name) {
+  m.def(name.c_str(),
+        [](const std::string& path,
+           bool lazy,
+           const py::object& cache) -> py::object {
+      if (!lazy) {
+        return box(ak::FromArraysetFile(path));
+      }
+      return box(ak::FromArraysetFileLazy(
+        path, unbox_arraycache(cache, "fromarrayset_file")));
+  }, py::arg("path"),
+     py::arg("lazy") = false,
+     py::arg("cache") = py::none());
 }
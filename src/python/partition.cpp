@@ -1,5 +1,7 @@
 // BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
 
+#include <sstream>
+
 #include "awkward/python/content.h"
 
 #include "awkward/python/partition.h"
@@ -50,6 +52,45 @@ tojson_file(const T& self,
   fclose(file);
 }
 
+/// @brief Returns the Reducer named `name` (as in the Content methods).
+std::shared_ptr<ak::Reducer>
+partitionedarray_reducer(const std::string& name) {
+  if (name == "count") {
+    return std::make_shared<ak::ReducerCount>();
+  }
+  else if (name == "count_nonzero") {
+    return std::make_shared<ak::ReducerCountNonzero>();
+  }
+  else if (name == "sum") {
+    return std::make_shared<ak::ReducerSum>();
+  }
+  else if (name == "prod") {
+    return std::make_shared<ak::ReducerProd>();
+  }
+  else if (name == "any") {
+    return std::make_shared<ak::ReducerAny>();
+  }
+  else if (name == "all") {
+    return std::make_shared<ak::ReducerAll>();
+  }
+  else if (name == "min") {
+    return std::make_shared<ak::ReducerMin>();
+  }
+  else if (name == "max") {
+    return std::make_shared<ak::ReducerMax>();
+  }
+  else if (name == "argmin") {
+    return std::make_shared<ak::ReducerArgmin>();
+  }
+  else if (name == "argmax") {
+    return std::make_shared<ak::ReducerArgmax>();
+  }
+  else {
+    throw std::invalid_argument(
+      std::string("unrecognized reducer: ") + name);
+  }
+}
+
 template <typename T>
 py::class_<T, std::shared_ptr<T>, ak::PartitionedArray>
 partitionedarray_methods(py::class_<T, std::shared_ptr<T>,
@@ -78,11 +119,24 @@ partitionedarray_methods(py::class_<T, std::shared_ptr<T>,
             out[1] = py::cast(index);
             return out;
           })
+          .def("partitionids_indexes_at",
+               [](const T& self, const std::vector<int64_t>& at)
+               -> py::object {
+            std::vector<int64_t> partitionids;
+            std::vector<int64_t> indexes;
+            self.partitionids_indexes_at(at, partitionids, indexes);
+            py::tuple out(2);
+            out[0] = py::cast(partitionids);
+            out[1] = py::cast(indexes);
+            return out;
+          })
           .def("repartition", [](const T& self,
                                  const std::vector<int64_t>& stops)
                               -> ak::PartitionedArrayPtr {
             return self.repartition(stops);
           })
+          .def("repartition_by_bytes", &T::repartition_by_bytes,
+               py::arg("target_bytes"))
           .def("tojson",
                &tojson_string<T>,
                py::arg("pretty") = false,
@@ -114,6 +168,68 @@ partitionedarray_methods(py::class_<T, std::shared_ptr<T>,
             }
             return self.getitem_range(intstart, intstop, intstep);
           })
+          .def("tocontent", [](const T& self) -> py::object {
+            return box(self.tocontent());
+          })
+          .def("is_partition_axis", &T::is_partition_axis)
+          .def("map", [](const T& self,
+                         const py::object& fn,
+                         int64_t nthreads) -> ak::PartitionedArrayPtr {
+            // fn is called from other threads, which need the GIL for it
+            std::function<const ak::ContentPtr(const ak::ContentPtr&)> call =
+              [&fn](const ak::ContentPtr& x) -> const ak::ContentPtr {
+                py::gil_scoped_acquire acquire;
+                return unbox_content(fn(box(x)));
+              };
+            py::gil_scoped_release release;
+            return self.map(call, nthreads);
+          }, py::arg("fn"), py::arg("nthreads") = 0)
+          .def("reduce", [](const T& self,
+                            const std::string& name,
+                            int64_t axis,
+                            bool mask,
+                            bool keepdims,
+                            int64_t nthreads) -> py::object {
+            std::shared_ptr<ak::Reducer> reducer =
+              partitionedarray_reducer(name);
+            if (self.is_partition_axis(axis)) {
+              ak::ContentPtr out(nullptr);
+              {
+                py::gil_scoped_release release;
+                out = self.reduce(*reducer.get(), axis, mask, keepdims,
+                                  nthreads);
+              }
+              return box(out);
+            }
+            else {
+              ak::PartitionedArrayPtr out(nullptr);
+              {
+                py::gil_scoped_release release;
+                out = self.map([&](const ak::ContentPtr& x)
+                               -> const ak::ContentPtr {
+                  return x.get()->reduce(*reducer.get(), axis, mask, keepdims);
+                }, nthreads);
+              }
+              return py::cast(out);
+            }
+          }, py::arg("name"),
+             py::arg("axis") = -1,
+             py::arg("mask") = false,
+             py::arg("keepdims") = false,
+             py::arg("nthreads") = 0)
+          .def("sort", &T::sort,
+               py::arg("axis") = -1,
+               py::arg("ascending") = true,
+               py::arg("stable") = false,
+               py::arg("nthreads") = 0,
+               py::call_guard<py::gil_scoped_release>())
+          .def("getitem", [](const T& self,
+                             const py::object& where,
+                             int64_t nthreads) -> ak::PartitionedArrayPtr {
+            ak::Slice slice = toslice(where);
+            py::gil_scoped_release release;
+            return self.getitem(slice, nthreads);
+          }, py::arg("where"), py::arg("nthreads") = 0)
 
   ;
 }
@@ -155,3 +271,69 @@ make_IrregularlyPartitionedArray(const py::handle& m, const std::string& name) {
 
   );
 }
+
+////////// PartitionPrefetcher
+
+py::class_<ak::PartitionPrefetcher, std::shared_ptr<ak::PartitionPrefetcher>>
+make_PartitionPrefetcher(const py::handle& m, const std::string& name) {
+  return py::class_<ak::PartitionPrefetcher,
+                    std::shared_ptr<ak::PartitionPrefetcher>>(m, name.c_str())
+      .def(py::init([](const ak::PartitionedArrayPtr& array,
+                       int64_t depth,
+                       const py::object& max_inflight_bytes)
+                    -> std::shared_ptr<ak::PartitionPrefetcher> {
+        int64_t max_bytes = -1;
+        if (!max_inflight_bytes.is(py::none())) {
+          max_bytes = max_inflight_bytes.cast<int64_t>();
+        }
+        // background threads may need the GIL to finish (Python generators),
+        // so do not hold it while the destructor waits for them
+        return std::shared_ptr<ak::PartitionPrefetcher>(
+          new ak::PartitionPrefetcher(array, depth, max_bytes),
+          [](ak::PartitionPrefetcher* ptr) -> void {
+            if (PyGILState_Check()) {
+              py::gil_scoped_release release;
+              delete ptr;
+            }
+            else {
+              delete ptr;
+            }
+          });
+      }), py::arg("array"),
+          py::arg("depth") = 1,
+          py::arg("max_inflight_bytes") = py::none())
+      .def("__repr__", [](const ak::PartitionPrefetcher& self)
+                       -> std::string {
+        std::stringstream out;
+        out << "<PartitionPrefetcher depth=\"" << self.depth() << "\"";
+        if (self.max_inflight_bytes() >= 0) {
+          out << " max_inflight_bytes=\"" << self.max_inflight_bytes() << "\"";
+        }
+        out << " inflight_bytes=\"" << self.inflight_bytes() << "\"/>";
+        return out.str();
+      })
+      .def_property_readonly("array", &ak::PartitionPrefetcher::array)
+      .def_property_readonly("depth", &ak::PartitionPrefetcher::depth)
+      .def_property_readonly("max_inflight_bytes",
+                             [](const ak::PartitionPrefetcher& self)
+                             -> py::object {
+        if (self.max_inflight_bytes() < 0) {
+          return py::none();
+        }
+        return py::cast(self.max_inflight_bytes());
+      })
+      .def_property_readonly("inflight_bytes",
+                             &ak::PartitionPrefetcher::inflight_bytes)
+      .def("partition", [](ak::PartitionPrefetcher& self, int64_t partitionid)
+                        -> py::object {
+        ak::ContentPtr out(nullptr);
+        {
+          py::gil_scoped_release release;
+          out = self.partition(partitionid);
+        }
+        return box(out);
+      }, py::arg("partitionid"))
+      .def("wait", &ak::PartitionPrefetcher::wait,
+           py::call_guard<py::gil_scoped_release>())
+  ;
+}
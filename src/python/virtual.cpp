@@ -37,6 +37,7 @@ PyArrayGenerator::kwargs() const {
 
 const ak::ContentPtr
 PyArrayGenerator::generate() const {
+  py::gil_scoped_acquire acquire;
   py::object out = callable_(*args_, **kwargs_);
   py::object layout = py::module::import("awkward1").attr("to_layout")(
                                         out, py::cast(false), py::cast(false));
@@ -138,6 +139,33 @@ PyArrayGenerator::with_kwargs(const py::dict& kwargs) const {
                                             kwargs);
 }
 
+py::dict
+arraygenerator_stats(const ak::ArrayGenerator& self) {
+  ak::ArrayGeneratorStats stats = self.stats();
+  py::dict out;
+  out["calls"] = py::cast(stats.calls);
+  out["wall_time"] = py::cast(1e-9 * (double)stats.wall_time_ns);
+  out["bytes"] = py::cast(stats.bytes);
+  return out;
+}
+
+py::dict
+arraycache_stats(const ak::ArrayCache& self) {
+  ak::ArrayCacheStats stats = self.stats();
+  py::dict out;
+  out["hits"] = py::cast(stats.hits);
+  out["misses"] = py::cast(stats.misses);
+  out["sets"] = py::cast(stats.sets);
+  out["evictions"] = py::cast(stats.evictions);
+  if (stats.resident_bytes < 0) {
+    out["resident_bytes"] = py::none();
+  }
+  else {
+    out["resident_bytes"] = py::cast(stats.resident_bytes);
+  }
+  return out;
+}
+
 py::class_<PyArrayGenerator, std::shared_ptr<PyArrayGenerator>>
 make_PyArrayGenerator(const py::handle& m, const std::string& name) {
   return (py::class_<PyArrayGenerator,
@@ -199,6 +227,11 @@ make_PyArrayGenerator(const py::handle& m, const std::string& name) {
       .def("__call__", [](const PyArrayGenerator& self) -> py::object {
         return box(self.generate_and_check());
       })
+      .def_property_readonly("stats", [](const PyArrayGenerator& self)
+                                      -> py::dict {
+        return arraygenerator_stats(self);
+      })
+      .def("reset_stats", &ak::ArrayGenerator::reset_stats)
       .def("__repr__", [](const PyArrayGenerator& self) -> std::string {
         return self.tostring_part("", "", "");
       })
@@ -293,6 +326,11 @@ make_SliceGenerator(const py::handle& m, const std::string& name) {
       .def("__call__", [](const ak::SliceGenerator& self) -> py::object {
         return box(self.generate_and_check());
       })
+      .def_property_readonly("stats", [](const ak::SliceGenerator& self)
+                                      -> py::dict {
+        return arraygenerator_stats(self);
+      })
+      .def("reset_stats", &ak::ArrayGenerator::reset_stats)
       .def("__repr__", [](const ak::SliceGenerator& self) -> std::string {
         return self.tostring_part("", "", "");
       })
@@ -309,6 +347,58 @@ make_SliceGenerator(const py::handle& m, const std::string& name) {
   );
 }
 
+////////// ArraysetGenerator
+
+py::class_<ak::ArraysetGenerator, std::shared_ptr<ak::ArraysetGenerator>>
+make_ArraysetGenerator(const py::handle& m, const std::string& name) {
+  return (py::class_<ak::ArraysetGenerator,
+                     std::shared_ptr<ak::ArraysetGenerator>>(m, name.c_str())
+      .def_property_readonly("form",
+                             [](const ak::ArraysetGenerator& self)
+                             -> py::object {
+        return py::cast(self.form().get());
+      })
+      .def_property_readonly("length",
+                             [](const ak::ArraysetGenerator& self)
+                             -> py::object {
+        int64_t length = self.length();
+        if (length < 0) {
+          return py::none();
+        }
+        else {
+          return py::cast(length);
+        }
+      })
+      .def_property_readonly("start", &ak::ArraysetGenerator::start)
+      .def_property_readonly("path",
+                             [](const ak::ArraysetGenerator& self)
+                             -> std::string {
+        return self.file().get()->path();
+      })
+      .def("__call__", [](const ak::ArraysetGenerator& self) -> py::object {
+        return box(self.generate_and_check());
+      })
+      .def_property_readonly("stats", [](const ak::ArraysetGenerator& self)
+                                      -> py::dict {
+        return arraygenerator_stats(self);
+      })
+      .def("reset_stats", &ak::ArrayGenerator::reset_stats)
+      .def("__repr__", [](const ak::ArraysetGenerator& self) -> std::string {
+        return self.tostring_part("", "", "");
+      })
+      .def("with_form", [](const ak::ArraysetGenerator& self,
+                           const std::shared_ptr<ak::Form>& form) -> py::object {
+        std::shared_ptr<ak::ArrayGenerator> out = self.with_form(form);
+        return py::cast(out);
+      })
+      .def("with_length", [](const ak::ArraysetGenerator& self,
+                             int64_t length) -> py::object {
+        std::shared_ptr<ak::ArrayGenerator> out = self.with_length(length);
+        return py::cast(out);
+      })
+  );
+}
+
 ////////// PyArrayCache
 
 PyArrayCache::PyArrayCache(const py::object& mutablemapping)
@@ -321,6 +411,7 @@ PyArrayCache::mutablemapping() const {
 
 ak::ContentPtr
 PyArrayCache::get(const std::string& key) const {
+  py::gil_scoped_acquire acquire;
   py::str pykey(PyUnicode_DecodeUTF8(key.data(),
                                      key.length(),
                                      "surrogateescape"));
@@ -329,16 +420,20 @@ PyArrayCache::get(const std::string& key) const {
     out = mutablemapping_.attr("__getitem__")(pykey);
   }
   catch (py::error_already_set err) {
+    stats_misses_++;
     return ak::ContentPtr(nullptr);
   }
+  stats_hits_++;
   return unbox_content(out);
 }
 
 void
 PyArrayCache::set(const std::string& key, const ak::ContentPtr& value) {
+  py::gil_scoped_acquire acquire;
   py::str pykey(PyUnicode_DecodeUTF8(key.data(),
                                      key.length(),
                                      "surrogateescape"));
+  stats_sets_++;
   mutablemapping_.attr("__setitem__")(pykey, box(value));
 }
 
@@ -365,6 +460,11 @@ make_PyArrayCache(const py::handle& m, const std::string& name) {
       .def(py::init<const py::object&>(),
            py::arg("mutablemapping"))
       .def_property_readonly("mutablemapping", &PyArrayCache::mutablemapping)
+      .def_property_readonly("stats", [](const PyArrayCache& self)
+                                      -> py::dict {
+        return arraycache_stats(self);
+      })
+      .def("reset_stats", &ak::ArrayCache::reset_stats)
       .def("__repr__", [](const PyArrayCache& self) -> std::string {
         return self.tostring_part("", "", "");
       })
@@ -390,3 +490,149 @@ make_PyArrayCache(const py::handle& m, const std::string& name) {
 
   );
 }
+
+////////// LRUArrayCache
+
+py::class_<ak::LRUArrayCache, std::shared_ptr<ak::LRUArrayCache>>
+make_LRUArrayCache(const py::handle& m, const std::string& name) {
+  return (py::class_<ak::LRUArrayCache,
+                     std::shared_ptr<ak::LRUArrayCache>>(m, name.c_str())
+      .def(py::init<int64_t>(),
+           py::arg("limit_bytes"))
+      .def_property_readonly("limit_bytes", &ak::LRUArrayCache::limit_bytes)
+      .def_property_readonly("current_bytes",
+                             &ak::LRUArrayCache::current_bytes)
+      .def_property_readonly("stats", [](const ak::LRUArrayCache& self)
+                                      -> py::dict {
+        return arraycache_stats(self);
+      })
+      .def("reset_stats", &ak::ArrayCache::reset_stats)
+      .def("__repr__", [](const ak::LRUArrayCache& self) -> std::string {
+        return self.tostring_part("", "", "");
+      })
+      .def("__getitem__", [](const ak::LRUArrayCache& self,
+                             const std::string& key) -> py::object {
+        ak::ContentPtr out = self.get(key);
+        if (out.get() == nullptr) {
+          throw py::key_error(key);
+        }
+        return box(out);
+      })
+      .def("__setitem__", [](ak::LRUArrayCache& self,
+                             const std::string& key,
+                             const py::object& value) -> void {
+        self.set(key, unbox_content(value));
+      })
+      .def("__delitem__", [](ak::LRUArrayCache& self,
+                             const std::string& key) -> void {
+        if (!self.remove(key)) {
+          throw py::key_error(key);
+        }
+      })
+      .def("__contains__", &ak::LRUArrayCache::has)
+      .def("__iter__", [](const ak::LRUArrayCache& self) -> py::object {
+        return py::iter(py::cast(self.keys()));
+      })
+      .def("__len__", &ak::LRUArrayCache::size)
+      .def("keys", &ak::LRUArrayCache::keys)
+      .def("clear", &ak::LRUArrayCache::clear)
+  );
+}
+
+////////// TieredArrayCache
+
+py::class_<ak::TieredArrayCache,
+           std::shared_ptr<ak::TieredArrayCache>,
+           ak::LRUArrayCache>
+make_TieredArrayCache(const py::handle& m, const std::string& name) {
+  return (py::class_<ak::TieredArrayCache,
+                     std::shared_ptr<ak::TieredArrayCache>,
+                     ak::LRUArrayCache>(m, name.c_str())
+      .def(py::init([](int64_t limit_bytes,
+                       const std::string& directory,
+                       const py::object& disk_limit_bytes)
+                    -> std::shared_ptr<ak::TieredArrayCache> {
+        int64_t disk_limit = -1;
+        if (!disk_limit_bytes.is(py::none())) {
+          disk_limit = disk_limit_bytes.cast<int64_t>();
+        }
+        return std::make_shared<ak::TieredArrayCache>(limit_bytes,
+                                                      directory,
+                                                      disk_limit);
+      }), py::arg("limit_bytes"),
+          py::arg("directory"),
+          py::arg("disk_limit_bytes") = py::none())
+      .def_property_readonly("directory", &ak::TieredArrayCache::directory)
+      .def_property_readonly("disk_limit_bytes",
+                             [](const ak::TieredArrayCache& self)
+                             -> py::object {
+        if (self.disk_limit_bytes() < 0) {
+          return py::none();
+        }
+        return py::cast(self.disk_limit_bytes());
+      })
+      .def_property_readonly("disk_bytes", &ak::TieredArrayCache::disk_bytes)
+      .def_property_readonly("disk_keys", &ak::TieredArrayCache::disk_keys)
+      .def_property_readonly("stats", [](const ak::TieredArrayCache& self)
+                                      -> py::dict {
+        py::dict out = arraycache_stats(self);
+        out["spills"] = py::cast(self.spills());
+        out["disk_hits"] = py::cast(self.disk_hits());
+        out["spill_failures"] = py::cast(self.spill_failures());
+        out["disk_bytes"] = py::cast(self.disk_bytes());
+        return out;
+      })
+      .def("__repr__", [](const ak::TieredArrayCache& self) -> std::string {
+        return self.tostring_part("", "", "");
+      })
+  );
+}
+
+ak::ArrayCachePtr
+unbox_arraycache(const py::object& cache, const std::string& where) {
+  if (cache.is(py::none())) {
+    return ak::ArrayCachePtr(nullptr);
+  }
+  try {
+    return cache.cast<std::shared_ptr<PyArrayCache>>();
+  }
+  catch (py::cast_error err) { }
+  try {
+    return cache.cast<std::shared_ptr<ak::LRUArrayCache>>();
+  }
+  catch (py::cast_error err) {
+    throw std::invalid_argument(
+        where + std::string(" 'cache' must be an ArrayCache, an "
+                            "LRUArrayCache, or None"));
+  }
+}
+
+py::object
+box_arraycache(const ak::ArrayCachePtr& cache) {
+  if (cache.get() == nullptr) {
+    return py::none();
+  }
+  else if (std::shared_ptr<PyArrayCache> ptr =
+             std::dynamic_pointer_cast<PyArrayCache>(cache)) {
+    return py::cast(ptr);
+  }
+  else if (std::shared_ptr<ak::LRUArrayCache> ptr =
+             std::dynamic_pointer_cast<ak::LRUArrayCache>(cache)) {
+    return py::cast(ptr);
+  }
+  else {
+    throw std::invalid_argument(
+            "cache is neither a Python MutableMapping nor an LRUArrayCache");
+  }
+}
+
+void
+wait_without_gil(const std::shared_future<ak::ContentPtr>& generation) {
+  if (PyGILState_Check()) {
+    py::gil_scoped_release release;
+    generation.wait();
+  }
+  else {
+    generation.wait();
+  }
+}
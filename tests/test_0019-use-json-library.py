@@ -96,3 +96,86 @@ def test_numpy():
 
     c = awkward1.layout.NumpyArray(numpy.array([[True, False, True], [False, False, True]]))
     assert awkward1.to_json(c) == "[[true,false,true],[false,false,true]]"
+
+def root_nestedvector_encode(entries, depth, dtype):
+    # one big-endian uint32 length header per std::vector, then the leaves
+    def encode(x, level):
+        out = [numpy.array([len(x)], dtype=">u4").tobytes()]
+        if level == depth - 1:
+            out.append(numpy.array(x, dtype=dtype).tobytes())
+        else:
+            for y in x:
+                out.extend(encode(y, level + 1))
+        return out
+    chunks = [b"".join(encode(entry, 0)) for entry in entries]
+    byteoffsets = numpy.cumsum([0] + [len(x) for x in chunks]).astype(numpy.int64)
+    rawdata = numpy.frombuffer(b"".join(chunks), dtype=numpy.uint8)
+    return awkward1.layout.Index64(byteoffsets), awkward1.layout.NumpyArray(rawdata)
+
+def test_root_nestedvector_formats():
+    entries1 = [[1, 2, 3], [], [4, 5]]
+    entries2 = [[[1], [], [2, 3]], [], [[4, 5], [6]]]
+    for format, native in [(">h", numpy.int16), (">i", numpy.int32), (">q", numpy.int64), (">f", numpy.float32), (">d", numpy.float64)]:
+        for depth, entries in [(1, entries1), (2, entries2)]:
+            byteoffsets, rawdata = root_nestedvector_encode(entries, depth, format)
+            result = awkward1._ext.fromroot_nestedvector(byteoffsets, rawdata, depth, numpy.dtype(format).itemsize, format)
+            assert awkward1.to_list(result) == entries
+            leaves = result
+            for i in range(depth):
+                leaves = leaves.content
+            assert numpy.asarray(leaves).dtype == numpy.dtype(native)
+            assert numpy.asarray(leaves).dtype.isnative
+
+def test_root_nestedvector_truncated():
+    byteoffsets, rawdata = root_nestedvector_encode([[1.1, 2.2], [3.3]], 1, ">d")
+    raw = numpy.asarray(rawdata)
+
+    # in the middle of the second length header
+    truncated = awkward1.layout.NumpyArray(raw[:22])
+    with pytest.raises(ValueError):
+        awkward1._ext.fromroot_nestedvector(byteoffsets, truncated, 1, 8, ">d")
+
+    # in the middle of the last leaf
+    truncated = awkward1.layout.NumpyArray(raw[:-1])
+    with pytest.raises(ValueError):
+        awkward1._ext.fromroot_nestedvector(byteoffsets, truncated, 1, 8, ">d")
+
+def root_nestedvector_arrays(layout, depth):
+    out = []
+    for i in range(depth):
+        out.append(numpy.asarray(layout.offsets).tolist())
+        layout = layout.content
+    out.append(numpy.asarray(layout).tolist())
+    return out
+
+def test_root_nestedvector_parallel():
+    entries1 = [[i*1.1 for i in range(n % 5)] for n in range(100)]
+    entries2 = [[[i + j for j in range(i % 3)] for i in range(n % 4)] for n in range(100)]
+    entries3 = [[[[k]*(k % 3) for k in range(j)] for j in range(n % 3)] for n in range(100)]
+    for depth, entries, format in [(1, entries1, ">d"), (2, entries2, ">i"), (3, entries3, ">h")]:
+        byteoffsets, rawdata = root_nestedvector_encode(entries, depth, format)
+        itemsize = numpy.dtype(format).itemsize
+        one = awkward1._ext.fromroot_nestedvector(byteoffsets, rawdata, depth, itemsize, format, numthreads=1)
+        assert awkward1.to_list(one) == entries
+        expected = root_nestedvector_arrays(one, depth)
+        for numthreads in [2, 0, 3, 1000]:
+            result = awkward1._ext.fromroot_nestedvector(byteoffsets, rawdata, depth, itemsize, format, numthreads=numthreads)
+            assert root_nestedvector_arrays(result, depth) == expected
+
+def test_root_nestedvector_parallel_small():
+    for entries in [[], [[]], [[], []], [[], [1, 2], []]]:
+        byteoffsets, rawdata = root_nestedvector_encode(entries, 1, ">i")
+        for numthreads in [1, 2, 0, 10]:
+            result = awkward1._ext.fromroot_nestedvector(byteoffsets, rawdata, 1, 4, ">i", numthreads=numthreads)
+            assert awkward1.to_list(result) == entries
+            assert numpy.asarray(result.offsets).tolist() == numpy.cumsum([0] + [len(x) for x in entries]).tolist()
+
+def test_root_nestedvector_parallel_truncated():
+    entries = [[1.1, 2.2, 3.3]] * 10
+    byteoffsets, rawdata = root_nestedvector_encode(entries, 1, ">d")
+
+    # the last entry is read by the second thread, not the caller's
+    truncated = awkward1.layout.NumpyArray(numpy.asarray(rawdata)[:-4])
+    for numthreads in [2, 3]:
+        with pytest.raises(ValueError):
+            awkward1._ext.fromroot_nestedvector(byteoffsets, truncated, 1, 8, ">d", numthreads=numthreads)
@@ -0,0 +1,175 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+
+#include "awkward/builder/ArrayBuilder.h"
+#include "awkward/builder/ArrayBuilderOptions.h"
+#include "awkward/array/ListOffsetArray.h"
+#include "awkward/array/NumpyArray.h"
+#include "awkward/array/RecordArray.h"
+#include "awkward/array/VirtualArray.h"
+#include "awkward/virtual/ArrayCache.h"
+#include "awkward/io/arrayset.h"
+
+namespace ak = awkward;
+
+int main(int, char**) {
+  ak::ArrayBuilder builder(ak::ArrayBuilderOptions(1024, 2.0));
+  std::vector<std::vector<double>> data = {{0.0, 1.1, 2.2}, {}, {3.3, 4.4}};
+  for (auto x : data) {
+    builder.beginrecord();
+    builder.field_check("x");
+    builder.integer((int64_t)x.size());
+    builder.field_check("y");
+    builder.beginlist();
+    for (auto y : x) {
+      builder.real(y);
+    }
+    builder.endlist();
+    builder.endrecord();
+  }
+  std::shared_ptr<ak::Content> array = builder.snapshot();
+
+  std::string path("test0356.akarrset");
+  ak::ToArraysetFile(array, path);
+
+  {
+    ak::ArraysetFile file(path);
+    if (file.length() != 3)
+      return -1;
+    if (!file.has_buffer("node2-offsets"))
+      return -1;
+
+    std::shared_ptr<ak::Content> copy = file.content();
+    if (copy.get()->tojson(false, 1) != array.get()->tojson(false, 1))
+      return -1;
+
+    // buffers are 64-byte aligned views of the mapping, not copies
+    std::shared_ptr<ak::ListOffsetArray64> y =
+      std::dynamic_pointer_cast<ak::ListOffsetArray64>(
+        copy.get()->getitem_field("y"));
+    if (y.get() == nullptr)
+      return -1;
+    if (reinterpret_cast<size_t>(y.get()->offsets().ptr().get()) % 64 != 0)
+      return -1;
+
+    std::shared_ptr<ak::NumpyArray> content =
+      std::dynamic_pointer_cast<ak::NumpyArray>(y.get()->content());
+    if (content.get() == nullptr  ||  content.get()->getdouble(4*sizeof(double)) != 4.4)
+      return -1;
+  }
+
+  {
+    std::shared_ptr<ak::RecordArray> lazy =
+      std::dynamic_pointer_cast<ak::RecordArray>(
+        ak::FromArraysetFileLazy(path, nullptr));
+    if (lazy.get() == nullptr  ||  lazy.get()->length() != 3)
+      return -1;
+    if (dynamic_cast<ak::VirtualArray*>(lazy.get()->field("y").get()) ==
+        nullptr)
+      return -1;
+    if (lazy.get()->tojson(false, 1) != array.get()->tojson(false, 1))
+      return -1;
+  }
+
+  {
+    // touching one field of a lazy file generates only that column
+    std::shared_ptr<ak::LRUArrayCache> cache =
+      std::make_shared<ak::LRUArrayCache>(1000000);
+    std::shared_ptr<ak::RecordArray> lazy =
+      std::dynamic_pointer_cast<ak::RecordArray>(
+        ak::FromArraysetFileLazy(path, cache));
+    if (lazy.get() == nullptr)
+      return -1;
+    std::shared_ptr<ak::VirtualArray> x =
+      std::dynamic_pointer_cast<ak::VirtualArray>(lazy.get()->field("x"));
+    std::shared_ptr<ak::VirtualArray> y =
+      std::dynamic_pointer_cast<ak::VirtualArray>(lazy.get()->field("y"));
+    if (x.get() == nullptr  ||  y.get() == nullptr  ||  cache.get()->size() != 0)
+      return -1;
+    if (y.get()->tojson(false, 1) != array.get()->getitem_field("y").get()->tojson(false, 1))
+      return -1;
+    if (cache.get()->size() != 1  ||  !cache.get()->has(y.get()->cache_key()))
+      return -1;
+    if (cache.get()->has(x.get()->cache_key())  ||  x.get()->peek_array().get() != nullptr)
+      return -1;
+  }
+
+  {
+    // projecting a field of a lazy record reads only that field
+    ak::ArraysetFilePtr file = std::make_shared<ak::ArraysetFile>(path);
+    ak::ArrayGeneratorPtr generator = std::make_shared<ak::ArraysetGenerator>(
+      file.get()->form(), file.get()->length(), file);
+    std::shared_ptr<ak::VirtualArray> lazy = std::make_shared<ak::VirtualArray>(
+      ak::Identities::none(), ak::util::Parameters(), generator, nullptr);
+    std::shared_ptr<ak::VirtualArray> y =
+      std::dynamic_pointer_cast<ak::VirtualArray>(lazy.get()->getitem_field("y"));
+    if (y.get() == nullptr)
+      return -1;
+    if (dynamic_cast<ak::ArraysetGenerator*>(y.get()->generator().get()) == nullptr)
+      return -1;
+    if (y.get()->has_virtual_form()  ||  y.get()->keys().size() != 0)
+      return -1;
+    if (lazy.get()->keys().size() != 2  ||  lazy.get()->peek_array().get() != nullptr)
+      return -1;
+    if (y.get()->tojson(false, 1) != array.get()->getitem_field("y").get()->tojson(false, 1))
+      return -1;
+    if (lazy.get()->peek_array().get() != nullptr)
+      return -1;
+
+    // a range of a range is one ranged read of the file
+    std::shared_ptr<ak::VirtualArray> part =
+      std::dynamic_pointer_cast<ak::VirtualArray>(
+        lazy.get()->getitem_range_nowrap(1, 3).get()->getitem_range_nowrap(1, 2));
+    if (part.get() == nullptr)
+      return -1;
+    ak::ArraysetGenerator* ranged =
+      dynamic_cast<ak::ArraysetGenerator*>(part.get()->generator().get());
+    if (ranged == nullptr  ||  ranged->start() != 2  ||  ranged->length() != 1)
+      return -1;
+    if (part.get()->tojson(false, 1) != array.get()->getitem_range_nowrap(2, 3).get()->tojson(false, 1))
+      return -1;
+    if (lazy.get()->peek_array().get() != nullptr)
+      return -1;
+  }
+
+  {
+    // a header that claims fewer bytes than a node needs is an error, not
+    // a short Index
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+    in.close();
+    std::string key("node2-offsets");
+    size_t where = bytes.find(key);
+    if (where == std::string::npos)
+      return -1;
+    uint64_t nbytes = sizeof(int64_t);
+    std::memcpy(&bytes[where + key.length() + sizeof(uint64_t)],
+                &nbytes,
+                sizeof(uint64_t));
+    std::string truncated("test0356-truncated.akarrset");
+    std::ofstream out(truncated, std::ios::binary);
+    out.write(bytes.data(), (std::streamsize)bytes.length());
+    out.close();
+
+    bool raised = false;
+    try {
+      ak::ArraysetFile(truncated).content();
+    }
+    catch (std::invalid_argument& err) {
+      raised = std::string(err.what()).find(key) != std::string::npos;
+    }
+    std::remove(truncated.c_str());
+    if (!raised)
+      return -1;
+  }
+
+  std::remove(path.c_str());
+  return 0;
+}
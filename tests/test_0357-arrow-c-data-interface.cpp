@@ -0,0 +1,57 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#include <memory>
+
+#include "awkward/builder/ArrayBuilder.h"
+#include "awkward/builder/ArrayBuilderOptions.h"
+#include "awkward/io/arrow.h"
+
+namespace ak = awkward;
+
+int main(int, char**) {
+  ak::ArrayBuilder builder(ak::ArrayBuilderOptions(1024, 2.0));
+  std::vector<std::vector<double>> data = {{0.0, 1.1, 2.2}, {}, {3.3, 4.4}};
+  for (size_t i = 0;  i < data.size();  i++) {
+    builder.beginrecord();
+    builder.field_check("x");
+    if (i == 1) {
+      builder.null();
+    }
+    else {
+      builder.integer((int64_t)i);
+    }
+    builder.field_check("y");
+    builder.beginlist();
+    for (auto y : data[i]) {
+      builder.real(y);
+    }
+    builder.endlist();
+    builder.field_check("z");
+    builder.string(std::string(i, 'z'));
+    builder.endrecord();
+  }
+  std::shared_ptr<ak::Content> array = builder.snapshot();
+
+  struct ArrowSchema schema;
+  struct ArrowArray arrowarray;
+  ak::ToArrow(array, &schema, &arrowarray);
+  if (std::string(schema.format) != "+s"  ||  schema.n_children != 3)
+    return -1;
+  if (arrowarray.length != 3)
+    return -1;
+
+  std::shared_ptr<ak::Content> copy = ak::FromArrow(&schema, &arrowarray);
+  if (schema.release != nullptr  ||  arrowarray.release != nullptr)
+    return -1;
+  if (copy.get()->tojson(false, 1) != array.get()->tojson(false, 1))
+    return -1;
+
+  // the original can go away: the copy shares its buffers
+  array = nullptr;
+  builder.clear();
+  if (copy.get()->getitem_at(2).get()->tojson(false, 1) !=
+      "{\"x\":2,\"y\":[3.3,4.4],\"z\":\"zz\"}")
+    return -1;
+
+  return 0;
+}
@@ -0,0 +1,69 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import pytest
+import numpy
+
+import awkward1
+
+def test_lru_array_cache():
+    one = awkward1.layout.NumpyArray(numpy.arange(100, dtype=numpy.float64))
+    two = awkward1.layout.NumpyArray(numpy.arange(100, dtype=numpy.float64))
+    three = awkward1.layout.NumpyArray(numpy.arange(100, dtype=numpy.float64))
+
+    cache = awkward1.layout.LRUArrayCache(2000)
+    assert len(cache) == 0
+    cache["one"] = one
+    cache["two"] = two
+    assert len(cache) == 2
+    assert cache.current_bytes == 1600
+
+    cache["one"]
+    cache["three"] = three
+    assert len(cache) == 2
+    assert "one" in cache
+    assert "two" not in cache
+    assert list(cache) == ["three", "one"]
+    with pytest.raises(KeyError):
+        cache["two"]
+
+    cache["big"] = awkward1.layout.NumpyArray(numpy.arange(1000, dtype=numpy.float64))
+    assert "big" not in cache
+    assert len(cache) == 2
+
+def test_virtual_with_lru_array_cache():
+    cache = awkward1.layout.LRUArrayCache(1000000)
+    calls = [0]
+    def generate():
+        calls[0] += 1
+        return awkward1.Array([[1.1, 2.2, 3.3], [], [4.4, 5.5]])
+    array = awkward1.virtual(generate, length=3, cache=cache, cache_key="x")
+    assert isinstance(array.layout.cache, awkward1.layout.LRUArrayCache)
+    assert awkward1.to_list(array) == [[1.1, 2.2, 3.3], [], [4.4, 5.5]]
+    assert awkward1.to_list(array) == [[1.1, 2.2, 3.3], [], [4.4, 5.5]]
+    assert calls[0] == 1
+    assert "x" in cache
+
+def test_stats():
+    cache = awkward1.layout.LRUArrayCache(1000)
+    generator = awkward1.layout.ArrayGenerator(
+        lambda: awkward1.layout.NumpyArray(numpy.arange(100, dtype=numpy.float64)),
+        form=awkward1.forms.NumpyForm([], 8, "d"), length=100)
+    virtualarray = awkward1.layout.VirtualArray(generator, cache, cache_key="x")
+
+    assert len(virtualarray.array) == 100
+    assert len(virtualarray.array) == 100
+    assert cache.stats == {"hits": 1, "misses": 1, "sets": 1, "evictions": 0, "resident_bytes": 800}
+    assert generator.stats["calls"] == 1
+    assert generator.stats["bytes"] == 800
+    assert generator.stats["wall_time"] >= 0
+
+    cache["y"] = awkward1.layout.NumpyArray(numpy.arange(100, dtype=numpy.float64))
+    assert cache.stats["evictions"] == 1
+    assert cache.stats["resident_bytes"] == 800
+
+    cache.reset_stats()
+    generator.reset_stats()
+    assert cache.stats == {"hits": 0, "misses": 0, "sets": 0, "evictions": 0, "resident_bytes": 800}
+    assert generator.stats == {"calls": 0, "wall_time": 0.0, "bytes": 0}
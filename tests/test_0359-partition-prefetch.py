@@ -0,0 +1,56 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import pytest
+import numpy
+
+import awkward1
+
+def lazy_partitions(calls):
+    cache = awkward1.layout.LRUArrayCache(1000000)
+    def generate(i):
+        calls.append(i)
+        return awkward1.layout.NumpyArray(numpy.arange(10, dtype=numpy.float64) + 10*i)
+    form = awkward1.forms.NumpyForm([], 8, "d")
+    partitions = []
+    for i in range(5):
+        generator = awkward1.layout.ArrayGenerator(generate, (i,), form=form, length=10)
+        partitions.append(awkward1.layout.VirtualArray(generator, cache, cache_key="p{0}".format(i)))
+    return awkward1.partition.IrregularlyPartitionedArray(partitions), cache
+
+def test_prefetch():
+    calls = []
+    array, cache = lazy_partitions(calls)
+    out = []
+    for x, y in awkward1.partition.iterate(array.numpartitions, [array, 3], prefetch=2):
+        assert y == 3
+        out.extend(awkward1.to_list(x))
+    assert out == list(range(50))
+    assert sorted(calls) == [0, 1, 2, 3, 4]
+    assert len(cache) == 5
+
+def test_max_inflight_bytes():
+    calls = []
+    array, cache = lazy_partitions(calls)
+    prefetcher = awkward1._ext.PartitionPrefetcher(array._ext, 3, 100)
+    assert awkward1.to_list(prefetcher.partition(0)) == list(range(10))
+    prefetcher.wait()
+    assert prefetcher.inflight_bytes == 80
+    assert awkward1.to_list(prefetcher.partition(1)) == list(range(10, 20))
+    prefetcher.wait()
+    assert prefetcher.inflight_bytes <= 100
+    assert sorted(calls) == sorted(set(calls))
+
+def test_prefetch_error():
+    def generate():
+        raise ValueError("oops")
+    form = awkward1.forms.NumpyForm([], 8, "d")
+    generator = awkward1.layout.ArrayGenerator(generate, form=form, length=10)
+    partitions = [awkward1.layout.NumpyArray(numpy.arange(10, dtype=numpy.float64)),
+                  awkward1.layout.VirtualArray(generator)]
+    array = awkward1.partition.IrregularlyPartitionedArray(partitions)
+    iterator = awkward1.partition.iterate(array.numpartitions, [array], prefetch=1)
+    assert awkward1.to_list(next(iterator)[0]) == list(range(10))
+    with pytest.raises(ValueError):
+        next(iterator)
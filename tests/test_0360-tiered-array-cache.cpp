@@ -0,0 +1,113 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#include <cstdio>
+#include <memory>
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+#include "awkward/builder/ArrayBuilder.h"
+#include "awkward/builder/ArrayBuilderOptions.h"
+#include "awkward/virtual/ArrayCache.h"
+
+namespace ak = awkward;
+
+std::shared_ptr<ak::Content> make(double start) {
+  ak::ArrayBuilder builder(ak::ArrayBuilderOptions(1024, 2.0));
+  for (int64_t i = 0;  i < 100;  i++) {
+    builder.real(start + (double)i);
+  }
+  return builder.snapshot();
+}
+
+// exposes the eviction hook, to evict an array while a newer one is set
+class Probe: public ak::TieredArrayCache {
+public:
+  Probe(const std::string& directory)
+      : ak::TieredArrayCache(1000000, directory, -1) { }
+
+  void
+  evict(const std::string& key, const std::shared_ptr<ak::Content>& value) {
+    evicted(key, value);
+  }
+};
+
+int main(int, char**) {
+  std::shared_ptr<ak::Content> one = make(0.0);
+  std::shared_ptr<ak::Content> two = make(100.0);
+
+  {
+    ak::TieredArrayCache cache(1000, ".", -1);
+    cache.set("one", one);
+    cache.set("two", two);
+
+    // "one" was evicted from memory to disk
+    if (cache.size() != 1  ||  cache.disk_keys().size() != 1)
+      return -1;
+    if (!cache.has("one")  ||  cache.spills() != 1)
+      return -1;
+
+    std::shared_ptr<ak::Content> back = cache.get("one");
+    if (back.get() == nullptr  ||  back.get() == one.get())
+      return -1;
+    if (back.get()->tojson(false, 1) != one.get()->tojson(false, 1))
+      return -1;
+    if (cache.disk_hits() != 1  ||  cache.stats().hits != 1)
+      return -1;
+
+    // reading "one" back evicted "two"; "one" is still on disk, too
+    if (cache.disk_keys().size() != 2  ||  cache.spills() != 2)
+      return -1;
+
+    cache.set("one", two);
+    if (cache.disk_keys().size() != 1)
+      return -1;
+
+    if (cache.get("three").get() != nullptr  ||  cache.stats().misses != 1)
+      return -1;
+  }
+
+  {
+    // the disk tier has its own limit
+    ak::TieredArrayCache cache(1000, ".", 1);
+    cache.set("one", one);
+    cache.set("two", two);
+    if (cache.has("one")  ||  cache.disk_bytes() != 0)
+      return -1;
+  }
+
+  {
+    // an array evicted after a newer one was set does not reach the disk
+    Probe cache(".");
+    cache.set("one", two);
+    cache.evict("one", one);
+    if (cache.disk_keys().size() != 0  ||  cache.spills() != 0)
+      return -1;
+    if (cache.get("one").get() != two.get())
+      return -1;
+
+    // an older file is replaced, not reused, by a different array
+    cache.remove("one");
+    cache.evict("one", one);
+    cache.evict("one", two);
+    if (cache.disk_keys().size() != 1  ||  cache.spills() != 2)
+      return -1;
+    std::shared_ptr<ak::Content> back = cache.get("one");
+    if (back.get()->tojson(false, 1) != two.get()->tojson(false, 1))
+      return -1;
+  }
+
+#ifndef _WIN32
+  {
+    // failed writes are counted
+    mkdir("test0360-gone", 0700);
+    Probe cache("test0360-gone");
+    std::remove("test0360-gone");
+    cache.evict("one", one);
+    if (cache.spill_failures() != 1  ||  cache.disk_keys().size() != 0)
+      return -1;
+  }
+#endif
+
+  return 0;
+}
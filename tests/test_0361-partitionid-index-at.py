@@ -0,0 +1,27 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import pytest
+import numpy
+
+import awkward1
+
+def test_partitionid_index_at():
+    array = awkward1.partition.IrregularlyPartitionedArray([
+        awkward1.layout.NumpyArray(numpy.arange(3, dtype=numpy.int64)),
+        awkward1.layout.NumpyArray(numpy.arange(0, dtype=numpy.int64)),
+        awkward1.layout.NumpyArray(numpy.arange(2, dtype=numpy.int64)),
+        awkward1.layout.NumpyArray(numpy.arange(4, dtype=numpy.int64))])
+    expected = [(0, 0), (0, 1), (0, 2), (2, 0), (2, 1),
+                (3, 0), (3, 1), (3, 2), (3, 3), (4, 0)]
+    assert [array.partitionid_index_at(i) for i in range(10)] == expected
+    assert array.partitionid_index_at(-1) == (-1, -1)
+
+    partitionids, indexes = array.partitionids_indexes_at(list(range(10)))
+    assert list(zip(partitionids, indexes)) == expected
+
+    partitionids, indexes = array.partitionids_indexes_at([8, 3, 3, 0, 9, -1, 5])
+    assert list(zip(partitionids, indexes)) == [
+        expected[8], expected[3], expected[3], expected[0], expected[9],
+        (-1, -1), expected[5]]
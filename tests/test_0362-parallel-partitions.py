@@ -0,0 +1,75 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import pytest
+import numpy
+
+import awkward1
+
+def partitioned():
+    return awkward1.partition.IrregularlyPartitionedArray([
+        awkward1.from_iter([[1, 2, 3], [], [4, 5]], highlevel=False),
+        awkward1.from_iter([[6], [7, 8, 9, 10]], highlevel=False),
+        awkward1.from_iter([[], [11, 12]], highlevel=False)])
+
+def test_map():
+    array = partitioned()
+    out = awkward1.partition.apply(lambda x: x.num(1), array, nthreads=2)
+    assert isinstance(out, awkward1.partition.PartitionedArray)
+    assert out.stops == [3, 5, 7]
+    assert awkward1.to_list(out.toContent()) == [3, 0, 2, 1, 4, 0, 2]
+
+def test_reduce():
+    array = partitioned()
+    content = array.toContent()
+    for name in ["count", "count_nonzero", "sum", "prod", "any", "all", "min", "max", "argmin", "argmax"]:
+        for axis in [0, 1, -1]:
+            for keepdims in [False, True]:
+                expected = getattr(content, name)(axis=axis, mask=False, keepdims=keepdims)
+                out = array.reduce(name, axis, False, keepdims, nthreads=3)
+                if isinstance(out, awkward1.partition.PartitionedArray):
+                    out = out.toContent()
+                assert awkward1.to_list(out) == awkward1.to_list(expected)
+
+def test_reduce_mask():
+    # partials with missing values are combined by the option-type reducer
+    array = partitioned()
+    content = array.toContent()
+    for name in ["min", "max", "argmin", "argmax"]:
+        for axis in [0, 1, -1]:
+            for keepdims in [False, True]:
+                expected = getattr(content, name)(axis=axis, mask=True, keepdims=keepdims)
+                out = array.reduce(name, axis, True, keepdims, nthreads=3)
+                if isinstance(out, awkward1.partition.PartitionedArray):
+                    out = out.toContent()
+                assert awkward1.to_list(out) == awkward1.to_list(expected)
+
+    flat = awkward1.partition.IrregularlyPartitionedArray([
+        awkward1.layout.NumpyArray(numpy.array([], dtype=numpy.int64)),
+        awkward1.layout.NumpyArray(numpy.array([5, 3, 7], dtype=numpy.int64)),
+        awkward1.layout.NumpyArray(numpy.array([], dtype=numpy.int64)),
+        awkward1.layout.NumpyArray(numpy.array([4], dtype=numpy.int64))])
+    empty = awkward1.partition.IrregularlyPartitionedArray([
+        awkward1.layout.NumpyArray(numpy.array([], dtype=numpy.int64)),
+        awkward1.layout.NumpyArray(numpy.array([], dtype=numpy.int64))])
+    for array in [flat, empty]:
+        content = array.toContent()
+        for name in ["min", "max"]:
+            for keepdims in [False, True]:
+                expected = getattr(content, name)(axis=0, mask=True, keepdims=keepdims)
+                out = array.reduce(name, 0, True, keepdims, nthreads=2)
+                assert awkward1.to_list(out) == awkward1.to_list(expected)
+    assert awkward1.to_list(flat.reduce("min", 0, True, True, nthreads=2)) == [3]
+    assert awkward1.to_list(empty.reduce("min", 0, True, True, nthreads=2)) == [None]
+
+def test_sort_and_getitem():
+    array = awkward1.partition.IrregularlyPartitionedArray([
+        awkward1.from_iter([[3, 1, 2], []], highlevel=False),
+        awkward1.from_iter([[5, 4]], highlevel=False)])
+    assert awkward1.to_list(array._ext.sort(1, True, False, 2).tocontent()) == [[1, 2, 3], [], [4, 5]]
+
+    out = array._ext.getitem((slice(1, None), slice(None, 1)), 2)
+    assert awkward1.to_list(out.tocontent()) == [[], [5]]
+    with pytest.raises(ValueError):
+        array._ext.getitem((0,), 2)
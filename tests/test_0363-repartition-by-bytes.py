@@ -0,0 +1,40 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import pytest
+import numpy
+
+import awkward1
+
+def test_repartition_by_bytes():
+    # 8-byte entries in partitions of 10, 10, 10, 300, and 5 entries
+    lengths = [10, 10, 10, 300, 5]
+    partitions = []
+    start = 0
+    for length in lengths:
+        partitions.append(awkward1.layout.NumpyArray(numpy.arange(start, start + length, dtype=numpy.float64)))
+        start += length
+    array = awkward1.partition.IrregularlyPartitionedArray(partitions)
+
+    out = array.repartition_by_bytes(800)
+    assert out.stops == [100, 200, 300, 335]
+    assert awkward1.to_list(out.toContent()) == list(range(335))
+
+    # partitions that are about the right size are kept as they are
+    out = array.repartition_by_bytes(80)
+    assert out.stops[:3] == [10, 20, 30]
+
+def test_virtual_is_not_materialized():
+    calls = []
+    def generate():
+        calls.append(None)
+        return awkward1.layout.NumpyArray(numpy.arange(100, dtype=numpy.int32))
+    form = awkward1.forms.NumpyForm([], 4, "i")
+    generator = awkward1.layout.ArrayGenerator(generate, form=form, length=100)
+    array = awkward1.partition.IrregularlyPartitionedArray([
+        awkward1.layout.VirtualArray(generator),
+        awkward1.layout.NumpyArray(numpy.arange(100, dtype=numpy.int32))])
+    out = array.repartition_by_bytes(200)
+    assert out.stops == [50, 100, 150, 200]
+    assert calls == []
@@ -0,0 +1,75 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import pytest
+import numpy
+
+import awkward1
+
+def test_slicemask():
+    assert awkward1._ext._slice_tostring(numpy.array([True, False, True])) == "[mask([True, False, True])]"
+    assert awkward1._ext._slice_tostring((numpy.array([True, False, True]), 0)) == "[array([0, 2]), array([0, 0])]"
+
+def test_numpyarray():
+    data = numpy.arange(10*3, dtype=numpy.float64).reshape(10, 3)
+    mask = numpy.array([True, True, False, True, False, False, True, True, True, False])
+    layout = awkward1.layout.NumpyArray(data)
+    assert awkward1.to_list(layout[mask]) == data[mask].tolist()
+    assert awkward1.to_list(layout[::2][mask[::2]]) == data[::2][mask[::2]].tolist()
+    assert awkward1.to_list(layout[mask, 1]) == data[mask, 1].tolist()
+    assert awkward1.to_list(layout[numpy.zeros(10, bool)]) == []
+
+    with pytest.raises(ValueError):
+        layout[mask[:5]]
+
+def test_recordarray():
+    array = awkward1.Array([{"x": i, "y": [i]*i} for i in range(5)])
+    mask = numpy.array([False, True, True, False, True])
+    assert awkward1.to_list(array[mask]) == [{"x": 1, "y": [1]}, {"x": 2, "y": [2, 2]}, {"x": 4, "y": [4, 4, 4, 4]}]
+    assert awkward1.to_list(array[mask, "y"]) == [[1], [2, 2], [4, 4, 4, 4]]
+
+    # a wrong-length mask is an error, not a list of positions
+    with pytest.raises(ValueError):
+        array.layout[mask[:3]]
+    with pytest.raises(ValueError):
+        array.layout[numpy.array([True] * 6)]
+
+def test_itemsizes():
+    mask = numpy.random.RandomState(42).randint(0, 2, 100).astype(bool)
+    mask[16:40] = True
+    for dtype in ("i1", "i2", "i4", "f8", "c16"):
+        data = numpy.arange(100).astype(dtype)
+        layout = awkward1.layout.NumpyArray(data)
+        assert awkward1.to_list(layout[mask]) == data[mask].tolist()
+        assert awkward1.to_list(layout[3:][mask[3:]]) == data[3:][mask[3:]].tolist()
+
+def test_jagged():
+    events = awkward1.Array([[{"pt": 10, "eta": 1.1}, {"pt": 30, "eta": 2.2}],
+                             [],
+                             [{"pt": 25, "eta": 3.3}, {"pt": 5, "eta": 4.4}, {"pt": 40, "eta": 5.5}]])
+    mask = events.pt > 20
+    assert awkward1._ext._slice_tostring(mask[:, :2][[0, 2]]) == "[jagged([0, 2, 4], mask([False, True, True, False]))]"
+    assert awkward1.to_list(events[mask]) == [[{"pt": 30, "eta": 2.2}], [], [{"pt": 25, "eta": 3.3}, {"pt": 40, "eta": 5.5}]]
+    assert awkward1.to_list(events.eta[mask]) == [[2.2], [], [3.3, 5.5]]
+    assert awkward1.to_list(events.pt[mask]) == [[30], [], [25, 40]]
+
+    # lists that do not start at zero or are not contiguous
+    assert awkward1.to_list(events[1:].pt[mask[1:]]) == [[], [25, 40]]
+    assert awkward1.to_list(events[[2, 0]].pt[mask[[2, 0]]]) == [[25, 40], [30]]
+
+    with pytest.raises(ValueError):
+        events.pt[awkward1.Array([[True, False], [], [True]])]
+
+def test_jagged_combined():
+    # with other items, the mask becomes local positions
+    array = awkward1.Array([[[1, 2], [3]], [], [[4], [5, 6], [7]]])
+    mask = awkward1.Array([[True, False], [], [True, False, True]])
+    assert awkward1._ext._slice_tostring((mask, slice(None, 1))) == "[jagged([0, 1, 1, 3], array([0, 0, 2])), :1]"
+    assert awkward1.to_list(array[mask, :1]) == [[[1]], [], [[4], [7]]]
+    assert awkward1.to_list(array[mask]) == [[[1, 2]], [], [[4], [7]]]
+
+def test_jagged_regular():
+    array = awkward1.layout.RegularArray(awkward1.layout.NumpyArray(numpy.arange(6)), 3)
+    mask = awkward1.Array([[True, False, True], [False, False, True]])
+    assert awkward1.to_list(array[mask]) == [[0, 2], [5]]
@@ -0,0 +1,35 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import pytest
+import numpy
+
+import awkward1
+
+def test_lazy_carry():
+    assert not awkward1.layout.Content.lazy_carry()
+    data = numpy.arange(100, dtype=numpy.float64)
+    layout = awkward1.layout.NumpyArray(data)
+    expected = data
+
+    awkward1.layout.Content.set_lazy_carry(True)
+    try:
+        out = layout
+        for cut in range(1, 6):
+            mask = expected % (cut + 1) != 0
+            out = out[mask]
+            expected = expected[mask]
+            # the data have not been gathered; only the index was composed
+            assert isinstance(out, awkward1.layout.IndexedArray64)
+            assert isinstance(out.content, awkward1.layout.NumpyArray)
+            assert len(out.content) == 100
+        assert awkward1.to_list(out) == expected.tolist()
+        assert awkward1.to_list(out[[0, -1]]) == [expected[0], expected[-1]]
+
+        jagged = awkward1.Array([[1.1, 2.2, 3.3], [], [4.4, 5.5]]).layout
+        assert awkward1.to_list(jagged[[2, 0]][[0]]) == [[4.4, 5.5]]
+    finally:
+        awkward1.layout.Content.set_lazy_carry(False)
+
+    assert isinstance(layout[numpy.array([0, 1])], awkward1.layout.NumpyArray)
@@ -0,0 +1,104 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import pytest
+import numpy
+
+import awkward1
+
+def test_numpyarray():
+    pieces = [awkward1.layout.NumpyArray(numpy.arange(i, i + 3, dtype=numpy.int64)) for i in range(0, 30, 3)]
+    out = pieces[0].merge_many(pieces[1:])
+    assert isinstance(out, awkward1.layout.NumpyArray)
+    assert awkward1.to_list(out) == list(range(30))
+
+    two = awkward1.layout.NumpyArray(numpy.arange(12, dtype=numpy.float64).reshape(6, 2)[::2])
+    assert awkward1.to_list(two.merge_many([two, two])) == [[0, 1], [4, 5], [8, 9]] * 3
+
+    mixed = pieces[0].merge_many([awkward1.layout.NumpyArray(numpy.array([1.5]))])
+    assert isinstance(mixed, awkward1.layout.NumpyArray)
+    assert numpy.asarray(mixed).dtype == numpy.dtype(numpy.float64)
+    assert awkward1.to_list(mixed) == [0, 1, 2, 1.5]
+
+def test_numpyarray_promotion():
+    int32 = awkward1.layout.NumpyArray(numpy.array([1, 2], dtype=numpy.int32))
+    int64 = awkward1.layout.NumpyArray(numpy.array([3], dtype=numpy.int64))
+    float64 = awkward1.layout.NumpyArray(numpy.array([4.5], dtype=numpy.float64))
+    out = int32.merge_many([int64, int32])
+    assert numpy.asarray(out).dtype == numpy.dtype(numpy.int64)
+    assert awkward1.to_list(out) == [1, 2, 3, 1, 2]
+    out = int32.merge_many([int64, float64])
+    assert isinstance(out, awkward1.layout.NumpyArray)
+    assert numpy.asarray(out).dtype == numpy.dtype(numpy.float64)
+    assert awkward1.to_list(out) == [1, 2, 3, 4.5]
+
+    uint8 = awkward1.layout.NumpyArray(numpy.array([[1, 2], [3, 4]], dtype=numpy.uint8))
+    int16 = awkward1.layout.NumpyArray(numpy.array([[-5, 6]], dtype=numpy.int16))
+    out = uint8.merge_many([int16])
+    assert numpy.asarray(out).dtype == numpy.dtype(numpy.int16)
+    assert awkward1.to_list(out) == [[1, 2], [3, 4], [-5, 6]]
+
+    boolean = awkward1.layout.NumpyArray(numpy.array([True, False]))
+    out = int64.merge_many([boolean], True)
+    assert awkward1.to_list(out) == [3, 1, 0]
+    assert isinstance(int64.merge_many([boolean]), awkward1.layout.UnionArray8_64)
+
+def test_emptyarray():
+    empty = awkward1.layout.EmptyArray()
+    pieces = [awkward1.layout.NumpyArray(numpy.array([1, 2], dtype=numpy.int32)), empty, awkward1.layout.NumpyArray(numpy.array([3.5])), empty]
+    out = pieces[0].merge_many(pieces[1:])
+    assert isinstance(out, awkward1.layout.NumpyArray)
+    assert numpy.asarray(out).dtype == numpy.dtype(numpy.float64)
+    assert awkward1.to_list(out) == [1, 2, 3.5]
+
+    lists = awkward1.Array([[1, 2], [], [3]]).layout
+    out = lists.merge_many([empty, lists])
+    assert isinstance(out, awkward1.layout.ListOffsetArray64)
+    assert awkward1.to_list(out) == [[1, 2], [], [3]] * 2
+
+    records = awkward1.Array([{"x": 1}, {"x": 2}]).layout
+    out = records.merge_many([empty, records])
+    assert isinstance(out, awkward1.layout.RecordArray)
+    assert awkward1.to_list(out) == [{"x": 1}, {"x": 2}] * 2
+
+def test_listoffsetarray_and_records():
+    pieces = [awkward1.Array([{"x": i, "y": [i] * i}, {"x": -i, "y": []}]) for i in range(1, 6)]
+    expected = sum([awkward1.to_list(x) for x in pieces], [])
+    out = awkward1.concatenate(pieces, highlevel=False)
+    assert isinstance(out, awkward1.layout.RecordArray)
+    assert isinstance(out.field("y"), awkward1.layout.ListOffsetArray64)
+    assert awkward1.to_list(out) == expected
+
+    sliced = [x.layout[1:] for x in pieces]
+    out = sliced[0].merge_many(sliced[1:])
+    assert awkward1.to_list(out) == [{"x": -i, "y": []} for i in range(1, 6)]
+
+    lists = [awkward1.Array([[1, 2], [3]]).layout[1:], awkward1.Array([[4.5], [], [6]]).layout]
+    assert awkward1.to_list(lists[0].merge_many(lists[1:])) == [[3], [4.5], [], [6]]
+
+def test_union():
+    out = awkward1.concatenate([awkward1.Array([1, 2]), awkward1.Array([[3]]), awkward1.Array([4])])
+    assert awkward1.to_list(out) == [1, 2, [3], 4]
+
+def test_listarray_and_regulararray():
+    content = awkward1.layout.NumpyArray(numpy.arange(10, dtype=numpy.int64))
+    starts = awkward1.layout.Index64(numpy.array([6, 0, 3], dtype=numpy.int64))
+    stops = awkward1.layout.Index64(numpy.array([9, 2, 3], dtype=numpy.int64))
+    listarray = awkward1.layout.ListArray64(starts, stops, content)
+    regular = awkward1.layout.RegularArray(awkward1.layout.NumpyArray(numpy.arange(100, 106, dtype=numpy.int64)), 2)
+    offsets = awkward1.layout.ListOffsetArray64(awkward1.layout.Index64(numpy.array([1, 2, 4], dtype=numpy.int64)), content)
+    expected = [[6, 7, 8], [0, 1], [], [100, 101], [102, 103], [104, 105], [2], [3, 4]]
+
+    for first in [listarray, awkward1.layout.ListArray32(awkward1.layout.Index32(numpy.asarray(starts).astype(numpy.int32)), awkward1.layout.Index32(numpy.asarray(stops).astype(numpy.int32)), content)]:
+        out = first.merge_many([regular, offsets])
+        assert isinstance(out, awkward1.layout.ListOffsetArray64)
+        assert awkward1.to_list(out) == expected
+
+    out = offsets.merge_many([listarray, regular])
+    assert isinstance(out, awkward1.layout.ListOffsetArray64)
+    assert awkward1.to_list(out) == [[2], [3, 4], [6, 7, 8], [0, 1], [], [100, 101], [102, 103], [104, 105]]
+
+    out = regular.merge_many([listarray])
+    assert isinstance(out, awkward1.layout.ListOffsetArray64)
+    assert awkward1.to_list(out) == [[100, 101], [102, 103], [104, 105], [6, 7, 8], [0, 1], []]
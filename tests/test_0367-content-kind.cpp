@@ -0,0 +1,50 @@
+// BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+#include <memory>
+
+#include "awkward/builder/ArrayBuilder.h"
+#include "awkward/builder/ArrayBuilderOptions.h"
+#include "awkward/array/IndexedArray.h"
+#include "awkward/array/ListOffsetArray.h"
+#include "awkward/array/NumpyArray.h"
+#include "awkward/array/RawArray.h"
+
+namespace ak = awkward;
+
+int main(int, char**) {
+  ak::ArrayBuilder builder(ak::ArrayBuilderOptions(1024, 2.0));
+  builder.beginlist();
+  builder.real(1.1);
+  builder.endlist();
+  builder.beginlist();
+  builder.endlist();
+  std::shared_ptr<ak::Content> array = builder.snapshot();
+
+  if (array.get()->kind() != ak::Content::Kind::ListOffsetArray64)
+    return -1;
+  ak::ListOffsetArray64* list = ak::kind_cast<ak::ListOffsetArray64>(array.get());
+  if (list == nullptr)
+    return -1;
+  if (ak::kind_cast<ak::ListOffsetArray32>(array.get()) != nullptr  ||
+      ak::kind_cast<ak::NumpyArray>(array.get()) != nullptr)
+    return -1;
+  if (ak::kind_cast<ak::NumpyArray>(list->content().get()) == nullptr)
+    return -1;
+
+  ak::Index64 index(2);
+  std::shared_ptr<ak::Content> indexed = std::make_shared<ak::IndexedOptionArray64>(
+    ak::Identities::none(), ak::util::Parameters(), index, array);
+  if (indexed.get()->kind() != ak::Content::Kind::IndexedOptionArray64  ||
+      ak::kind_cast<ak::IndexedArray64>(indexed.get()) != nullptr  ||
+      ak::kind_cast<ak::IndexedOptionArray64>(indexed.get()) == nullptr)
+    return -1;
+
+  ak::RawArrayOf<double> raw(ak::Identities::none(), ak::util::Parameters(), 3);
+  if (raw.kind() != ak::Content::Kind::RawArray)
+    return -1;
+
+  if (ak::kind_cast<ak::NumpyArray>(nullptr) != nullptr)
+    return -1;
+
+  return 0;
+}
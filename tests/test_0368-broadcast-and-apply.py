@@ -0,0 +1,92 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import pytest
+import numpy
+
+import awkward1
+
+def native(ufunc, *inputs):
+    layouts = [x.layout if isinstance(x, awkward1.Array) else x for x in inputs]
+    return awkward1.layout._broadcast_and_apply(ufunc.__name__, layouts)
+
+def test_jagged():
+    one = awkward1.Array([[1.1, 2.2, 3.3], [], [4.4, 5.5]])
+    two = awkward1.Array([[10, 20, 30], [], [40, 50]])
+    out = native(numpy.add, one, two)
+    assert isinstance(out, awkward1.layout.ListOffsetArray64)
+    assert awkward1.to_list(out) == awkward1.to_list(one + two)
+    assert awkward1.to_list(out) == [[11.1, 22.2, 33.3], [], [44.4, 55.5]]
+
+    # one value per list is broadcast into the list
+    three = awkward1.Array([100, 200, 300])
+    assert awkward1.to_list(native(numpy.multiply, two, three)) == [[1000, 2000, 3000], [], [12000, 15000]]
+
+    # a list that is sliced is compacted to the first list's offsets
+    sliced = awkward1.Array([[0, 1, 2, 3], [], [4, 5, 6]])[:, 1:]
+    assert awkward1.to_list(native(numpy.subtract, sliced, one)) == awkward1.to_list(sliced - one)
+
+def test_scalars_and_types():
+    ints = awkward1.Array([[1, 2, 3], [], [4, 5]])
+    out = native(numpy.add, ints, 1)
+    assert numpy.asarray(out.content).dtype == numpy.int64
+    assert awkward1.to_list(out) == [[2, 3, 4], [], [5, 6]]
+    assert numpy.asarray(native(numpy.add, ints, 1.5).content).dtype == numpy.float64
+    assert numpy.asarray(native(numpy.true_divide, ints, 2).content).dtype == numpy.float64
+    assert awkward1.to_list(native(numpy.greater, ints, 2)) == [[False, False, True], [], [True, True]]
+    assert awkward1.to_list(native(numpy.sqrt, awkward1.Array([[4.0], [9.0]]))) == [[2.0], [3.0]]
+
+    small = awkward1.Array(numpy.array([1, 2, 3], dtype=numpy.int32))
+    assert numpy.asarray(native(numpy.add, small, 1)).dtype == numpy.int32
+    assert numpy.asarray(native(numpy.add, small, 2**40)).dtype == numpy.int64
+
+    flags = awkward1.Array([[True, False], [True]])
+    assert awkward1.to_list(native(numpy.logical_not, flags)) == [[False, True], [False]]
+    # NumPy's rules for these are left to the Python implementation
+    assert native(numpy.add, flags, flags) is None
+    assert native(numpy.logical_and, ints, ints) is None
+
+def test_regular():
+    array = awkward1.layout.NumpyArray(numpy.arange(2*3*5).reshape(2, 3, 5))
+    other = awkward1.layout.NumpyArray(numpy.arange(2*3).reshape(2, 3, 1) * 100)
+    out = native(numpy.add, array, other)
+    assert awkward1.to_list(out) == (numpy.arange(2*3*5).reshape(2, 3, 5) + numpy.arange(2*3).reshape(2, 3, 1) * 100).tolist()
+
+    # same shapes go straight to the kernel
+    out = native(numpy.multiply, array, array)
+    assert isinstance(out, awkward1.layout.NumpyArray)
+    assert awkward1.to_list(out) == (numpy.arange(2*3*5).reshape(2, 3, 5)**2).tolist()
+
+def test_option():
+    one = awkward1.Array([[1, 2, 3], None, [4, 5], [6]])
+    two = awkward1.Array([10, 20, None, 40])
+    out = native(numpy.add, one, two)
+    assert awkward1.to_list(out) == [[11, 12, 13], None, None, [46]]
+    assert awkward1.to_list(out) == awkward1.to_list(one + two)
+
+def test_records():
+    one = awkward1.Array([{"x": 1, "y": [1.1]}, {"x": 2, "y": []}])
+    two = awkward1.Array([{"y": [10.0], "x": 10}, {"y": [], "x": 20}])
+    out = native(numpy.add, one, two)
+    assert isinstance(out, awkward1.layout.RecordArray)
+    assert awkward1.to_list(out) == [{"x": 11, "y": [11.1]}, {"x": 22, "y": []}]
+    assert native(numpy.add, one, awkward1.Array([{"x": 1}, {"x": 2}])) is None
+
+def test_fallback():
+    # unions, behaviors, and length mismatches use the Python implementation
+    union = awkward1.Array([1, [2, 3]])
+    assert native(numpy.add, union, 1) is None
+    assert awkward1.to_list(union + 1) == [2, [3, 4]]
+
+    strings = awkward1.Array(["one", "two"])
+    assert native(numpy.equal, strings, strings) is None
+    assert awkward1.to_list(strings == strings) == [True, True]
+
+    assert native(numpy.add, awkward1.Array([1, 2]), awkward1.Array([1, 2, 3])) is None
+    with pytest.raises(ValueError):
+        awkward1.Array([1, 2]) + awkward1.Array([1, 2, 3])
+
+    # functions without an elementwise kernel
+    assert native(numpy.arctan2, awkward1.Array([1.0]), awkward1.Array([1.0])) is None
+    assert awkward1.to_list(numpy.arctan2(awkward1.Array([[1.0]]), 1.0)) == [[numpy.arctan2(1.0, 1.0)]]
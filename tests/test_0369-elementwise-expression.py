@@ -0,0 +1,96 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import pytest
+import numpy
+
+import awkward1
+
+def test_program():
+    expr = awkward1.layout.ElementwiseExpression(["#0", "2", "power", "#1", "2", "power", "add", "sqrt"])
+    assert expr.numinputs == 2
+    assert not expr.isboolean
+    assert awkward1.layout.ElementwiseExpression(["#0", "1.5", "less"]).isboolean
+
+    with pytest.raises(ValueError):
+        awkward1.layout.ElementwiseExpression(["#0", "add"])
+    with pytest.raises(ValueError):
+        awkward1.layout.ElementwiseExpression(["#0", "#1"])
+    with pytest.raises(ValueError):
+        awkward1.layout.ElementwiseExpression(["#0", "arctan2"])
+
+def test_shared_offsets():
+    particles = awkward1.Array([[{"px": 3.0, "py": 4}, {"px": 0.0, "py": 1}], [], [{"px": 5.0, "py": 12}]])
+    px, py = particles.px, particles.py
+    expr = awkward1.layout.ElementwiseExpression(["#0", "2", "power", "#1", "2", "power", "add", "sqrt"])
+    out = expr.apply([px.layout, py.layout])
+    assert awkward1.to_list(out) == [[5.0, 1.0], [], [13.0]]
+
+    # the fields of a list of records share offsets, which are reused as-is
+    assert numpy.asarray(out.offsets).tolist() == numpy.asarray(particles.layout.offsets).tolist()
+    assert awkward1.to_list(out) == awkward1.to_list(numpy.sqrt(px**2 + py**2))
+
+    # sliced lists are still evaluated on the reachable elements only
+    assert awkward1.to_list(expr.apply([px[1:].layout, py[1:].layout])) == [[], [13.0]]
+
+def test_fused():
+    px = awkward1.Array([[1.0, 2.0, 3.0], [], [4.0, 5.0]])
+    py = awkward1.Array([[1, 2, 3], [], [4, 5]])
+    out = awkward1.numexpr.fused("sqrt(px**2 + py**2)")
+    assert awkward1.to_list(out) == awkward1.to_list(numpy.sqrt(px**2 + py**2))
+
+    assert awkward1.to_list(awkward1.numexpr.fused("(px > 2) & (py < 5)")) == [[False, False, True], [], [True, False]]
+    assert awkward1.to_list(awkward1.numexpr.fused("where(px > 2, px, -1)")) == [[-1, -1, 3], [], [4, 5]]
+
+    # different structures are broadcast as in ufuncs
+    scale = awkward1.Array([10, 20, 30])
+    assert awkward1.to_list(awkward1.numexpr.fused("px * scale + 1")) == [[11, 21, 31], [], [121, 151]]
+
+    # local variables and numbers
+    offset = 0.5
+    assert awkward1.to_list(awkward1.numexpr.fused("px + offset")) == [[1.5, 2.5, 3.5], [], [4.5, 5.5]]
+
+    with pytest.raises(ValueError):
+        awkward1.numexpr.fused("px[0]")
+
+def test_fused_literals_and_behavior():
+    py = awkward1.Array([[1, 2, 3], [], [4, 5]])
+    out = awkward1.numexpr.fused("py * 2 + 1")
+    assert numpy.asarray(out.layout.content).dtype == numpy.dtype(numpy.int64)
+    assert awkward1.to_list(out) == [[3, 5, 7], [], [9, 11]]
+    out = awkward1.numexpr.fused("py * 2.0")
+    assert numpy.asarray(out.layout.content).dtype == numpy.dtype(numpy.float64)
+    assert numpy.asarray(awkward1.layout.ElementwiseExpression(["#0", "2.0", "multiply"]).apply([py.layout.content])).dtype == numpy.dtype(numpy.float64)
+
+    behavior = {"marker": True}
+    py = awkward1.Array([[1, 2, 3], [], [4, 5]], behavior=behavior)
+    out = awkward1.numexpr.fused("py + 1")
+    assert out.behavior is not None and out.behavior["marker"] is True
+
+def test_dtypes():
+    big = awkward1.layout.NumpyArray(numpy.array([2**60 + 1, 3, -5], dtype=numpy.int64))
+    small = awkward1.layout.NumpyArray(numpy.array([2, 3, 4], dtype=numpy.int32))
+    out = awkward1.layout.ElementwiseExpression(["#0", "#1", "multiply", "1", "add"]).apply([big, small])
+    assert numpy.asarray(out).dtype == numpy.dtype(numpy.int64)
+    assert numpy.asarray(out).tolist() == [(2**60 + 1)*2 + 1, 10, -19]
+
+    out = awkward1.layout.ElementwiseExpression(["#0", "#1", "subtract", "#1", "greater"]).apply([big, small])
+    assert numpy.asarray(out).dtype == numpy.dtype(numpy.bool_)
+    assert numpy.asarray(out).tolist() == [True, False, False]
+
+    # divide, power and transcendental functions need floating point
+    for program in [["#0", "3", "divide"], ["#0", "2", "power"], ["#0", "sqrt"], ["#0", "0.5", "add"]]:
+        out = awkward1.layout.ElementwiseExpression(program).apply([small])
+        assert numpy.asarray(out).dtype == numpy.dtype(numpy.float64)
+
+    x = awkward1.layout.NumpyArray(numpy.array([3, 0, 5], dtype=numpy.float32))
+    y = awkward1.layout.NumpyArray(numpy.array([4, 1, 12], dtype=numpy.float32))
+    expr = awkward1.layout.ElementwiseExpression(["#0", "2", "power", "#1", "2", "power", "add", "sqrt"])
+    out = expr.apply([x, y])
+    assert numpy.asarray(out).dtype == numpy.dtype(numpy.float32)
+    assert numpy.asarray(out).tolist() == [5.0, 1.0, 13.0]
+
+    # float32 with integers is float64, as in NumPy
+    out = expr.apply([x, small])
+    assert numpy.asarray(out).dtype == numpy.dtype(numpy.float64)
@@ -0,0 +1,113 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import pytest
+import numpy
+
+import awkward1
+
+def test_lists():
+    array = awkward1.Array([[1.1, 2.2, 3.3], [], [4.4, 5.5], [6.6], [7.7, 8.8, 9.9]])
+    sliced = array[3:]
+    out = sliced.layout.packed()
+    assert isinstance(out, awkward1.layout.ListOffsetArray64)
+    assert numpy.asarray(out.offsets).tolist() == [0, 1, 4]
+    assert numpy.asarray(out.content).tolist() == [6.6, 7.7, 8.8, 9.9]
+    assert awkward1.to_list(out) == awkward1.to_list(sliced)
+    assert out.nbytes < sliced.layout.nbytes
+
+    # ListArray from a filter
+    filtered = array[[4, 0]]
+    out = awkward1.packed(filtered)
+    assert isinstance(out.layout, awkward1.layout.ListOffsetArray64)
+    assert numpy.asarray(out.layout.content).tolist() == [7.7, 8.8, 9.9, 1.1, 2.2, 3.3]
+    assert awkward1.to_list(out) == [[7.7, 8.8, 9.9], [1.1, 2.2, 3.3]]
+    assert awkward1.type(out) == awkward1.type(filtered)
+
+    # lists within lists are trimmed at every level
+    nested = awkward1.Array([[[1, 2], [3]], [], [[4, 5, 6]], [[7], [8, 9]]])[2:, 1:]
+    out = nested.layout.packed()
+    assert awkward1.to_list(out) == [[], [[8, 9]]]
+    assert numpy.asarray(out.content.content).tolist() == [8, 9]
+
+def test_option():
+    array = awkward1.Array([[1, 2, 3], None, [4, 5], None, [6]])
+    masked = array[[4, 1, 0]]
+    out = masked.layout.packed()
+    assert isinstance(out, awkward1.layout.IndexedOptionArray64)
+    assert numpy.asarray(out.index).tolist() == [0, -1, 1]
+    assert awkward1.to_list(out.content) == [[6], [1, 2, 3]]
+    assert awkward1.to_list(out) == awkward1.to_list(masked)
+
+    bytemasked = awkward1.layout.ByteMaskedArray(
+        awkward1.layout.Index8(numpy.array([1, 0, 1], dtype=numpy.int8)),
+        awkward1.layout.NumpyArray(numpy.arange(10)),
+        valid_when=True)
+    out = bytemasked.packed()
+    assert awkward1.to_list(out) == [0, None, 2]
+    assert len(out.content) == 3
+
+    bitmasked = awkward1.layout.BitMaskedArray(
+        awkward1.layout.IndexU8(numpy.array([0b101, 0, 0, 0], dtype=numpy.uint8)),
+        awkward1.layout.NumpyArray(numpy.arange(32)),
+        valid_when=True, length=3, lsb_order=True)
+    out = bitmasked.packed()
+    assert isinstance(out, awkward1.layout.BitMaskedArray)
+    assert awkward1.to_list(out) == [0, None, 2]
+    assert len(numpy.asarray(out.mask)) == 1
+    assert len(out.content) == 3
+
+def test_records_and_unions():
+    array = awkward1.Array([{"x": 1, "y": [1.1]}, {"x": 2, "y": []}, {"x": 3, "y": [3.3, 3.3]}])
+    out = array[1:].layout.packed()
+    assert awkward1.to_list(out) == [{"x": 2, "y": []}, {"x": 3, "y": [3.3, 3.3]}]
+    assert numpy.asarray(out.field("x")).tolist() == [2, 3]
+    assert awkward1.to_list(awkward1.packed(array[2])) == {"x": 3, "y": [3.3, 3.3]}
+
+    union = awkward1.Array([1, [2, 3], 4, [5]])[[3, 2]]
+    out = union.layout.packed()
+    assert awkward1.to_list(out) == [[5], 4]
+    assert sum(len(x) for x in out.contents) == 2
+    assert awkward1.type(out) == awkward1.type(union.layout)
+
+def test_regular_and_numpy():
+    array = awkward1.layout.NumpyArray(numpy.arange(2*3*5).reshape(2, 3, 5)[:, ::2, 1:])
+    out = array.packed()
+    assert awkward1.to_list(out) == awkward1.to_list(array)
+    assert out.iscontiguous
+
+    regular = awkward1.layout.RegularArray(awkward1.layout.NumpyArray(numpy.arange(10)), 3)
+    out = regular.packed()
+    assert awkward1.to_list(out) == [[0, 1, 2], [3, 4, 5], [6, 7, 8]]
+    assert len(out.content) == 9
+
+def test_carried_through_records():
+    # lists and option types over records carry every field in one pass
+    regular = awkward1.layout.RegularArray(awkward1.layout.NumpyArray(numpy.arange(12)), 2)
+    bytemasked = awkward1.layout.ByteMaskedArray(
+        awkward1.layout.Index8(numpy.array([1, 0, 1, 1, 0, 1], dtype=numpy.int8)),
+        awkward1.layout.NumpyArray(numpy.arange(6) * 1.1),
+        valid_when=True)
+    bitmasked = awkward1.layout.BitMaskedArray(
+        awkward1.layout.IndexU8(numpy.array([0b110101], dtype=numpy.uint8)),
+        awkward1.layout.NumpyArray(numpy.arange(10)),
+        valid_when=True, length=6, lsb_order=True)
+    unmasked = awkward1.layout.UnmaskedArray(awkward1.layout.NumpyArray(numpy.arange(6)))
+    records = awkward1.layout.RecordArray([regular, bytemasked, bitmasked, unmasked], ["r", "b", "m", "u"])
+
+    index = awkward1.layout.Index64(numpy.array([5, 0, 3], dtype=numpy.int64))
+    indexed = awkward1.layout.IndexedArray64(index, records)
+    out = indexed.packed()
+    assert isinstance(out, awkward1.layout.RecordArray)
+    assert awkward1.to_list(out) == awkward1.to_list(indexed)
+    assert len(out.field("r").content) == 6
+    assert len(out.field("b").content) == 3
+    assert len(out.field("m").content) == 3
+    assert len(out.field("u").content) == 3
+
+    offsets = awkward1.layout.Index64(numpy.array([0, 2, 2, 5], dtype=numpy.int64))
+    lists = awkward1.layout.ListOffsetArray64(offsets, records)[[2, 0]]
+    out = lists.packed()
+    assert awkward1.to_list(out) == awkward1.to_list(lists)
+    assert len(out.content.field("r").content) == 10
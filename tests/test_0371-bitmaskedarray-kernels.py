@@ -0,0 +1,48 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import pytest
+import numpy
+
+import awkward1
+
+def bitmasked(lsb_order, valid_when):
+    bits = numpy.array([1, 0, 1, 1, 0, 0, 0, 1, 1, 1, 0, 1, 1], dtype=numpy.bool_)
+    if not valid_when:
+        bits = ~bits
+    mask = numpy.packbits(bits, bitorder="little" if lsb_order else "big")
+    content = awkward1.layout.NumpyArray(numpy.arange(13))
+    return awkward1.layout.BitMaskedArray(awkward1.layout.IndexU8(mask), content, valid_when=valid_when, length=13, lsb_order=lsb_order)
+
+expected = [0, None, 2, 3, None, None, None, 7, 8, 9, None, 11, 12]
+
+@pytest.mark.parametrize("lsb_order", [False, True])
+@pytest.mark.parametrize("valid_when", [False, True])
+def test_carry_and_project(lsb_order, valid_when):
+    array = bitmasked(lsb_order, valid_when)
+    assert awkward1.to_list(array) == expected
+
+    # carrying keeps the bitmap instead of expanding it to bytes
+    out = array[[12, 1, 0, 4, 7, 7, 10, 11, 3]]
+    assert isinstance(out, awkward1.layout.BitMaskedArray)
+    assert out.lsb_order == lsb_order and out.valid_when == valid_when
+    assert len(numpy.asarray(out.mask)) == 2
+    assert awkward1.to_list(out) == [expected[i] for i in [12, 1, 0, 4, 7, 7, 10, 11, 3]]
+
+    assert numpy.asarray(array.project()).tolist() == [x for x in expected if x is not None]
+    assert awkward1.to_list(array.project()) == awkward1.to_list(array.toByteMaskedArray().project())
+
+def test_getitem_and_reduce():
+    content = awkward1.Array([[0, 1, 2], [], [3, 4], [5], [6, 7, 8, 9]]).layout
+    mask = awkward1.layout.IndexU8(numpy.array([0b00011001], dtype=numpy.uint8))
+    array = awkward1.Array(awkward1.layout.BitMaskedArray(mask, content, valid_when=True, length=5, lsb_order=True))
+    assert awkward1.to_list(array) == [[0, 1, 2], None, None, [5], [6, 7, 8, 9]]
+
+    assert awkward1.to_list(array[:, 0]) == [0, None, None, 5, 6]
+    assert awkward1.to_list(array[:, 1:]) == [[1, 2], None, None, [], [7, 8, 9]]
+    assert awkward1.to_list(array[[[1], [], [], [], [0, 3]]]) == [[1], None, None, [], [6, 9]]
+
+    assert awkward1.to_list(awkward1.sum(array, axis=-1)) == [3, None, None, 5, 30]
+    assert awkward1.to_list(awkward1.sum(array, axis=0)) == [11, 8, 10, 9]
+    assert awkward1.count(array, axis=None) == 8
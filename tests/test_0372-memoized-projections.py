@@ -0,0 +1,95 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import pytest
+import numpy
+
+import awkward1
+
+def address(layout):
+    return numpy.asarray(layout).ctypes.data
+
+def test_indexedarray():
+    assert not awkward1.layout.Content.memoize_projections()
+    content = awkward1.layout.NumpyArray(numpy.array([0.0, 1.1, 2.2, 3.3, 4.4]))
+    index = awkward1.layout.Index64(numpy.array([4, 2, 2, 0], dtype=numpy.int64))
+    indexedarray = awkward1.layout.IndexedArray64(index, content)
+    optindex = awkward1.layout.Index64(numpy.array([4, -1, 2, -1, 0], dtype=numpy.int64))
+    indexedoptionarray = awkward1.layout.IndexedOptionArray64(optindex, content)
+
+    one, two = indexedarray.project(), indexedarray.project()
+    assert address(one) != address(two)
+
+    cache = awkward1.layout.LRUArrayCache(1000000)
+    awkward1.layout.Content.set_memoize_projections(cache)
+    try:
+        assert awkward1.layout.Content.memoize_projections() is cache
+        one = indexedarray.project()
+        two = indexedarray.project()
+        assert awkward1.to_list(one) == [4.4, 2.2, 2.2, 0.0]
+        assert address(one) == address(two)
+
+        one = indexedoptionarray.project()
+        two = indexedoptionarray.project()
+        assert awkward1.to_list(one) == [4.4, 2.2, 0.0]
+        assert address(one) == address(two)
+
+        # a projection with a mask is not the memoized one
+        mask = awkward1.layout.Index8(numpy.array([0, 0, 1, 0, 0], dtype=numpy.int8))
+        assert awkward1.to_list(indexedoptionarray.project(mask)) == [4.4, 0.0]
+        assert awkward1.to_list(indexedoptionarray.project()) == [4.4, 2.2, 0.0]
+
+        # new identities are not hidden by an earlier projection
+        indexedarray.setidentities()
+        assert indexedarray.project().identities is not None
+    finally:
+        awkward1.layout.Content.set_memoize_projections(None)
+    assert awkward1.layout.Content.memoize_projections() is None
+
+def test_unionarray():
+    tags = awkward1.layout.Index8(numpy.array([0, 1, 0, 1, 0], dtype=numpy.int8))
+    index = awkward1.layout.Index64(numpy.array([0, 0, 1, 1, 2], dtype=numpy.int64))
+    content0 = awkward1.layout.NumpyArray(numpy.array([1.1, 2.2, 3.3]))
+    content1 = awkward1.layout.NumpyArray(numpy.array([10, 20], dtype=numpy.int64))
+    unionarray = awkward1.layout.UnionArray8_64(tags, index, [content0, content1])
+
+    awkward1.layout.Content.set_memoize_projections(awkward1.layout.ArrayCache({}))
+    try:
+        assert awkward1.to_list(unionarray.project(0)) == [1.1, 2.2, 3.3]
+        assert awkward1.to_list(unionarray.project(1)) == [10, 20]
+        assert address(unionarray.project(0)) == address(unionarray.project(0))
+        assert address(unionarray.project(1)) == address(unionarray.project(1))
+        assert address(unionarray.project(0)) != address(unionarray.project(1))
+        with pytest.raises(ValueError):
+            unionarray.project(2)
+    finally:
+        awkward1.layout.Content.set_memoize_projections(None)
+
+    one, two = unionarray.project(0), unionarray.project(0)
+    assert address(one) != address(two)
+
+def test_bounded():
+    content = awkward1.layout.NumpyArray(numpy.arange(1000, dtype=numpy.float64))
+    index = awkward1.layout.Index64(numpy.arange(999, -1, -1, dtype=numpy.int64))
+    arrays = [awkward1.layout.IndexedArray64(index, content) for i in range(10)]
+
+    # room for two projections of 8000 bytes each
+    cache = awkward1.layout.LRUArrayCache(20000)
+    awkward1.layout.Content.set_memoize_projections(cache)
+    try:
+        first = arrays[0].project()
+        for array in arrays:
+            assert numpy.asarray(array.project()).tolist() == list(range(999, -1, -1))
+        assert len(cache) == 2
+        assert cache.current_bytes <= 20000
+
+        # the most recent ones are still memoized, the evicted ones are not
+        assert address(arrays[-1].project()) == address(arrays[-1].project())
+        assert address(arrays[0].project()) != address(first)
+    finally:
+        awkward1.layout.Content.set_memoize_projections(None)
+
+def test_not_a_cache():
+    with pytest.raises(ValueError):
+        awkward1.layout.Content.set_memoize_projections(True)
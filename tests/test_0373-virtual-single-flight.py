@@ -0,0 +1,59 @@
+# BSD 3-Clause License; see https://github.com/scikit-hep/awkward-1.0/blob/master/LICENSE
+
+from __future__ import absolute_import
+
+import threading
+import time
+
+import pytest
+import numpy
+
+import awkward1
+
+def test_single_flight():
+    calls = []
+    def generate():
+        calls.append(None)
+        time.sleep(0.2)
+        return awkward1.layout.NumpyArray(numpy.arange(10, dtype=numpy.float64))
+    form = awkward1.forms.NumpyForm([], 8, "d")
+    for cache in [awkward1.layout.LRUArrayCache(1000000), None]:
+        del calls[:]
+        generator = awkward1.layout.ArrayGenerator(generate, form=form, length=10)
+        if cache is None:
+            array = awkward1.layout.VirtualArray(generator)
+        else:
+            array = awkward1.layout.VirtualArray(generator, cache)
+        results = []
+        threads = [threading.Thread(target=lambda: results.append(awkward1.to_list(array))) for i in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        assert results == [list(range(10))] * 4
+        assert len(calls) == 1
+
+def test_prefetch_cpp_generator():
+    # the leader runs on a background thread and needs the GIL for the
+    # dict cache and the Python generator inside the SliceGenerator, while
+    # the main thread waits for it as a follower
+    started = [threading.Event() for i in range(3)]
+    def generate(i):
+        started[i].set()
+        time.sleep(0.2)
+        return awkward1.layout.NumpyArray(numpy.arange(11, dtype=numpy.float64) + 10*i)
+    form = awkward1.forms.NumpyForm([], 8, "d")
+    cache = {}
+    partitions = []
+    for i in range(3):
+        inner = awkward1.layout.VirtualArray(awkward1.layout.ArrayGenerator(generate, (i,), form=form, length=11))
+        generator = awkward1.layout.SliceGenerator(inner, slice(1, None), form, 10)
+        partitions.append(awkward1.layout.VirtualArray(generator, awkward1.layout.ArrayCache(cache), cache_key="p{0}".format(i)))
+    array = awkward1.partition.IrregularlyPartitionedArray(partitions)
+
+    prefetcher = awkward1._ext.PartitionPrefetcher(array._ext, 2)
+    assert awkward1.to_list(prefetcher.partition(0)) == list(range(1, 11))
+    assert started[1].wait(5)
+    assert awkward1.to_list(partitions[1]) == list(range(11, 21))
+    prefetcher.wait()
+    assert "p1" in cache